@@ -34,6 +34,104 @@
 #include "core/math/geometry_3d.h"
 #include "core/object/script_language.h"
 
+// Per-thread search state for the compacted graphs, so queries don't write to the graph
+// and can run from several threads at once.
+struct AStarCompactSolveBuffers {
+	static constexpr uint32_t CLOSED = UINT32_MAX;
+
+	LocalVector<uint32_t> open_pass;
+	LocalVector<uint32_t> open_list_indices; // Position in `open_list`, or `CLOSED` once processed.
+	LocalVector<uint32_t> prev_points;
+	LocalVector<real_t> g_scores;
+	LocalVector<real_t> f_scores;
+	LocalVector<uint32_t> open_list;
+	uint32_t pass = 0;
+
+	void begin_pass(uint32_t p_point_count) {
+		if (open_pass.size() < p_point_count) {
+			const uint32_t old_size = open_pass.size();
+			open_pass.resize(p_point_count);
+			memset(open_pass.ptr() + old_size, 0, (p_point_count - old_size) * sizeof(uint32_t));
+			open_list_indices.resize(p_point_count);
+			prev_points.resize(p_point_count);
+			g_scores.resize(p_point_count);
+			f_scores.resize(p_point_count);
+		}
+
+		pass++;
+		if (unlikely(pass == 0)) {
+			memset(open_pass.ptr(), 0, open_pass.size() * sizeof(uint32_t));
+			pass = 1;
+		}
+		open_list.clear();
+	}
+
+	_FORCE_INLINE_ bool is_closed(uint32_t p_point) const {
+		return open_pass[p_point] == pass && open_list_indices[p_point] == CLOSED;
+	}
+
+	_FORCE_INLINE_ bool is_worse(uint32_t p_a, uint32_t p_b) const { // Same ordering as `AStar3D::SortPoints`.
+		if (f_scores[p_a] > f_scores[p_b]) {
+			return true;
+		} else if (f_scores[p_a] < f_scores[p_b]) {
+			return false;
+		} else {
+			return g_scores[p_a] < g_scores[p_b];
+		}
+	}
+
+	// Same sifting as `SortArray::push_heap()` and `SortArray::pop_heap()`, but keeps the position of each point up to date.
+	void sift_up(uint32_t p_hole, uint32_t p_point) {
+		while (p_hole > 0) {
+			const uint32_t parent = (p_hole - 1) / 2;
+			if (!is_worse(open_list[parent], p_point)) {
+				break;
+			}
+			open_list[p_hole] = open_list[parent];
+			open_list_indices[open_list[p_hole]] = p_hole;
+			p_hole = parent;
+		}
+		open_list[p_hole] = p_point;
+		open_list_indices[p_point] = p_hole;
+	}
+
+	void push(uint32_t p_point) {
+		open_list.push_back(p_point);
+		sift_up(open_list.size() - 1, p_point);
+	}
+
+	void pop() {
+		open_list_indices[open_list[0]] = CLOSED;
+
+		const uint32_t len = open_list.size() - 1;
+		const uint32_t last = open_list[len];
+		open_list.resize(len);
+		if (len == 0) {
+			return;
+		}
+
+		uint32_t hole = 0;
+		uint32_t second_child = 2;
+		while (second_child < len) {
+			if (is_worse(open_list[second_child], open_list[second_child - 1])) {
+				second_child--;
+			}
+			open_list[hole] = open_list[second_child];
+			open_list_indices[open_list[hole]] = hole;
+			hole = second_child;
+			second_child = 2 * (second_child + 1);
+		}
+		if (second_child == len) {
+			open_list[hole] = open_list[second_child - 1];
+			open_list_indices[open_list[hole]] = hole;
+			hole = second_child - 1;
+		}
+		sift_up(hole, last);
+	}
+};
+
+static thread_local AStarCompactSolveBuffers compact_solve_buffers;
+
 int64_t AStar3D::get_available_point_id() const {
 	if (points.has(last_free_id)) {
 		int64_t cur_new_id = last_free_id + 1;
@@ -63,9 +161,16 @@ void AStar3D::add_point(int64_t p_id, const Vector3 &p_pos, real_t p_weight_scal
 		pt->closed_pass = 0;
 		pt->enabled = true;
 		points.set(p_id, pt);
+		_clear_compact_graph();
 	} else {
 		found_pt->pos = p_pos;
 		found_pt->weight_scale = p_weight_scale;
+
+		uint32_t index;
+		if (compacted && compact_graph.lookup(p_id, index)) {
+			compact_graph.positions[index] = p_pos;
+			compact_graph.weight_scales[index] = p_weight_scale;
+		}
 	}
 }
 
@@ -83,6 +188,11 @@ void AStar3D::set_point_position(int64_t p_id, const Vector3 &p_pos) {
 	ERR_FAIL_COND_MSG(!p_exists, vformat("Can't set point's position. Point with id: %d doesn't exist.", p_id));
 
 	p->pos = p_pos;
+
+	uint32_t index;
+	if (compacted && compact_graph.lookup(p_id, index)) {
+		compact_graph.positions[index] = p_pos;
+	}
 }
 
 real_t AStar3D::get_point_weight_scale(int64_t p_id) const {
@@ -100,6 +210,11 @@ void AStar3D::set_point_weight_scale(int64_t p_id, real_t p_weight_scale) {
 	ERR_FAIL_COND_MSG(p_weight_scale < 0.0, vformat("Can't set point's weight scale less than 0.0: %f.", p_weight_scale));
 
 	p->weight_scale = p_weight_scale;
+
+	uint32_t index;
+	if (compacted && compact_graph.lookup(p_id, index)) {
+		compact_graph.weight_scales[index] = p_weight_scale;
+	}
 }
 
 void AStar3D::remove_point(int64_t p_id) {
@@ -126,6 +241,7 @@ void AStar3D::remove_point(int64_t p_id) {
 	memdelete(p);
 	points.remove(p_id);
 	last_free_id = p_id;
+	_clear_compact_graph();
 }
 
 void AStar3D::connect_points(int64_t p_id, int64_t p_with_id, bool bidirectional) {
@@ -164,6 +280,7 @@ void AStar3D::connect_points(int64_t p_id, int64_t p_with_id, bool bidirectional
 	}
 
 	segments.insert(s);
+	_clear_compact_graph();
 }
 
 void AStar3D::disconnect_points(int64_t p_id, int64_t p_with_id, bool bidirectional) {
@@ -203,6 +320,7 @@ void AStar3D::disconnect_points(int64_t p_id, int64_t p_with_id, bool bidirectio
 		if (s.direction != Segment::NONE) {
 			segments.insert(s);
 		}
+		_clear_compact_graph();
 	}
 }
 
@@ -249,6 +367,7 @@ void AStar3D::clear() {
 	}
 	segments.clear();
 	points.clear();
+	_clear_compact_graph();
 }
 
 int64_t AStar3D::get_point_count() const {
@@ -265,6 +384,85 @@ void AStar3D::reserve_space(int64_t p_num_nodes) {
 	points.reserve(p_num_nodes);
 }
 
+void AStar3D::CompactGraph::clear() {
+	dense_ids = false;
+	indices.clear();
+	ids.clear();
+	positions.clear();
+	weight_scales.clear();
+	enabled.clear();
+	neighbor_offsets.clear();
+	neighbors.clear();
+}
+
+void AStar3D::_clear_compact_graph() {
+	if (compacted) {
+		compact_graph.clear();
+		compacted = false;
+	}
+}
+
+void AStar3D::compact() {
+	ERR_FAIL_COND_MSG(points.get_num_elements() >= UINT32_MAX, "Too many points to compact the graph.");
+	_clear_compact_graph();
+
+	const uint32_t point_count = points.get_num_elements();
+
+	// Unique non-negative ids are dense when none of them is out of the `[0, point_count)` range.
+	int64_t max_id = -1;
+	for (OAHashMap<int64_t, Point *>::Iterator it = points.iter(); it.valid; it = points.next_iter(it)) {
+		max_id = MAX(max_id, *(it.key));
+	}
+	compact_graph.dense_ids = max_id < (int64_t)point_count;
+
+	LocalVector<Point *> sorted_points;
+	sorted_points.resize(point_count);
+	compact_graph.ids.resize(point_count);
+	compact_graph.positions.resize(point_count);
+	compact_graph.weight_scales.resize(point_count);
+	compact_graph.enabled.resize(point_count);
+	if (!compact_graph.dense_ids) {
+		compact_graph.indices.reserve(point_count);
+	}
+
+	uint32_t next_index = 0;
+	for (OAHashMap<int64_t, Point *>::Iterator it = points.iter(); it.valid; it = points.next_iter(it)) {
+		Point *p = *(it.value);
+		uint32_t index = compact_graph.dense_ids ? (uint32_t)p->id : next_index++;
+		if (!compact_graph.dense_ids) {
+			compact_graph.indices.insert(p->id, index);
+		}
+		sorted_points[index] = p;
+		compact_graph.ids[index] = p->id;
+		compact_graph.positions[index] = p->pos;
+		compact_graph.weight_scales[index] = p->weight_scale;
+		compact_graph.enabled[index] = p->enabled;
+	}
+
+	compact_graph.neighbor_offsets.resize(point_count + 1);
+	compact_graph.neighbor_offsets[0] = 0;
+	for (uint32_t i = 0; i < point_count; i++) {
+		compact_graph.neighbor_offsets[i + 1] = compact_graph.neighbor_offsets[i] + sorted_points[i]->neighbors.get_num_elements();
+	}
+
+	// Neighbors keep the iteration order of the hash map, so the results match the regular solver.
+	compact_graph.neighbors.resize(compact_graph.neighbor_offsets[point_count]);
+	uint32_t *neighbors_ptr = compact_graph.neighbors.ptr();
+	for (uint32_t i = 0; i < point_count; i++) {
+		Point *p = sorted_points[i];
+		for (OAHashMap<int64_t, Point *>::Iterator it = p->neighbors.iter(); it.valid; it = p->neighbors.next_iter(it)) {
+			compact_graph.lookup(*(it.key), *neighbors_ptr);
+			neighbors_ptr++;
+		}
+	}
+
+	compacted = true;
+}
+
+bool AStar3D::is_compacted() const {
+	return compacted;
+}
+
 int64_t AStar3D::get_closest_point(const Vector3 &p_point, bool p_include_disabled) const {
 	int64_t closest_id = -1;
 	real_t closest_dist = 1e20;
@@ -391,12 +589,115 @@ bool AStar3D::_solve(Point *begin_point, Point *end_point, bool p_allow_partial_
 	return found_route;
 }
 
+template <typename T>
+bool AStar3D::_solve_compact(T *p_astar, const CompactGraph &p_graph, uint32_t p_begin, uint32_t p_end, bool p_allow_partial_path, LocalVector<uint32_t> &r_path) {
+	r_path.clear();
+
+	if (p_begin == p_end) {
+		r_path.push_back(p_begin);
+		return true;
+	}
+
+	if (!p_graph.enabled[p_end] && !p_allow_partial_path) {
+		return false;
+	}
+
+	AStarCompactSolveBuffers &buffers = compact_solve_buffers;
+	buffers.begin_pass(p_graph.ids.size());
+
+	const int64_t end_id = p_graph.ids[p_end];
+	uint32_t closest_point = UINT32_MAX;
+	bool found_route = false;
+
+	buffers.g_scores[p_begin] = 0;
+	buffers.f_scores[p_begin] = p_astar->_estimate_cost(p_graph.ids[p_begin], end_id);
+	buffers.open_pass[p_begin] = buffers.pass;
+	buffers.push(p_begin);
+
+	while (!buffers.open_list.is_empty()) {
+		const uint32_t p = buffers.open_list[0]; // The currently processed point.
+
+		// Find point closer to end_point, or same distance to end_point but closer to begin_point.
+		if (closest_point == UINT32_MAX) {
+			closest_point = p;
+		} else {
+			const real_t closest_abs_f_score = buffers.f_scores[closest_point] - buffers.g_scores[closest_point];
+			const real_t p_abs_f_score = buffers.f_scores[p] - buffers.g_scores[p];
+			if (closest_abs_f_score > p_abs_f_score || (closest_abs_f_score >= p_abs_f_score && buffers.g_scores[closest_point] > buffers.g_scores[p])) {
+				closest_point = p;
+			}
+		}
+
+		if (p == p_end) {
+			found_route = true;
+			break;
+		}
+
+		buffers.pop(); // Remove the current point from the open list and mark it as closed.
+
+		const int64_t p_id = p_graph.ids[p];
+		const uint32_t neighbors_end = p_graph.neighbor_offsets[p + 1];
+		for (uint32_t i = p_graph.neighbor_offsets[p]; i < neighbors_end; i++) {
+			const uint32_t e = p_graph.neighbors[i]; // The neighbor point.
+
+			if (!p_graph.enabled[e] || buffers.is_closed(e)) {
+				continue;
+			}
+
+			const int64_t e_id = p_graph.ids[e];
+			real_t tentative_g_score = buffers.g_scores[p] + p_astar->_compute_cost(p_id, e_id) * p_graph.weight_scales[e];
+
+			bool new_point = false;
+
+			if (buffers.open_pass[e] != buffers.pass) { // The point wasn't inside the open list.
+				buffers.open_pass[e] = buffers.pass;
+				new_point = true;
+			} else if (tentative_g_score >= buffers.g_scores[e]) { // The new path is worse than the previous.
+				continue;
+			}
+
+			buffers.prev_points[e] = p;
+			buffers.g_scores[e] = tentative_g_score;
+			buffers.f_scores[e] = tentative_g_score + p_astar->_estimate_cost(e_id, end_id);
+
+			if (new_point) {
+				buffers.push(e);
+			} else {
+				buffers.sift_up(buffers.open_list_indices[e], e);
+			}
+		}
+	}
+
+	uint32_t path_end = p_end;
+	if (!found_route) {
+		if (!p_allow_partial_path || closest_point == UINT32_MAX) {
+			return false;
+		}
+
+		// Use closest point instead.
+		path_end = closest_point;
+	}
+
+	for (uint32_t p = path_end; p != p_begin; p = buffers.prev_points[p]) {
+		r_path.push_back(p);
+	}
+	r_path.push_back(p_begin);
+	r_path.invert();
+
+	return true;
+}
+
 real_t AStar3D::_estimate_cost(int64_t p_from_id, int64_t p_end_id) {
 	real_t scost;
 	if (GDVIRTUAL_CALL(_estimate_cost, p_from_id, p_end_id, scost)) {
 		return scost;
 	}
 
+	uint32_t from_index, to_index;
+	if (compacted && compact_graph.lookup(p_from_id, from_index) && compact_graph.lookup(p_end_id, to_index)) {
+		return compact_graph.positions[from_index].distance_to(compact_graph.positions[to_index]);
+	}
+
 	Point *from_point = nullptr;
 	bool from_exists = points.lookup(p_from_id, from_point);
 	ERR_FAIL_COND_V_MSG(!from_exists, 0, vformat("Can't estimate cost. Point with id: %d doesn't exist.", p_from_id));
@@ -414,6 +715,11 @@ real_t AStar3D::_compute_cost(int64_t p_from_id, int64_t p_to_id) {
 		return scost;
 	}
 
+	uint32_t from_index, to_index;
+	if (compacted && compact_graph.lookup(p_from_id, from_index) && compact_graph.lookup(p_to_id, to_index)) {
+		return compact_graph.positions[from_index].distance_to(compact_graph.positions[to_index]);
+	}
+
 	Point *from_point = nullptr;
 	bool from_exists = points.lookup(p_from_id, from_point);
 	ERR_FAIL_COND_V_MSG(!from_exists, 0, vformat("Can't compute cost. Point with id: %d doesn't exist.", p_from_id));
@@ -426,6 +732,25 @@ real_t AStar3D::_compute_cost(int64_t p_from_id, int64_t p_to_id) {
 }
 
 Vector<Vector3> AStar3D::get_point_path(int64_t p_from_id, int64_t p_to_id, bool p_allow_partial_path) {
+	if (compacted) {
+		uint32_t from_index, to_index;
+		ERR_FAIL_COND_V_MSG(!compact_graph.lookup(p_from_id, from_index), Vector<Vector3>(), vformat("Can't get point path. Point with id: %d doesn't exist.", p_from_id));
+		ERR_FAIL_COND_V_MSG(!compact_graph.lookup(p_to_id, to_index), Vector<Vector3>(), vformat("Can't get point path. Point with id: %d doesn't exist.", p_to_id));
+
+		LocalVector<uint32_t> route;
+		if (!_solve_compact(this, compact_graph, from_index, to_index, p_allow_partial_path, route)) {
+			return Vector<Vector3>();
+		}
+
+		Vector<Vector3> path;
+		path.resize(route.size());
+		Vector3 *w = path.ptrw();
+		for (uint32_t i = 0; i < route.size(); i++) {
+			w[i] = compact_graph.positions[route[i]];
+		}
+		return path;
+	}
+
 	Point *a = nullptr;
 	bool from_exists = points.lookup(p_from_id, a);
 	ERR_FAIL_COND_V_MSG(!from_exists, Vector<Vector3>(), vformat("Can't get point path. Point with id: %d doesn't exist.", p_from_id));
@@ -480,6 +805,25 @@ Vector<Vector3> AStar3D::get_point_path(int64_t p_from_id, int64_t p_to_id, bool
 }
 
 Vector<int64_t> AStar3D::get_id_path(int64_t p_from_id, int64_t p_to_id, bool p_allow_partial_path) {
+	if (compacted) {
+		uint32_t from_index, to_index;
+		ERR_FAIL_COND_V_MSG(!compact_graph.lookup(p_from_id, from_index), Vector<int64_t>(), vformat("Can't get id path. Point with id: %d doesn't exist.", p_from_id));
+		ERR_FAIL_COND_V_MSG(!compact_graph.lookup(p_to_id, to_index), Vector<int64_t>(), vformat("Can't get id path. Point with id: %d doesn't exist.", p_to_id));
+
+		LocalVector<uint32_t> route;
+		if (!_solve_compact(this, compact_graph, from_index, to_index, p_allow_partial_path, route)) {
+			return Vector<int64_t>();
+		}
+
+		Vector<int64_t> path;
+		path.resize(route.size());
+		int64_t *w = path.ptrw();
+		for (uint32_t i = 0; i < route.size(); i++) {
+			w[i] = compact_graph.ids[route[i]];
+		}
+		return path;
+	}
+
 	Point *a = nullptr;
 	bool from_exists = points.lookup(p_from_id, a);
 	ERR_FAIL_COND_V_MSG(!from_exists, Vector<int64_t>(), vformat("Can't get id path. Point with id: %d doesn't exist.", p_from_id));
@@ -539,6 +883,11 @@ void AStar3D::set_point_disabled(int64_t p_id, bool p_disabled) {
 	ERR_FAIL_COND_MSG(!p_exists, vformat("Can't set if point is disabled. Point with id: %d doesn't exist.", p_id));
 
 	p->enabled = !p_disabled;
+
+	uint32_t index;
+	if (compacted && compact_graph.lookup(p_id, index)) {
+		compact_graph.enabled[index] = !p_disabled;
+	}
 }
 
 bool AStar3D::is_point_disabled(int64_t p_id) const {
@@ -572,6 +921,8 @@ void AStar3D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_point_capacity"), &AStar3D::get_point_capacity);
 	ClassDB::bind_method(D_METHOD("reserve_space", "num_nodes"), &AStar3D::reserve_space);
 	ClassDB::bind_method(D_METHOD("clear"), &AStar3D::clear);
+	ClassDB::bind_method(D_METHOD("compact"), &AStar3D::compact);
+	ClassDB::bind_method(D_METHOD("is_compacted"), &AStar3D::is_compacted);
 
 	ClassDB::bind_method(D_METHOD("get_closest_point", "to_position", "include_disabled"), &AStar3D::get_closest_point, DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("get_closest_position_in_segment", "to_position"), &AStar3D::get_closest_position_in_segment);
@@ -666,6 +1017,14 @@ void AStar2D::reserve_space(int64_t p_num_nodes) {
 	astar.reserve_space(p_num_nodes);
 }
 
+void AStar2D::compact() {
+	astar.compact();
+}
+
+bool AStar2D::is_compacted() const {
+	return astar.is_compacted();
+}
+
 int64_t AStar2D::get_closest_point(const Vector2 &p_point, bool p_include_disabled) const {
 	return astar.get_closest_point(Vector3(p_point.x, p_point.y, 0), p_include_disabled);
 }
@@ -681,6 +1040,11 @@ real_t AStar2D::_estimate_cost(int64_t p_from_id, int64_t p_end_id) {
 		return scost;
 	}
 
+	uint32_t from_index, to_index;
+	if (astar.compacted && astar.compact_graph.lookup(p_from_id, from_index) && astar.compact_graph.lookup(p_end_id, to_index)) {
+		return astar.compact_graph.positions[from_index].distance_to(astar.compact_graph.positions[to_index]);
+	}
+
 	AStar3D::Point *from_point = nullptr;
 	bool from_exists = astar.points.lookup(p_from_id, from_point);
 	ERR_FAIL_COND_V_MSG(!from_exists, 0, vformat("Can't estimate cost. Point with id: %d doesn't exist.", p_from_id));
@@ -698,6 +1062,11 @@ real_t AStar2D::_compute_cost(int64_t p_from_id, int64_t p_to_id) {
 		return scost;
 	}
 
+	uint32_t from_index, to_index;
+	if (astar.compacted && astar.compact_graph.lookup(p_from_id, from_index) && astar.compact_graph.lookup(p_to_id, to_index)) {
+		return astar.compact_graph.positions[from_index].distance_to(astar.compact_graph.positions[to_index]);
+	}
+
 	AStar3D::Point *from_point = nullptr;
 	bool from_exists = astar.points.lookup(p_from_id, from_point);
 	ERR_FAIL_COND_V_MSG(!from_exists, 0, vformat("Can't compute cost. Point with id: %d doesn't exist.", p_from_id));
@@ -710,6 +1079,26 @@ real_t AStar2D::_compute_cost(int64_t p_from_id, int64_t p_to_id) {
 }
 
 Vector<Vector2> AStar2D::get_point_path(int64_t p_from_id, int64_t p_to_id, bool p_allow_partial_path) {
+	if (astar.compacted) {
+		uint32_t from_index, to_index;
+		ERR_FAIL_COND_V_MSG(!astar.compact_graph.lookup(p_from_id, from_index), Vector<Vector2>(), vformat("Can't get point path. Point with id: %d doesn't exist.", p_from_id));
+		ERR_FAIL_COND_V_MSG(!astar.compact_graph.lookup(p_to_id, to_index), Vector<Vector2>(), vformat("Can't get point path. Point with id: %d doesn't exist.", p_to_id));
+
+		LocalVector<uint32_t> route;
+		if (!AStar3D::_solve_compact(this, astar.compact_graph, from_index, to_index, p_allow_partial_path, route)) {
+			return Vector<Vector2>();
+		}
+
+		Vector<Vector2> path;
+		path.resize(route.size());
+		Vector2 *w = path.ptrw();
+		for (uint32_t i = 0; i < route.size(); i++) {
+			const Vector3 &pos = astar.compact_graph.positions[route[i]];
+			w[i] = Vector2(pos.x, pos.y);
+		}
+		return path;
+	}
+
 	AStar3D::Point *a = nullptr;
 	bool from_exists = astar.points.lookup(p_from_id, a);
 	ERR_FAIL_COND_V_MSG(!from_exists, Vector<Vector2>(), vformat("Can't get point path. Point with id: %d doesn't exist.", p_from_id));
@@ -763,6 +1152,25 @@ Vector<Vector2> AStar2D::get_point_path(int64_t p_from_id, int64_t p_to_id, bool
 }
 
 Vector<int64_t> AStar2D::get_id_path(int64_t p_from_id, int64_t p_to_id, bool p_allow_partial_path) {
+	if (astar.compacted) {
+		uint32_t from_index, to_index;
+		ERR_FAIL_COND_V_MSG(!astar.compact_graph.lookup(p_from_id, from_index), Vector<int64_t>(), vformat("Can't get id path. Point with id: %d doesn't exist.", p_from_id));
+		ERR_FAIL_COND_V_MSG(!astar.compact_graph.lookup(p_to_id, to_index), Vector<int64_t>(), vformat("Can't get id path. Point with id: %d doesn't exist.", p_to_id));
+
+		LocalVector<uint32_t> route;
+		if (!AStar3D::_solve_compact(this, astar.compact_graph, from_index, to_index, p_allow_partial_path, route)) {
+			return Vector<int64_t>();
+		}
+
+		Vector<int64_t> path;
+		path.resize(route.size());
+		int64_t *w = path.ptrw();
+		for (uint32_t i = 0; i < route.size(); i++) {
+			w[i] = astar.compact_graph.ids[route[i]];
+		}
+		return path;
+	}
+
 	AStar3D::Point *a = nullptr;
 	bool from_exists = astar.points.lookup(p_from_id, a);
 	ERR_FAIL_COND_V_MSG(!from_exists, Vector<int64_t>(), vformat("Can't get id path. Point with id: %d doesn't exist.", p_from_id));
@@ -911,6 +1319,8 @@ void AStar2D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_point_capacity"), &AStar2D::get_point_capacity);
 	ClassDB::bind_method(D_METHOD("reserve_space", "num_nodes"), &AStar2D::reserve_space);
 	ClassDB::bind_method(D_METHOD("clear"), &AStar2D::clear);
+	ClassDB::bind_method(D_METHOD("compact"), &AStar2D::compact);
+	ClassDB::bind_method(D_METHOD("is_compacted"), &AStar2D::is_compacted);
 
 	ClassDB::bind_method(D_METHOD("get_closest_point", "to_position", "include_disabled"), &AStar2D::get_closest_point, DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("get_closest_position_in_segment", "to_position"), &AStar2D::get_closest_position_in_segment);
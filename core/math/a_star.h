@@ -33,6 +33,8 @@
 
 #include "core/object/gdvirtual.gen.inc"
 #include "core/object/ref_counted.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
 #include "core/templates/oa_hash_map.h"
 
 /**
@@ -108,6 +110,40 @@ class AStar3D : public RefCounted {
 		}
 	};
 
+	// Read-only copy of the graph with contiguous point data and the connections
+	// in compressed sparse row layout. Built by `compact()`, dropped when the topology changes.
+	struct CompactGraph {
+		bool dense_ids = false; // The ids are exactly `[0, size)`, so they are used as indices directly.
+		HashMap<int64_t, uint32_t> indices; // Only filled when the ids are not dense.
+
+		LocalVector<int64_t> ids;
+		LocalVector<Vector3> positions;
+		LocalVector<real_t> weight_scales;
+		LocalVector<uint8_t> enabled;
+
+		// The neighbors of the point at index `i` are `neighbors[neighbor_offsets[i]]` to `neighbors[neighbor_offsets[i + 1] - 1]`.
+		LocalVector<uint32_t> neighbor_offsets;
+		LocalVector<uint32_t> neighbors;
+
+		_FORCE_INLINE_ bool lookup(int64_t p_id, uint32_t &r_index) const {
+			if (dense_ids) {
+				if (p_id < 0 || p_id >= (int64_t)ids.size()) {
+					return false;
+				}
+				r_index = (uint32_t)p_id;
+				return true;
+			}
+			const uint32_t *index = indices.getptr(p_id);
+			if (!index) {
+				return false;
+			}
+			r_index = *index;
+			return true;
+		}
+
+		void clear();
+	};
+
 	int64_t last_free_id = 0;
 	uint64_t pass = 1;
 
@@ -115,8 +151,15 @@ class AStar3D : public RefCounted {
 	HashSet<Segment, Segment> segments;
 	Point *last_closest_point = nullptr;
 
+	bool compacted = false;
+	CompactGraph compact_graph;
+
+	void _clear_compact_graph();
 	bool _solve(Point *begin_point, Point *end_point, bool p_allow_partial_path);
 
+	template <typename T>
+	static bool _solve_compact(T *p_astar, const CompactGraph &p_graph, uint32_t p_begin, uint32_t p_end, bool p_allow_partial_path, LocalVector<uint32_t> &r_path);
+
 protected:
 	static void _bind_methods();
 
@@ -157,6 +200,9 @@ public:
 	void reserve_space(int64_t p_num_nodes);
 	void clear();
 
+	void compact();
+	bool is_compacted() const;
+
 	int64_t get_closest_point(const Vector3 &p_point, bool p_include_disabled = false) const;
 	Vector3 get_closest_position_in_segment(const Vector3 &p_point) const;
 
@@ -169,6 +215,8 @@ public:
 
 class AStar2D : public RefCounted {
 	GDCLASS(AStar2D, RefCounted);
+	friend class AStar3D;
+
 	AStar3D astar;
 
 	bool _solve(AStar3D::Point *begin_point, AStar3D::Point *end_point, bool p_allow_partial_path);
@@ -213,6 +261,9 @@ public:
 	void reserve_space(int64_t p_num_nodes);
 	void clear();
 
+	void compact();
+	bool is_compacted() const;
+
 	int64_t get_closest_point(const Vector2 &p_point, bool p_include_disabled = false) const;
 	Vector2 get_closest_position_in_segment(const Vector2 &p_point) const;
 
@@ -126,45 +126,41 @@ void AStarGrid2D::update() {
 		return;
 	}
 
-	points.clear();
+	// The grid is surrounded by a border of solid cells, so neighbors and jumps never leave the arrays.
+	const uint32_t width = region.size.x + 2;
+	const uint32_t height = region.size.y + 2;
+	const uint32_t cell_count = width * height;
+	mask_stride = width;
+
 	solid_mask.clear();
+	solid_mask.resize((cell_count + 63) / 64);
+	memset(solid_mask.ptr(), 0, solid_mask.size() * sizeof(uint64_t));
 
-	const int32_t end_x = region.get_end().x;
-	const int32_t end_y = region.get_end().y;
-	const Vector2 half_cell_size = cell_size / 2;
-	for (int32_t x = region.position.x; x < end_x + 2; x++) {
-		solid_mask.push_back(true);
-	}
-
-	for (int32_t y = region.position.y; y < end_y; y++) {
-		LocalVector<Point> line;
-		solid_mask.push_back(true);
-		for (int32_t x = region.position.x; x < end_x; x++) {
-			Vector2 v = offset;
-			switch (cell_shape) {
-				case CELL_SHAPE_ISOMETRIC_RIGHT:
-					v += half_cell_size + Vector2(x + y, y - x) * half_cell_size;
-					break;
-				case CELL_SHAPE_ISOMETRIC_DOWN:
-					v += half_cell_size + Vector2(x - y, x + y) * half_cell_size;
-					break;
-				case CELL_SHAPE_SQUARE:
-					v += Vector2(x, y) * cell_size;
-					break;
-				default:
-					break;
-			}
-			line.push_back(Point(Vector2i(x, y), v));
-			solid_mask.push_back(false);
-		}
-		solid_mask.push_back(true);
-		points.push_back(line);
+	for (uint32_t x = 0; x < width; x++) {
+		_set_cell_solid(x, true);
+		_set_cell_solid((height - 1) * width + x, true);
+	}
+	for (uint32_t y = 1; y < height - 1; y++) {
+		_set_cell_solid(y * width, true);
+		_set_cell_solid(y * width + width - 1, true);
 	}
 
-	for (int32_t x = region.position.x; x < end_x + 2; x++) {
-		solid_mask.push_back(true);
+	weight_scales.clear();
+	weight_scales.resize(cell_count);
+	for (real_t &weight_scale : weight_scales) {
+		weight_scale = 1.0;
 	}
 
+	open_pass.clear();
+	open_pass.resize(cell_count);
+	memset(open_pass.ptr(), 0, cell_count * sizeof(uint32_t));
+	pass = 1;
+
+	open_list_indices.resize(cell_count);
+	prev_cells.resize(cell_count);
+	g_scores.resize(cell_count);
+	f_scores.resize(cell_count);
+
 	dirty = false;
 }
 
@@ -231,13 +227,13 @@ void AStarGrid2D::set_point_weight_scale(const Vector2i &p_id, real_t p_weight_s
 	ERR_FAIL_COND_MSG(dirty, "Grid is not initialized. Call the update method.");
 	ERR_FAIL_COND_MSG(!is_in_boundsv(p_id), vformat("Can't set point's weight scale. Point %s out of bounds %s.", p_id, region));
 	ERR_FAIL_COND_MSG(p_weight_scale < 0.0, vformat("Can't set point's weight scale less than 0.0: %f.", p_weight_scale));
-	_get_point_unchecked(p_id)->weight_scale = p_weight_scale;
+	weight_scales[_to_mask_index(p_id.x, p_id.y)] = p_weight_scale;
 }
 
 real_t AStarGrid2D::get_point_weight_scale(const Vector2i &p_id) const {
 	ERR_FAIL_COND_V_MSG(dirty, 0, "Grid is not initialized. Call the update method.");
 	ERR_FAIL_COND_V_MSG(!is_in_boundsv(p_id), 0, vformat("Can't get point's weight scale. Point %s out of bounds %s.", p_id, region));
-	return _get_point_unchecked(p_id)->weight_scale;
+	return weight_scales[_to_mask_index(p_id.x, p_id.y)];
 }
 
 void AStarGrid2D::fill_solid_region(const Rect2i &p_region, bool p_solid) {
@@ -264,17 +260,20 @@ void AStarGrid2D::fill_weight_scale_region(const Rect2i &p_region, real_t p_weig
 
 	for (int32_t y = safe_region.position.y; y < end_y; y++) {
 		for (int32_t x = safe_region.position.x; x < end_x; x++) {
-			_get_point_unchecked(x, y)->weight_scale = p_weight_scale;
+			weight_scales[_to_mask_index(x, y)] = p_weight_scale;
 		}
 	}
 }
 
-AStarGrid2D::Point *AStarGrid2D::_jump(Point *p_from, Point *p_to) {
-	int32_t from_x = p_from->id.x;
-	int32_t from_y = p_from->id.y;
+uint32_t AStarGrid2D::_jump(uint32_t p_from, uint32_t p_to) {
+	const Vector2i from_id = _get_cell_id(p_from);
+	const Vector2i to_id = _get_cell_id(p_to);
 
-	int32_t to_x = p_to->id.x;
-	int32_t to_y = p_to->id.y;
+	int32_t from_x = from_id.x;
+	int32_t from_y = from_id.y;
+
+	int32_t to_x = to_id.x;
+	int32_t to_y = to_id.y;
 
 	int32_t dx = to_x - from_x;
 	int32_t dy = to_y - from_y;
@@ -285,16 +284,17 @@ AStarGrid2D::Point *AStarGrid2D::_jump(Point *p_from, Point *p_to) {
 		}
 
 		while (_is_walkable(to_x, to_y) && (diagonal_mode == DIAGONAL_MODE_ALWAYS || _is_walkable(to_x, to_y - dy) || _is_walkable(to_x - dx, to_y))) {
-			if (end->id.x == to_x && end->id.y == to_y) {
+			const uint32_t to_cell = _to_mask_index(to_x, to_y);
+			if (to_cell == end) {
 				return end;
 			}
 
 			if ((_is_walkable(to_x - dx, to_y + dy) && !_is_walkable(to_x - dx, to_y)) || (_is_walkable(to_x + dx, to_y - dy) && !_is_walkable(to_x, to_y - dy))) {
-				return _get_point_unchecked(to_x, to_y);
+				return to_cell;
 			}
 
-			if (_forced_successor(to_x + dx, to_y, dx, 0) != nullptr || _forced_successor(to_x, to_y + dy, 0, dy) != nullptr) {
-				return _get_point_unchecked(to_x, to_y);
+			if (_forced_successor(to_x + dx, to_y, dx, 0) != INVALID_CELL || _forced_successor(to_x, to_y + dy, 0, dy) != INVALID_CELL) {
+				return to_cell;
 			}
 
 			to_x += dx;
@@ -307,16 +307,17 @@ AStarGrid2D::Point *AStarGrid2D::_jump(Point *p_from, Point *p_to) {
 		}
 
 		while (_is_walkable(to_x, to_y) && _is_walkable(to_x, to_y - dy) && _is_walkable(to_x - dx, to_y)) {
-			if (end->id.x == to_x && end->id.y == to_y) {
+			const uint32_t to_cell = _to_mask_index(to_x, to_y);
+			if (to_cell == end) {
 				return end;
 			}
 
 			if ((_is_walkable(to_x + dx, to_y + dy) && !_is_walkable(to_x, to_y + dy)) || !_is_walkable(to_x + dx, to_y)) {
-				return _get_point_unchecked(to_x, to_y);
+				return to_cell;
 			}
 
-			if (_forced_successor(to_x, to_y, dx, 0) != nullptr || _forced_successor(to_x, to_y, 0, dy) != nullptr) {
-				return _get_point_unchecked(to_x, to_y);
+			if (_forced_successor(to_x, to_y, dx, 0) != INVALID_CELL || _forced_successor(to_x, to_y, 0, dy) != INVALID_CELL) {
+				return to_cell;
 			}
 
 			to_x += dx;
@@ -329,26 +330,27 @@ AStarGrid2D::Point *AStarGrid2D::_jump(Point *p_from, Point *p_to) {
 		}
 
 		while (_is_walkable(to_x, to_y)) {
-			if (end->id.x == to_x && end->id.y == to_y) {
+			const uint32_t to_cell = _to_mask_index(to_x, to_y);
+			if (to_cell == end) {
 				return end;
 			}
 
 			if ((_is_walkable(to_x - 1, to_y) && !_is_walkable(to_x - 1, to_y - dy)) || (_is_walkable(to_x + 1, to_y) && !_is_walkable(to_x + 1, to_y - dy))) {
-				return _get_point_unchecked(to_x, to_y);
+				return to_cell;
 			}
 
-			if (_forced_successor(to_x, to_y, 1, 0, true) != nullptr || _forced_successor(to_x, to_y, -1, 0, true) != nullptr) {
-				return _get_point_unchecked(to_x, to_y);
+			if (_forced_successor(to_x, to_y, 1, 0, true) != INVALID_CELL || _forced_successor(to_x, to_y, -1, 0, true) != INVALID_CELL) {
+				return to_cell;
 			}
 
 			to_y += dy;
 		}
 	}
 
-	return nullptr;
+	return INVALID_CELL;
 }
 
-AStarGrid2D::Point *AStarGrid2D::_forced_successor(int32_t p_x, int32_t p_y, int32_t p_dx, int32_t p_dy, bool p_inclusive) {
+uint32_t AStarGrid2D::_forced_successor(int32_t p_x, int32_t p_y, int32_t p_dx, int32_t p_dy, bool p_inclusive) {
 	// Remembering previous results can improve performance.
 	bool l_prev = false, r_prev = false, l = false, r = false;
 
@@ -362,7 +364,8 @@ AStarGrid2D::Point *AStarGrid2D::_forced_successor(int32_t p_x, int32_t p_y, int
 	int32_t r_x = p_x + p_dy, r_y = p_y + p_dx;
 
 	while (_is_walkable(o_x, o_y)) {
-		if (end->id.x == o_x && end->id.y == o_y) {
+		const uint32_t o_cell = _to_mask_index(o_x, o_y);
+		if (o_cell == end) {
 			return end;
 		}
 
@@ -378,77 +381,39 @@ AStarGrid2D::Point *AStarGrid2D::_forced_successor(int32_t p_x, int32_t p_y, int
 		r = _is_walkable(r_x, r_y);
 
 		if ((l && !l_prev) || (r && !r_prev)) {
-			return _get_point_unchecked(o_x, o_y);
+			return o_cell;
 		}
 
 		o_x += p_dx;
 		o_y += p_dy;
 	}
-	return nullptr;
+	return INVALID_CELL;
 }
 
-void AStarGrid2D::_get_nbors(Point *p_point, LocalVector<Point *> &r_nbors) {
+void AStarGrid2D::_get_nbors(uint32_t p_cell, LocalVector<uint32_t> &r_nbors) {
 	bool ts0 = false, td0 = false,
 		 ts1 = false, td1 = false,
 		 ts2 = false, td2 = false,
 		 ts3 = false, td3 = false;
 
-	Point *left = nullptr;
-	Point *right = nullptr;
-	Point *top = nullptr;
-	Point *bottom = nullptr;
-
-	Point *top_left = nullptr;
-	Point *top_right = nullptr;
-	Point *bottom_left = nullptr;
-	Point *bottom_right = nullptr;
-
-	{
-		bool has_left = false;
-		bool has_right = false;
+	// Cells outside of the region are part of the solid border, so no bounds checks are needed.
+	const uint32_t top = p_cell - mask_stride;
+	const uint32_t bottom = p_cell + mask_stride;
 
-		if (p_point->id.x - 1 >= region.position.x) {
-			left = _get_point_unchecked(p_point->id.x - 1, p_point->id.y);
-			has_left = true;
-		}
-		if (p_point->id.x + 1 < region.position.x + region.size.width) {
-			right = _get_point_unchecked(p_point->id.x + 1, p_point->id.y);
-			has_right = true;
-		}
-		if (p_point->id.y - 1 >= region.position.y) {
-			top = _get_point_unchecked(p_point->id.x, p_point->id.y - 1);
-			if (has_left) {
-				top_left = _get_point_unchecked(p_point->id.x - 1, p_point->id.y - 1);
-			}
-			if (has_right) {
-				top_right = _get_point_unchecked(p_point->id.x + 1, p_point->id.y - 1);
-			}
-		}
-		if (p_point->id.y + 1 < region.position.y + region.size.height) {
-			bottom = _get_point_unchecked(p_point->id.x, p_point->id.y + 1);
-			if (has_left) {
-				bottom_left = _get_point_unchecked(p_point->id.x - 1, p_point->id.y + 1);
-			}
-			if (has_right) {
-				bottom_right = _get_point_unchecked(p_point->id.x + 1, p_point->id.y + 1);
-			}
-		}
-	}
-
-	if (top && !_get_solid_unchecked(top->id)) {
+	if (!_is_cell_solid(top)) {
 		r_nbors.push_back(top);
 		ts0 = true;
 	}
-	if (right && !_get_solid_unchecked(right->id)) {
-		r_nbors.push_back(right);
+	if (!_is_cell_solid(p_cell + 1)) {
+		r_nbors.push_back(p_cell + 1);
 		ts1 = true;
 	}
-	if (bottom && !_get_solid_unchecked(bottom->id)) {
+	if (!_is_cell_solid(bottom)) {
 		r_nbors.push_back(bottom);
 		ts2 = true;
 	}
-	if (left && !_get_solid_unchecked(left->id)) {
-		r_nbors.push_back(left);
+	if (!_is_cell_solid(p_cell - 1)) {
+		r_nbors.push_back(p_cell - 1);
 		ts3 = true;
 	}
 
@@ -477,98 +442,153 @@ void AStarGrid2D::_get_nbors(Point *p_point, LocalVector<Point *> &r_nbors) {
 			break;
 	}
 
-	if (td0 && (top_left && !_get_solid_unchecked(top_left->id))) {
-		r_nbors.push_back(top_left);
+	if (td0 && !_is_cell_solid(top - 1)) {
+		r_nbors.push_back(top - 1);
 	}
-	if (td1 && (top_right && !_get_solid_unchecked(top_right->id))) {
-		r_nbors.push_back(top_right);
+	if (td1 && !_is_cell_solid(top + 1)) {
+		r_nbors.push_back(top + 1);
 	}
-	if (td2 && (bottom_right && !_get_solid_unchecked(bottom_right->id))) {
-		r_nbors.push_back(bottom_right);
+	if (td2 && !_is_cell_solid(bottom + 1)) {
+		r_nbors.push_back(bottom + 1);
 	}
-	if (td3 && (bottom_left && !_get_solid_unchecked(bottom_left->id))) {
-		r_nbors.push_back(bottom_left);
+	if (td3 && !_is_cell_solid(bottom - 1)) {
+		r_nbors.push_back(bottom - 1);
 	}
 }
 
-bool AStarGrid2D::_solve(Point *p_begin_point, Point *p_end_point, bool p_allow_partial_path) {
-	last_closest_point = nullptr;
+void AStarGrid2D::_open_list_sift_up(uint32_t p_hole, uint32_t p_cell) {
+	// Same ordering as `SortArray::push_heap()`, but keeps the position of each cell up to date.
+	while (p_hole > 0) {
+		const uint32_t parent = (p_hole - 1) / 2;
+		if (!_is_cell_worse(open_list[parent], p_cell)) {
+			break;
+		}
+		open_list[p_hole] = open_list[parent];
+		open_list_indices[open_list[p_hole]] = p_hole;
+		p_hole = parent;
+	}
+	open_list[p_hole] = p_cell;
+	open_list_indices[p_cell] = p_hole;
+}
+
+void AStarGrid2D::_open_list_pop() {
+	// Same ordering as `SortArray::pop_heap()`: move the hole down to a leaf, then sift the last cell up from there.
+	open_list_indices[open_list[0]] = CLOSED_CELL;
+
+	const uint32_t len = open_list.size() - 1;
+	const uint32_t last = open_list[len];
+	open_list.resize(len);
+	if (len == 0) {
+		return;
+	}
+
+	uint32_t hole = 0;
+	uint32_t second_child = 2;
+	while (second_child < len) {
+		if (_is_cell_worse(open_list[second_child], open_list[second_child - 1])) {
+			second_child--;
+		}
+		open_list[hole] = open_list[second_child];
+		open_list_indices[open_list[hole]] = hole;
+		hole = second_child;
+		second_child = 2 * (second_child + 1);
+	}
+	if (second_child == len) {
+		open_list[hole] = open_list[second_child - 1];
+		open_list_indices[open_list[hole]] = hole;
+		hole = second_child - 1;
+	}
+	_open_list_sift_up(hole, last);
+}
+
+bool AStarGrid2D::_solve(uint32_t p_begin_cell, uint32_t p_end_cell, bool p_allow_partial_path) {
+	last_closest_point = INVALID_CELL;
 	pass++;
+	if (unlikely(pass == 0)) {
+		// The pass counter wrapped around, stale cells could be mistaken for visited ones.
+		memset(open_pass.ptr(), 0, open_pass.size() * sizeof(uint32_t));
+		pass = 1;
+	}
 
-	if (_get_solid_unchecked(p_end_point->id) && !p_allow_partial_path) {
+	if (_is_cell_solid(p_end_cell) && !p_allow_partial_path) {
 		return false;
 	}
 
 	bool found_route = false;
 
-	LocalVector<Point *> open_list;
-	SortArray<Point *, SortPoints> sorter;
+	const Vector2i end_id = _get_cell_id(p_end_cell);
 
-	p_begin_point->g_score = 0;
-	p_begin_point->f_score = _estimate_cost(p_begin_point->id, p_end_point->id);
-	p_begin_point->abs_g_score = 0;
-	p_begin_point->abs_f_score = _estimate_cost(p_begin_point->id, p_end_point->id);
-	open_list.push_back(p_begin_point);
-	end = p_end_point;
+	open_list.clear();
+	g_scores[p_begin_cell] = 0;
+	f_scores[p_begin_cell] = _estimate_cost(_get_cell_id(p_begin_cell), end_id);
+	open_pass[p_begin_cell] = pass;
+	open_list.push_back(p_begin_cell);
+	open_list_indices[p_begin_cell] = 0;
+	end = p_end_cell;
 
 	while (!open_list.is_empty()) {
-		Point *p = open_list[0]; // The currently processed point.
+		const uint32_t p = open_list[0]; // The currently processed cell.
 
-		// Find point closer to end_point, or same distance to end_point but closer to begin_point.
-		if (last_closest_point == nullptr || last_closest_point->abs_f_score > p->abs_f_score || (last_closest_point->abs_f_score >= p->abs_f_score && last_closest_point->abs_g_score > p->abs_g_score)) {
+		// Find cell closer to end_point, or same distance to end_point but closer to begin_point.
+		// The remaining estimated distance is `f_score - g_score`, the traveled one is `g_score`.
+		if (last_closest_point == INVALID_CELL) {
 			last_closest_point = p;
+		} else {
+			const real_t closest_abs_f_score = f_scores[last_closest_point] - g_scores[last_closest_point];
+			const real_t p_abs_f_score = f_scores[p] - g_scores[p];
+			if (closest_abs_f_score > p_abs_f_score || (closest_abs_f_score >= p_abs_f_score && g_scores[last_closest_point] > g_scores[p])) {
+				last_closest_point = p;
+			}
 		}
 
-		if (p == p_end_point) {
+		if (p == p_end_cell) {
 			found_route = true;
 			break;
 		}
 
-		sorter.pop_heap(0, open_list.size(), open_list.ptr()); // Remove the current point from the open list.
-		open_list.remove_at(open_list.size() - 1);
-		p->closed_pass = pass; // Mark the point as closed.
+		_open_list_pop(); // Remove the current cell from the open list and mark it as closed.
 
-		LocalVector<Point *> nbors;
+		const Vector2i p_id = _get_cell_id(p);
+
+		nbors.clear();
 		_get_nbors(p, nbors);
 
-		for (Point *e : nbors) {
+		for (uint32_t e : nbors) {
 			real_t weight_scale = 1.0;
 
 			if (jumping_enabled) {
 				// TODO: Make it works with weight_scale.
 				e = _jump(p, e);
-				if (!e || e->closed_pass == pass) {
+				if (e == INVALID_CELL || _is_cell_closed(e)) {
 					continue;
 				}
 			} else {
-				if (_get_solid_unchecked(e->id) || e->closed_pass == pass) {
+				if (_is_cell_solid(e) || _is_cell_closed(e)) {
 					continue;
 				}
-				weight_scale = e->weight_scale;
+				weight_scale = weight_scales[e];
 			}
 
-			real_t tentative_g_score = p->g_score + _compute_cost(p->id, e->id) * weight_scale;
+			const Vector2i e_id = _get_cell_id(e);
+			real_t tentative_g_score = g_scores[p] + _compute_cost(p_id, e_id) * weight_scale;
 			bool new_point = false;
 
-			if (e->open_pass != pass) { // The point wasn't inside the open list.
-				e->open_pass = pass;
-				open_list.push_back(e);
+			if (open_pass[e] != pass) { // The cell wasn't inside the open list.
+				open_pass[e] = pass;
 				new_point = true;
-			} else if (tentative_g_score >= e->g_score) { // The new path is worse than the previous.
+			} else if (tentative_g_score >= g_scores[e]) { // The new path is worse than the previous.
 				continue;
 			}
 
-			e->prev_point = p;
-			e->g_score = tentative_g_score;
-			e->f_score = e->g_score + _estimate_cost(e->id, p_end_point->id);
-
-			e->abs_g_score = tentative_g_score;
-			e->abs_f_score = e->f_score - e->g_score;
+			prev_cells[e] = p;
+			g_scores[e] = tentative_g_score;
+			f_scores[e] = tentative_g_score + _estimate_cost(e_id, end_id);
 
-			if (new_point) { // The position of the new points is already known.
-				sorter.push_heap(0, open_list.size() - 1, 0, e, open_list.ptr());
+			if (new_point) {
+				open_list.push_back(e);
+				_open_list_sift_up(open_list.size() - 1, e);
 			} else {
-				sorter.push_heap(0, open_list.find(e), 0, e, open_list.ptr());
+				_open_list_sift_up(open_list_indices[e], e);
 			}
 		}
 	}
@@ -593,36 +613,61 @@ real_t AStarGrid2D::_compute_cost(const Vector2i &p_from_id, const Vector2i &p_t
 }
 
 void AStarGrid2D::clear() {
-	points.clear();
+	solid_mask.clear();
+	weight_scales.clear();
+	open_pass.clear();
+	open_list_indices.clear();
+	prev_cells.clear();
+	g_scores.clear();
+	f_scores.clear();
+	open_list.clear();
+	mask_stride = 0;
 	region = Rect2i();
 }
 
+Vector2 AStarGrid2D::_get_point_position_unchecked(int32_t p_x, int32_t p_y) const {
+	const Vector2 half_cell_size = cell_size / 2;
+	Vector2 v = offset;
+	switch (cell_shape) {
+		case CELL_SHAPE_ISOMETRIC_RIGHT:
+			v += half_cell_size + Vector2(p_x + p_y, p_y - p_x) * half_cell_size;
+			break;
+		case CELL_SHAPE_ISOMETRIC_DOWN:
+			v += half_cell_size + Vector2(p_x - p_y, p_x + p_y) * half_cell_size;
+			break;
+		case CELL_SHAPE_SQUARE:
+			v += Vector2(p_x, p_y) * cell_size;
+			break;
+		default:
+			break;
+	}
+	return v;
+}
+
 Vector2 AStarGrid2D::get_point_position(const Vector2i &p_id) const {
 	ERR_FAIL_COND_V_MSG(dirty, Vector2(), "Grid is not initialized. Call the update method.");
 	ERR_FAIL_COND_V_MSG(!is_in_boundsv(p_id), Vector2(), vformat("Can't get point's position. Point %s out of bounds %s.", p_id, region));
-	return _get_point_unchecked(p_id)->pos;
+	return _get_point_position_unchecked(p_id.x, p_id.y);
 }
 
 TypedArray<Dictionary> AStarGrid2D::get_point_data_in_region(const Rect2i &p_region) const {
 	ERR_FAIL_COND_V_MSG(dirty, TypedArray<Dictionary>(), "Grid is not initialized. Call the update method.");
 	const Rect2i inter_region = region.intersection(p_region);
 
-	const int32_t start_x = inter_region.position.x - region.position.x;
-	const int32_t start_y = inter_region.position.y - region.position.y;
-	const int32_t end_x = inter_region.get_end().x - region.position.x;
-	const int32_t end_y = inter_region.get_end().y - region.position.y;
+	const int32_t end_x = inter_region.get_end().x;
+	const int32_t end_y = inter_region.get_end().y;
 
 	TypedArray<Dictionary> data;
 
-	for (int32_t y = start_y; y < end_y; y++) {
-		for (int32_t x = start_x; x < end_x; x++) {
-			const Point &p = points[y][x];
+	for (int32_t y = inter_region.position.y; y < end_y; y++) {
+		for (int32_t x = inter_region.position.x; x < end_x; x++) {
+			const uint32_t cell = _to_mask_index(x, y);
 
 			Dictionary dict;
-			dict["id"] = p.id;
-			dict["position"] = p.pos;
-			dict["solid"] = _get_solid_unchecked(p.id);
-			dict["weight_scale"] = p.weight_scale;
+			dict["id"] = Vector2i(x, y);
+			dict["position"] = _get_point_position_unchecked(x, y);
+			dict["solid"] = _is_cell_solid(cell);
+			dict["weight_scale"] = weight_scales[cell];
 			data.push_back(dict);
 		}
 	}
@@ -635,33 +680,30 @@ Vector<Vector2> AStarGrid2D::get_point_path(const Vector2i &p_from_id, const Vec
 	ERR_FAIL_COND_V_MSG(!is_in_boundsv(p_from_id), Vector<Vector2>(), vformat("Can't get id path. Point %s out of bounds %s.", p_from_id, region));
 	ERR_FAIL_COND_V_MSG(!is_in_boundsv(p_to_id), Vector<Vector2>(), vformat("Can't get id path. Point %s out of bounds %s.", p_to_id, region));
 
-	Point *a = _get_point(p_from_id.x, p_from_id.y);
-	Point *b = _get_point(p_to_id.x, p_to_id.y);
+	const uint32_t begin_cell = _to_mask_index(p_from_id.x, p_from_id.y);
+	uint32_t end_cell = _to_mask_index(p_to_id.x, p_to_id.y);
 
-	if (a == b) {
+	if (begin_cell == end_cell) {
 		Vector<Vector2> ret;
-		ret.push_back(a->pos);
+		ret.push_back(_get_point_position_unchecked(p_from_id.x, p_from_id.y));
 		return ret;
 	}
 
-	Point *begin_point = a;
-	Point *end_point = b;
-
-	bool found_route = _solve(begin_point, end_point, p_allow_partial_path);
+	bool found_route = _solve(begin_cell, end_cell, p_allow_partial_path);
 	if (!found_route) {
-		if (!p_allow_partial_path || last_closest_point == nullptr) {
+		if (!p_allow_partial_path || last_closest_point == INVALID_CELL) {
 			return Vector<Vector2>();
 		}
 
 		// Use closest point instead.
-		end_point = last_closest_point;
+		end_cell = last_closest_point;
 	}
 
-	Point *p = end_point;
+	uint32_t p = end_cell;
 	int32_t pc = 1;
-	while (p != begin_point) {
+	while (p != begin_cell) {
 		pc++;
-		p = p->prev_point;
+		p = prev_cells[p];
 	}
 
 	Vector<Vector2> path;
@@ -670,14 +712,15 @@ Vector<Vector2> AStarGrid2D::get_point_path(const Vector2i &p_from_id, const Vec
 	{
 		Vector2 *w = path.ptrw();
 
-		p = end_point;
+		p = end_cell;
 		int32_t idx = pc - 1;
-		while (p != begin_point) {
-			w[idx--] = p->pos;
-			p = p->prev_point;
+		while (p != begin_cell) {
+			const Vector2i id = _get_cell_id(p);
+			w[idx--] = _get_point_position_unchecked(id.x, id.y);
+			p = prev_cells[p];
 		}
 
-		w[0] = p->pos;
+		w[0] = _get_point_position_unchecked(p_from_id.x, p_from_id.y);
 	}
 
 	return path;
@@ -688,47 +731,44 @@ TypedArray<Vector2i> AStarGrid2D::get_id_path(const Vector2i &p_from_id, const V
 	ERR_FAIL_COND_V_MSG(!is_in_boundsv(p_from_id), TypedArray<Vector2i>(), vformat("Can't get id path. Point %s out of bounds %s.", p_from_id, region));
 	ERR_FAIL_COND_V_MSG(!is_in_boundsv(p_to_id), TypedArray<Vector2i>(), vformat("Can't get id path. Point %s out of bounds %s.", p_to_id, region));
 
-	Point *a = _get_point(p_from_id.x, p_from_id.y);
-	Point *b = _get_point(p_to_id.x, p_to_id.y);
+	const uint32_t begin_cell = _to_mask_index(p_from_id.x, p_from_id.y);
+	uint32_t end_cell = _to_mask_index(p_to_id.x, p_to_id.y);
 
-	if (a == b) {
+	if (begin_cell == end_cell) {
 		TypedArray<Vector2i> ret;
-		ret.push_back(a->id);
+		ret.push_back(p_from_id);
 		return ret;
 	}
 
-	Point *begin_point = a;
-	Point *end_point = b;
-
-	bool found_route = _solve(begin_point, end_point, p_allow_partial_path);
+	bool found_route = _solve(begin_cell, end_cell, p_allow_partial_path);
 	if (!found_route) {
-		if (!p_allow_partial_path || last_closest_point == nullptr) {
+		if (!p_allow_partial_path || last_closest_point == INVALID_CELL) {
 			return TypedArray<Vector2i>();
 		}
 
 		// Use closest point instead.
-		end_point = last_closest_point;
+		end_cell = last_closest_point;
 	}
 
-	Point *p = end_point;
+	uint32_t p = end_cell;
 	int32_t pc = 1;
-	while (p != begin_point) {
+	while (p != begin_cell) {
 		pc++;
-		p = p->prev_point;
+		p = prev_cells[p];
 	}
 
 	TypedArray<Vector2i> path;
 	path.resize(pc);
 
 	{
-		p = end_point;
+		p = end_cell;
 		int32_t idx = pc - 1;
-		while (p != begin_point) {
-			path[idx--] = p->id;
-			p = p->prev_point;
+		while (p != begin_cell) {
+			path[idx--] = _get_cell_id(p);
+			p = prev_cells[p];
 		}
 
-		path[0] = p->id;
+		path[0] = p_from_id;
 	}
 
 	return path;
@@ -75,92 +75,91 @@ private:
 	Heuristic default_compute_heuristic = HEURISTIC_EUCLIDEAN;
 	Heuristic default_estimate_heuristic = HEURISTIC_EUCLIDEAN;
 
-	struct Point {
-		Vector2i id;
+	// The grid is stored as a structure of arrays, all indexed by `_to_mask_index()`. The index
+	// includes a border of solid cells around the region, so neighbors never need bounds checks.
+	int32_t mask_stride = 0;
+	LocalVector<uint64_t> solid_mask; // One bit per cell.
+	LocalVector<real_t> weight_scales;
 
-		Vector2 pos;
-		real_t weight_scale = 1.0;
+	// Per-query scratch data, only valid for the cells whose `open_pass` matches `pass`.
+	// Bumping `pass` resets all of it at once.
+	LocalVector<uint32_t> open_pass;
+	LocalVector<uint32_t> open_list_indices; // Position in `open_list`, or `CLOSED_CELL` once processed.
+	LocalVector<uint32_t> prev_cells;
+	LocalVector<real_t> g_scores;
+	LocalVector<real_t> f_scores;
 
-		// Used for pathfinding.
-		Point *prev_point = nullptr;
-		real_t g_score = 0;
-		real_t f_score = 0;
-		uint64_t open_pass = 0;
-		uint64_t closed_pass = 0;
+	LocalVector<uint32_t> open_list;
+	LocalVector<uint32_t> nbors;
 
-		// Used for getting last_closest_point.
-		real_t abs_g_score = 0;
-		real_t abs_f_score = 0;
+	static constexpr uint32_t INVALID_CELL = UINT32_MAX;
+	static constexpr uint32_t CLOSED_CELL = UINT32_MAX;
 
-		Point() {}
+	uint32_t end = INVALID_CELL;
+	uint32_t last_closest_point = INVALID_CELL;
 
-		Point(const Vector2i &p_id, const Vector2 &p_pos) :
-				id(p_id), pos(p_pos) {}
-	};
-
-	struct SortPoints {
-		_FORCE_INLINE_ bool operator()(const Point *A, const Point *B) const { // Returns true when the Point A is worse than Point B.
-			if (A->f_score > B->f_score) {
-				return true;
-			} else if (A->f_score < B->f_score) {
-				return false;
-			} else {
-				return A->g_score < B->g_score; // If the f_costs are the same then prioritize the points that are further away from the start.
-			}
-		}
-	};
+	uint32_t pass = 1;
 
-	LocalVector<bool> solid_mask;
-	LocalVector<LocalVector<Point>> points;
-	Point *end = nullptr;
-	Point *last_closest_point = nullptr;
+private: // Internal routines.
+	_FORCE_INLINE_ uint32_t _to_mask_index(int32_t p_x, int32_t p_y) const {
+		return ((p_y - region.position.y + 1) * mask_stride) + p_x - region.position.x + 1;
+	}
 
-	uint64_t pass = 1;
+	_FORCE_INLINE_ Vector2i _get_cell_id(uint32_t p_cell) const {
+		return Vector2i(int32_t(p_cell % mask_stride) + region.position.x - 1, int32_t(p_cell / mask_stride) + region.position.y - 1);
+	}
 
-private: // Internal routines.
-	_FORCE_INLINE_ size_t _to_mask_index(int32_t p_x, int32_t p_y) const {
-		return ((p_y - region.position.y + 1) * (region.size.x + 2)) + p_x - region.position.x + 1;
+	_FORCE_INLINE_ bool _is_cell_solid(uint32_t p_cell) const {
+		return (solid_mask[p_cell >> 6] >> (p_cell & 63)) & 1;
 	}
 
 	_FORCE_INLINE_ bool _is_walkable(int32_t p_x, int32_t p_y) const {
-		return !solid_mask[_to_mask_index(p_x, p_y)];
+		return !_is_cell_solid(_to_mask_index(p_x, p_y));
 	}
 
-	_FORCE_INLINE_ Point *_get_point(int32_t p_x, int32_t p_y) {
-		if (region.has_point(Vector2i(p_x, p_y))) {
-			return &points[p_y - region.position.y][p_x - region.position.x];
+	_FORCE_INLINE_ void _set_cell_solid(uint32_t p_cell, bool p_solid) {
+		if (p_solid) {
+			solid_mask[p_cell >> 6] |= uint64_t(1) << (p_cell & 63);
+		} else {
+			solid_mask[p_cell >> 6] &= ~(uint64_t(1) << (p_cell & 63));
 		}
-		return nullptr;
 	}
 
 	_FORCE_INLINE_ void _set_solid_unchecked(int32_t p_x, int32_t p_y, bool p_solid) {
-		solid_mask[_to_mask_index(p_x, p_y)] = p_solid;
+		_set_cell_solid(_to_mask_index(p_x, p_y), p_solid);
 	}
 
 	_FORCE_INLINE_ void _set_solid_unchecked(const Vector2i &p_id, bool p_solid) {
-		solid_mask[_to_mask_index(p_id.x, p_id.y)] = p_solid;
+		_set_cell_solid(_to_mask_index(p_id.x, p_id.y), p_solid);
 	}
 
 	_FORCE_INLINE_ bool _get_solid_unchecked(const Vector2i &p_id) const {
-		return solid_mask[_to_mask_index(p_id.x, p_id.y)];
+		return _is_cell_solid(_to_mask_index(p_id.x, p_id.y));
 	}
 
-	_FORCE_INLINE_ Point *_get_point_unchecked(int32_t p_x, int32_t p_y) {
-		return &points[p_y - region.position.y][p_x - region.position.x];
+	_FORCE_INLINE_ bool _is_cell_closed(uint32_t p_cell) const {
+		return open_pass[p_cell] == pass && open_list_indices[p_cell] == CLOSED_CELL;
 	}
 
-	_FORCE_INLINE_ Point *_get_point_unchecked(const Vector2i &p_id) {
-		return &points[p_id.y - region.position.y][p_id.x - region.position.x];
+	_FORCE_INLINE_ bool _is_cell_worse(uint32_t p_a, uint32_t p_b) const { // Returns true when the cell A is worse than cell B.
+		if (f_scores[p_a] > f_scores[p_b]) {
+			return true;
+		} else if (f_scores[p_a] < f_scores[p_b]) {
+			return false;
+		} else {
+			return g_scores[p_a] < g_scores[p_b]; // If the f_costs are the same then prioritize the points that are further away from the start.
+		}
 	}
 
-	_FORCE_INLINE_ const Point *_get_point_unchecked(const Vector2i &p_id) const {
-		return &points[p_id.y - region.position.y][p_id.x - region.position.x];
-	}
+	Vector2 _get_point_position_unchecked(int32_t p_x, int32_t p_y) const;
+
+	void _open_list_sift_up(uint32_t p_hole, uint32_t p_cell);
+	void _open_list_pop();
 
-	void _get_nbors(Point *p_point, LocalVector<Point *> &r_nbors);
-	Point *_jump(Point *p_from, Point *p_to);
-	bool _solve(Point *p_begin_point, Point *p_end_point, bool p_allow_partial_path);
-	Point *_forced_successor(int32_t p_x, int32_t p_y, int32_t p_dx, int32_t p_dy, bool p_inclusive = false);
+	void _get_nbors(uint32_t p_cell, LocalVector<uint32_t> &r_nbors);
+	uint32_t _jump(uint32_t p_from, uint32_t p_to);
+	bool _solve(uint32_t p_begin_cell, uint32_t p_end_cell, bool p_allow_partial_path);
+	uint32_t _forced_successor(int32_t p_x, int32_t p_y, int32_t p_dx, int32_t p_dy, bool p_inclusive = false);
 
 protected:
 	static void _bind_methods();
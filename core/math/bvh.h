@@ -52,6 +52,7 @@
 // and pairable_mask is either 0 if static, or set to all if non static
 
 #include "bvh_tree.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/os/mutex.h"
 
 #define BVHTREE_CLASS BVH_Tree<T, NUM_TREES, 2, MAX_ITEMS, USER_PAIR_TEST_FUNCTION, USER_CULL_TEST_FUNCTION, USE_PAIRS, BOUNDS, POINT>
@@ -88,6 +89,13 @@ public:
 		tree.params_set_pairing_expansion(p_value);
 	}
 
+	// Number of changed items from which the pairing queries are spread across the WorkerThreadPool.
+	// Zero disables it.
+	void params_set_parallel_pairing_threshold(uint32_t p_value) {
+		BVH_LOCKED_FUNCTION
+		_parallel_pairing_threshold = p_value;
+	}
+
 	void set_pair_callback(PairCallback p_callback, void *p_userdata) {
 		BVH_LOCKED_FUNCTION
 		pair_callback = p_callback;
@@ -381,6 +389,44 @@ public:
 		return params.result_count_overall;
 	}
 
+	// Variants of cull_aabb() and cull_segment() that don't lock, and store the hits in r_hits instead of the tree.
+	// These can run on several threads at once, as long as the BVH isn't modified meanwhile.
+	int cull_aabb_concurrent(const BOUNDS &p_aabb, T **p_result_array, int p_result_max, const T *p_tester, LocalVector<uint32_t, uint32_t, true> &r_hits, uint32_t p_tree_collision_mask = 0xFFFFFFFF, int *p_subindex_array = nullptr) {
+		typename BVHTREE_CLASS::CullParams params;
+
+		params.result_count_overall = 0;
+		params.result_max = p_result_max;
+		params.result_array = p_result_array;
+		params.subindex_array = p_subindex_array;
+		params.tree_collision_mask = p_tree_collision_mask;
+		params.abb.from(p_aabb);
+		params.tester = p_tester;
+		params.hits = &r_hits;
+
+		tree.cull_aabb(params);
+
+		return params.result_count_overall;
+	}
+
+	int cull_segment_concurrent(const POINT &p_from, const POINT &p_to, T **p_result_array, int p_result_max, const T *p_tester, LocalVector<uint32_t, uint32_t, true> &r_hits, uint32_t p_tree_collision_mask = 0xFFFFFFFF, int *p_subindex_array = nullptr) {
+		typename BVHTREE_CLASS::CullParams params;
+
+		params.result_count_overall = 0;
+		params.result_max = p_result_max;
+		params.result_array = p_result_array;
+		params.subindex_array = p_subindex_array;
+		params.tester = p_tester;
+		params.tree_collision_mask = p_tree_collision_mask;
+		params.hits = &r_hits;
+
+		params.segment.from = p_from;
+		params.segment.to = p_to;
+
+		tree.cull_segment(params);
+
+		return params.result_count_overall;
+	}
+
 	int cull_point(const POINT &p_point, T **p_result_array, int p_result_max, const T *p_tester, uint32_t p_tree_collision_mask = 0xFFFFFFFF, int *p_subindex_array = nullptr) {
 		BVH_LOCKED_FUNCTION
 		typename BVHTREE_CLASS::CullParams params;
@@ -435,6 +481,12 @@ private:
 			return;
 		}
 
+		// Blocking a pool thread on a nested group task could starve the pool, so only do this from other threads.
+		if (USE_PAIRS && _parallel_pairing_threshold && changed_items.size() >= _parallel_pairing_threshold && WorkerThreadPool::get_singleton() && WorkerThreadPool::get_thread_index() == -1) {
+			_check_for_collisions_parallel(p_full_check);
+			return;
+		}
+
 		BOUNDS bb;
 
 		typename BVHTREE_CLASS::CullParams params;
@@ -480,6 +532,54 @@ private:
 		_reset();
 	}
 
+	// Tree queries only read the tree, so they are done for all the changed items in parallel first.
+	// Pairing and unpairing is then done serially, in the same order as _check_for_collisions(),
+	// so callbacks happen in the exact same sequence and results stay deterministic.
+	void _check_for_collisions_parallel(bool p_full_check) {
+		uint32_t changed_count = changed_items.size();
+		if (_pair_candidates.size() < changed_count) {
+			_pair_candidates.resize(changed_count);
+		}
+
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &BVH_Manager::_find_pair_candidates, nullptr, changed_count, -1, true, SNAME("BVHFindPairCandidates"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+		for (uint32_t i = 0; i < changed_count; i++) {
+			const BVHHandle &h = changed_items[i];
+
+			BVHABB_CLASS abb;
+			abb.from(tree._pairs[h.id()].expanded_aabb);
+			_find_leavers(h, abb, p_full_check);
+
+			uint32_t changed_item_ref_id = h.id();
+			for (const uint32_t ref_id : _pair_candidates[i]) {
+				if (ref_id == changed_item_ref_id) {
+					continue;
+				}
+
+				BVHHandle h_collidee;
+				h_collidee.set_id(ref_id);
+				_collide(h, h_collidee);
+			}
+		}
+		_reset();
+	}
+
+	void _find_pair_candidates(uint32_t p_index, void *p_userdata) {
+		const BVHHandle &h = changed_items[p_index];
+
+		typename BVHTREE_CLASS::CullParams params;
+		params.result_count_overall = 0;
+		params.result_max = INT_MAX;
+		params.result_array = nullptr;
+		params.subindex_array = nullptr;
+		params.abb.from(tree._pairs[h.id()].expanded_aabb);
+		params.hits = &_pair_candidates[p_index];
+
+		tree.item_fill_cullparams(h, params);
+		tree.cull_aabb(params, false);
+	}
+
 public:
 	void item_get_AABB(BVHHandle p_handle, BOUNDS &r_aabb) {
 		DEV_ASSERT(!p_handle.is_invalid());
@@ -773,6 +873,10 @@ private:
 	LocalVector<BVHHandle, uint32_t, true> changed_items;
 	uint32_t _tick = 1; // Start from 1 so items with 0 indicate never updated.
 
+	// Per changed item tree query results, when pairing in parallel. Kept around to reuse allocations.
+	LocalVector<LocalVector<uint32_t, uint32_t, true>> _pair_candidates;
+	uint32_t _parallel_pairing_threshold = 256;
+
 	class BVHLockedFunction {
 	public:
 		BVHLockedFunction(Mutex *p_mutex, bool p_thread_safe) {
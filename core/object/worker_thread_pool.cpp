@@ -70,14 +70,19 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 		// about to be run uses scripting, guarantees are held.
 		ScriptServer::thread_enter();
 
-		task_mutex.lock();
-		p_task->pool_thread_index = pool_thread_index;
+		// No mutex needed here. Only this thread writes its current task, and other threads
+		// only use it as a hint when deciding which threads to wake up.
+		// notify_yield_over() sets the pending flag, then reads the thread index. This sets the
+		// thread index, then reads the flag. A release store followed by an acquire load can be
+		// reordered, so both sides need a full fence between them for one to see the other.
 		prev_task = curr_thread.current_task;
 		curr_thread.current_task = p_task;
-		if (p_task->pending_notify_yield_over) {
+		p_task->pool_thread_index.set(pool_thread_index);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		if (unlikely(p_task->pending_notify_yield_over.is_set())) {
+			MutexLock task_lock(task_mutex);
 			curr_thread.yield_is_over = true;
 		}
-		task_mutex.unlock();
 	}
 #endif
 
@@ -85,6 +90,8 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 	bool low_priority = p_task->low_priority;
 #endif
 
+	LocalVector<DependentTasks *> ready_dependents;
+
 	if (p_task->group) {
 		// Handling a group
 		bool do_post = false;
@@ -116,21 +123,23 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 		}
 
 		if (do_post) {
+			{
+				MutexLock task_lock(task_mutex);
+				p_task->group->completed.set_to(true);
+				_collect_ready_dependents(p_task->group->dependents, ready_dependents);
+			}
 			p_task->group->done_semaphore.post();
-			p_task->group->completed.set_to(true);
 		}
 		uint32_t max_users = p_task->group->tasks_used + 1; // Add 1 because the thread waiting for it is also user. Read before to avoid another thread freeing task after increment.
 		uint32_t finished_users = p_task->group->finished.increment();
 
+		task_mutex.lock();
 		if (finished_users == max_users) {
 			// Get rid of the group, because nobody else is using it.
-			MutexLock task_lock(task_mutex);
 			group_allocator.free(p_task->group);
 		}
 
 		// For groups, tasks get rid of themselves.
-
-		task_mutex.lock();
 		task_allocator.free(p_task);
 	} else {
 		if (p_task->native_func) {
@@ -144,7 +153,8 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 
 		task_mutex.lock();
 		p_task->completed = true;
-		p_task->pool_thread_index = -1;
+		p_task->pool_thread_index.set(-1);
+		_collect_ready_dependents(p_task->dependents, ready_dependents);
 		if (p_task->waiting_user) {
 			p_task->done_semaphore.post(p_task->waiting_user);
 		}
@@ -176,13 +186,26 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 	set_current_thread_safe_for_nodes(safe_for_nodes_backup);
 	MessageQueue::set_thread_singleton_override(call_queue_backup);
 #endif
+
+	if (ready_dependents.size()) {
+		_post_dependents(ready_dependents);
+	}
 }
 
 void WorkerThreadPool::_thread_function(void *p_user) {
 	ThreadData *thread_data = (ThreadData *)p_user;
 
 	while (true) {
-		Task *task_to_process = nullptr;
+		// Fast path: own queue first, then other threads', without taking the mutex.
+		Task *task_to_process = thread_data->local_queue.pop();
+		if (!task_to_process) {
+			task_to_process = singleton->_steal_task(thread_data);
+		}
+		if (task_to_process) {
+			singleton->_process_task(task_to_process);
+			continue;
+		}
+
 		{
 			MutexLock lock(singleton->task_mutex);
 
@@ -197,7 +220,16 @@ void WorkerThreadPool::_thread_function(void *p_user) {
 				task_to_process = singleton->task_queue.first()->self();
 				singleton->task_queue.remove(singleton->task_queue.first());
 			} else {
-				thread_data->cond_var.wait(lock);
+				// Tasks are pushed to local queues without the mutex. Pushers check the sleeping count
+				// after pushing, and this checks the queues after counting itself, so either this
+				// thread finds the task or the pusher wakes it up.
+				singleton->sleeping_thread_count.fetch_add(1);
+				std::atomic_thread_fence(std::memory_order_seq_cst);
+				task_to_process = singleton->_steal_task(thread_data);
+				if (!task_to_process) {
+					thread_data->cond_var.wait(lock);
+				}
+				singleton->sleeping_thread_count.fetch_sub(1);
 			}
 		}
 
@@ -207,7 +239,10 @@ void WorkerThreadPool::_thread_function(void *p_user) {
 	}
 }
 
-void WorkerThreadPool::_post_tasks(Task **p_tasks, uint32_t p_count, bool p_high_priority, MutexLock<BinaryMutex> &p_lock) {
+// Must be called with task_mutex held. If p_allow_local is true and the caller is a pool thread posting
+// high-priority tasks, returns true without posting them: the caller must release the mutex and then
+// pass them to _push_local_tasks().
+bool WorkerThreadPool::_post_tasks(Task **p_tasks, uint32_t p_count, bool p_high_priority, MutexLock<BinaryMutex> &p_lock, bool p_allow_local) {
 	// Fall back to processing on the calling thread if there are no worker threads.
 	// Separated into its own variable to make it easier to extend this logic
 	// in custom builds.
@@ -218,7 +253,7 @@ void WorkerThreadPool::_post_tasks(Task **p_tasks, uint32_t p_count, bool p_high
 			_process_task(p_tasks[i]);
 		}
 		p_lock.temp_relock();
-		return;
+		return false;
 	}
 
 	while (runlevel == RUNLEVEL_EXIT_LANGUAGES) {
@@ -230,6 +265,14 @@ void WorkerThreadPool::_post_tasks(Task **p_tasks, uint32_t p_count, bool p_high
 
 	ThreadData *caller_pool_thread = thread_ids.has(Thread::get_caller_id()) ? &threads[thread_ids[Thread::get_caller_id()]] : nullptr;
 
+	if (p_allow_local && p_high_priority && caller_pool_thread) {
+		// Tasks posted from a pool thread stay close to it. Idle threads will steal them.
+		for (uint32_t i = 0; i < p_count; i++) {
+			p_tasks[i]->low_priority = false;
+		}
+		return true;
+	}
+
 	for (uint32_t i = 0; i < p_count; i++) {
 		p_tasks[i]->low_priority = !p_high_priority;
 		if (p_high_priority || low_priority_threads_used < max_low_priority_threads) {
@@ -246,6 +289,27 @@ void WorkerThreadPool::_post_tasks(Task **p_tasks, uint32_t p_count, bool p_high
 	}
 
 	_notify_threads(caller_pool_thread, to_process, to_promote);
+	return false;
+}
+
+void WorkerThreadPool::_push_local_tasks(ThreadData *p_caller_pool_thread, Task **p_tasks, uint32_t p_count) {
+	uint32_t pushed = 0;
+	while (pushed < p_count && p_caller_pool_thread->local_queue.push(p_tasks[pushed])) {
+		pushed++;
+	}
+
+	// Pairs with the fence in the threads going to sleep; see _thread_function().
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	if (pushed == p_count && sleeping_thread_count.load() == 0) {
+		return; // Every thread is busy and will look at the queues before sleeping.
+	}
+
+	MutexLock lock(task_mutex);
+	for (uint32_t i = pushed; i < p_count; i++) {
+		// The local queue is full, so the rest goes to the shared one.
+		task_queue.add_last(&p_tasks[i]->task_elem);
+	}
+	_notify_threads(p_caller_pool_thread, p_count, 0);
 }
 
 void WorkerThreadPool::_notify_threads(const ThreadData *p_current_thread_data, uint32_t p_process_count, uint32_t p_promote_count) {
@@ -272,9 +336,10 @@ void WorkerThreadPool::_notify_threads(const ThreadData *p_current_thread_data,
 		if (th.signaled) {
 			continue;
 		}
-		if (th.current_task) {
+		Task *th_current_task = th.current_task;
+		if (th_current_task) {
 			// Good thread for promoting low-prio?
-			if (to_promote && th.awaited_task && th.current_task->low_priority) {
+			if (to_promote && th.awaited_task && th_current_task->low_priority) {
 				if (likely(&th != p_current_thread_data)) {
 					th.cond_var.notify_one();
 				}
@@ -312,6 +377,85 @@ void WorkerThreadPool::_notify_threads(const ThreadData *p_current_thread_data,
 	}
 }
 
+bool WorkerThreadPool::LocalTaskQueue::push(Task *p_task) {
+	int64_t b = bottom.load(std::memory_order_relaxed);
+	int64_t t = top.load(std::memory_order_acquire);
+	if (b - t >= (int64_t)LOCAL_QUEUE_SIZE) {
+		return false; // Full; the caller will use the shared queue instead.
+	}
+	buffer[b & (LOCAL_QUEUE_SIZE - 1)].store(p_task, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+	bottom.store(b + 1, std::memory_order_relaxed);
+	return true;
+}
+
+WorkerThreadPool::Task *WorkerThreadPool::LocalTaskQueue::pop() {
+	int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+	bottom.store(b, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	int64_t t = top.load(std::memory_order_relaxed);
+	if (t > b) {
+		// Empty.
+		bottom.store(b + 1, std::memory_order_relaxed);
+		return nullptr;
+	}
+	Task *task = buffer[b & (LOCAL_QUEUE_SIZE - 1)].load(std::memory_order_relaxed);
+	if (t == b) {
+		// Last element; race against thieves for it.
+		if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+			task = nullptr;
+		}
+		bottom.store(b + 1, std::memory_order_relaxed);
+	}
+	return task;
+}
+
+WorkerThreadPool::Task *WorkerThreadPool::LocalTaskQueue::steal() {
+	int64_t t = top.load(std::memory_order_acquire);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	int64_t b = bottom.load(std::memory_order_acquire);
+	if (t >= b) {
+		return nullptr;
+	}
+	Task *task = buffer[t & (LOCAL_QUEUE_SIZE - 1)].load(std::memory_order_relaxed);
+	if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+		return nullptr; // Lost the race against the owner or another thief.
+	}
+	return task;
+}
+
+WorkerThreadPool::Task *WorkerThreadPool::_steal_task(const ThreadData *p_thief) {
+	uint32_t thread_count = threads.size();
+	if (thread_count == 0) {
+		return nullptr;
+	}
+	// Start at a different victim for each thief to spread the contention on the queues' tops.
+	uint32_t start = p_thief ? p_thief->index + 1 : 0;
+	for (uint32_t i = 0; i < thread_count; i++) {
+		ThreadData &victim = threads[(start + i) % thread_count];
+		if (&victim == p_thief) {
+			continue;
+		}
+		// A steal may fail spuriously due to a race; retry while there's still work there.
+		while (!victim.local_queue.is_empty()) {
+			Task *task = victim.local_queue.steal();
+			if (task) {
+				return task;
+			}
+		}
+	}
+	return nullptr;
+}
+
+bool WorkerThreadPool::_has_local_tasks() const {
+	for (uint32_t i = 0; i < threads.size(); i++) {
+		if (!threads[i].local_queue.is_empty()) {
+			return true;
+		}
+	}
+	return false;
+}
+
 bool WorkerThreadPool::_try_promote_low_priority_task() {
 	if (low_priority_task_queue.first()) {
 		Task *low_prio_task = low_priority_task_queue.first()->self();
@@ -328,21 +472,32 @@ WorkerThreadPool::TaskID WorkerThreadPool::add_native_task(void (*p_func)(void *
 	return _add_task(Callable(), p_func, p_userdata, nullptr, p_high_priority, p_description);
 }
 
-WorkerThreadPool::TaskID WorkerThreadPool::_add_task(const Callable &p_callable, void (*p_func)(void *), void *p_userdata, BaseTemplateUserdata *p_template_userdata, bool p_high_priority, const String &p_description) {
-	MutexLock<BinaryMutex> lock(task_mutex);
-
-	// Get a free task
-	Task *task = task_allocator.alloc();
-	TaskID id = last_task++;
-	task->self = id;
-	task->callable = p_callable;
-	task->native_func = p_func;
-	task->native_func_userdata = p_userdata;
-	task->description = p_description;
-	task->template_userdata = p_template_userdata;
-	tasks.insert(id, task);
+WorkerThreadPool::TaskID WorkerThreadPool::_add_task(const Callable &p_callable, void (*p_func)(void *), void *p_userdata, BaseTemplateUserdata *p_template_userdata, bool p_high_priority, const String &p_description, const Vector<TaskID> &p_dependencies) {
+	Task *task = nullptr;
+	TaskID id = INVALID_TASK_ID;
+	bool push_local = false;
+	{
+		MutexLock<BinaryMutex> lock(task_mutex);
+
+		// Get a free task
+		task = task_allocator.alloc();
+		id = last_task++;
+		task->self = id;
+		task->callable = p_callable;
+		task->native_func = p_func;
+		task->native_func_userdata = p_userdata;
+		task->description = p_description;
+		task->template_userdata = p_template_userdata;
+		tasks.insert(id, task);
+
+		if (!_defer_tasks(&task, 1, p_high_priority, p_dependencies)) {
+			push_local = _post_tasks(&task, 1, p_high_priority, lock, true);
+		}
+	}
 
-	_post_tasks(&task, 1, p_high_priority, lock);
+	if (push_local) {
+		_push_local_tasks(&threads[thread_ids[Thread::get_caller_id()]], &task, 1);
+	}
 
 	return id;
 }
@@ -351,6 +506,72 @@ WorkerThreadPool::TaskID WorkerThreadPool::add_task(const Callable &p_action, bo
 	return _add_task(p_action, nullptr, nullptr, nullptr, p_high_priority, p_description);
 }
 
+WorkerThreadPool::TaskID WorkerThreadPool::add_native_dependent_task(void (*p_func)(void *), void *p_userdata, const Vector<TaskID> &p_dependencies, bool p_high_priority, const String &p_description) {
+	return _add_task(Callable(), p_func, p_userdata, nullptr, p_high_priority, p_description, p_dependencies);
+}
+
+WorkerThreadPool::TaskID WorkerThreadPool::add_dependent_task(const Callable &p_action, const Vector<TaskID> &p_dependencies, bool p_high_priority, const String &p_description) {
+	return _add_task(p_action, nullptr, nullptr, nullptr, p_high_priority, p_description, p_dependencies);
+}
+
+// Must be called with task_mutex held. Returns false if all the dependencies are already completed,
+// in which case the caller must post the tasks right away.
+bool WorkerThreadPool::_defer_tasks(Task **p_tasks, uint32_t p_count, bool p_high_priority, const Vector<TaskID> &p_dependencies) {
+	if (p_dependencies.is_empty() || p_count == 0) {
+		return false;
+	}
+
+	DependentTasks *dependent = nullptr;
+	for (const TaskID &dependency : p_dependencies) {
+		LocalVector<DependentTasks *> *dependents = nullptr;
+		if (Task **taskp = tasks.getptr(dependency)) {
+			if (!(*taskp)->completed) {
+				dependents = &(*taskp)->dependents;
+			}
+		} else if (Group **groupp = groups.getptr(dependency)) {
+			if (!(*groupp)->completed.is_set()) {
+				dependents = &(*groupp)->dependents;
+			}
+		} else {
+			// Either already awaited, and therefore completed, or bogus.
+			ERR_CONTINUE_MSG(dependency <= 0 || dependency >= (TaskID)last_task, vformat("Invalid Task or Group ID as dependency: %d.", dependency));
+		}
+
+		if (dependents) {
+			if (!dependent) {
+				dependent = memnew(DependentTasks);
+				dependent->high_priority = p_high_priority;
+				dependent->tasks.resize(p_count);
+				memcpy(dependent->tasks.ptr(), p_tasks, sizeof(Task *) * p_count);
+			}
+			dependents->push_back(dependent);
+			dependent->pending_dependencies++;
+		}
+	}
+
+	return dependent != nullptr;
+}
+
+// Must be called with task_mutex held.
+void WorkerThreadPool::_collect_ready_dependents(LocalVector<DependentTasks *> &p_dependents, LocalVector<DependentTasks *> &r_ready) {
+	for (DependentTasks *dependent : p_dependents) {
+		DEV_ASSERT(dependent->pending_dependencies > 0);
+		dependent->pending_dependencies--;
+		if (dependent->pending_dependencies == 0) {
+			r_ready.push_back(dependent);
+		}
+	}
+	p_dependents.clear();
+}
+
+void WorkerThreadPool::_post_dependents(LocalVector<DependentTasks *> &p_dependents) {
+	MutexLock<BinaryMutex> lock(task_mutex);
+	for (DependentTasks *dependent : p_dependents) {
+		_post_tasks(dependent->tasks.ptr(), dependent->tasks.size(), dependent->high_priority, lock);
+		memdelete(dependent);
+	}
+}
+
 bool WorkerThreadPool::is_task_completed(TaskID p_task_id) const {
 	MutexLock task_lock(task_mutex);
 	const Task *const *taskp = tasks.getptr(p_task_id);
@@ -380,7 +601,7 @@ Error WorkerThreadPool::wait_for_task_completion(TaskID p_task_id) {
 	}
 
 	ThreadData *caller_pool_thread = thread_ids.has(Thread::get_caller_id()) ? &threads[thread_ids[Thread::get_caller_id()]] : nullptr;
-	if (caller_pool_thread && p_task_id <= caller_pool_thread->current_task->self) {
+	if (caller_pool_thread && p_task_id <= caller_pool_thread->current_task.load()->self) {
 		// Deadlock prevention:
 		// When a pool thread wants to wait for an older task, the following situations can happen:
 		// 1. Awaited task is deep in the stack of the awaiter.
@@ -451,6 +672,7 @@ void WorkerThreadPool::_wait_collaboratively(ThreadData *p_caller_pool_thread, T
 
 	while (true) {
 		Task *task_to_process = nullptr;
+		bool pop_local = false;
 		bool relock_unlockables = false;
 		{
 			MutexLock lock(task_mutex);
@@ -479,8 +701,8 @@ void WorkerThreadPool::_wait_collaboratively(ThreadData *p_caller_pool_thread, T
 				if (was_signaled) {
 					// This thread was awaken for some additional reason, but it's about to exit.
 					// Let's find out what may be pending and forward the requests.
-					uint32_t to_process = task_queue.first() ? 1 : 0;
-					uint32_t to_promote = p_caller_pool_thread->current_task->low_priority && low_priority_task_queue.first() ? 1 : 0;
+					uint32_t to_process = (task_queue.first() || _has_local_tasks()) ? 1 : 0;
+					uint32_t to_promote = p_caller_pool_thread->current_task.load()->low_priority && low_priority_task_queue.first() ? 1 : 0;
 					if (to_process || to_promote) {
 						// This thread must be left alone since it won't loop again.
 						p_caller_pool_thread->signaled = true;
@@ -491,29 +713,44 @@ void WorkerThreadPool::_wait_collaboratively(ThreadData *p_caller_pool_thread, T
 				break;
 			}
 
-			if (p_caller_pool_thread->current_task->low_priority && low_priority_task_queue.first()) {
+			if (p_caller_pool_thread->current_task.load()->low_priority && low_priority_task_queue.first()) {
 				if (_try_promote_low_priority_task()) {
 					_notify_threads(p_caller_pool_thread, 1, 0);
 				}
 			}
 
-			if (singleton->task_queue.first()) {
+			// Own tasks first, since the awaited one is likely among them.
+			// They are popped below, once the mutex is released.
+			pop_local = !p_caller_pool_thread->local_queue.is_empty();
+			if (!pop_local && task_queue.first()) {
 				task_to_process = task_queue.first()->self();
 				task_queue.remove(task_queue.first());
 			}
+			if (!pop_local && !task_to_process) {
+				// See _thread_function() about the sleeping count.
+				sleeping_thread_count.fetch_add(1);
+				std::atomic_thread_fence(std::memory_order_seq_cst);
+				task_to_process = _steal_task(p_caller_pool_thread);
+				if (!task_to_process) {
+					p_caller_pool_thread->awaited_task = p_task;
 
-			if (!task_to_process) {
-				p_caller_pool_thread->awaited_task = p_task;
-
-				_unlock_unlockable_mutexes();
-				relock_unlockables = true;
+					_unlock_unlockable_mutexes();
+					relock_unlockables = true;
 
-				p_caller_pool_thread->cond_var.wait(lock);
+					p_caller_pool_thread->cond_var.wait(lock);
 
-				p_caller_pool_thread->awaited_task = nullptr;
+					p_caller_pool_thread->awaited_task = nullptr;
+				}
+				sleeping_thread_count.fetch_sub(1);
 			}
 		}
 
+		if (pop_local) {
+			// Only this thread pops from its own queue; other threads may steal concurrently,
+			// in which case this comes back empty and the loop goes on.
+			task_to_process = p_caller_pool_thread->local_queue.pop();
+		}
+
 		if (relock_unlockables) {
 			_lock_unlockable_mutexes();
 		}
@@ -543,7 +780,7 @@ bool WorkerThreadPool::_handle_runlevel(ThreadData *p_thread_data, MutexLock<Bin
 		} break;
 		case RUNLEVEL_PRE_EXIT_LANGUAGES: {
 			if (!p_thread_data->pre_exited_languages) {
-				if (!task_queue.first() && !low_priority_task_queue.first()) {
+				if (!task_queue.first() && !low_priority_task_queue.first() && !_has_local_tasks()) {
 					p_thread_data->pre_exited_languages = true;
 					runlevel_data.pre_exit_languages.num_idle_threads++;
 					control_cond_var.notify_all();
@@ -592,21 +829,26 @@ void WorkerThreadPool::notify_yield_over(TaskID p_task_id) {
 		ERR_FAIL_MSG("Invalid Task ID.");
 	}
 	Task *task = *taskp;
-	if (task->pool_thread_index == -1) { // Completed or not started yet.
-		if (!task->completed) {
-			// This avoids a race condition where a task is created and yield-over called before it's processed.
-			task->pending_notify_yield_over = true;
-		}
+	if (task->completed) {
 		return;
 	}
 
-	ThreadData &td = threads[task->pool_thread_index];
+	// This avoids a race condition where a task is created and yield-over called before it's processed.
+	// It must be visible before reading the thread index; see _process_task().
+	task->pending_notify_yield_over.set();
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	int pool_thread_index = task->pool_thread_index.get();
+	if (pool_thread_index == -1) { // Not started yet.
+		return;
+	}
+
+	ThreadData &td = threads[pool_thread_index];
 	td.yield_is_over = true;
 	td.signaled = true;
 	td.cond_var.notify_one();
 }
 
-WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_callable, void (*p_func)(void *, uint32_t), void *p_userdata, BaseTemplateUserdata *p_template_userdata, int p_elements, int p_tasks, bool p_high_priority, const String &p_description) {
+WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_callable, void (*p_func)(void *, uint32_t), void *p_userdata, BaseTemplateUserdata *p_template_userdata, int p_elements, int p_tasks, bool p_high_priority, const String &p_description, const Vector<TaskID> &p_dependencies) {
 	ERR_FAIL_COND_V(p_elements < 0, INVALID_TASK_ID);
 	if (p_tasks < 0) {
 		p_tasks = MAX(1u, threads.size());
@@ -648,7 +890,13 @@ WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_ca
 
 	groups[id] = group;
 
-	_post_tasks(tasks_posted, p_tasks, p_high_priority, lock);
+	if (!_defer_tasks(tasks_posted, p_tasks, p_high_priority, p_dependencies)) {
+		if (_post_tasks(tasks_posted, p_tasks, p_high_priority, lock, true)) {
+			lock.temp_unlock();
+			_push_local_tasks(&threads[thread_ids[Thread::get_caller_id()]], tasks_posted, p_tasks);
+			lock.temp_relock();
+		}
+	}
 
 	return id;
 }
@@ -661,6 +909,14 @@ WorkerThreadPool::GroupID WorkerThreadPool::add_group_task(const Callable &p_act
 	return _add_group_task(p_action, nullptr, nullptr, nullptr, p_elements, p_tasks, p_high_priority, p_description);
 }
 
+WorkerThreadPool::GroupID WorkerThreadPool::add_native_dependent_group_task(void (*p_func)(void *, uint32_t), void *p_userdata, int p_elements, const Vector<TaskID> &p_dependencies, int p_tasks, bool p_high_priority, const String &p_description) {
+	return _add_group_task(Callable(), p_func, p_userdata, nullptr, p_elements, p_tasks, p_high_priority, p_description, p_dependencies);
+}
+
+WorkerThreadPool::GroupID WorkerThreadPool::add_dependent_group_task(const Callable &p_action, int p_elements, const Vector<TaskID> &p_dependencies, int p_tasks, bool p_high_priority, const String &p_description) {
+	return _add_group_task(p_action, nullptr, nullptr, nullptr, p_elements, p_tasks, p_high_priority, p_description, p_dependencies);
+}
+
 uint32_t WorkerThreadPool::get_group_processed_element_count(GroupID p_group) const {
 	MutexLock task_lock(task_mutex);
 	const Group *const *groupp = groups.getptr(p_group);
@@ -694,6 +950,12 @@ void WorkerThreadPool::wait_for_group_task_completion(GroupID p_group) {
 		group->done_semaphore.wait();
 		_lock_unlockable_mutexes();
 
+		{
+			// Unregister before it may be freed, so dependency lookups never find a dangling group.
+			MutexLock task_lock(task_mutex); // This mutex is needed when Physics 2D and/or 3D is selected to run on a separate thread.
+			groups.erase(p_group);
+		}
+
 		uint32_t max_users = group->tasks_used + 1; // Add 1 because the thread waiting for it is also user. Read before to avoid another thread freeing task after increment.
 		uint32_t finished_users = group->finished.increment(); // fetch happens before inc, so increment later.
 
@@ -703,9 +965,6 @@ void WorkerThreadPool::wait_for_group_task_completion(GroupID p_group) {
 			group_allocator.free(group);
 		}
 	}
-
-	MutexLock task_lock(task_mutex); // This mutex is needed when Physics 2D and/or 3D is selected to run on a separate thread.
-	groups.erase(p_group);
 #endif
 }
 
@@ -717,7 +976,7 @@ int WorkerThreadPool::get_thread_index() {
 WorkerThreadPool::TaskID WorkerThreadPool::get_caller_task_id() {
 	int th_index = get_thread_index();
 	if (th_index != -1 && singleton->threads[th_index].current_task) {
-		return singleton->threads[th_index].current_task->self;
+		return singleton->threads[th_index].current_task.load()->self;
 	} else {
 		return INVALID_TASK_ID;
 	}
@@ -826,7 +1085,10 @@ void WorkerThreadPool::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("is_task_completed", "task_id"), &WorkerThreadPool::is_task_completed);
 	ClassDB::bind_method(D_METHOD("wait_for_task_completion", "task_id"), &WorkerThreadPool::wait_for_task_completion);
 
+	ClassDB::bind_method(D_METHOD("add_dependent_task", "action", "dependencies", "high_priority", "description"), &WorkerThreadPool::add_dependent_task, DEFVAL(false), DEFVAL(String()));
+
 	ClassDB::bind_method(D_METHOD("add_group_task", "action", "elements", "tasks_needed", "high_priority", "description"), &WorkerThreadPool::add_group_task, DEFVAL(-1), DEFVAL(false), DEFVAL(String()));
+	ClassDB::bind_method(D_METHOD("add_dependent_group_task", "action", "elements", "dependencies", "tasks_needed", "high_priority", "description"), &WorkerThreadPool::add_dependent_group_task, DEFVAL(-1), DEFVAL(false), DEFVAL(String()));
 	ClassDB::bind_method(D_METHOD("is_group_task_completed", "group_id"), &WorkerThreadPool::is_group_task_completed);
 	ClassDB::bind_method(D_METHOD("get_group_processed_element_count", "group_id"), &WorkerThreadPool::get_group_processed_element_count);
 	ClassDB::bind_method(D_METHOD("wait_for_group_task_completion", "group_id"), &WorkerThreadPool::wait_for_group_task_completion);
@@ -41,6 +41,8 @@
 #include "core/templates/rid.h"
 #include "core/templates/safe_refcount.h"
 
+#include <atomic>
+
 class WorkerThreadPool : public Object {
 	GDCLASS(WorkerThreadPool, Object)
 public:
@@ -54,6 +56,13 @@ public:
 private:
 	struct Task;
 
+	// Tasks held back until all the tasks and groups they depend on are completed.
+	struct DependentTasks {
+		LocalVector<Task *> tasks;
+		uint32_t pending_dependencies = 0;
+		bool high_priority = false;
+	};
+
 	struct BaseTemplateUserdata {
 		virtual void callback() {}
 		virtual void callback_indexed(uint32_t p_index) {}
@@ -69,6 +78,7 @@ private:
 		SafeFlag completed;
 		SafeNumeric<uint32_t> finished;
 		uint32_t tasks_used = 0;
+		LocalVector<DependentTasks *> dependents;
 	};
 
 	struct Task {
@@ -80,24 +90,38 @@ private:
 		String description;
 		Semaphore done_semaphore; // For user threads awaiting.
 		bool completed : 1;
-		bool pending_notify_yield_over : 1;
+		SafeFlag pending_notify_yield_over; // Set by notify_yield_over() before the task starts.
 		Group *group = nullptr;
 		SelfList<Task> task_elem;
 		uint32_t waiting_pool = 0;
 		uint32_t waiting_user = 0;
 		bool low_priority = false;
 		BaseTemplateUserdata *template_userdata = nullptr;
-		int pool_thread_index = -1;
+		SafeNumeric<int> pool_thread_index{ -1 };
+		LocalVector<DependentTasks *> dependents;
 
 		void free_template_userdata();
 		Task() :
 				completed(false),
-				pending_notify_yield_over(false),
 				task_elem(this) {}
 	};
 
 	static const uint32_t TASKS_PAGE_SIZE = 1024;
 	static const uint32_t GROUPS_PAGE_SIZE = 256;
+	static const uint32_t LOCAL_QUEUE_SIZE = 256; // Must be a power of two.
+
+	// Bounded lock-free work-stealing deque (Chase-Lev).
+	// Only the owner thread may push or pop (LIFO, at the bottom); any thread may steal (FIFO, from the top).
+	struct LocalTaskQueue {
+		std::atomic<int64_t> top = { 0 };
+		std::atomic<int64_t> bottom = { 0 };
+		std::atomic<Task *> buffer[LOCAL_QUEUE_SIZE] = {};
+
+		bool push(Task *p_task);
+		Task *pop();
+		Task *steal();
+		_FORCE_INLINE_ bool is_empty() const { return bottom.load(std::memory_order_acquire) <= top.load(std::memory_order_acquire); }
+	};
 
 	PagedAllocator<Task, false, TASKS_PAGE_SIZE> task_allocator;
 	PagedAllocator<Group, false, GROUPS_PAGE_SIZE> group_allocator;
@@ -116,9 +140,10 @@ private:
 		bool yield_is_over : 1;
 		bool pre_exited_languages : 1;
 		bool exited_languages : 1;
-		Task *current_task = nullptr;
+		std::atomic<Task *> current_task = { nullptr }; // Set by the thread itself without the mutex.
 		Task *awaited_task = nullptr; // Null if not awaiting the condition variable, or special value (YIELDING).
 		ConditionVariable cond_var;
+		LocalTaskQueue local_queue; // High-priority tasks posted by this thread. Other threads steal from it.
 
 		ThreadData() :
 				signaled(false),
@@ -163,6 +188,7 @@ private:
 	uint32_t max_low_priority_threads = 0;
 	uint32_t low_priority_threads_used = 0;
 	uint32_t notify_index = 0; // For rotating across threads, no help distributing load.
+	std::atomic<uint32_t> sleeping_thread_count = { 0 }; // Threads about to wait, or waiting, on their condition variable.
 
 	uint64_t last_task = 1;
 
@@ -170,7 +196,14 @@ private:
 
 	void _process_task(Task *task);
 
-	void _post_tasks(Task **p_tasks, uint32_t p_count, bool p_high_priority, MutexLock<BinaryMutex> &p_lock);
+	bool _post_tasks(Task **p_tasks, uint32_t p_count, bool p_high_priority, MutexLock<BinaryMutex> &p_lock, bool p_allow_local = false);
+	void _push_local_tasks(ThreadData *p_caller_pool_thread, Task **p_tasks, uint32_t p_count);
+	Task *_steal_task(const ThreadData *p_thief);
+	bool _has_local_tasks() const;
+
+	bool _defer_tasks(Task **p_tasks, uint32_t p_count, bool p_high_priority, const Vector<TaskID> &p_dependencies);
+	void _collect_ready_dependents(LocalVector<DependentTasks *> &p_dependents, LocalVector<DependentTasks *> &r_ready);
+	void _post_dependents(LocalVector<DependentTasks *> &p_dependents);
 	void _notify_threads(const ThreadData *p_current_thread_data, uint32_t p_process_count, uint32_t p_promote_count);
 
 	bool _try_promote_low_priority_task();
@@ -186,8 +219,8 @@ private:
 	static thread_local UnlockableLocks unlockable_locks[MAX_UNLOCKABLE_LOCKS];
 #endif
 
-	TaskID _add_task(const Callable &p_callable, void (*p_func)(void *), void *p_userdata, BaseTemplateUserdata *p_template_userdata, bool p_high_priority, const String &p_description);
-	GroupID _add_group_task(const Callable &p_callable, void (*p_func)(void *, uint32_t), void *p_userdata, BaseTemplateUserdata *p_template_userdata, int p_elements, int p_tasks, bool p_high_priority, const String &p_description);
+	TaskID _add_task(const Callable &p_callable, void (*p_func)(void *), void *p_userdata, BaseTemplateUserdata *p_template_userdata, bool p_high_priority, const String &p_description, const Vector<TaskID> &p_dependencies = Vector<TaskID>());
+	GroupID _add_group_task(const Callable &p_callable, void (*p_func)(void *, uint32_t), void *p_userdata, BaseTemplateUserdata *p_template_userdata, int p_elements, int p_tasks, bool p_high_priority, const String &p_description, const Vector<TaskID> &p_dependencies = Vector<TaskID>());
 
 	template <typename C, typename M, typename U>
 	struct TaskUserData : public BaseTemplateUserdata {
@@ -237,6 +270,20 @@ public:
 	TaskID add_native_task(void (*p_func)(void *), void *p_userdata, bool p_high_priority = false, const String &p_description = String());
 	TaskID add_task(const Callable &p_action, bool p_high_priority = false, const String &p_description = String());
 
+	// Dependent variants: the task is not queued until every task or group in p_dependencies is completed.
+	// This allows submitting a whole graph of work at once and waiting only for its last nodes.
+	template <typename C, typename M, typename U>
+	TaskID add_template_dependent_task(C *p_instance, M p_method, U p_userdata, const Vector<TaskID> &p_dependencies, bool p_high_priority = false, const String &p_description = String()) {
+		typedef TaskUserData<C, M, U> TUD;
+		TUD *ud = memnew(TUD);
+		ud->instance = p_instance;
+		ud->method = p_method;
+		ud->userdata = p_userdata;
+		return _add_task(Callable(), nullptr, nullptr, ud, p_high_priority, p_description, p_dependencies);
+	}
+	TaskID add_native_dependent_task(void (*p_func)(void *), void *p_userdata, const Vector<TaskID> &p_dependencies, bool p_high_priority = false, const String &p_description = String());
+	TaskID add_dependent_task(const Callable &p_action, const Vector<TaskID> &p_dependencies, bool p_high_priority = false, const String &p_description = String());
+
 	bool is_task_completed(TaskID p_task_id) const;
 	Error wait_for_task_completion(TaskID p_task_id);
 
@@ -254,6 +301,18 @@ public:
 	}
 	GroupID add_native_group_task(void (*p_func)(void *, uint32_t), void *p_userdata, int p_elements, int p_tasks = -1, bool p_high_priority = false, const String &p_description = String());
 	GroupID add_group_task(const Callable &p_action, int p_elements, int p_tasks = -1, bool p_high_priority = false, const String &p_description = String());
+
+	template <typename C, typename M, typename U>
+	GroupID add_template_dependent_group_task(C *p_instance, M p_method, U p_userdata, int p_elements, const Vector<TaskID> &p_dependencies, int p_tasks = -1, bool p_high_priority = false, const String &p_description = String()) {
+		typedef GroupUserData<C, M, U> GroupUD;
+		GroupUD *ud = memnew(GroupUD);
+		ud->instance = p_instance;
+		ud->method = p_method;
+		ud->userdata = p_userdata;
+		return _add_group_task(Callable(), nullptr, nullptr, ud, p_elements, p_tasks, p_high_priority, p_description, p_dependencies);
+	}
+	GroupID add_native_dependent_group_task(void (*p_func)(void *, uint32_t), void *p_userdata, int p_elements, const Vector<TaskID> &p_dependencies, int p_tasks = -1, bool p_high_priority = false, const String &p_description = String());
+	GroupID add_dependent_group_task(const Callable &p_action, int p_elements, const Vector<TaskID> &p_dependencies, int p_tasks = -1, bool p_high_priority = false, const String &p_description = String());
 	uint32_t get_group_processed_element_count(GroupID p_group) const;
 	bool is_group_task_completed(GroupID p_group) const;
 	void wait_for_group_task_completion(GroupID p_group);
@@ -248,10 +248,30 @@ Variant GodotBody2D::get_param(PhysicsServer2D::BodyParameter p_param) const {
 	return 0;
 }
 
+void GodotBody2D::_island_changed() {
+	// The contact graph changed, the island will be rebuilt (merged or split) next time it's stepped.
+	get_space()->island_free(island);
+}
+
 void GodotBody2D::set_mode(PhysicsServer2D::BodyMode p_mode) {
 	PhysicsServer2D::BodyMode prev = mode;
 	mode = p_mode;
 
+	if (island != -1 && prev != mode) {
+		_island_changed();
+	}
+	if ((prev == PhysicsServer2D::BODY_MODE_STATIC) != (mode == PhysicsServer2D::BODY_MODE_STATIC)) {
+		// Static bodies don't connect islands, so the islands of the bodies touching this one merge or split.
+		for (const Pair<GodotConstraint2D *, int> &E : constraint_list) {
+			for (int i = 0; i < E.first->get_body_count(); i++) {
+				GodotBody2D *other_body = E.first->get_body_ptr()[i];
+				if (other_body != this && other_body->island != -1) {
+					other_body->_island_changed();
+				}
+			}
+		}
+	}
+
 	switch (p_mode) {
 		//CLEAR UP EVERYTHING IN CASE IT NOT WORKS!
 		case PhysicsServer2D::BODY_MODE_STATIC:
@@ -392,6 +412,10 @@ void GodotBody2D::set_space(GodotSpace2D *p_space) {
 	if (get_space()) {
 		wakeup_neighbours();
 
+		if (island != -1) {
+			_island_changed();
+		}
+
 		if (mass_properties_update_list.in_list()) {
 			get_space()->body_remove_from_mass_properties_update_list(&mass_properties_update_list);
 		}
@@ -151,8 +151,10 @@ class GodotBody2D : public GodotCollisionObject2D {
 	GodotPhysicsDirectBodyState2D *direct_state = nullptr;
 
 	uint64_t island_step = 0;
+	int32_t island = -1; // Persistent island in the space, -1 when it needs to be rebuilt.
 
 	void _update_transform_dependent();
+	void _island_changed();
 
 	friend class GodotPhysicsDirectBodyState2D; // i give up, too many functions to expose
 
@@ -202,8 +204,21 @@ public:
 	_FORCE_INLINE_ uint64_t get_island_step() const { return island_step; }
 	_FORCE_INLINE_ void set_island_step(uint64_t p_step) { island_step = p_step; }
 
-	_FORCE_INLINE_ void add_constraint(GodotConstraint2D *p_constraint, int p_pos) { constraint_list.push_back({ p_constraint, p_pos }); }
-	_FORCE_INLINE_ void remove_constraint(GodotConstraint2D *p_constraint, int p_pos) { constraint_list.erase({ p_constraint, p_pos }); }
+	_FORCE_INLINE_ int32_t get_island() const { return island; }
+	_FORCE_INLINE_ void set_island(int32_t p_island) { island = p_island; }
+
+	_FORCE_INLINE_ void add_constraint(GodotConstraint2D *p_constraint, int p_pos) {
+		constraint_list.push_back({ p_constraint, p_pos });
+		if (island != -1) {
+			_island_changed();
+		}
+	}
+	_FORCE_INLINE_ void remove_constraint(GodotConstraint2D *p_constraint, int p_pos) {
+		constraint_list.erase({ p_constraint, p_pos });
+		if (island != -1) {
+			_island_changed();
+		}
+	}
 	const List<Pair<GodotConstraint2D *, int>> &get_constraint_list() const { return constraint_list; }
 	_FORCE_INLINE_ void clear_constraint_list() { constraint_list.clear(); }
 
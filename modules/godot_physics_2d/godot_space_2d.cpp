@@ -1211,6 +1211,26 @@ bool GodotSpace2D::is_locked() const {
 	return locked;
 }
 
+uint32_t GodotSpace2D::island_create() {
+	if (free_islands.size()) {
+		uint32_t island = free_islands[free_islands.size() - 1];
+		free_islands.resize(free_islands.size() - 1);
+		return island;
+	}
+	islands.push_back(Island());
+	return islands.size() - 1;
+}
+
+void GodotSpace2D::island_free(uint32_t p_island) {
+	Island &island = islands[p_island];
+	for (GodotBody2D *body : island.bodies) {
+		body->set_island(-1);
+	}
+	island.bodies.clear();
+	island.constraints.clear();
+	free_islands.push_back(p_island);
+}
+
 GodotPhysicsDirectSpaceState2D *GodotSpace2D::get_direct_state() {
 	return direct_access;
 }
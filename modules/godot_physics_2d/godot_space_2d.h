@@ -40,6 +40,7 @@
 
 #include "core/config/project_settings.h"
 #include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
 #include "core/typedefs.h"
 
 class GodotPhysicsDirectSpaceState2D : public PhysicsDirectSpaceState2D {
@@ -70,6 +71,12 @@ public:
 
 	};
 
+	// Islands are kept between steps and only rebuilt when constraints are added to or removed from one of their bodies.
+	struct Island {
+		LocalVector<GodotBody2D *> bodies; // All non-static bodies, including kinematic ones.
+		LocalVector<GodotConstraint2D *> constraints;
+	};
+
 private:
 	struct ExcludedShapeSW {
 		GodotShape2D *local_shape = nullptr;
@@ -119,6 +126,9 @@ private:
 
 	real_t last_step = 0.001;
 
+	LocalVector<Island> islands;
+	LocalVector<uint32_t> free_islands;
+
 	int island_count = 0;
 	int active_objects = 0;
 	int collision_pairs = 0;
@@ -182,6 +192,10 @@ public:
 	void set_param(PhysicsServer2D::SpaceParameter p_param, real_t p_value);
 	real_t get_param(PhysicsServer2D::SpaceParameter p_param) const;
 
+	uint32_t island_create();
+	void island_free(uint32_t p_island);
+	_FORCE_INLINE_ Island &island_get(uint32_t p_island) { return islands[p_island]; }
+
 	void set_island_count(int p_island_count) { island_count = p_island_count; }
 	int get_island_count() const { return island_count; }
 
@@ -41,6 +41,12 @@
 
 void GodotStep2D::_populate_island(GodotBody2D *p_body, LocalVector<GodotBody2D *> &p_body_island, LocalVector<GodotConstraint2D *> &p_constraint_island) {
 	p_body->set_island_step(_step);
+	island_bodies.push_back(p_body);
+
+	if (p_body->get_island() != -1) {
+		// The island this body was stored in is being merged into this one, so it no longer holds.
+		p_body->get_space()->island_free(p_body->get_island());
+	}
 
 	if (p_body->get_mode() > PhysicsServer2D::BODY_MODE_KINEMATIC) {
 		// Only rigid bodies are tested for activation.
@@ -72,6 +78,32 @@ void GodotStep2D::_populate_island(GodotBody2D *p_body, LocalVector<GodotBody2D
 	}
 }
 
+void GodotStep2D::_restore_island(const GodotSpace2D::Island &p_island, LocalVector<GodotBody2D *> &p_body_island, LocalVector<GodotConstraint2D *> &p_constraint_island) {
+	for (GodotBody2D *body : p_island.bodies) {
+		body->set_island_step(_step);
+		if (body->get_mode() > PhysicsServer2D::BODY_MODE_KINEMATIC) {
+			// Only rigid bodies are tested for activation.
+			p_body_island.push_back(body);
+		}
+	}
+
+	for (GodotConstraint2D *constraint : p_island.constraints) {
+		constraint->set_island_step(_step);
+		p_constraint_island.push_back(constraint);
+		all_constraints.push_back(constraint);
+	}
+}
+
+void GodotStep2D::_store_island(GodotSpace2D *p_space, const LocalVector<GodotConstraint2D *> &p_constraint_island) {
+	uint32_t island_index = p_space->island_create();
+	GodotSpace2D::Island &island = p_space->island_get(island_index);
+	island.bodies = island_bodies;
+	island.constraints = p_constraint_island;
+	for (GodotBody2D *body : island_bodies) {
+		body->set_island(island_index);
+	}
+}
+
 void GodotStep2D::_setup_constraint(uint32_t p_constraint_index, void *p_userdata) {
 	GodotConstraint2D *constraint = all_constraints[p_constraint_index];
 	constraint->setup(delta);
@@ -162,34 +194,8 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 		profile_begtime = profile_endtime;
 	}
 
-	/* GENERATE CONSTRAINT ISLANDS FOR MOVING AREAS */
-
 	uint32_t island_count = 0;
 
-	const SelfList<GodotArea2D>::List &aml = p_space->get_moved_area_list();
-
-	while (aml.first()) {
-		for (GodotConstraint2D *E : aml.first()->self()->get_constraints()) {
-			GodotConstraint2D *constraint = E;
-			if (constraint->get_island_step() == _step) {
-				continue;
-			}
-			constraint->set_island_step(_step);
-
-			// Each constraint can be on a separate island for areas as there's no solving phase.
-			++island_count;
-			if (constraint_islands.size() < island_count) {
-				constraint_islands.resize(island_count);
-			}
-			LocalVector<GodotConstraint2D *> &constraint_island = constraint_islands[island_count - 1];
-			constraint_island.clear();
-
-			all_constraints.push_back(constraint);
-			constraint_island.push_back(constraint);
-		}
-		p_space->area_remove_from_moved_list((SelfList<GodotArea2D> *)aml.first()); //faster to remove here
-	}
-
 	/* GENERATE CONSTRAINT ISLANDS FOR ACTIVE RIGID BODIES */
 
 	b = body_list->first();
@@ -216,7 +222,14 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 			constraint_island.clear();
 			constraint_island.reserve(ISLAND_SIZE_RESERVE);
 
-			_populate_island(body, body_island, constraint_island);
+			if (body->get_island() != -1) {
+				// The island didn't change since it was last built, no need to walk the constraint graph.
+				_restore_island(p_space->island_get(body->get_island()), body_island, constraint_island);
+			} else {
+				island_bodies.clear();
+				_populate_island(body, body_island, constraint_island);
+				_store_island(p_space, constraint_island);
+			}
 
 			if (body_island.is_empty()) {
 				--body_island_count;
@@ -229,6 +242,34 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 		b = b->next();
 	}
 
+	/* GENERATE CONSTRAINT ISLANDS FOR MOVING AREAS */
+
+	// Done after body islands, which already contain the area constraints of active bodies.
+
+	const SelfList<GodotArea2D>::List &aml = p_space->get_moved_area_list();
+
+	while (aml.first()) {
+		for (GodotConstraint2D *E : aml.first()->self()->get_constraints()) {
+			GodotConstraint2D *constraint = E;
+			if (constraint->get_island_step() == _step) {
+				continue;
+			}
+			constraint->set_island_step(_step);
+
+			// Each constraint can be on a separate island for areas as there's no solving phase.
+			++island_count;
+			if (constraint_islands.size() < island_count) {
+				constraint_islands.resize(island_count);
+			}
+			LocalVector<GodotConstraint2D *> &constraint_island = constraint_islands[island_count - 1];
+			constraint_island.clear();
+
+			all_constraints.push_back(constraint);
+			constraint_island.push_back(constraint);
+		}
+		p_space->area_remove_from_moved_list((SelfList<GodotArea2D> *)aml.first()); //faster to remove here
+	}
+
 	p_space->set_island_count((int)island_count);
 
 	{ //profile
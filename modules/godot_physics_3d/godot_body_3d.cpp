@@ -295,10 +295,30 @@ Variant GodotBody3D::get_param(PhysicsServer3D::BodyParameter p_param) const {
 	return 0;
 }
 
+void GodotBody3D::_island_changed() {
+	// The contact graph changed, the island will be rebuilt (merged or split) next time it's stepped.
+	get_space()->island_free(island);
+}
+
 void GodotBody3D::set_mode(PhysicsServer3D::BodyMode p_mode) {
 	PhysicsServer3D::BodyMode prev = mode;
 	mode = p_mode;
 
+	if (island != -1 && prev != mode) {
+		_island_changed();
+	}
+	if ((prev == PhysicsServer3D::BODY_MODE_STATIC) != (mode == PhysicsServer3D::BODY_MODE_STATIC)) {
+		// Static bodies don't connect islands, so the islands of the bodies touching this one merge or split.
+		for (const KeyValue<GodotConstraint3D *, int> &E : constraint_map) {
+			for (int i = 0; i < E.key->get_body_count(); i++) {
+				GodotBody3D *other_body = E.key->get_body_ptr()[i];
+				if (other_body != this && other_body->island != -1) {
+					other_body->_island_changed();
+				}
+			}
+		}
+	}
+
 	switch (p_mode) {
 		case PhysicsServer3D::BODY_MODE_STATIC:
 		case PhysicsServer3D::BODY_MODE_KINEMATIC: {
@@ -439,6 +459,9 @@ Variant GodotBody3D::get_state(PhysicsServer3D::BodyState p_state) const {
 
 void GodotBody3D::set_space(GodotSpace3D *p_space) {
 	if (get_space()) {
+		if (island != -1) {
+			_island_changed();
+		}
 		if (mass_properties_update_list.in_list()) {
 			get_space()->body_remove_from_mass_properties_update_list(&mass_properties_update_list);
 		}
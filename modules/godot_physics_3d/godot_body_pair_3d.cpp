@@ -30,6 +30,7 @@
 
 #include "godot_body_pair_3d.h"
 
+#include "godot_collision_batch_3d.h"
 #include "godot_collision_solver_3d.h"
 #include "godot_space_3d.h"
 
@@ -260,7 +261,23 @@ real_t combine_friction(GodotBody3D *A, GodotBody3D *B) {
 	return ABS(MIN(A->get_friction(), B->get_friction()));
 }
 
+void GodotBodyPair3D::add_to_collision_batch(GodotCollisionBatch3D &p_batch) {
+	const Vector3 &offset_A = A->get_transform().get_origin();
+	Transform3D xform_Au = Transform3D(A->get_transform().basis, Vector3());
+	Transform3D xform_A = xform_Au * A->get_shape_transform(shape_A);
+
+	Transform3D xform_Bu = B->get_transform();
+	xform_Bu.origin -= offset_A;
+	Transform3D xform_B = xform_Bu * B->get_shape_transform(shape_B);
+
+	collision_batch_slot = p_batch.add(A->get_shape(shape_A), xform_A, B->get_shape(shape_B), xform_B);
+	collision_batch = collision_batch_slot != -1 ? &p_batch : nullptr;
+}
+
 bool GodotBodyPair3D::setup(real_t p_step) {
+	const GodotCollisionBatch3D *batch = collision_batch;
+	collision_batch = nullptr;
+
 	check_ccd = false;
 
 	if (!A->interacts_with(B) || A->has_exception(B->get_self()) || B->has_exception(A->get_self())) {
@@ -296,7 +313,12 @@ bool GodotBodyPair3D::setup(real_t p_step) {
 	GodotShape3D *shape_A_ptr = A->get_shape(shape_A);
 	GodotShape3D *shape_B_ptr = B->get_shape(shape_B);
 
-	collided = GodotCollisionSolver3D::solve_static(shape_A_ptr, xform_A, shape_B_ptr, xform_B, _contact_added_callback, this, &sep_axis);
+	if (batch && batch->is_separated(collision_batch_slot)) {
+		// The exact solver would find no contacts either.
+		collided = false;
+	} else {
+		collided = GodotCollisionSolver3D::solve_static(shape_A_ptr, xform_A, shape_B_ptr, xform_B, _contact_added_callback, this, &sep_axis);
+	}
 
 	if (!collided) {
 		if (A->is_continuous_collision_detection_enabled() && collide_A) {
@@ -97,6 +97,10 @@ class GodotBodyPair3D : public GodotBodyContact3D {
 	Contact contacts[MAX_CONTACTS];
 	int contact_count = 0;
 
+	// Set when pretested in a batch, only valid until the following setup().
+	const GodotCollisionBatch3D *collision_batch = nullptr;
+	int collision_batch_slot = -1;
+
 	static void _contact_added_callback(const Vector3 &p_point_A, int p_index_A, const Vector3 &p_point_B, int p_index_B, const Vector3 &normal, void *p_userdata);
 
 	void contact_added_callback(const Vector3 &p_point_A, int p_index_A, const Vector3 &p_point_B, int p_index_B, const Vector3 &normal);
@@ -105,6 +109,7 @@ class GodotBodyPair3D : public GodotBodyContact3D {
 	bool _test_ccd(real_t p_step, GodotBody3D *p_A, int p_shape_A, const Transform3D &p_xform_A, GodotBody3D *p_B, int p_shape_B, const Transform3D &p_xform_B);
 
 public:
+	virtual void add_to_collision_batch(GodotCollisionBatch3D &p_batch) override;
 	virtual bool setup(real_t p_step) override;
 	virtual bool pre_solve(real_t p_step) override;
 	virtual void solve(real_t p_step) override;
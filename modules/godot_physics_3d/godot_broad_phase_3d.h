@@ -33,6 +33,7 @@
 
 #include "core/math/aabb.h"
 #include "core/math/math_funcs.h"
+#include "core/templates/local_vector.h"
 
 class GodotCollisionObject3D;
 
@@ -61,6 +62,10 @@ public:
 	virtual int cull_segment(const Vector3 &p_from, const Vector3 &p_to, GodotCollisionObject3D **p_results, int p_max_results, int *p_result_indices = nullptr) = 0;
 	virtual int cull_aabb(const AABB &p_aabb, GodotCollisionObject3D **p_results, int p_max_results, int *p_result_indices = nullptr) = 0;
 
+	// Can run on several threads at once while the broadphase isn't modified, r_hits is used as scratch storage.
+	virtual int cull_segment_concurrent(const Vector3 &p_from, const Vector3 &p_to, GodotCollisionObject3D **p_results, int p_max_results, LocalVector<uint32_t, uint32_t, true> &r_hits, int *p_result_indices = nullptr) = 0;
+	virtual int cull_aabb_concurrent(const AABB &p_aabb, GodotCollisionObject3D **p_results, int p_max_results, LocalVector<uint32_t, uint32_t, true> &r_hits, int *p_result_indices = nullptr) = 0;
+
 	virtual void set_pair_callback(PairCallback p_pair_callback, void *p_userdata) = 0;
 	virtual void set_unpair_callback(UnpairCallback p_unpair_callback, void *p_userdata) = 0;
 
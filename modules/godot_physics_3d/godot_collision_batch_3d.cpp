@@ -0,0 +1,237 @@
+/**************************************************************************/
+/*  godot_collision_batch_3d.cpp                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "godot_collision_batch_3d.h"
+
+// Gaps smaller than this are left to the exact solver.
+#define SEPARATION_TOLERANCE 0.001
+
+int GodotCollisionBatch3D::add(const GodotShape3D *p_shape_A, const Transform3D &p_transform_A, const GodotShape3D *p_shape_B, const Transform3D &p_transform_B) {
+	if (pair_count == MAX_PAIRS) {
+		return -1;
+	}
+
+	PhysicsServer3D::ShapeType type_A = p_shape_A->get_type();
+	PhysicsServer3D::ShapeType type_B = p_shape_B->get_type();
+
+	// The box goes last, so everything is expressed in its local space.
+	const GodotShape3D *shape = p_shape_A;
+	const GodotShape3D *box = p_shape_B;
+	const Transform3D *transform = &p_transform_A;
+	const Transform3D *box_transform = &p_transform_B;
+	if (type_B != PhysicsServer3D::SHAPE_BOX) {
+		SWAP(type_A, type_B);
+		SWAP(shape, box);
+		SWAP(transform, box_transform);
+	}
+	if (type_B != PhysicsServer3D::SHAPE_BOX) {
+		return -1;
+	}
+
+	PairType pair_type;
+	switch (type_A) {
+		case PhysicsServer3D::SHAPE_SPHERE: {
+			pair_type = PAIR_SPHERE_BOX;
+		} break;
+		case PhysicsServer3D::SHAPE_CAPSULE: {
+			pair_type = PAIR_CAPSULE_BOX;
+		} break;
+		case PhysicsServer3D::SHAPE_BOX: {
+			pair_type = PAIR_BOX_BOX;
+		} break;
+		default: {
+			return -1;
+		}
+	}
+
+	// Scaled or skewed shapes are left to the exact solver.
+	if (!transform->basis.is_orthonormal() || !box_transform->basis.is_orthonormal()) {
+		return -1;
+	}
+
+	Transform3D relative = box_transform->affine_inverse() * *transform;
+
+	Lanes &l = lanes[pair_type];
+	uint32_t i = l.count++;
+	uint32_t slot = pair_count++;
+	l.slot[i] = slot;
+	separated[slot] = false;
+
+	const Vector3 box_half_extents = static_cast<const GodotBoxShape3D *>(box)->get_half_extents();
+	l.box_x[i] = box_half_extents.x;
+	l.box_y[i] = box_half_extents.y;
+	l.box_z[i] = box_half_extents.z;
+
+	l.center_x[i] = relative.origin.x;
+	l.center_y[i] = relative.origin.y;
+	l.center_z[i] = relative.origin.z;
+	for (int row = 0; row < 3; row++) {
+		for (int column = 0; column < 3; column++) {
+			l.rot[row * 3 + column][i] = relative.basis.rows[row][column];
+		}
+	}
+
+	switch (pair_type) {
+		case PAIR_SPHERE_BOX: {
+			l.extent_x[i] = static_cast<const GodotSphereShape3D *>(shape)->get_radius();
+			l.extent_y[i] = 0;
+			l.extent_z[i] = 0;
+		} break;
+		case PAIR_CAPSULE_BOX: {
+			const GodotCapsuleShape3D *capsule = static_cast<const GodotCapsuleShape3D *>(shape);
+			l.extent_x[i] = capsule->get_radius();
+			l.extent_y[i] = MAX(capsule->get_height() * 0.5 - capsule->get_radius(), (real_t)0);
+			l.extent_z[i] = 0;
+		} break;
+		case PAIR_BOX_BOX: {
+			const Vector3 half_extents = static_cast<const GodotBoxShape3D *>(shape)->get_half_extents();
+			l.extent_x[i] = half_extents.x;
+			l.extent_y[i] = half_extents.y;
+			l.extent_z[i] = half_extents.z;
+		} break;
+		default: {
+		}
+	}
+
+	return slot;
+}
+
+void GodotCollisionBatch3D::_test_sphere_box(Lanes &p_lanes) {
+	for (uint32_t i = 0; i < p_lanes.count; i++) {
+		// Distance from the sphere center to the box.
+		real_t dx = MAX(Math::abs(p_lanes.center_x[i]) - p_lanes.box_x[i], (real_t)0);
+		real_t dy = MAX(Math::abs(p_lanes.center_y[i]) - p_lanes.box_y[i], (real_t)0);
+		real_t dz = MAX(Math::abs(p_lanes.center_z[i]) - p_lanes.box_z[i], (real_t)0);
+		real_t reach = p_lanes.extent_x[i] + (real_t)SEPARATION_TOLERANCE;
+		separated[p_lanes.slot[i]] = dx * dx + dy * dy + dz * dz > reach * reach;
+	}
+}
+
+void GodotCollisionBatch3D::_test_capsule_box(Lanes &p_lanes) {
+	for (uint32_t i = 0; i < p_lanes.count; i++) {
+		const real_t cx = p_lanes.center_x[i];
+		const real_t cy = p_lanes.center_y[i];
+		const real_t cz = p_lanes.center_z[i];
+		const real_t bx = p_lanes.box_x[i];
+		const real_t by = p_lanes.box_y[i];
+		const real_t bz = p_lanes.box_z[i];
+		const real_t radius = p_lanes.extent_x[i] + (real_t)SEPARATION_TOLERANCE;
+		const real_t half_segment = p_lanes.extent_y[i];
+
+		// Capsule axis (local Y) in box space.
+		const real_t ux = p_lanes.rot[1][i];
+		const real_t uy = p_lanes.rot[4][i];
+		const real_t uz = p_lanes.rot[7][i];
+		const real_t aux = Math::abs(ux);
+		const real_t auy = Math::abs(uy);
+		const real_t auz = Math::abs(uz);
+
+		bool sep = false;
+
+		// Box face normals.
+		sep |= Math::abs(cx) > bx + half_segment * aux + radius;
+		sep |= Math::abs(cy) > by + half_segment * auy + radius;
+		sep |= Math::abs(cz) > bz + half_segment * auz + radius;
+
+		// Capsule axis crossed with the box edges. The segment projects to a point on these.
+		// The axes are left unnormalized and the radius is scaled by their length instead. When the capsule
+		// is parallel to an edge the axis degenerates, so it's skipped like the exact solver does.
+		const real_t len_x = Math::sqrt(uy * uy + uz * uz);
+		const real_t len_y = Math::sqrt(ux * ux + uz * uz);
+		const real_t len_z = Math::sqrt(ux * ux + uy * uy);
+		sep |= (len_x > (real_t)CMP_EPSILON) & (Math::abs(cy * uz - cz * uy) > by * auz + bz * auy + radius * len_x);
+		sep |= (len_y > (real_t)CMP_EPSILON) & (Math::abs(cz * ux - cx * uz) > bx * auz + bz * aux + radius * len_y);
+		sep |= (len_z > (real_t)CMP_EPSILON) & (Math::abs(cx * uy - cy * ux) > bx * auy + by * aux + radius * len_z);
+
+		separated[p_lanes.slot[i]] = sep;
+	}
+}
+
+void GodotCollisionBatch3D::_test_box_box(Lanes &p_lanes) {
+	// Oriented box separating axis test over the 15 candidate axes.
+	for (uint32_t i = 0; i < p_lanes.count; i++) {
+		const real_t a0 = p_lanes.box_x[i];
+		const real_t a1 = p_lanes.box_y[i];
+		const real_t a2 = p_lanes.box_z[i];
+		const real_t b0 = p_lanes.extent_x[i];
+		const real_t b1 = p_lanes.extent_y[i];
+		const real_t b2 = p_lanes.extent_z[i];
+		const real_t t0 = p_lanes.center_x[i];
+		const real_t t1 = p_lanes.center_y[i];
+		const real_t t2 = p_lanes.center_z[i];
+
+		real_t r[3][3];
+		real_t ar[3][3];
+		for (int k = 0; k < 9; k++) {
+			r[k / 3][k % 3] = p_lanes.rot[k][i];
+			// Epsilon keeps near-parallel edges, whose cross product is degenerate, from reporting a separation.
+			ar[k / 3][k % 3] = Math::abs(r[k / 3][k % 3]) + (real_t)CMP_EPSILON;
+		}
+
+		const real_t tol = (real_t)SEPARATION_TOLERANCE;
+		bool sep = false;
+
+		// Faces of the reference box.
+		sep |= Math::abs(t0) > a0 + b0 * ar[0][0] + b1 * ar[0][1] + b2 * ar[0][2] + tol;
+		sep |= Math::abs(t1) > a1 + b0 * ar[1][0] + b1 * ar[1][1] + b2 * ar[1][2] + tol;
+		sep |= Math::abs(t2) > a2 + b0 * ar[2][0] + b1 * ar[2][1] + b2 * ar[2][2] + tol;
+
+		// Faces of the other box.
+		sep |= Math::abs(t0 * r[0][0] + t1 * r[1][0] + t2 * r[2][0]) > a0 * ar[0][0] + a1 * ar[1][0] + a2 * ar[2][0] + b0 + tol;
+		sep |= Math::abs(t0 * r[0][1] + t1 * r[1][1] + t2 * r[2][1]) > a0 * ar[0][1] + a1 * ar[1][1] + a2 * ar[2][1] + b1 + tol;
+		sep |= Math::abs(t0 * r[0][2] + t1 * r[1][2] + t2 * r[2][2]) > a0 * ar[0][2] + a1 * ar[1][2] + a2 * ar[2][2] + b2 + tol;
+
+		// Edge-edge cross products. These axes aren't normalized, which only makes the tolerance stricter.
+		sep |= Math::abs(t2 * r[1][0] - t1 * r[2][0]) > a1 * ar[2][0] + a2 * ar[1][0] + b1 * ar[0][2] + b2 * ar[0][1] + tol;
+		sep |= Math::abs(t2 * r[1][1] - t1 * r[2][1]) > a1 * ar[2][1] + a2 * ar[1][1] + b0 * ar[0][2] + b2 * ar[0][0] + tol;
+		sep |= Math::abs(t2 * r[1][2] - t1 * r[2][2]) > a1 * ar[2][2] + a2 * ar[1][2] + b0 * ar[0][1] + b1 * ar[0][0] + tol;
+		sep |= Math::abs(t0 * r[2][0] - t2 * r[0][0]) > a0 * ar[2][0] + a2 * ar[0][0] + b1 * ar[1][2] + b2 * ar[1][1] + tol;
+		sep |= Math::abs(t0 * r[2][1] - t2 * r[0][1]) > a0 * ar[2][1] + a2 * ar[0][1] + b0 * ar[1][2] + b2 * ar[1][0] + tol;
+		sep |= Math::abs(t0 * r[2][2] - t2 * r[0][2]) > a0 * ar[2][2] + a2 * ar[0][2] + b0 * ar[1][1] + b1 * ar[1][0] + tol;
+		sep |= Math::abs(t1 * r[0][0] - t0 * r[1][0]) > a0 * ar[1][0] + a1 * ar[0][0] + b1 * ar[2][2] + b2 * ar[2][1] + tol;
+		sep |= Math::abs(t1 * r[0][1] - t0 * r[1][1]) > a0 * ar[1][1] + a1 * ar[0][1] + b0 * ar[2][2] + b2 * ar[2][0] + tol;
+		sep |= Math::abs(t1 * r[0][2] - t0 * r[1][2]) > a0 * ar[1][2] + a1 * ar[0][2] + b0 * ar[2][1] + b1 * ar[2][0] + tol;
+
+		separated[p_lanes.slot[i]] = sep;
+	}
+}
+
+void GodotCollisionBatch3D::solve() {
+	_test_sphere_box(lanes[PAIR_SPHERE_BOX]);
+	_test_capsule_box(lanes[PAIR_CAPSULE_BOX]);
+	_test_box_box(lanes[PAIR_BOX_BOX]);
+}
+
+void GodotCollisionBatch3D::clear() {
+	for (int i = 0; i < PAIR_TYPE_MAX; i++) {
+		lanes[i].count = 0;
+	}
+	pair_count = 0;
+}
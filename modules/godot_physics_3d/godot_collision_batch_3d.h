@@ -0,0 +1,89 @@
+/**************************************************************************/
+/*  godot_collision_batch_3d.h                                            */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef GODOT_COLLISION_BATCH_3D_H
+#define GODOT_COLLISION_BATCH_3D_H
+
+#include "godot_shape_3d.h"
+
+// Batched separation pretest for the most common primitive pairs (sphere-box, capsule-box and box-box).
+// Pairs are gathered in structure-of-arrays form, expressed in the local space of the box,
+// and tested with branchless loops the compiler can vectorize over several pairs at once.
+// The test is conservative: a pair is only reported as separated when the exact solver would
+// find no contact either, so the regular solver remains the path for everything else.
+class GodotCollisionBatch3D {
+public:
+	static const uint32_t MAX_PAIRS = 64;
+
+private:
+	enum PairType {
+		PAIR_SPHERE_BOX,
+		PAIR_CAPSULE_BOX,
+		PAIR_BOX_BOX,
+		PAIR_TYPE_MAX
+	};
+
+	struct Lanes {
+		uint32_t count = 0;
+		uint32_t slot[MAX_PAIRS];
+		// Half extents of the box all the others are expressed relative to.
+		real_t box_x[MAX_PAIRS];
+		real_t box_y[MAX_PAIRS];
+		real_t box_z[MAX_PAIRS];
+		// Center and rotation (rows are box axes, columns are the other shape's axes) of the other shape.
+		real_t center_x[MAX_PAIRS];
+		real_t center_y[MAX_PAIRS];
+		real_t center_z[MAX_PAIRS];
+		real_t rot[9][MAX_PAIRS];
+		// Sphere: radius. Capsule: radius, half segment length. Box: half extents.
+		real_t extent_x[MAX_PAIRS];
+		real_t extent_y[MAX_PAIRS];
+		real_t extent_z[MAX_PAIRS];
+	};
+
+	Lanes lanes[PAIR_TYPE_MAX];
+	bool separated[MAX_PAIRS];
+	uint32_t pair_count = 0;
+
+	void _test_sphere_box(Lanes &p_lanes);
+	void _test_capsule_box(Lanes &p_lanes);
+	void _test_box_box(Lanes &p_lanes);
+
+public:
+	// Returns the slot of the pair, or -1 if it's not a supported pair (or the batch is full).
+	int add(const GodotShape3D *p_shape_A, const Transform3D &p_transform_A, const GodotShape3D *p_shape_B, const Transform3D &p_transform_B);
+	void solve();
+
+	_FORCE_INLINE_ bool is_separated(int p_slot) const { return separated[p_slot]; }
+	_FORCE_INLINE_ uint32_t get_pair_count() const { return pair_count; }
+	void clear();
+};
+
+#endif // GODOT_COLLISION_BATCH_3D_H
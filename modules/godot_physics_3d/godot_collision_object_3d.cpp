@@ -106,6 +106,15 @@ void GodotCollisionObject3D::remove_shape(GodotShape3D *p_shape) {
 	}
 }
 
+void GodotCollisionObject3D::replace_shape(GodotShape3D *p_shape, GodotShape3D *p_with_shape) {
+	//replace a shape, all the times it appears
+	for (int i = 0; i < shapes.size(); i++) {
+		if (shapes[i].shape == p_shape) {
+			set_shape(i, p_with_shape);
+		}
+	}
+}
+
 void GodotCollisionObject3D::remove_shape(int p_index) {
 	//remove anything from shape to be erased to end, so subindices don't change
 	ERR_FAIL_INDEX(p_index, shapes.size());
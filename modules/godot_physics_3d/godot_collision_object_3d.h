@@ -183,6 +183,7 @@ public:
 
 	void remove_shape(GodotShape3D *p_shape) override;
 	void remove_shape(int p_index);
+	void replace_shape(GodotShape3D *p_shape, GodotShape3D *p_with_shape) override;
 
 	virtual void set_space(GodotSpace3D *p_space) = 0;
 
@@ -33,6 +33,7 @@
 
 class GodotBody3D;
 class GodotSoftBody3D;
+class GodotCollisionBatch3D;
 
 class GodotConstraint3D {
 	GodotBody3D **_body_ptr;
@@ -71,6 +72,9 @@ public:
 	_FORCE_INLINE_ void disable_collisions_between_bodies(const bool p_disabled) { disabled_collisions_between_bodies = p_disabled; }
 	_FORCE_INLINE_ bool is_disabled_collisions_between_bodies() const { return disabled_collisions_between_bodies; }
 
+	// Lets the constraint take part in a batched narrowphase pretest, done right before setup().
+	virtual void add_to_collision_batch(GodotCollisionBatch3D &p_batch) {}
+
 	virtual bool setup(real_t p_step) = 0;
 	virtual bool pre_solve(real_t p_step) = 0;
 	virtual void solve(real_t p_step) = 0;
@@ -38,7 +38,9 @@
 #include "joints/godot_pin_joint_3d.h"
 #include "joints/godot_slider_joint_3d.h"
 
+#include "core/config/project_settings.h"
 #include "core/debugger/engine_debugger.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
 
 #define FLUSH_QUERY_CHECK(m_object) \
@@ -102,10 +104,57 @@ RID GodotPhysicsServer3D::custom_shape_create() {
 	ERR_FAIL_V(RID());
 }
 
+static GodotShape3D *_create_shape_of_type(PhysicsServer3D::ShapeType p_type) {
+	switch (p_type) {
+		case PhysicsServer3D::SHAPE_WORLD_BOUNDARY:
+			return memnew(GodotWorldBoundaryShape3D);
+		case PhysicsServer3D::SHAPE_SEPARATION_RAY:
+			return memnew(GodotSeparationRayShape3D);
+		case PhysicsServer3D::SHAPE_SPHERE:
+			return memnew(GodotSphereShape3D);
+		case PhysicsServer3D::SHAPE_BOX:
+			return memnew(GodotBoxShape3D);
+		case PhysicsServer3D::SHAPE_CAPSULE:
+			return memnew(GodotCapsuleShape3D);
+		case PhysicsServer3D::SHAPE_CYLINDER:
+			return memnew(GodotCylinderShape3D);
+		case PhysicsServer3D::SHAPE_CONVEX_POLYGON:
+			return memnew(GodotConvexPolygonShape3D);
+		case PhysicsServer3D::SHAPE_CONCAVE_POLYGON:
+			return memnew(GodotConcavePolygonShape3D);
+		case PhysicsServer3D::SHAPE_HEIGHTMAP:
+			return memnew(GodotHeightMapShape3D);
+		default:
+			return nullptr;
+	}
+}
+
 void GodotPhysicsServer3D::shape_set_data(RID p_shape, const Variant &p_data) {
 	GodotShape3D *shape = shape_owner.get_or_null(p_shape);
 	ERR_FAIL_NULL(shape);
-	shape->set_data(p_data);
+
+	if (snapshot_spaces.is_empty() && snapshot_retired_states.is_empty()) {
+		shape->set_data(p_data);
+		return;
+	}
+
+	// Snapshots may be reading the shape from other threads, so it can't change in place.
+	// A new shape takes its place for the RID and its owners, and the old one is deleted once no snapshot can use it.
+	GodotShape3D *new_shape = _create_shape_of_type(shape->get_type());
+	ERR_FAIL_NULL(new_shape);
+	new_shape->set_self(p_shape);
+	new_shape->set_custom_bias(shape->get_custom_bias());
+	shape_owner.replace(p_shape, new_shape);
+
+	while (shape->get_owners().size()) {
+		GodotShapeOwner3D *so = shape->get_owners().begin()->key;
+		so->replace_shape(shape, new_shape);
+	}
+
+	snapshot_pending_shape_frees.push_back({ shape, snapshot_serial });
+
+	// Owners are notified of the new data like when it's set in place.
+	new_shape->set_data(p_data);
 };
 
 void GodotPhysicsServer3D::shape_set_custom_solver_bias(RID p_shape, real_t p_bias) {
@@ -164,6 +213,7 @@ void GodotPhysicsServer3D::space_set_active(RID p_space, bool p_active) {
 	if (p_active) {
 		active_spaces.insert(space);
 	} else {
+		// Stays in the snapshot spaces: queries may still read its last snapshot.
 		active_spaces.erase(space);
 	}
 }
@@ -196,6 +246,16 @@ PhysicsDirectSpaceState3D *GodotPhysicsServer3D::space_get_direct_state(RID p_sp
 	return space->get_direct_state();
 }
 
+PhysicsDirectSpaceState3D *GodotPhysicsServer3D::space_get_snapshot_state(RID p_space) {
+	GodotSpace3D *space = space_owner.get_or_null(p_space);
+	ERR_FAIL_NULL_V(space, nullptr);
+
+	// Can be called from any thread, the physics thread starts publishing snapshots after its next step.
+	GodotPhysicsDirectSpaceSnapshotState3D *snapshot_state = space->get_snapshot_state();
+	snapshot_state->enable();
+	return snapshot_state;
+}
+
 void GodotPhysicsServer3D::space_set_debug_contacts(RID p_space, int p_max_contacts) {
 	GodotSpace3D *space = space_owner.get_or_null(p_space);
 	ERR_FAIL_NULL(space);
@@ -1565,7 +1625,12 @@ void GodotPhysicsServer3D::free(RID p_rid) {
 		}
 
 		shape_owner.free(p_rid);
-		memdelete(shape);
+		if (snapshot_spaces.is_empty() && snapshot_retired_states.is_empty()) {
+			memdelete(shape);
+		} else {
+			// Snapshots may still be read from other threads, the shape is deleted once none of them can use it.
+			snapshot_pending_shape_frees.push_back({ shape, snapshot_serial });
+		}
 	} else if (body_owner.owns(p_rid)) {
 		GodotBody3D *body = body_owner.get_or_null(p_rid);
 
@@ -1607,6 +1672,14 @@ void GodotPhysicsServer3D::free(RID p_rid) {
 		free(space->get_default_area()->get_self());
 		free(space->get_static_global_body());
 
+		if (snapshot_spaces.has(space)) {
+			// Other threads may be querying a snapshot right now, the state is deleted once they are done.
+			snapshot_spaces.erase(space);
+			GodotPhysicsDirectSpaceSnapshotState3D *snapshot_state = space->detach_snapshot_state();
+			snapshot_state->retire();
+			snapshot_retired_states.push_back(snapshot_state);
+		}
+
 		space_owner.free(p_rid);
 		memdelete(space);
 	} else if (joint_owner.owns(p_rid)) {
@@ -1626,6 +1699,11 @@ void GodotPhysicsServer3D::set_active(bool p_active) {
 
 void GodotPhysicsServer3D::init() {
 	stepper = memnew(GodotStep3D);
+	step_spaces_in_parallel = GLOBAL_GET("physics/3d/step_spaces_in_parallel");
+}
+
+void GodotPhysicsServer3D::_step_space(uint32_t p_index, real_t p_step) {
+	space_steppers[p_index]->step(spaces_to_step[p_index], p_step);
 }
 
 void GodotPhysicsServer3D::step(real_t p_step) {
@@ -1638,12 +1716,80 @@ void GodotPhysicsServer3D::step(real_t p_step) {
 	island_count = 0;
 	active_objects = 0;
 	collision_pairs = 0;
+
+	if (step_spaces_in_parallel && active_spaces.size() > 1) {
+		// Spaces don't share bodies, areas or joints, so they can be stepped independently.
+		// Each one gets its own stepper, which runs its stages inline on the pool thread stepping it.
+		spaces_to_step.clear();
+		for (const GodotSpace3D *E : active_spaces) {
+			spaces_to_step.push_back(const_cast<GodotSpace3D *>(E));
+		}
+		while (space_steppers.size() < spaces_to_step.size()) {
+			GodotStep3D *space_stepper = memnew(GodotStep3D);
+			space_stepper->set_use_thread_pool(false);
+			space_steppers.push_back(space_stepper);
+		}
+
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotPhysicsServer3D::_step_space, p_step, spaces_to_step.size(), -1, true, SNAME("Physics3DStepSpaces"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+		for (const GodotSpace3D *E : spaces_to_step) {
+			island_count += E->get_island_count();
+			active_objects += E->get_active_objects();
+			collision_pairs += E->get_collision_pairs();
+		}
+
+		_publish_snapshots();
+		return;
+	}
+
 	for (const GodotSpace3D *E : active_spaces) {
 		stepper->step(const_cast<GodotSpace3D *>(E), p_step);
 		island_count += E->get_island_count();
 		active_objects += E->get_active_objects();
 		collision_pairs += E->get_collision_pairs();
 	}
+
+	_publish_snapshots();
+}
+
+void GodotPhysicsServer3D::_publish_snapshots() {
+	for (const GodotSpace3D *E : active_spaces) {
+		GodotSpace3D *space = const_cast<GodotSpace3D *>(E);
+		if (space->get_snapshot_state()->is_enabled()) {
+			snapshot_spaces.insert(space);
+			space->get_snapshot_state()->publish(++snapshot_serial);
+		}
+	}
+
+	uint64_t oldest_serial = UINT64_MAX;
+	for (uint32_t i = 0; i < snapshot_retired_states.size();) {
+		uint64_t state_oldest_serial = snapshot_retired_states[i]->get_oldest_serial_in_use();
+		if (state_oldest_serial == UINT64_MAX) {
+			memdelete(snapshot_retired_states[i]);
+			snapshot_retired_states.remove_at_unordered(i);
+		} else {
+			oldest_serial = MIN(oldest_serial, state_oldest_serial);
+			i++;
+		}
+	}
+
+	if (snapshot_pending_shape_frees.is_empty()) {
+		return;
+	}
+
+	for (GodotSpace3D *space : snapshot_spaces) {
+		oldest_serial = MIN(oldest_serial, space->get_snapshot_state()->get_oldest_serial_in_use());
+	}
+
+	for (uint32_t i = 0; i < snapshot_pending_shape_frees.size();) {
+		if (snapshot_pending_shape_frees[i].serial < oldest_serial) {
+			memdelete(snapshot_pending_shape_frees[i].shape);
+			snapshot_pending_shape_frees.remove_at_unordered(i);
+		} else {
+			i++;
+		}
+	}
 }
 
 void GodotPhysicsServer3D::sync() {
@@ -1706,6 +1852,19 @@ void GodotPhysicsServer3D::end_sync() {
 
 void GodotPhysicsServer3D::finish() {
 	memdelete(stepper);
+	for (GodotStep3D *space_stepper : space_steppers) {
+		memdelete(space_stepper);
+	}
+	space_steppers.clear();
+
+	for (GodotPhysicsDirectSpaceSnapshotState3D *E : snapshot_retired_states) {
+		memdelete(E);
+	}
+	snapshot_retired_states.clear();
+	for (const SnapshotPendingShapeFree &E : snapshot_pending_shape_frees) {
+		memdelete(E.shape);
+	}
+	snapshot_pending_shape_frees.clear();
 }
 
 int GodotPhysicsServer3D::get_process_info(ProcessInfo p_info) {
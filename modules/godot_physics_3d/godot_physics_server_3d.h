@@ -43,6 +43,8 @@ class GodotPhysicsServer3D : public PhysicsServer3D {
 	GDCLASS(GodotPhysicsServer3D, PhysicsServer3D);
 
 	friend class GodotPhysicsDirectSpaceState3D;
+	friend class GodotPhysicsDirectSpaceSnapshotState3D;
+	friend class TestGodotPhysicsServer3DInternalsAccessor;
 	bool active = true;
 
 	int island_count = 0;
@@ -56,6 +58,24 @@ class GodotPhysicsServer3D : public PhysicsServer3D {
 	GodotStep3D *stepper = nullptr;
 	HashSet<const GodotSpace3D *> active_spaces;
 
+	// Stepping independent spaces concurrently, one space per pool task.
+	bool step_spaces_in_parallel = false;
+	LocalVector<GodotStep3D *> space_steppers;
+	LocalVector<GodotSpace3D *> spaces_to_step;
+	void _step_space(uint32_t p_index, real_t p_step);
+
+	// Spaces publishing snapshots for queries from other threads, and shapes freed while a snapshot may still read them.
+	// Snapshot states of freed spaces are kept until no query uses them anymore.
+	struct SnapshotPendingShapeFree {
+		GodotShape3D *shape = nullptr;
+		uint64_t serial = 0;
+	};
+	HashSet<GodotSpace3D *> snapshot_spaces;
+	LocalVector<GodotPhysicsDirectSpaceSnapshotState3D *> snapshot_retired_states;
+	LocalVector<SnapshotPendingShapeFree> snapshot_pending_shape_frees;
+	uint64_t snapshot_serial = 0;
+	void _publish_snapshots();
+
 	mutable RID_PtrOwner<GodotShape3D, true> shape_owner;
 	mutable RID_PtrOwner<GodotSpace3D, true> space_owner;
 	mutable RID_PtrOwner<GodotArea3D, true> area_owner;
@@ -112,6 +132,7 @@ public:
 
 	// this function only works on physics process, errors and returns null otherwise
 	virtual PhysicsDirectSpaceState3D *space_get_direct_state(RID p_space) override;
+	virtual PhysicsDirectSpaceState3D *space_get_snapshot_state(RID p_space) override;
 
 	virtual void space_set_debug_contacts(RID p_space, int p_max_contacts) override;
 	virtual Vector<Vector3> space_get_contacts(RID p_space) const override;
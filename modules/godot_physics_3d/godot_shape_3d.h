@@ -41,6 +41,7 @@ class GodotShapeOwner3D {
 public:
 	virtual void _shape_changed() = 0;
 	virtual void remove_shape(GodotShape3D *p_shape) = 0;
+	virtual void replace_shape(GodotShape3D *p_shape, GodotShape3D *p_with_shape) = 0;
 
 	virtual ~GodotShapeOwner3D() {}
 };
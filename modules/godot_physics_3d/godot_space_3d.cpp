@@ -34,6 +34,7 @@
 #include "godot_physics_server_3d.h"
 
 #include "core/config/project_settings.h"
+#include "core/object/worker_thread_pool.h"
 
 #define TEST_MOTION_MARGIN_MIN_VALUE 0.0001
 #define TEST_MOTION_MIN_CONTACT_DEPTH_FACTOR 0.05
@@ -105,16 +106,22 @@ int GodotPhysicsDirectSpaceState3D::intersect_point(const PointParameters &p_par
 	return cc;
 }
 
-bool GodotPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_parameters, RayResult &r_result) {
-	ERR_FAIL_COND_V(space->locked, false);
-
+bool GodotPhysicsDirectSpaceState3D::_intersect_ray(const RayParameters &p_parameters, const Vector3 &p_from, const Vector3 &p_to, RayResult &r_result, const QueryBuffers &p_buffers) {
 	Vector3 begin, end;
 	Vector3 normal;
-	begin = p_parameters.from;
-	end = p_parameters.to;
+	begin = p_from;
+	end = p_to;
 	normal = (end - begin).normalized();
 
-	int amount = space->broadphase->cull_segment(begin, end, space->intersection_query_results, GodotSpace3D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+	GodotCollisionObject3D **query_results = p_buffers.results;
+	int *query_subindex_results = p_buffers.subindex_results;
+
+	int amount;
+	if (p_buffers.hits) {
+		amount = space->broadphase->cull_segment_concurrent(begin, end, query_results, GodotSpace3D::INTERSECTION_QUERY_MAX, *p_buffers.hits, query_subindex_results);
+	} else {
+		amount = space->broadphase->cull_segment(begin, end, query_results, GodotSpace3D::INTERSECTION_QUERY_MAX, query_subindex_results);
+	}
 
 	//todo, create another array that references results, compute AABBs and check closest point to ray origin, sort, and stop evaluating results when beyond first collision
 
@@ -126,21 +133,21 @@ bool GodotPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_parame
 	real_t min_d = 1e10;
 
 	for (int i = 0; i < amount; i++) {
-		if (!_can_collide_with(space->intersection_query_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
+		if (!_can_collide_with(query_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
 			continue;
 		}
 
-		if (p_parameters.pick_ray && !(space->intersection_query_results[i]->is_ray_pickable())) {
+		if (p_parameters.pick_ray && !(query_results[i]->is_ray_pickable())) {
 			continue;
 		}
 
-		if (p_parameters.exclude.has(space->intersection_query_results[i]->get_self())) {
+		if (p_parameters.exclude.has(query_results[i]->get_self())) {
 			continue;
 		}
 
-		const GodotCollisionObject3D *col_obj = space->intersection_query_results[i];
+		const GodotCollisionObject3D *col_obj = query_results[i];
 
-		int shape_idx = space->intersection_query_subindex_results[i];
+		int shape_idx = query_subindex_results[i];
 		Transform3D inv_xform = col_obj->get_shape_inv_transform(shape_idx) * col_obj->get_inv_transform();
 
 		Vector3 local_from = inv_xform.xform(begin);
@@ -205,17 +212,81 @@ bool GodotPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_parame
 	return true;
 }
 
-int GodotPhysicsDirectSpaceState3D::intersect_shape(const ShapeParameters &p_parameters, ShapeResult *r_results, int p_result_max) {
-	if (p_result_max <= 0) {
+bool GodotPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_parameters, RayResult &r_result) {
+	ERR_FAIL_COND_V(space->locked, false);
+
+	QueryBuffers buffers;
+	buffers.results = space->intersection_query_results;
+	buffers.subindex_results = space->intersection_query_subindex_results;
+
+	return _intersect_ray(p_parameters, p_parameters.from, p_parameters.to, r_result, buffers);
+}
+
+void GodotPhysicsDirectSpaceState3D::_intersect_ray_batch(uint32_t p_chunk, RayBatch *p_batch) {
+	int from = p_chunk * BATCH_QUERY_CHUNK_SIZE;
+	int to = MIN(from + BATCH_QUERY_CHUNK_SIZE, p_batch->count);
+
+	LocalVector<GodotCollisionObject3D *> query_results;
+	query_results.resize(GodotSpace3D::INTERSECTION_QUERY_MAX);
+	LocalVector<int> query_subindex_results;
+	query_subindex_results.resize(GodotSpace3D::INTERSECTION_QUERY_MAX);
+	LocalVector<uint32_t, uint32_t, true> hits;
+
+	QueryBuffers buffers;
+	buffers.results = query_results.ptr();
+	buffers.subindex_results = query_subindex_results.ptr();
+	buffers.hits = &hits;
+
+	for (int i = from; i < to; i++) {
+		p_batch->collided[i] = _intersect_ray(*p_batch->parameters, p_batch->from[i], p_batch->to[i], p_batch->results[i], buffers);
+	}
+}
+
+int GodotPhysicsDirectSpaceState3D::intersect_rays(const RayParameters &p_parameters, const Vector3 *p_from, const Vector3 *p_to, int p_count, RayResult *r_results, bool *r_collided) {
+	ERR_FAIL_COND_V(space->locked, 0);
+	if (p_count <= 0) {
 		return 0;
 	}
 
-	GodotShape3D *shape = GodotPhysicsServer3D::godot_singleton->shape_owner.get_or_null(p_parameters.shape_rid);
-	ERR_FAIL_NULL_V(shape, 0);
+	RayBatch batch;
+	batch.parameters = &p_parameters;
+	batch.from = p_from;
+	batch.to = p_to;
+	batch.results = r_results;
+	batch.collided = r_collided;
+	batch.count = p_count;
+
+	uint32_t chunk_count = (p_count + BATCH_QUERY_CHUNK_SIZE - 1) / BATCH_QUERY_CHUNK_SIZE;
+	if (chunk_count > 1 && WorkerThreadPool::get_thread_index() == -1) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotPhysicsDirectSpaceState3D::_intersect_ray_batch, &batch, chunk_count, -1, true, SNAME("Physics3DIntersectRays"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		for (uint32_t chunk = 0; chunk < chunk_count; chunk++) {
+			_intersect_ray_batch(chunk, &batch);
+		}
+	}
 
-	AABB aabb = p_parameters.transform.xform(shape->get_aabb());
+	int collided_count = 0;
+	for (int i = 0; i < p_count; i++) {
+		if (r_collided[i]) {
+			collided_count++;
+		}
+	}
+	return collided_count;
+}
 
-	int amount = space->broadphase->cull_aabb(aabb, space->intersection_query_results, GodotSpace3D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+int GodotPhysicsDirectSpaceState3D::_intersect_shape(const ShapeParameters &p_parameters, GodotShape3D *p_shape, const Transform3D &p_transform, ShapeResult *r_results, int p_result_max, const QueryBuffers &p_buffers) {
+	AABB aabb = p_transform.xform(p_shape->get_aabb());
+
+	GodotCollisionObject3D **query_results = p_buffers.results;
+	int *query_subindex_results = p_buffers.subindex_results;
+
+	int amount;
+	if (p_buffers.hits) {
+		amount = space->broadphase->cull_aabb_concurrent(aabb, query_results, GodotSpace3D::INTERSECTION_QUERY_MAX, *p_buffers.hits, query_subindex_results);
+	} else {
+		amount = space->broadphase->cull_aabb(aabb, query_results, GodotSpace3D::INTERSECTION_QUERY_MAX, query_subindex_results);
+	}
 
 	int cc = 0;
 
@@ -226,20 +297,20 @@ int GodotPhysicsDirectSpaceState3D::intersect_shape(const ShapeParameters &p_par
 			break;
 		}
 
-		if (!_can_collide_with(space->intersection_query_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
+		if (!_can_collide_with(query_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
 			continue;
 		}
 
 		//area can't be picked by ray (default)
 
-		if (p_parameters.exclude.has(space->intersection_query_results[i]->get_self())) {
+		if (p_parameters.exclude.has(query_results[i]->get_self())) {
 			continue;
 		}
 
-		const GodotCollisionObject3D *col_obj = space->intersection_query_results[i];
-		int shape_idx = space->intersection_query_subindex_results[i];
+		const GodotCollisionObject3D *col_obj = query_results[i];
+		int shape_idx = query_subindex_results[i];
 
-		if (!GodotCollisionSolver3D::solve_static(shape, p_parameters.transform, col_obj->get_shape(shape_idx), col_obj->get_transform() * col_obj->get_shape_transform(shape_idx), nullptr, nullptr, nullptr, p_parameters.margin, 0)) {
+		if (!GodotCollisionSolver3D::solve_static(p_shape, p_transform, col_obj->get_shape(shape_idx), col_obj->get_transform() * col_obj->get_shape_transform(shape_idx), nullptr, nullptr, nullptr, p_parameters.margin, 0)) {
 			continue;
 		}
 
@@ -260,55 +331,138 @@ int GodotPhysicsDirectSpaceState3D::intersect_shape(const ShapeParameters &p_par
 	return cc;
 }
 
-bool GodotPhysicsDirectSpaceState3D::cast_motion(const ShapeParameters &p_parameters, real_t &p_closest_safe, real_t &p_closest_unsafe, ShapeRestInfo *r_info) {
+int GodotPhysicsDirectSpaceState3D::intersect_shape(const ShapeParameters &p_parameters, ShapeResult *r_results, int p_result_max) {
+	if (p_result_max <= 0) {
+		return 0;
+	}
+
 	GodotShape3D *shape = GodotPhysicsServer3D::godot_singleton->shape_owner.get_or_null(p_parameters.shape_rid);
-	ERR_FAIL_NULL_V(shape, false);
+	ERR_FAIL_NULL_V(shape, 0);
 
-	AABB aabb = p_parameters.transform.xform(shape->get_aabb());
-	aabb = aabb.merge(AABB(aabb.position + p_parameters.motion, aabb.size)); //motion
+	QueryBuffers buffers;
+	buffers.results = space->intersection_query_results;
+	buffers.subindex_results = space->intersection_query_subindex_results;
+
+	return _intersect_shape(p_parameters, shape, p_parameters.transform, r_results, p_result_max, buffers);
+}
+
+void GodotPhysicsDirectSpaceState3D::_intersect_shape_batch(uint32_t p_chunk, ShapeBatch *p_batch) {
+	int from = p_chunk * BATCH_QUERY_CHUNK_SIZE;
+	int to = MIN(from + BATCH_QUERY_CHUNK_SIZE, p_batch->count);
+
+	LocalVector<GodotCollisionObject3D *> query_results;
+	query_results.resize(GodotSpace3D::INTERSECTION_QUERY_MAX);
+	LocalVector<int> query_subindex_results;
+	query_subindex_results.resize(GodotSpace3D::INTERSECTION_QUERY_MAX);
+	LocalVector<uint32_t, uint32_t, true> hits;
+
+	QueryBuffers buffers;
+	buffers.results = query_results.ptr();
+	buffers.subindex_results = query_subindex_results.ptr();
+	buffers.hits = &hits;
+
+	Transform3D transform = p_batch->parameters->transform;
+	for (int i = from; i < to; i++) {
+		transform.origin = p_batch->origins[i];
+		p_batch->result_counts[i] = _intersect_shape(*p_batch->parameters, p_batch->shape, transform, p_batch->results + i * p_batch->result_max, p_batch->result_max, buffers);
+	}
+}
+
+int GodotPhysicsDirectSpaceState3D::intersect_shapes(const ShapeParameters &p_parameters, const Vector3 *p_origins, int p_count, ShapeResult *r_results, int p_result_max, int *r_result_counts) {
+	ERR_FAIL_COND_V(space->locked, 0);
+	if (p_count <= 0) {
+		return 0;
+	}
+	if (p_result_max <= 0) {
+		for (int i = 0; i < p_count; i++) {
+			r_result_counts[i] = 0;
+		}
+		return 0;
+	}
+
+	GodotShape3D *shape = GodotPhysicsServer3D::godot_singleton->shape_owner.get_or_null(p_parameters.shape_rid);
+	ERR_FAIL_NULL_V(shape, 0);
+
+	ShapeBatch batch;
+	batch.parameters = &p_parameters;
+	batch.shape = shape;
+	batch.origins = p_origins;
+	batch.results = r_results;
+	batch.result_max = p_result_max;
+	batch.result_counts = r_result_counts;
+	batch.count = p_count;
+
+	uint32_t chunk_count = (p_count + BATCH_QUERY_CHUNK_SIZE - 1) / BATCH_QUERY_CHUNK_SIZE;
+	if (chunk_count > 1 && WorkerThreadPool::get_thread_index() == -1) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotPhysicsDirectSpaceState3D::_intersect_shape_batch, &batch, chunk_count, -1, true, SNAME("Physics3DIntersectShapes"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		for (uint32_t chunk = 0; chunk < chunk_count; chunk++) {
+			_intersect_shape_batch(chunk, &batch);
+		}
+	}
+
+	int result_count = 0;
+	for (int i = 0; i < p_count; i++) {
+		result_count += r_result_counts[i];
+	}
+	return result_count;
+}
+
+void GodotPhysicsDirectSpaceState3D::_cast_motion(const ShapeParameters &p_parameters, GodotShape3D *p_shape, const Transform3D &p_transform, const Vector3 &p_motion, real_t &p_closest_safe, real_t &p_closest_unsafe, ShapeRestInfo *r_info, const QueryBuffers &p_buffers) {
+	AABB aabb = p_transform.xform(p_shape->get_aabb());
+	aabb = aabb.merge(AABB(aabb.position + p_motion, aabb.size)); //motion
 	aabb = aabb.grow(p_parameters.margin);
 
-	int amount = space->broadphase->cull_aabb(aabb, space->intersection_query_results, GodotSpace3D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+	GodotCollisionObject3D **query_results = p_buffers.results;
+	int *query_subindex_results = p_buffers.subindex_results;
+
+	int amount;
+	if (p_buffers.hits) {
+		amount = space->broadphase->cull_aabb_concurrent(aabb, query_results, GodotSpace3D::INTERSECTION_QUERY_MAX, *p_buffers.hits, query_subindex_results);
+	} else {
+		amount = space->broadphase->cull_aabb(aabb, query_results, GodotSpace3D::INTERSECTION_QUERY_MAX, query_subindex_results);
+	}
 
 	real_t best_safe = 1;
 	real_t best_unsafe = 1;
 
-	Transform3D xform_inv = p_parameters.transform.affine_inverse();
+	Transform3D xform_inv = p_transform.affine_inverse();
 	GodotMotionShape3D mshape;
-	mshape.shape = shape;
-	mshape.motion = xform_inv.basis.xform(p_parameters.motion);
+	mshape.shape = p_shape;
+	mshape.motion = xform_inv.basis.xform(p_motion);
 
 	bool best_first = true;
 
-	Vector3 motion_normal = p_parameters.motion.normalized();
+	Vector3 motion_normal = p_motion.normalized();
 
 	Vector3 closest_A, closest_B;
 
 	for (int i = 0; i < amount; i++) {
-		if (!_can_collide_with(space->intersection_query_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
+		if (!_can_collide_with(query_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
 			continue;
 		}
 
-		if (p_parameters.exclude.has(space->intersection_query_results[i]->get_self())) {
+		if (p_parameters.exclude.has(query_results[i]->get_self())) {
 			continue; //ignore excluded
 		}
 
-		const GodotCollisionObject3D *col_obj = space->intersection_query_results[i];
-		int shape_idx = space->intersection_query_subindex_results[i];
+		const GodotCollisionObject3D *col_obj = query_results[i];
+		int shape_idx = query_subindex_results[i];
 
 		Vector3 point_A, point_B;
 		Vector3 sep_axis = motion_normal;
 
 		Transform3D col_obj_xform = col_obj->get_transform() * col_obj->get_shape_transform(shape_idx);
 		//test initial overlap, does it collide if going all the way?
-		if (GodotCollisionSolver3D::solve_distance(&mshape, p_parameters.transform, col_obj->get_shape(shape_idx), col_obj_xform, point_A, point_B, aabb, &sep_axis)) {
+		if (GodotCollisionSolver3D::solve_distance(&mshape, p_transform, col_obj->get_shape(shape_idx), col_obj_xform, point_A, point_B, aabb, &sep_axis)) {
 			continue;
 		}
 
 		//test initial overlap, ignore objects it's inside of.
 		sep_axis = motion_normal;
 
-		if (!GodotCollisionSolver3D::solve_distance(shape, p_parameters.transform, col_obj->get_shape(shape_idx), col_obj_xform, point_A, point_B, aabb, &sep_axis)) {
+		if (!GodotCollisionSolver3D::solve_distance(p_shape, p_transform, col_obj->get_shape(shape_idx), col_obj_xform, point_A, point_B, aabb, &sep_axis)) {
 			continue;
 		}
 
@@ -319,11 +473,11 @@ bool GodotPhysicsDirectSpaceState3D::cast_motion(const ShapeParameters &p_parame
 		for (int j = 0; j < 8; j++) { //steps should be customizable..
 			real_t fraction = low + (hi - low) * fraction_coeff;
 
-			mshape.motion = xform_inv.basis.xform(p_parameters.motion * fraction);
+			mshape.motion = xform_inv.basis.xform(p_motion * fraction);
 
 			Vector3 lA, lB;
 			Vector3 sep = motion_normal; //important optimization for this to work fast enough
-			bool collided = !GodotCollisionSolver3D::solve_distance(&mshape, p_parameters.transform, col_obj->get_shape(shape_idx), col_obj_xform, lA, lB, aabb, &sep);
+			bool collided = !GodotCollisionSolver3D::solve_distance(&mshape, p_transform, col_obj->get_shape(shape_idx), col_obj_xform, lA, lB, aabb, &sep);
 
 			if (collided) {
 				hi = fraction;
@@ -375,6 +529,68 @@ bool GodotPhysicsDirectSpaceState3D::cast_motion(const ShapeParameters &p_parame
 
 	p_closest_safe = best_safe;
 	p_closest_unsafe = best_unsafe;
+}
+
+bool GodotPhysicsDirectSpaceState3D::cast_motion(const ShapeParameters &p_parameters, real_t &p_closest_safe, real_t &p_closest_unsafe, ShapeRestInfo *r_info) {
+	GodotShape3D *shape = GodotPhysicsServer3D::godot_singleton->shape_owner.get_or_null(p_parameters.shape_rid);
+	ERR_FAIL_NULL_V(shape, false);
+
+	QueryBuffers buffers;
+	buffers.results = space->intersection_query_results;
+	buffers.subindex_results = space->intersection_query_subindex_results;
+
+	_cast_motion(p_parameters, shape, p_parameters.transform, p_parameters.motion, p_closest_safe, p_closest_unsafe, r_info, buffers);
+	return true;
+}
+
+void GodotPhysicsDirectSpaceState3D::_cast_motion_batch(uint32_t p_chunk, MotionBatch *p_batch) {
+	int from = p_chunk * BATCH_QUERY_CHUNK_SIZE;
+	int to = MIN(from + BATCH_QUERY_CHUNK_SIZE, p_batch->count);
+
+	LocalVector<GodotCollisionObject3D *> query_results;
+	query_results.resize(GodotSpace3D::INTERSECTION_QUERY_MAX);
+	LocalVector<int> query_subindex_results;
+	query_subindex_results.resize(GodotSpace3D::INTERSECTION_QUERY_MAX);
+	LocalVector<uint32_t, uint32_t, true> hits;
+
+	QueryBuffers buffers;
+	buffers.results = query_results.ptr();
+	buffers.subindex_results = query_subindex_results.ptr();
+	buffers.hits = &hits;
+
+	Transform3D transform = p_batch->parameters->transform;
+	for (int i = from; i < to; i++) {
+		transform.origin = p_batch->origins[i];
+		_cast_motion(*p_batch->parameters, p_batch->shape, transform, p_batch->motions[i], p_batch->closest_safe[i], p_batch->closest_unsafe[i], nullptr, buffers);
+	}
+}
+
+bool GodotPhysicsDirectSpaceState3D::cast_motions(const ShapeParameters &p_parameters, const Vector3 *p_origins, const Vector3 *p_motions, int p_count, real_t *r_closest_safe, real_t *r_closest_unsafe) {
+	ERR_FAIL_COND_V(space->locked, false);
+	GodotShape3D *shape = GodotPhysicsServer3D::godot_singleton->shape_owner.get_or_null(p_parameters.shape_rid);
+	ERR_FAIL_NULL_V(shape, false);
+	if (p_count <= 0) {
+		return true;
+	}
+
+	MotionBatch batch;
+	batch.parameters = &p_parameters;
+	batch.shape = shape;
+	batch.origins = p_origins;
+	batch.motions = p_motions;
+	batch.closest_safe = r_closest_safe;
+	batch.closest_unsafe = r_closest_unsafe;
+	batch.count = p_count;
+
+	uint32_t chunk_count = (p_count + BATCH_QUERY_CHUNK_SIZE - 1) / BATCH_QUERY_CHUNK_SIZE;
+	if (chunk_count > 1 && WorkerThreadPool::get_thread_index() == -1) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotPhysicsDirectSpaceState3D::_cast_motion_batch, &batch, chunk_count, -1, true, SNAME("Physics3DCastMotions"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		for (uint32_t chunk = 0; chunk < chunk_count; chunk++) {
+			_cast_motion_batch(chunk, &batch);
+		}
+	}
 
 	return true;
 }
@@ -1249,6 +1465,26 @@ bool GodotSpace3D::is_locked() const {
 	return locked;
 }
 
+uint32_t GodotSpace3D::island_create() {
+	if (free_islands.size()) {
+		uint32_t island = free_islands[free_islands.size() - 1];
+		free_islands.resize(free_islands.size() - 1);
+		return island;
+	}
+	islands.push_back(Island());
+	return islands.size() - 1;
+}
+
+void GodotSpace3D::island_free(uint32_t p_island) {
+	Island &island = islands[p_island];
+	for (GodotBody3D *body : island.bodies) {
+		body->set_island(-1);
+	}
+	island.bodies.clear();
+	island.constraints.clear();
+	free_islands.push_back(p_island);
+}
+
 GodotPhysicsDirectSpaceState3D *GodotSpace3D::get_direct_state() {
 	return direct_access;
 }
@@ -1269,9 +1505,15 @@ GodotSpace3D::GodotSpace3D() {
 
 	direct_access = memnew(GodotPhysicsDirectSpaceState3D);
 	direct_access->space = this;
+
+	snapshot_access = memnew(GodotPhysicsDirectSpaceSnapshotState3D);
+	snapshot_access->space = this;
 }
 
 GodotSpace3D::~GodotSpace3D() {
 	memdelete(broadphase);
 	memdelete(direct_access);
+	if (snapshot_access) {
+		memdelete(snapshot_access);
+	}
 }
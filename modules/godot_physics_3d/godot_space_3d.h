@@ -38,21 +38,73 @@
 #include "godot_broad_phase_3d.h"
 #include "godot_collision_object_3d.h"
 #include "godot_soft_body_3d.h"
+#include "godot_space_snapshot_3d.h"
 
 #include "core/config/project_settings.h"
 #include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
 #include "core/typedefs.h"
 
 class GodotPhysicsDirectSpaceState3D : public PhysicsDirectSpaceState3D {
 	GDCLASS(GodotPhysicsDirectSpaceState3D, PhysicsDirectSpaceState3D);
 
+	enum {
+		BATCH_QUERY_CHUNK_SIZE = 64
+	};
+
+	// Broadphase query storage, the space's own arrays or per thread ones when running batched queries.
+	struct QueryBuffers {
+		GodotCollisionObject3D **results = nullptr;
+		int *subindex_results = nullptr;
+		LocalVector<uint32_t, uint32_t, true> *hits = nullptr; // Only set when querying from several threads at once.
+	};
+
+	struct RayBatch {
+		const RayParameters *parameters = nullptr;
+		const Vector3 *from = nullptr;
+		const Vector3 *to = nullptr;
+		RayResult *results = nullptr;
+		bool *collided = nullptr;
+		int count = 0;
+	};
+
+	struct ShapeBatch {
+		const ShapeParameters *parameters = nullptr;
+		GodotShape3D *shape = nullptr;
+		const Vector3 *origins = nullptr;
+		ShapeResult *results = nullptr;
+		int result_max = 0;
+		int *result_counts = nullptr;
+		int count = 0;
+	};
+
+	struct MotionBatch {
+		const ShapeParameters *parameters = nullptr;
+		GodotShape3D *shape = nullptr;
+		const Vector3 *origins = nullptr;
+		const Vector3 *motions = nullptr;
+		real_t *closest_safe = nullptr;
+		real_t *closest_unsafe = nullptr;
+		int count = 0;
+	};
+
+	bool _intersect_ray(const RayParameters &p_parameters, const Vector3 &p_from, const Vector3 &p_to, RayResult &r_result, const QueryBuffers &p_buffers);
+	void _intersect_ray_batch(uint32_t p_chunk, RayBatch *p_batch);
+	int _intersect_shape(const ShapeParameters &p_parameters, GodotShape3D *p_shape, const Transform3D &p_transform, ShapeResult *r_results, int p_result_max, const QueryBuffers &p_buffers);
+	void _intersect_shape_batch(uint32_t p_chunk, ShapeBatch *p_batch);
+	void _cast_motion(const ShapeParameters &p_parameters, GodotShape3D *p_shape, const Transform3D &p_transform, const Vector3 &p_motion, real_t &p_closest_safe, real_t &p_closest_unsafe, ShapeRestInfo *r_info, const QueryBuffers &p_buffers);
+	void _cast_motion_batch(uint32_t p_chunk, MotionBatch *p_batch);
+
 public:
 	GodotSpace3D *space = nullptr;
 
 	virtual int intersect_point(const PointParameters &p_parameters, ShapeResult *r_results, int p_result_max) override;
 	virtual bool intersect_ray(const RayParameters &p_parameters, RayResult &r_result) override;
+	virtual int intersect_rays(const RayParameters &p_parameters, const Vector3 *p_from, const Vector3 *p_to, int p_count, RayResult *r_results, bool *r_collided) override;
 	virtual int intersect_shape(const ShapeParameters &p_parameters, ShapeResult *r_results, int p_result_max) override;
+	virtual int intersect_shapes(const ShapeParameters &p_parameters, const Vector3 *p_origins, int p_count, ShapeResult *r_results, int p_result_max, int *r_result_counts) override;
 	virtual bool cast_motion(const ShapeParameters &p_parameters, real_t &p_closest_safe, real_t &p_closest_unsafe, ShapeRestInfo *r_info = nullptr) override;
+	virtual bool cast_motions(const ShapeParameters &p_parameters, const Vector3 *p_origins, const Vector3 *p_motions, int p_count, real_t *r_closest_safe, real_t *r_closest_unsafe) override;
 	virtual bool collide_shape(const ShapeParameters &p_parameters, Vector3 *r_results, int p_result_max, int &r_result_count) override;
 	virtual bool rest_info(const ShapeParameters &p_parameters, ShapeRestInfo *r_info) override;
 	virtual Vector3 get_closest_point_to_object_volume(RID p_object, const Vector3 p_point) const override;
@@ -72,10 +124,17 @@ public:
 
 	};
 
+	// Islands are kept between steps and only rebuilt when constraints are added to or removed from one of their bodies.
+	struct Island {
+		LocalVector<GodotBody3D *> bodies; // All non-static bodies, including kinematic ones.
+		LocalVector<GodotConstraint3D *> constraints;
+	};
+
 private:
 	uint64_t elapsed_time[ELAPSED_TIME_MAX] = {};
 
 	GodotPhysicsDirectSpaceState3D *direct_access = nullptr;
+	GodotPhysicsDirectSpaceSnapshotState3D *snapshot_access = nullptr;
 	RID self;
 
 	GodotBroadPhase3D *broadphase = nullptr;
@@ -115,6 +174,9 @@ private:
 
 	real_t last_step = 0.001;
 
+	LocalVector<Island> islands;
+	LocalVector<uint32_t> free_islands;
+
 	int island_count = 0;
 	int active_objects = 0;
 	int collision_pairs = 0;
@@ -183,6 +245,10 @@ public:
 	void set_param(PhysicsServer3D::SpaceParameter p_param, real_t p_value);
 	real_t get_param(PhysicsServer3D::SpaceParameter p_param) const;
 
+	uint32_t island_create();
+	void island_free(uint32_t p_island);
+	_FORCE_INLINE_ Island &island_get(uint32_t p_island) { return islands[p_island]; }
+
 	void set_island_count(int p_island_count) { island_count = p_island_count; }
 	int get_island_count() const { return island_count; }
 
@@ -192,6 +258,13 @@ public:
 	int get_collision_pairs() const { return collision_pairs; }
 
 	GodotPhysicsDirectSpaceState3D *get_direct_state();
+	GodotPhysicsDirectSpaceSnapshotState3D *get_snapshot_state() { return snapshot_access; }
+	// The caller becomes responsible for deleting the snapshot state, which may outlive the space.
+	GodotPhysicsDirectSpaceSnapshotState3D *detach_snapshot_state() {
+		GodotPhysicsDirectSpaceSnapshotState3D *state = snapshot_access;
+		snapshot_access = nullptr;
+		return state;
+	}
 
 	void set_debug_contacts(int p_amount) { contact_debug.resize(p_amount); }
 	_FORCE_INLINE_ bool is_debugging_contacts() const { return !contact_debug.is_empty(); }
@@ -0,0 +1,795 @@
+/**************************************************************************/
+/*  godot_space_snapshot_3d.cpp                                           */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "godot_space_snapshot_3d.h"
+
+#include "godot_collision_solver_3d.h"
+#include "godot_physics_server_3d.h"
+#include "godot_space_3d.h"
+
+#include "core/templates/sort_array.h"
+
+#define SNAPSHOT_CULL_STACK_SIZE 64
+
+// Same as the space's direct state.
+#define SNAPSHOT_TEST_MOTION_MARGIN_MIN_VALUE 0.0001
+#define SNAPSHOT_TEST_MOTION_MIN_CONTACT_DEPTH_FACTOR 0.05
+
+struct _SnapshotItemAxisCompare {
+	const GodotSpaceSnapshot3D::Item *items = nullptr;
+	int axis = 0;
+
+	_FORCE_INLINE_ bool operator()(uint32_t p_a, uint32_t p_b) const {
+		return items[p_a].aabb.get_center()[axis] < items[p_b].aabb.get_center()[axis];
+	}
+};
+
+void GodotSpaceSnapshot3D::_build_node(uint32_t p_node, uint32_t p_from, uint32_t p_to) {
+	AABB aabb = items[leaf_items[p_from]].aabb;
+	AABB centers(aabb.get_center(), Vector3());
+	for (uint32_t i = p_from + 1; i < p_to; i++) {
+		const AABB &item_aabb = items[leaf_items[i]].aabb;
+		aabb.merge_with(item_aabb);
+		centers.expand_to(item_aabb.get_center());
+	}
+
+	nodes[p_node].aabb = aabb;
+
+	if (p_to - p_from <= LEAF_SIZE) {
+		nodes[p_node].first = p_from;
+		nodes[p_node].count = p_to - p_from;
+		return;
+	}
+
+	// Median split along the longest axis of the item centers.
+	uint32_t mid = (p_from + p_to) / 2;
+	SortArray<uint32_t, _SnapshotItemAxisCompare> sorter;
+	sorter.compare.items = items.ptr();
+	sorter.compare.axis = centers.get_longest_axis_index();
+	sorter.nth_element(p_from, p_to, mid, leaf_items.ptr());
+
+	// Children are allocated in pairs after their parent, so refitting can go through the nodes backwards.
+	uint32_t first_child = nodes.size();
+	nodes.resize(first_child + 2);
+	nodes[p_node].first = first_child;
+	nodes[p_node].count = 0;
+
+	_build_node(first_child, p_from, mid);
+	_build_node(first_child + 1, mid, p_to);
+}
+
+void GodotSpaceSnapshot3D::_build() {
+	refit_count = 0;
+
+	leaf_items.resize(items.size());
+	for (uint32_t i = 0; i < items.size(); i++) {
+		leaf_items[i] = i;
+	}
+
+	nodes.clear();
+	if (items.is_empty()) {
+		return;
+	}
+	nodes.resize(1);
+	_build_node(0, 0, items.size());
+}
+
+bool GodotSpaceSnapshot3D::_refit(const GodotSpaceSnapshot3D *p_previous) {
+	if (!p_previous || p_previous->items.size() != items.size() || p_previous->refit_count + 1 >= REBUILD_INTERVAL) {
+		return false;
+	}
+
+	// The hierarchy can only be reused if the same shapes are still there, in the same order.
+	for (uint32_t i = 0; i < items.size(); i++) {
+		const Item &item = items[i];
+		const Item &previous_item = p_previous->items[i];
+		if (item.rid != previous_item.rid || item.shape_index != previous_item.shape_index) {
+			return false;
+		}
+	}
+
+	refit_count = p_previous->refit_count + 1;
+	leaf_items = p_previous->leaf_items;
+	nodes = p_previous->nodes;
+
+	for (int64_t i = int64_t(nodes.size()) - 1; i >= 0; i--) {
+		Node &node = nodes[i];
+		if (node.count) {
+			node.aabb = items[leaf_items[node.first]].aabb;
+			for (uint32_t j = 1; j < node.count; j++) {
+				node.aabb.merge_with(items[leaf_items[node.first + j]].aabb);
+			}
+		} else {
+			node.aabb = nodes[node.first].aabb.merge(nodes[node.first + 1].aabb);
+		}
+	}
+
+	return true;
+}
+
+void GodotSpaceSnapshot3D::update(const GodotSpace3D *p_space, const GodotSpaceSnapshot3D *p_previous) {
+	items.clear();
+	objects.clear();
+
+	for (const GodotCollisionObject3D *object : p_space->get_objects()) {
+		if (object->get_type() == GodotCollisionObject3D::TYPE_SOFT_BODY) {
+			// Soft body shapes read from the soft body itself, which can't be accessed while it's being stepped.
+			continue;
+		}
+
+		ObjectInfo object_info;
+		object_info.transform = object->get_transform();
+		object_info.first_item = items.size();
+
+		Vector3 linear_velocity;
+		Vector3 angular_velocity;
+		Vector3 center_of_mass;
+		if (object->get_type() == GodotCollisionObject3D::TYPE_BODY) {
+			const GodotBody3D *body = static_cast<const GodotBody3D *>(object);
+			linear_velocity = body->get_linear_velocity();
+			angular_velocity = body->get_angular_velocity();
+			center_of_mass = body->get_transform().origin + body->get_center_of_mass();
+		}
+
+		for (int i = 0; i < object->get_shape_count(); i++) {
+			if (object->is_shape_disabled(i)) {
+				continue;
+			}
+
+			Item item;
+			item.aabb = object->get_shape_aabb(i);
+			item.transform = object->get_transform() * object->get_shape_transform(i);
+			item.inv_transform = object->get_shape_inv_transform(i) * object->get_inv_transform();
+			item.shape = object->get_shape(i);
+			item.rid = object->get_self();
+			item.instance_id = object->get_instance_id();
+			item.collision_layer = object->get_collision_layer();
+			item.shape_index = i;
+			item.is_area = object->get_type() == GodotCollisionObject3D::TYPE_AREA;
+			item.ray_pickable = object->is_ray_pickable();
+			item.linear_velocity = linear_velocity;
+			item.angular_velocity = angular_velocity;
+			item.center_of_mass = center_of_mass;
+			items.push_back(item);
+		}
+
+		object_info.item_count = items.size() - object_info.first_item;
+		objects.insert(object->get_self(), object_info);
+	}
+
+	if (!_refit(p_previous)) {
+		_build();
+	}
+}
+
+void GodotSpaceSnapshot3D::cull_segment(const Vector3 &p_from, const Vector3 &p_to, LocalVector<uint32_t> &r_items) const {
+	if (nodes.is_empty()) {
+		return;
+	}
+
+	uint32_t stack[SNAPSHOT_CULL_STACK_SIZE];
+	uint32_t stack_size = 0;
+	stack[stack_size++] = 0;
+
+	while (stack_size) {
+		const Node &node = nodes[stack[--stack_size]];
+		if (!node.aabb.intersects_segment(p_from, p_to)) {
+			continue;
+		}
+
+		if (node.count) {
+			for (uint32_t i = 0; i < node.count; i++) {
+				uint32_t item_index = leaf_items[node.first + i];
+				if (items[item_index].aabb.intersects_segment(p_from, p_to)) {
+					r_items.push_back(item_index);
+				}
+			}
+		} else {
+			stack[stack_size++] = node.first;
+			stack[stack_size++] = node.first + 1;
+		}
+	}
+}
+
+void GodotSpaceSnapshot3D::cull_point(const Vector3 &p_point, LocalVector<uint32_t> &r_items) const {
+	if (nodes.is_empty()) {
+		return;
+	}
+
+	uint32_t stack[SNAPSHOT_CULL_STACK_SIZE];
+	uint32_t stack_size = 0;
+	stack[stack_size++] = 0;
+
+	while (stack_size) {
+		const Node &node = nodes[stack[--stack_size]];
+		if (!node.aabb.has_point(p_point)) {
+			continue;
+		}
+
+		if (node.count) {
+			for (uint32_t i = 0; i < node.count; i++) {
+				uint32_t item_index = leaf_items[node.first + i];
+				if (items[item_index].aabb.has_point(p_point)) {
+					r_items.push_back(item_index);
+				}
+			}
+		} else {
+			stack[stack_size++] = node.first;
+			stack[stack_size++] = node.first + 1;
+		}
+	}
+}
+
+void GodotSpaceSnapshot3D::cull_aabb(const AABB &p_aabb, LocalVector<uint32_t> &r_items) const {
+	if (nodes.is_empty()) {
+		return;
+	}
+
+	uint32_t stack[SNAPSHOT_CULL_STACK_SIZE];
+	uint32_t stack_size = 0;
+	stack[stack_size++] = 0;
+
+	while (stack_size) {
+		const Node &node = nodes[stack[--stack_size]];
+		if (!node.aabb.intersects(p_aabb)) {
+			continue;
+		}
+
+		if (node.count) {
+			for (uint32_t i = 0; i < node.count; i++) {
+				uint32_t item_index = leaf_items[node.first + i];
+				if (items[item_index].aabb.intersects(p_aabb)) {
+					r_items.push_back(item_index);
+				}
+			}
+		} else {
+			stack[stack_size++] = node.first;
+			stack[stack_size++] = node.first + 1;
+		}
+	}
+}
+
+/////////////////////////////////////
+
+_FORCE_INLINE_ static bool _can_collide_with(const GodotSpaceSnapshot3D::Item &p_item, uint32_t p_collision_mask, bool p_collide_with_bodies, bool p_collide_with_areas) {
+	if (!(p_item.collision_layer & p_collision_mask)) {
+		return false;
+	}
+
+	return p_item.is_area ? p_collide_with_areas : p_collide_with_bodies;
+}
+
+GodotSpaceSnapshot3D *GodotPhysicsDirectSpaceSnapshotState3D::_acquire_snapshot() const {
+	snapshot_lock.lock();
+	GodotSpaceSnapshot3D *snapshot = current_snapshot;
+	if (snapshot) {
+		snapshot->readers.increment();
+	}
+	snapshot_lock.unlock();
+	return snapshot;
+}
+
+void GodotPhysicsDirectSpaceSnapshotState3D::_release_snapshot(GodotSpaceSnapshot3D *p_snapshot) const {
+	p_snapshot->readers.decrement();
+}
+
+GodotShape3D *GodotPhysicsDirectSpaceSnapshotState3D::_get_query_shape(const RID &p_shape) const {
+	// Only called while holding a snapshot: a shape freed or changed from now on is kept alive until the snapshot is released.
+	return GodotPhysicsServer3D::godot_singleton->shape_owner.get_or_null(p_shape);
+}
+
+void GodotPhysicsDirectSpaceSnapshotState3D::publish(uint64_t p_serial) {
+	// Reuse a snapshot nobody reads anymore, so there are usually only two of them.
+	// Snapshots other than the current one can't gain new readers.
+	GodotSpaceSnapshot3D *snapshot = nullptr;
+	for (GodotSpaceSnapshot3D *E : snapshots) {
+		if (E != current_snapshot && E->readers.get() == 0) {
+			snapshot = E;
+			break;
+		}
+	}
+	if (!snapshot) {
+		snapshot = memnew(GodotSpaceSnapshot3D);
+		snapshots.push_back(snapshot);
+	}
+
+	snapshot->update(space, current_snapshot);
+	snapshot->serial = p_serial;
+
+	snapshot_lock.lock();
+	current_snapshot = snapshot;
+	snapshot_lock.unlock();
+}
+
+void GodotPhysicsDirectSpaceSnapshotState3D::retire() {
+	enabled.clear();
+	snapshot_lock.lock();
+	current_snapshot = nullptr;
+	snapshot_lock.unlock();
+	space = nullptr;
+}
+
+uint64_t GodotPhysicsDirectSpaceSnapshotState3D::get_oldest_serial_in_use() {
+	uint64_t oldest = UINT64_MAX;
+	for (const GodotSpaceSnapshot3D *E : snapshots) {
+		if (E == current_snapshot || E->readers.get() > 0) {
+			oldest = MIN(oldest, E->serial);
+		}
+	}
+	return oldest;
+}
+
+int GodotPhysicsDirectSpaceSnapshotState3D::intersect_point(const PointParameters &p_parameters, ShapeResult *r_results, int p_result_max) {
+	GodotSpaceSnapshot3D *snapshot = _acquire_snapshot();
+	if (!snapshot) {
+		return 0;
+	}
+
+	LocalVector<uint32_t> candidates;
+	snapshot->cull_point(p_parameters.position, candidates);
+
+	int cc = 0;
+	for (uint32_t item_index : candidates) {
+		if (cc >= p_result_max) {
+			break;
+		}
+
+		const GodotSpaceSnapshot3D::Item &item = snapshot->get_item(item_index);
+		if (!_can_collide_with(item, p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
+			continue;
+		}
+
+		if (p_parameters.exclude.has(item.rid)) {
+			continue;
+		}
+
+		if (!item.shape->intersect_point(item.inv_transform.xform(p_parameters.position))) {
+			continue;
+		}
+
+		r_results[cc].collider_id = item.instance_id;
+		r_results[cc].collider = item.instance_id.is_valid() ? ObjectDB::get_instance(item.instance_id) : nullptr;
+		r_results[cc].rid = item.rid;
+		r_results[cc].shape = item.shape_index;
+
+		cc++;
+	}
+
+	_release_snapshot(snapshot);
+	return cc;
+}
+
+bool GodotPhysicsDirectSpaceSnapshotState3D::intersect_ray(const RayParameters &p_parameters, RayResult &r_result) {
+	GodotSpaceSnapshot3D *snapshot = _acquire_snapshot();
+	if (!snapshot) {
+		return false;
+	}
+
+	Vector3 begin = p_parameters.from;
+	Vector3 end = p_parameters.to;
+	Vector3 normal = (end - begin).normalized();
+
+	LocalVector<uint32_t> candidates;
+	snapshot->cull_segment(begin, end, candidates);
+
+	const GodotSpaceSnapshot3D::Item *res_item = nullptr;
+	Vector3 res_point, res_normal;
+	int res_face_index = -1;
+	real_t min_d = 1e10;
+
+	for (uint32_t item_index : candidates) {
+		const GodotSpaceSnapshot3D::Item &item = snapshot->get_item(item_index);
+		if (!_can_collide_with(item, p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
+			continue;
+		}
+
+		if (p_parameters.pick_ray && !item.ray_pickable) {
+			continue;
+		}
+
+		if (p_parameters.exclude.has(item.rid)) {
+			continue;
+		}
+
+		Vector3 local_from = item.inv_transform.xform(begin);
+		Vector3 local_to = item.inv_transform.xform(end);
+
+		if (item.shape->intersect_point(local_from)) {
+			if (p_parameters.hit_from_inside) {
+				// Hit shape at starting point.
+				res_point = begin;
+				res_normal = Vector3();
+				res_face_index = -1;
+				res_item = &item;
+				break;
+			} else {
+				// Ignore shape when starting inside.
+				continue;
+			}
+		}
+
+		Vector3 shape_point, shape_normal;
+		int shape_face_index = -1;
+		if (item.shape->intersect_segment(local_from, local_to, shape_point, shape_normal, shape_face_index, p_parameters.hit_back_faces)) {
+			shape_point = item.transform.xform(shape_point);
+
+			real_t ld = normal.dot(shape_point);
+			if (ld < min_d) {
+				min_d = ld;
+				res_point = shape_point;
+				res_normal = item.inv_transform.basis.xform_inv(shape_normal).normalized();
+				res_face_index = shape_face_index;
+				res_item = &item;
+			}
+		}
+	}
+
+	bool collided = res_item != nullptr;
+	if (collided) {
+		r_result.collider_id = res_item->instance_id;
+		r_result.collider = res_item->instance_id.is_valid() ? ObjectDB::get_instance(res_item->instance_id) : nullptr;
+		r_result.normal = res_normal;
+		r_result.face_index = res_face_index;
+		r_result.position = res_point;
+		r_result.rid = res_item->rid;
+		r_result.shape = res_item->shape_index;
+	}
+
+	_release_snapshot(snapshot);
+	return collided;
+}
+
+int GodotPhysicsDirectSpaceSnapshotState3D::intersect_shape(const ShapeParameters &p_parameters, ShapeResult *r_results, int p_result_max) {
+	if (p_result_max <= 0) {
+		return 0;
+	}
+
+	GodotSpaceSnapshot3D *snapshot = _acquire_snapshot();
+	if (!snapshot) {
+		return 0;
+	}
+
+	GodotShape3D *shape = _get_query_shape(p_parameters.shape_rid);
+	if (!shape) {
+		_release_snapshot(snapshot);
+		ERR_FAIL_V(0);
+	}
+
+	LocalVector<uint32_t> candidates;
+	snapshot->cull_aabb(p_parameters.transform.xform(shape->get_aabb()), candidates);
+
+	int cc = 0;
+	for (uint32_t item_index : candidates) {
+		if (cc >= p_result_max) {
+			break;
+		}
+
+		const GodotSpaceSnapshot3D::Item &item = snapshot->get_item(item_index);
+		if (!_can_collide_with(item, p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
+			continue;
+		}
+
+		if (p_parameters.exclude.has(item.rid)) {
+			continue;
+		}
+
+		if (!GodotCollisionSolver3D::solve_static(shape, p_parameters.transform, item.shape, item.transform, nullptr, nullptr, nullptr, p_parameters.margin, 0)) {
+			continue;
+		}
+
+		if (r_results) {
+			r_results[cc].collider_id = item.instance_id;
+			r_results[cc].collider = item.instance_id.is_valid() ? ObjectDB::get_instance(item.instance_id) : nullptr;
+			r_results[cc].rid = item.rid;
+			r_results[cc].shape = item.shape_index;
+		}
+
+		cc++;
+	}
+
+	_release_snapshot(snapshot);
+	return cc;
+}
+
+bool GodotPhysicsDirectSpaceSnapshotState3D::cast_motion(const ShapeParameters &p_parameters, real_t &p_closest_safe, real_t &p_closest_unsafe, ShapeRestInfo *r_info) {
+	GodotSpaceSnapshot3D *snapshot = _acquire_snapshot();
+	if (!snapshot) {
+		p_closest_safe = 1.0;
+		p_closest_unsafe = 1.0;
+		return true;
+	}
+
+	GodotShape3D *shape = _get_query_shape(p_parameters.shape_rid);
+	if (!shape) {
+		_release_snapshot(snapshot);
+		ERR_FAIL_V(false);
+	}
+
+	AABB aabb = p_parameters.transform.xform(shape->get_aabb());
+	aabb = aabb.merge(AABB(aabb.position + p_parameters.motion, aabb.size)); //motion
+	aabb = aabb.grow(p_parameters.margin);
+
+	LocalVector<uint32_t> candidates;
+	snapshot->cull_aabb(aabb, candidates);
+
+	real_t best_safe = 1;
+	real_t best_unsafe = 1;
+
+	Transform3D xform_inv = p_parameters.transform.affine_inverse();
+	GodotMotionShape3D mshape;
+	mshape.shape = shape;
+	mshape.motion = xform_inv.basis.xform(p_parameters.motion);
+
+	bool best_first = true;
+
+	Vector3 motion_normal = p_parameters.motion.normalized();
+
+	Vector3 closest_A, closest_B;
+
+	for (uint32_t item_index : candidates) {
+		const GodotSpaceSnapshot3D::Item &item = snapshot->get_item(item_index);
+		if (!_can_collide_with(item, p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
+			continue;
+		}
+
+		if (p_parameters.exclude.has(item.rid)) {
+			continue; //ignore excluded
+		}
+
+		Vector3 point_A, point_B;
+		Vector3 sep_axis = motion_normal;
+
+		//test initial overlap, does it collide if going all the way?
+		if (GodotCollisionSolver3D::solve_distance(&mshape, p_parameters.transform, item.shape, item.transform, point_A, point_B, aabb, &sep_axis)) {
+			continue;
+		}
+
+		//test initial overlap, ignore objects it's inside of.
+		sep_axis = motion_normal;
+
+		if (!GodotCollisionSolver3D::solve_distance(shape, p_parameters.transform, item.shape, item.transform, point_A, point_B, aabb, &sep_axis)) {
+			continue;
+		}
+
+		// Same kinematic solving as the space's direct state, so both give the same results on the same scene.
+		real_t low = 0.0;
+		real_t hi = 1.0;
+		real_t fraction_coeff = 0.5;
+		for (int j = 0; j < 8; j++) {
+			real_t fraction = low + (hi - low) * fraction_coeff;
+
+			mshape.motion = xform_inv.basis.xform(p_parameters.motion * fraction);
+
+			Vector3 lA, lB;
+			Vector3 sep = motion_normal;
+			bool collided = !GodotCollisionSolver3D::solve_distance(&mshape, p_parameters.transform, item.shape, item.transform, lA, lB, aabb, &sep);
+
+			if (collided) {
+				hi = fraction;
+				fraction_coeff = ((j == 0) || (low > 0.0)) ? 0.5 : 0.25;
+			} else {
+				point_A = lA;
+				point_B = lB;
+				low = fraction;
+				fraction_coeff = ((j == 0) || (hi < 1.0)) ? 0.5 : 0.75;
+			}
+		}
+
+		if (low < best_safe) {
+			best_first = true; //force reset
+			best_safe = low;
+			best_unsafe = hi;
+		}
+
+		if (r_info && (best_first || (point_A.distance_squared_to(point_B) < closest_A.distance_squared_to(closest_B) && low <= best_safe))) {
+			closest_A = point_A;
+			closest_B = point_B;
+			r_info->collider_id = item.instance_id;
+			r_info->rid = item.rid;
+			r_info->shape = item.shape_index;
+			r_info->point = closest_B;
+			r_info->normal = (closest_A - closest_B).normalized();
+			r_info->linear_velocity = item.linear_velocity + item.angular_velocity.cross(closest_B - item.center_of_mass);
+			best_first = false;
+		}
+	}
+
+	_release_snapshot(snapshot);
+
+	p_closest_safe = best_safe;
+	p_closest_unsafe = best_unsafe;
+	return true;
+}
+
+bool GodotPhysicsDirectSpaceSnapshotState3D::collide_shape(const ShapeParameters &p_parameters, Vector3 *r_results, int p_result_max, int &r_result_count) {
+	r_result_count = 0;
+	if (p_result_max <= 0) {
+		return false;
+	}
+
+	GodotSpaceSnapshot3D *snapshot = _acquire_snapshot();
+	if (!snapshot) {
+		return false;
+	}
+
+	GodotShape3D *shape = _get_query_shape(p_parameters.shape_rid);
+	if (!shape) {
+		_release_snapshot(snapshot);
+		ERR_FAIL_V(false);
+	}
+
+	AABB aabb = p_parameters.transform.xform(shape->get_aabb());
+	aabb = aabb.grow(p_parameters.margin);
+
+	LocalVector<uint32_t> candidates;
+	snapshot->cull_aabb(aabb, candidates);
+
+	bool collided = false;
+
+	GodotPhysicsServer3D::CollCbkData cbk;
+	cbk.max = p_result_max;
+	cbk.amount = 0;
+	cbk.ptr = r_results;
+
+	for (uint32_t item_index : candidates) {
+		const GodotSpaceSnapshot3D::Item &item = snapshot->get_item(item_index);
+		if (!_can_collide_with(item, p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
+			continue;
+		}
+
+		if (p_parameters.exclude.has(item.rid)) {
+			continue;
+		}
+
+		if (GodotCollisionSolver3D::solve_static(shape, p_parameters.transform, item.shape, item.transform, GodotPhysicsServer3D::_shape_col_cbk, &cbk, nullptr, p_parameters.margin)) {
+			collided = true;
+		}
+	}
+
+	_release_snapshot(snapshot);
+
+	r_result_count = cbk.amount;
+	return collided;
+}
+
+struct _SnapshotRestCallbackData {
+	const GodotSpaceSnapshot3D::Item *item = nullptr;
+	real_t min_allowed_depth = 0.0;
+
+	const GodotSpaceSnapshot3D::Item *best_item = nullptr;
+	Vector3 best_contact;
+	Vector3 best_normal;
+	real_t best_len = 0.0;
+};
+
+static void _snapshot_rest_cbk_result(const Vector3 &p_point_A, int p_index_A, const Vector3 &p_point_B, int p_index_B, const Vector3 &normal, void *p_userdata) {
+	_SnapshotRestCallbackData *rd = static_cast<_SnapshotRestCallbackData *>(p_userdata);
+
+	real_t len = (p_point_B - p_point_A).length();
+	if (len < rd->min_allowed_depth || len <= rd->best_len) {
+		return;
+	}
+
+	rd->best_len = len;
+	rd->best_contact = p_point_B;
+	rd->best_normal = normal;
+	rd->best_item = rd->item;
+}
+
+bool GodotPhysicsDirectSpaceSnapshotState3D::rest_info(const ShapeParameters &p_parameters, ShapeRestInfo *r_info) {
+	GodotSpaceSnapshot3D *snapshot = _acquire_snapshot();
+	if (!snapshot) {
+		return false;
+	}
+
+	GodotShape3D *shape = _get_query_shape(p_parameters.shape_rid);
+	if (!shape) {
+		_release_snapshot(snapshot);
+		ERR_FAIL_V(false);
+	}
+
+	real_t margin = MAX(p_parameters.margin, SNAPSHOT_TEST_MOTION_MARGIN_MIN_VALUE);
+
+	AABB aabb = p_parameters.transform.xform(shape->get_aabb());
+	aabb = aabb.grow(margin);
+
+	LocalVector<uint32_t> candidates;
+	snapshot->cull_aabb(aabb, candidates);
+
+	_SnapshotRestCallbackData rcd;
+
+	// Allowed depth can't be lower than motion length, in order to handle contacts at low speed.
+	real_t motion_length = p_parameters.motion.length();
+	real_t min_contact_depth = margin * SNAPSHOT_TEST_MOTION_MIN_CONTACT_DEPTH_FACTOR;
+	rcd.min_allowed_depth = MIN(motion_length, min_contact_depth);
+
+	for (uint32_t item_index : candidates) {
+		const GodotSpaceSnapshot3D::Item &item = snapshot->get_item(item_index);
+		if (!_can_collide_with(item, p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
+			continue;
+		}
+
+		if (p_parameters.exclude.has(item.rid)) {
+			continue;
+		}
+
+		rcd.item = &item;
+		GodotCollisionSolver3D::solve_static(shape, p_parameters.transform, item.shape, item.transform, _snapshot_rest_cbk_result, &rcd, nullptr, margin);
+	}
+
+	bool found = rcd.best_len != 0 && rcd.best_item;
+	if (found) {
+		r_info->collider_id = rcd.best_item->instance_id;
+		r_info->shape = rcd.best_item->shape_index;
+		r_info->normal = rcd.best_normal;
+		r_info->point = rcd.best_contact;
+		r_info->rid = rcd.best_item->rid;
+		r_info->linear_velocity = rcd.best_item->linear_velocity + rcd.best_item->angular_velocity.cross(rcd.best_contact - rcd.best_item->center_of_mass);
+	}
+
+	_release_snapshot(snapshot);
+	return found;
+}
+
+Vector3 GodotPhysicsDirectSpaceSnapshotState3D::get_closest_point_to_object_volume(RID p_object, const Vector3 p_point) const {
+	GodotSpaceSnapshot3D *snapshot = _acquire_snapshot();
+	ERR_FAIL_NULL_V_MSG(snapshot, Vector3(), "No snapshot of the space was taken yet.");
+
+	const GodotSpaceSnapshot3D::ObjectInfo *object = snapshot->get_object(p_object);
+	if (!object) {
+		_release_snapshot(snapshot);
+		ERR_FAIL_V_MSG(Vector3(), "The object isn't in the last snapshot of the space.");
+	}
+
+	Vector3 min_point = object->transform.origin; //no shapes found, use distance to origin.
+	real_t min_distance = 1e20;
+
+	for (uint32_t i = object->first_item; i < object->first_item + object->item_count; i++) {
+		const GodotSpaceSnapshot3D::Item &item = snapshot->get_item(i);
+
+		Vector3 point = item.shape->get_closest_point_to(item.inv_transform.xform(p_point));
+		point = item.transform.xform(point);
+
+		real_t dist = point.distance_to(p_point);
+		if (dist < min_distance) {
+			min_distance = dist;
+			min_point = point;
+		}
+	}
+
+	_release_snapshot(snapshot);
+	return min_point;
+}
+
+GodotPhysicsDirectSpaceSnapshotState3D::~GodotPhysicsDirectSpaceSnapshotState3D() {
+	for (GodotSpaceSnapshot3D *E : snapshots) {
+		memdelete(E);
+	}
+}
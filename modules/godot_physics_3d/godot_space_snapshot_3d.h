@@ -0,0 +1,148 @@
+/**************************************************************************/
+/*  godot_space_snapshot_3d.h                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef GODOT_SPACE_SNAPSHOT_3D_H
+#define GODOT_SPACE_SNAPSHOT_3D_H
+
+#include "godot_shape_3d.h"
+
+#include "core/os/spin_lock.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
+#include "servers/physics_server_3d.h"
+
+class GodotSpace3D;
+
+// Read-only copy of the shapes in a space and of a bounding volume hierarchy over them,
+// taken at the end of a physics step so it can be queried from any thread.
+// The shapes themselves aren't copied: the server never changes or deletes a shape a snapshot may still read.
+class GodotSpaceSnapshot3D {
+public:
+	struct Item {
+		AABB aabb;
+		Transform3D transform;
+		Transform3D inv_transform;
+		GodotShape3D *shape = nullptr;
+		RID rid;
+		ObjectID instance_id;
+		uint32_t collision_layer = 0;
+		int shape_index = 0;
+		bool is_area = false;
+		bool ray_pickable = false;
+		// Owner velocity, to compute the velocity at contact points. Zero for areas and static bodies.
+		Vector3 linear_velocity;
+		Vector3 angular_velocity;
+		Vector3 center_of_mass; // In global coordinates.
+	};
+
+	struct ObjectInfo {
+		Transform3D transform;
+		uint32_t first_item = 0; // The items of an object are next to each other.
+		uint32_t item_count = 0;
+	};
+
+private:
+	enum {
+		LEAF_SIZE = 4,
+		REBUILD_INTERVAL = 64,
+	};
+
+	struct Node {
+		AABB aabb;
+		uint32_t first = 0; // Child nodes (first, first + 1) for inner nodes, first entry in leaf_items for leaves.
+		uint32_t count = 0; // Number of items for leaves, 0 for inner nodes.
+	};
+
+	LocalVector<Item> items;
+	HashMap<RID, ObjectInfo> objects;
+	LocalVector<Node> nodes;
+	LocalVector<uint32_t> leaf_items;
+	uint32_t refit_count = 0;
+
+	void _build_node(uint32_t p_node, uint32_t p_from, uint32_t p_to);
+	void _build();
+	bool _refit(const GodotSpaceSnapshot3D *p_previous);
+
+public:
+	SafeNumeric<uint32_t> readers;
+	uint64_t serial = 0;
+
+	void update(const GodotSpace3D *p_space, const GodotSpaceSnapshot3D *p_previous);
+
+	_FORCE_INLINE_ const Item &get_item(uint32_t p_index) const { return items[p_index]; }
+	_FORCE_INLINE_ const ObjectInfo *get_object(const RID &p_rid) const { return objects.getptr(p_rid); }
+
+	void cull_segment(const Vector3 &p_from, const Vector3 &p_to, LocalVector<uint32_t> &r_items) const;
+	void cull_point(const Vector3 &p_point, LocalVector<uint32_t> &r_items) const;
+	void cull_aabb(const AABB &p_aabb, LocalVector<uint32_t> &r_items) const;
+};
+
+// Queries the last snapshot published for a space. Unlike the regular direct space state, it can be used from any thread
+// at any time without synchronizing with the physics server, at the cost of results being up to one step old.
+class GodotPhysicsDirectSpaceSnapshotState3D : public PhysicsDirectSpaceState3D {
+	GDCLASS(GodotPhysicsDirectSpaceSnapshotState3D, PhysicsDirectSpaceState3D);
+
+	SafeFlag enabled;
+
+	// Only held while swapping or taking a reference to the current snapshot.
+	mutable SpinLock snapshot_lock;
+	GodotSpaceSnapshot3D *current_snapshot = nullptr;
+	LocalVector<GodotSpaceSnapshot3D *> snapshots;
+
+	GodotSpaceSnapshot3D *_acquire_snapshot() const;
+	void _release_snapshot(GodotSpaceSnapshot3D *p_snapshot) const;
+	GodotShape3D *_get_query_shape(const RID &p_shape) const;
+
+public:
+	GodotSpace3D *space = nullptr;
+
+	// Snapshots are only taken once they were requested for the space.
+	void enable() { enabled.set(); }
+	bool is_enabled() const { return enabled.is_set(); }
+
+	void publish(uint64_t p_serial);
+	// Stops serving queries, for when the space is freed. Queries already running keep their snapshot until they finish.
+	void retire();
+	// Serial of the oldest snapshot that may still be read, UINT64_MAX if none.
+	uint64_t get_oldest_serial_in_use();
+
+	virtual int intersect_point(const PointParameters &p_parameters, ShapeResult *r_results, int p_result_max) override;
+	virtual bool intersect_ray(const RayParameters &p_parameters, RayResult &r_result) override;
+	virtual int intersect_shape(const ShapeParameters &p_parameters, ShapeResult *r_results, int p_result_max) override;
+	virtual bool cast_motion(const ShapeParameters &p_parameters, real_t &p_closest_safe, real_t &p_closest_unsafe, ShapeRestInfo *r_info = nullptr) override;
+	virtual bool collide_shape(const ShapeParameters &p_parameters, Vector3 *r_results, int p_result_max, int &r_result_count) override;
+	virtual bool rest_info(const ShapeParameters &p_parameters, ShapeRestInfo *r_info) override;
+	virtual Vector3 get_closest_point_to_object_volume(RID p_object, const Vector3 p_point) const override;
+
+	~GodotPhysicsDirectSpaceSnapshotState3D();
+};
+
+#endif // GODOT_SPACE_SNAPSHOT_3D_H
@@ -30,6 +30,7 @@
 
 #include "godot_step_3d.h"
 
+#include "godot_collision_batch_3d.h"
 #include "godot_joint_3d.h"
 
 #include "core/object/worker_thread_pool.h"
@@ -41,8 +42,16 @@
 #define ISLAND_SIZE_RESERVE 512
 #define CONSTRAINT_COUNT_RESERVE 1024
 
+SafeNumeric<uint64_t> GodotStep3D::last_step;
+
 void GodotStep3D::_populate_island(GodotBody3D *p_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island) {
 	p_body->set_island_step(_step);
+	island_bodies.push_back(p_body);
+
+	if (p_body->get_island() != -1) {
+		// The island this body was stored in is being merged into this one, so it no longer holds.
+		p_body->get_space()->island_free(p_body->get_island());
+	}
 
 	if (p_body->get_mode() > PhysicsServer3D::BODY_MODE_KINEMATIC) {
 		// Only rigid bodies are tested for activation.
@@ -88,6 +97,9 @@ void GodotStep3D::_populate_island(GodotBody3D *p_body, LocalVector<GodotBody3D
 void GodotStep3D::_populate_island_soft_body(GodotSoftBody3D *p_soft_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island) {
 	p_soft_body->set_island_step(_step);
 
+	// Soft body constraints aren't tracked by the space, so islands containing them are rebuilt every step.
+	island_persistent = false;
+
 	for (const GodotConstraint3D *E : p_soft_body->get_constraints()) {
 		GodotConstraint3D *constraint = const_cast<GodotConstraint3D *>(E);
 		if (constraint->get_island_step() == _step) {
@@ -112,9 +124,48 @@ void GodotStep3D::_populate_island_soft_body(GodotSoftBody3D *p_soft_body, Local
 	}
 }
 
-void GodotStep3D::_setup_constraint(uint32_t p_constraint_index, void *p_userdata) {
-	GodotConstraint3D *constraint = all_constraints[p_constraint_index];
-	constraint->setup(delta);
+void GodotStep3D::_restore_island(const GodotSpace3D::Island &p_island, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island) {
+	for (GodotBody3D *body : p_island.bodies) {
+		body->set_island_step(_step);
+		if (body->get_mode() > PhysicsServer3D::BODY_MODE_KINEMATIC) {
+			// Only rigid bodies are tested for activation.
+			p_body_island.push_back(body);
+		}
+	}
+
+	for (GodotConstraint3D *constraint : p_island.constraints) {
+		constraint->set_island_step(_step);
+		p_constraint_island.push_back(constraint);
+		all_constraints.push_back(constraint);
+	}
+}
+
+void GodotStep3D::_store_island(GodotSpace3D *p_space, const LocalVector<GodotConstraint3D *> &p_constraint_island) {
+	uint32_t island_index = p_space->island_create();
+	GodotSpace3D::Island &island = p_space->island_get(island_index);
+	island.bodies = island_bodies;
+	island.constraints = p_constraint_island;
+	for (GodotBody3D *body : island_bodies) {
+		body->set_island(island_index);
+	}
+}
+
+void GodotStep3D::_setup_constraint_batch(uint32_t p_batch_index, void *p_userdata) {
+	uint32_t from = p_batch_index * GodotCollisionBatch3D::MAX_PAIRS;
+	uint32_t to = MIN(from + GodotCollisionBatch3D::MAX_PAIRS, all_constraints.size());
+
+	// Pretest primitive pairs together, so the narrowphase can be skipped for the separated ones.
+	GodotCollisionBatch3D batch;
+	for (uint32_t constraint_index = from; constraint_index < to; ++constraint_index) {
+		all_constraints[constraint_index]->add_to_collision_batch(batch);
+	}
+	if (batch.get_pair_count()) {
+		batch.solve();
+	}
+
+	for (uint32_t constraint_index = from; constraint_index < to; ++constraint_index) {
+		all_constraints[constraint_index]->setup(delta);
+	}
 }
 
 void GodotStep3D::_pre_solve_island(LocalVector<GodotConstraint3D *> &p_constraint_island) const {
@@ -183,6 +234,8 @@ void GodotStep3D::_check_suspend(const LocalVector<GodotBody3D *> &p_body_island
 }
 
 void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
+	_step = last_step.increment();
+
 	p_space->lock(); // can't access space during this
 
 	p_space->setup(); //update inertias, etc
@@ -230,34 +283,8 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 		profile_begtime = profile_endtime;
 	}
 
-	/* GENERATE CONSTRAINT ISLANDS FOR MOVING AREAS */
-
 	uint32_t island_count = 0;
 
-	const SelfList<GodotArea3D>::List &aml = p_space->get_moved_area_list();
-
-	while (aml.first()) {
-		for (GodotConstraint3D *E : aml.first()->self()->get_constraints()) {
-			GodotConstraint3D *constraint = E;
-			if (constraint->get_island_step() == _step) {
-				continue;
-			}
-			constraint->set_island_step(_step);
-
-			// Each constraint can be on a separate island for areas as there's no solving phase.
-			++island_count;
-			if (constraint_islands.size() < island_count) {
-				constraint_islands.resize(island_count);
-			}
-			LocalVector<GodotConstraint3D *> &constraint_island = constraint_islands[island_count - 1];
-			constraint_island.clear();
-
-			all_constraints.push_back(constraint);
-			constraint_island.push_back(constraint);
-		}
-		p_space->area_remove_from_moved_list((SelfList<GodotArea3D> *)aml.first()); //faster to remove here
-	}
-
 	/* GENERATE CONSTRAINT ISLANDS FOR ACTIVE RIGID BODIES */
 
 	b = body_list->first();
@@ -284,7 +311,17 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 			constraint_island.clear();
 			constraint_island.reserve(ISLAND_SIZE_RESERVE);
 
-			_populate_island(body, body_island, constraint_island);
+			if (body->get_island() != -1) {
+				// The island didn't change since it was last built, no need to walk the constraint graph.
+				_restore_island(p_space->island_get(body->get_island()), body_island, constraint_island);
+			} else {
+				island_bodies.clear();
+				island_persistent = true;
+				_populate_island(body, body_island, constraint_island);
+				if (island_persistent) {
+					_store_island(p_space, constraint_island);
+				}
+			}
 
 			if (body_island.is_empty()) {
 				--body_island_count;
@@ -333,6 +370,34 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 		sb = sb->next();
 	}
 
+	/* GENERATE CONSTRAINT ISLANDS FOR MOVING AREAS */
+
+	// Done after body islands, which already contain the area constraints of active bodies.
+
+	const SelfList<GodotArea3D>::List &aml = p_space->get_moved_area_list();
+
+	while (aml.first()) {
+		for (GodotConstraint3D *E : aml.first()->self()->get_constraints()) {
+			GodotConstraint3D *constraint = E;
+			if (constraint->get_island_step() == _step) {
+				continue;
+			}
+			constraint->set_island_step(_step);
+
+			// Each constraint can be on a separate island for areas as there's no solving phase.
+			++island_count;
+			if (constraint_islands.size() < island_count) {
+				constraint_islands.resize(island_count);
+			}
+			LocalVector<GodotConstraint3D *> &constraint_island = constraint_islands[island_count - 1];
+			constraint_island.clear();
+
+			all_constraints.push_back(constraint);
+			constraint_island.push_back(constraint);
+		}
+		p_space->area_remove_from_moved_list((SelfList<GodotArea3D> *)aml.first()); //faster to remove here
+	}
+
 	p_space->set_island_count((int)island_count);
 
 	{ //profile
@@ -344,8 +409,15 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 	/* SETUP CONSTRAINTS / PROCESS COLLISIONS */
 
 	uint32_t total_constraint_count = all_constraints.size();
-	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_setup_constraint, nullptr, total_constraint_count, -1, true, SNAME("Physics3DConstraintSetup"));
-	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	uint32_t constraint_batch_count = (total_constraint_count + GodotCollisionBatch3D::MAX_PAIRS - 1) / GodotCollisionBatch3D::MAX_PAIRS;
+	if (use_thread_pool) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_setup_constraint_batch, nullptr, constraint_batch_count, -1, true, SNAME("Physics3DConstraintSetup"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		for (uint32_t batch_index = 0; batch_index < constraint_batch_count; ++batch_index) {
+			_setup_constraint_batch(batch_index);
+		}
+	}
 
 	{ //profile
 		profile_endtime = OS::get_singleton()->get_ticks_usec();
@@ -364,8 +436,14 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 
 	// WARNING: `_solve_island` modifies the constraint islands for optimization purpose,
 	// their content is not reliable after these calls and shouldn't be used anymore.
-	group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_solve_island, nullptr, island_count, -1, true, SNAME("Physics3DConstraintSolveIslands"));
-	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	if (use_thread_pool) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_solve_island, nullptr, island_count, -1, true, SNAME("Physics3DConstraintSolveIslands"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		for (uint32_t island_index = 0; island_index < island_count; ++island_index) {
+			_solve_island(island_index);
+		}
+	}
 
 	{ //profile
 		profile_endtime = OS::get_singleton()->get_ticks_usec();
@@ -405,7 +483,6 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 	all_constraints.clear();
 
 	p_space->unlock();
-	_step++;
 }
 
 GodotStep3D::GodotStep3D() {
@@ -34,10 +34,15 @@
 #include "godot_space_3d.h"
 
 #include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
 
 class GodotStep3D {
+	// Island stamps must be unique across steppers, since several may be used for different spaces.
+	static SafeNumeric<uint64_t> last_step;
 	uint64_t _step = 1;
 
+	bool use_thread_pool = true;
+
 	int iterations = 0;
 	real_t delta = 0.0;
 
@@ -45,14 +50,23 @@ class GodotStep3D {
 	LocalVector<LocalVector<GodotConstraint3D *>> constraint_islands;
 	LocalVector<GodotConstraint3D *> all_constraints;
 
+	// Bodies reached while populating the current island, used to store it in the space.
+	LocalVector<GodotBody3D *> island_bodies;
+	bool island_persistent = true;
+
 	void _populate_island(GodotBody3D *p_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island);
 	void _populate_island_soft_body(GodotSoftBody3D *p_soft_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island);
-	void _setup_constraint(uint32_t p_constraint_index, void *p_userdata = nullptr);
+	void _restore_island(const GodotSpace3D::Island &p_island, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island);
+	void _store_island(GodotSpace3D *p_space, const LocalVector<GodotConstraint3D *> &p_constraint_island);
+	void _setup_constraint_batch(uint32_t p_batch_index, void *p_userdata = nullptr);
 	void _pre_solve_island(LocalVector<GodotConstraint3D *> &p_constraint_island) const;
 	void _solve_island(uint32_t p_island_index, void *p_userdata = nullptr);
 	void _check_suspend(const LocalVector<GodotBody3D *> &p_body_island) const;
 
 public:
+	// When stepping several spaces concurrently from pool threads, each space's stages run inline instead.
+	void set_use_thread_pool(bool p_enable) { use_thread_pool = p_enable; }
+
 	void step(GodotSpace3D *p_space, real_t p_delta);
 	GodotStep3D();
 	~GodotStep3D();
@@ -0,0 +1,192 @@
+/**************************************************************************/
+/*  test_godot_collision_batch_3d.h                                       */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_GODOT_COLLISION_BATCH_3D_H
+#define TEST_GODOT_COLLISION_BATCH_3D_H
+
+#include "../godot_collision_batch_3d.h"
+#include "../godot_collision_solver_3d.h"
+
+#include "core/math/random_number_generator.h"
+
+#include "tests/test_macros.h"
+
+namespace TestGodotCollisionBatch3D {
+
+struct TestPair {
+	const GodotShape3D *shape_A = nullptr;
+	Transform3D transform_A;
+	const GodotShape3D *shape_B = nullptr;
+	Transform3D transform_B;
+};
+
+static void _count_contact(const Vector3 &p_point_A, int p_index_A, const Vector3 &p_point_B, int p_index_B, const Vector3 &normal, void *p_userdata) {
+	(*(uint64_t *)p_userdata)++;
+}
+
+static Transform3D _random_transform(RandomNumberGenerator &p_rng, real_t p_range) {
+	Vector3 axis = Vector3(p_rng.randf_range(-1, 1), p_rng.randf_range(-1, 1), p_rng.randf_range(-1, 1));
+	if (axis.is_zero_approx()) {
+		axis = Vector3(0, 1, 0);
+	}
+	Basis basis(axis.normalized(), p_rng.randf_range(-Math_PI, Math_PI));
+	return Transform3D(basis, Vector3(p_rng.randf_range(-p_range, p_range), p_rng.randf_range(-p_range, p_range), p_rng.randf_range(-p_range, p_range)));
+}
+
+static void _make_pairs(LocalVector<TestPair> &r_pairs, const LocalVector<const GodotShape3D *> &p_shapes, const GodotShape3D *p_box, uint32_t p_count) {
+	RandomNumberGenerator rng;
+	rng.set_seed(1234);
+	r_pairs.resize(p_count);
+	for (uint32_t i = 0; i < p_count; i++) {
+		TestPair &pair = r_pairs[i];
+		pair.shape_A = p_shapes[i % p_shapes.size()];
+		pair.transform_A = _random_transform(rng, 3.0);
+		pair.shape_B = p_box;
+		pair.transform_B = _random_transform(rng, 3.0);
+		if (i % 2) {
+			SWAP(pair.shape_A, pair.shape_B);
+			SWAP(pair.transform_A, pair.transform_B);
+		}
+	}
+}
+
+TEST_CASE("[Physics][GodotCollisionBatch3D] Primitive pairs reported as separated have no contacts") {
+	GodotSphereShape3D sphere;
+	sphere.set_data(0.5);
+	GodotBoxShape3D box;
+	box.set_data(Vector3(0.5, 1.0, 0.75));
+	GodotCapsuleShape3D capsule;
+	Dictionary capsule_data;
+	capsule_data["radius"] = 0.4;
+	capsule_data["height"] = 2.0;
+	capsule.set_data(capsule_data);
+
+	LocalVector<const GodotShape3D *> shapes;
+	shapes.push_back(&sphere);
+	shapes.push_back(&capsule);
+	shapes.push_back(&box);
+
+	LocalVector<TestPair> pairs;
+	_make_pairs(pairs, shapes, &box, 4096);
+
+	uint32_t separated_count = 0;
+	uint32_t wrongly_separated_count = 0;
+	GodotCollisionBatch3D batch;
+	for (uint32_t from = 0; from < pairs.size(); from += GodotCollisionBatch3D::MAX_PAIRS) {
+		batch.clear();
+		int slots[GodotCollisionBatch3D::MAX_PAIRS];
+		for (uint32_t i = 0; i < GodotCollisionBatch3D::MAX_PAIRS; i++) {
+			const TestPair &pair = pairs[from + i];
+			slots[i] = batch.add(pair.shape_A, pair.transform_A, pair.shape_B, pair.transform_B);
+			CHECK(slots[i] != -1);
+		}
+		batch.solve();
+
+		for (uint32_t i = 0; i < GodotCollisionBatch3D::MAX_PAIRS; i++) {
+			if (!batch.is_separated(slots[i])) {
+				continue;
+			}
+			separated_count++;
+			const TestPair &pair = pairs[from + i];
+			uint64_t contacts = 0;
+			if (GodotCollisionSolver3D::solve_static(pair.shape_A, pair.transform_A, pair.shape_B, pair.transform_B, _count_contact, &contacts)) {
+				wrongly_separated_count++;
+			}
+		}
+	}
+
+	CHECK_MESSAGE(separated_count > 0, "Some of the random pairs should be separated.");
+	CHECK_MESSAGE(wrongly_separated_count == 0, "The pretest must never discard pairs the exact solver reports as colliding.");
+
+	// A capsule parallel to a box edge makes the cross axes degenerate; they must not report a separation.
+	batch.clear();
+	const int aligned = batch.add(&capsule, Transform3D(Basis(), Vector3(0.8, 0.0, 0.0)), &box, Transform3D());
+	const int aligned_offset = batch.add(&capsule, Transform3D(Basis(), Vector3(0.8, 0.5, 0.9)), &box, Transform3D());
+	batch.solve();
+	CHECK_FALSE(batch.is_separated(aligned));
+	CHECK_FALSE(batch.is_separated(aligned_offset));
+
+	// Unsupported pairs are rejected.
+	batch.clear();
+	CHECK(batch.add(&sphere, Transform3D(), &capsule, Transform3D()) == -1);
+	CHECK(batch.add(&box, Transform3D().scaled(Vector3(2, 2, 2)), &box, Transform3D()) == -1);
+}
+
+TEST_CASE("[Physics][GodotCollisionBatch3D] Skipping separated pairs gives the same contacts as the scalar solver") {
+	GodotSphereShape3D sphere;
+	sphere.set_data(0.5);
+	GodotBoxShape3D box;
+	box.set_data(Vector3(0.5, 0.5, 0.5));
+	GodotCapsuleShape3D capsule;
+	Dictionary capsule_data;
+	capsule_data["radius"] = 0.3;
+	capsule_data["height"] = 1.5;
+	capsule.set_data(capsule_data);
+
+	LocalVector<const GodotShape3D *> shapes;
+	shapes.push_back(&sphere);
+	shapes.push_back(&capsule);
+	shapes.push_back(&box);
+
+	const uint32_t pair_count = 1024;
+	LocalVector<TestPair> pairs;
+	_make_pairs(pairs, shapes, &box, pair_count);
+
+	uint64_t scalar_contacts = 0;
+	for (const TestPair &pair : pairs) {
+		GodotCollisionSolver3D::solve_static(pair.shape_A, pair.transform_A, pair.shape_B, pair.transform_B, _count_contact, &scalar_contacts);
+	}
+
+	uint64_t batched_contacts = 0;
+	GodotCollisionBatch3D batch;
+	for (uint32_t from = 0; from < pair_count; from += GodotCollisionBatch3D::MAX_PAIRS) {
+		batch.clear();
+		int slots[GodotCollisionBatch3D::MAX_PAIRS];
+		for (uint32_t i = 0; i < GodotCollisionBatch3D::MAX_PAIRS; i++) {
+			const TestPair &pair = pairs[from + i];
+			slots[i] = batch.add(pair.shape_A, pair.transform_A, pair.shape_B, pair.transform_B);
+		}
+		batch.solve();
+		for (uint32_t i = 0; i < GodotCollisionBatch3D::MAX_PAIRS; i++) {
+			if (slots[i] != -1 && batch.is_separated(slots[i])) {
+				continue;
+			}
+			const TestPair &pair = pairs[from + i];
+			GodotCollisionSolver3D::solve_static(pair.shape_A, pair.transform_A, pair.shape_B, pair.transform_B, _count_contact, &batched_contacts);
+		}
+	}
+
+	CHECK_MESSAGE(scalar_contacts > 0, "Some of the random pairs should collide.");
+	CHECK_MESSAGE(batched_contacts == scalar_contacts, "Both paths must generate the same contacts.");
+}
+
+} // namespace TestGodotCollisionBatch3D
+
+#endif // TEST_GODOT_COLLISION_BATCH_3D_H
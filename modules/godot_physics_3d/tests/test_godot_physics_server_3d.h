@@ -0,0 +1,161 @@
+/**************************************************************************/
+/*  test_godot_physics_server_3d.h                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_GODOT_PHYSICS_SERVER_3D_H
+#define TEST_GODOT_PHYSICS_SERVER_3D_H
+
+#include "../godot_physics_server_3d.h"
+
+#include "tests/test_macros.h"
+
+class TestGodotPhysicsServer3DInternalsAccessor {
+public:
+	static void set_step_spaces_in_parallel(GodotPhysicsServer3D *p_server, bool p_enabled) {
+		p_server->step_spaces_in_parallel = p_enabled;
+	}
+	static bool is_step_spaces_in_parallel(const GodotPhysicsServer3D *p_server) {
+		return p_server->step_spaces_in_parallel;
+	}
+};
+
+namespace TestGodotPhysicsServer3D {
+
+static LocalVector<int> state_sync_counts;
+
+static void _body_state_synced(PhysicsDirectBodyState3D *p_state, int p_index) {
+	state_sync_counts[p_index]++;
+}
+
+// Steps a few spaces with falling spheres and returns every body's transform after each step,
+// along with how many state sync callbacks each body got.
+static LocalVector<Transform3D> _step_spaces(GodotPhysicsServer3D *p_server, bool p_parallel, LocalVector<int> &r_state_sync_counts) {
+	const int space_count = 3;
+	const int spheres_per_space = 4;
+	const int steps = 120;
+
+	RID floor_shape = p_server->box_shape_create();
+	p_server->shape_set_data(floor_shape, Vector3(10, 1, 10));
+	RID sphere_shape = p_server->sphere_shape_create();
+	p_server->shape_set_data(sphere_shape, 0.5);
+
+	LocalVector<RID> spaces;
+	LocalVector<RID> bodies;
+	for (int i = 0; i < space_count; i++) {
+		RID space = p_server->space_create();
+		p_server->space_set_active(space, true);
+		spaces.push_back(space);
+
+		RID floor = p_server->body_create();
+		p_server->body_set_mode(floor, PhysicsServer3D::BODY_MODE_STATIC);
+		p_server->body_add_shape(floor, floor_shape);
+		p_server->body_set_state(floor, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(0, -1, 0)));
+		p_server->body_set_space(floor, space);
+		bodies.push_back(floor);
+
+		// Each space gets a different layout, so they don't all do the same work.
+		for (int j = 0; j < spheres_per_space; j++) {
+			RID sphere = p_server->body_create();
+			p_server->body_set_mode(sphere, PhysicsServer3D::BODY_MODE_RIGID);
+			p_server->body_add_shape(sphere, sphere_shape);
+			p_server->body_set_state(sphere, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(j * 0.6 - 1.0, 1.0 + j * 0.9 + i * 0.3, i * 0.2)));
+			p_server->body_set_state_sync_callback(sphere, callable_mp_static(&_body_state_synced).bind(int(bodies.size())));
+			p_server->body_set_space(sphere, space);
+			bodies.push_back(sphere);
+		}
+	}
+
+	state_sync_counts.clear();
+	state_sync_counts.resize(bodies.size());
+	for (int &count : state_sync_counts) {
+		count = 0;
+	}
+
+	const bool prev_parallel = TestGodotPhysicsServer3DInternalsAccessor::is_step_spaces_in_parallel(p_server);
+	TestGodotPhysicsServer3DInternalsAccessor::set_step_spaces_in_parallel(p_server, p_parallel);
+
+	LocalVector<Transform3D> transforms;
+	for (int step = 0; step < steps; step++) {
+		p_server->step(1.0 / 60.0);
+		p_server->flush_queries();
+		for (const RID &body : bodies) {
+			transforms.push_back(p_server->body_get_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM));
+		}
+	}
+
+	TestGodotPhysicsServer3DInternalsAccessor::set_step_spaces_in_parallel(p_server, prev_parallel);
+	r_state_sync_counts = state_sync_counts;
+
+	for (const RID &body : bodies) {
+		p_server->free(body);
+	}
+	for (const RID &space : spaces) {
+		p_server->free(space);
+	}
+	p_server->free(sphere_shape);
+	p_server->free(floor_shape);
+
+	return transforms;
+}
+
+TEST_CASE("[SceneTree][GodotPhysicsServer3D] Stepping spaces in parallel gives the same results as serially") {
+	GodotPhysicsServer3D *server = Object::cast_to<GodotPhysicsServer3D>(PhysicsServer3D::get_singleton());
+	REQUIRE_MESSAGE(server, "The tests must run with GodotPhysics3D as the physics server.");
+
+	LocalVector<int> serial_state_sync_counts;
+	const LocalVector<Transform3D> serial = _step_spaces(server, false, serial_state_sync_counts);
+	LocalVector<int> parallel_state_sync_counts;
+	const LocalVector<Transform3D> parallel = _step_spaces(server, true, parallel_state_sync_counts);
+
+	REQUIRE(parallel.size() == serial.size());
+	bool same_transforms = true;
+	for (uint32_t i = 0; i < serial.size(); i++) {
+		same_transforms = same_transforms && parallel[i] == serial[i];
+	}
+	CHECK_MESSAGE(same_transforms, "Bodies should move exactly the same way in both modes.");
+
+	// The last sphere must have fallen from 4.3 and landed on the floor, so the comparison above means something.
+	CHECK(serial[serial.size() - 1].origin.y < 3.0);
+	CHECK(serial[serial.size() - 1].origin.y > 0.0);
+
+	REQUIRE(parallel_state_sync_counts.size() == serial_state_sync_counts.size());
+	bool same_callbacks = true;
+	bool all_called = true;
+	for (uint32_t i = 0; i < serial_state_sync_counts.size(); i++) {
+		same_callbacks = same_callbacks && parallel_state_sync_counts[i] == serial_state_sync_counts[i];
+		// Only the spheres have a callback. The floor is the first body of each space.
+		all_called = all_called && (i % 5 == 0 || serial_state_sync_counts[i] > 0);
+	}
+	CHECK_MESSAGE(same_callbacks, "Every body should get the same state sync callbacks in both modes.");
+	CHECK(all_called);
+}
+
+} // namespace TestGodotPhysicsServer3D
+
+#endif // TEST_GODOT_PHYSICS_SERVER_3D_H
@@ -0,0 +1,287 @@
+/**************************************************************************/
+/*  test_godot_space_3d.h                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_GODOT_SPACE_3D_H
+#define TEST_GODOT_SPACE_3D_H
+
+#include "../godot_physics_server_3d.h"
+
+#include "core/math/random_pcg.h"
+#include "tests/test_macros.h"
+
+namespace TestGodotSpace3D {
+
+// Batches of up to 64 queries run on the calling thread, bigger ones are split in chunks run on the thread pool.
+const int SERIAL_QUERY_COUNT = 40;
+const int THREADED_QUERY_COUNT = 500;
+
+// A grid of static boxes with gaps between them, so queries can hit or miss.
+struct QueryScene {
+	PhysicsServer3D *server = nullptr;
+	RID space;
+	RID box_shape;
+	RID query_shape;
+	LocalVector<RID> boxes;
+
+	QueryScene(PhysicsServer3D *p_server) {
+		server = p_server;
+
+		space = server->space_create();
+		server->space_set_active(space, true);
+
+		box_shape = server->box_shape_create();
+		server->shape_set_data(box_shape, Vector3(0.5, 0.5, 0.5));
+		query_shape = server->sphere_shape_create();
+		server->shape_set_data(query_shape, 0.6);
+
+		for (int x = 0; x < 6; x++) {
+			for (int z = 0; z < 6; z++) {
+				RID box = server->body_create();
+				server->body_set_mode(box, PhysicsServer3D::BODY_MODE_STATIC);
+				server->body_add_shape(box, box_shape);
+				server->body_set_state(box, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(x * 2.0, 0, z * 2.0)));
+				server->body_set_space(box, space);
+				boxes.push_back(box);
+			}
+		}
+
+		// Puts the new shapes in the broadphase.
+		server->step(1.0 / 60.0);
+		server->flush_queries();
+	}
+
+	~QueryScene() {
+		for (const RID &box : boxes) {
+			server->free(box);
+		}
+		server->free(space);
+		server->free(query_shape);
+		server->free(box_shape);
+	}
+};
+
+static Vector3 _random_point(RandomPCG &p_rng, real_t p_y) {
+	return Vector3(p_rng.random(-2.0, 12.0), p_y, p_rng.random(-2.0, 12.0));
+}
+
+TEST_CASE("[SceneTree][GodotPhysicsDirectSpaceState3D] Batched rays match single rays") {
+	PhysicsServer3D *server = PhysicsServer3D::get_singleton();
+	REQUIRE_MESSAGE(Object::cast_to<GodotPhysicsServer3D>(server), "The tests must run with GodotPhysics3D as the physics server.");
+
+	QueryScene scene(server);
+	PhysicsDirectSpaceState3D *space_state = server->space_get_direct_state(scene.space);
+	REQUIRE(space_state);
+
+	PhysicsDirectSpaceState3D::RayParameters parameters;
+	parameters.exclude.insert(scene.boxes[7]);
+
+	for (int count : { SERIAL_QUERY_COUNT, THREADED_QUERY_COUNT }) {
+		RandomPCG rng(count);
+		LocalVector<Vector3> from;
+		LocalVector<Vector3> to;
+		for (int i = 0; i < count; i++) {
+			from.push_back(_random_point(rng, 3.0));
+			to.push_back(from[i] + Vector3(rng.random(-1.0, 1.0), -6.0, rng.random(-1.0, 1.0)));
+		}
+
+		LocalVector<PhysicsDirectSpaceState3D::RayResult> results;
+		results.resize(count);
+		LocalVector<bool> collided;
+		collided.resize(count);
+		const int collided_count = space_state->intersect_rays(parameters, from.ptr(), to.ptr(), count, results.ptr(), collided.ptr());
+
+		int expected_collided_count = 0;
+		bool same_results = true;
+		bool hit_excluded = false;
+		for (int i = 0; i < count; i++) {
+			PhysicsDirectSpaceState3D::RayParameters single_parameters = parameters;
+			single_parameters.from = from[i];
+			single_parameters.to = to[i];
+			PhysicsDirectSpaceState3D::RayResult single_result;
+			const bool single_collided = space_state->intersect_ray(single_parameters, single_result);
+
+			same_results = same_results && collided[i] == single_collided;
+			if (single_collided) {
+				expected_collided_count++;
+				same_results = same_results && results[i].position == single_result.position && results[i].normal == single_result.normal && results[i].rid == single_result.rid && results[i].collider_id == single_result.collider_id && results[i].shape == single_result.shape && results[i].face_index == single_result.face_index;
+			}
+			hit_excluded = hit_excluded || (collided[i] && results[i].rid == scene.boxes[7]);
+		}
+
+		CHECK_MESSAGE(same_results, "Every batched ray should give the same result as a single ray, with ", count, " rays.");
+		CHECK(collided_count == expected_collided_count);
+		CHECK_MESSAGE(!hit_excluded, "Batched rays should skip excluded bodies.");
+		// Make sure the batch has both hits and misses.
+		CHECK(collided_count > 0);
+		CHECK(collided_count < count);
+	}
+
+	// Without the exclusion, rays straight down on the excluded box hit it.
+	parameters.exclude.clear();
+	Vector3 from[2] = { Vector3(2, 3, 2), Vector3(3, 3, 3) };
+	Vector3 to[2] = { Vector3(2, -3, 2), Vector3(3, -3, 3) };
+	PhysicsDirectSpaceState3D::RayResult results[2];
+	bool collided[2];
+	CHECK(space_state->intersect_rays(parameters, from, to, 2, results, collided) == 1);
+	CHECK(collided[0]);
+	CHECK(results[0].rid == scene.boxes[7]);
+	CHECK_FALSE(collided[1]);
+}
+
+TEST_CASE("[SceneTree][GodotPhysicsDirectSpaceState3D] Batched motion casts match single motion casts") {
+	PhysicsServer3D *server = PhysicsServer3D::get_singleton();
+	REQUIRE_MESSAGE(Object::cast_to<GodotPhysicsServer3D>(server), "The tests must run with GodotPhysics3D as the physics server.");
+
+	QueryScene scene(server);
+	PhysicsDirectSpaceState3D *space_state = server->space_get_direct_state(scene.space);
+	REQUIRE(space_state);
+
+	PhysicsDirectSpaceState3D::ShapeParameters parameters;
+	parameters.shape_rid = scene.query_shape;
+	parameters.exclude.insert(scene.boxes[7]);
+
+	for (int count : { SERIAL_QUERY_COUNT, THREADED_QUERY_COUNT }) {
+		RandomPCG rng(count);
+		LocalVector<Vector3> origins;
+		LocalVector<Vector3> motions;
+		for (int i = 0; i < count; i++) {
+			origins.push_back(_random_point(rng, 3.0));
+			motions.push_back(Vector3(rng.random(-1.0, 1.0), -6.0, rng.random(-1.0, 1.0)));
+		}
+
+		LocalVector<real_t> closest_safe;
+		closest_safe.resize(count);
+		LocalVector<real_t> closest_unsafe;
+		closest_unsafe.resize(count);
+		REQUIRE(space_state->cast_motions(parameters, origins.ptr(), motions.ptr(), count, closest_safe.ptr(), closest_unsafe.ptr()));
+
+		bool same_results = true;
+		int blocked_count = 0;
+		for (int i = 0; i < count; i++) {
+			PhysicsDirectSpaceState3D::ShapeParameters single_parameters = parameters;
+			single_parameters.transform.origin = origins[i];
+			single_parameters.motion = motions[i];
+			real_t single_safe = 1.0;
+			real_t single_unsafe = 1.0;
+			REQUIRE(space_state->cast_motion(single_parameters, single_safe, single_unsafe));
+
+			same_results = same_results && closest_safe[i] == single_safe && closest_unsafe[i] == single_unsafe;
+			if (single_safe < 1.0) {
+				blocked_count++;
+			}
+		}
+
+		CHECK_MESSAGE(same_results, "Every batched motion cast should give the same result as a single one, with ", count, " casts.");
+		// Make sure the batch has both blocked and free motions.
+		CHECK(blocked_count > 0);
+		CHECK(blocked_count < count);
+	}
+
+	// The excluded box doesn't block the motion, the one next to it does.
+	Vector3 origins[2] = { Vector3(2, 3, 2), Vector3(2, 3, 4) };
+	Vector3 motions[2] = { Vector3(0, -6, 0), Vector3(0, -6, 0) };
+	real_t closest_safe[2];
+	real_t closest_unsafe[2];
+	REQUIRE(space_state->cast_motions(parameters, origins, motions, 2, closest_safe, closest_unsafe));
+	CHECK(closest_safe[0] == 1.0);
+	CHECK(closest_safe[1] < 1.0);
+}
+
+TEST_CASE("[SceneTree][GodotPhysicsDirectSpaceState3D] Batched shape intersections match single shape intersections") {
+	PhysicsServer3D *server = PhysicsServer3D::get_singleton();
+	REQUIRE_MESSAGE(Object::cast_to<GodotPhysicsServer3D>(server), "The tests must run with GodotPhysics3D as the physics server.");
+
+	QueryScene scene(server);
+	PhysicsDirectSpaceState3D *space_state = server->space_get_direct_state(scene.space);
+	REQUIRE(space_state);
+
+	PhysicsDirectSpaceState3D::ShapeParameters parameters;
+	parameters.shape_rid = scene.query_shape;
+	parameters.exclude.insert(scene.boxes[7]);
+
+	const int result_max = 4;
+
+	for (int count : { SERIAL_QUERY_COUNT, THREADED_QUERY_COUNT }) {
+		RandomPCG rng(count);
+		LocalVector<Vector3> origins;
+		for (int i = 0; i < count; i++) {
+			origins.push_back(_random_point(rng, rng.random(-1.0, 1.0)));
+		}
+
+		LocalVector<PhysicsDirectSpaceState3D::ShapeResult> results;
+		results.resize(count * result_max);
+		LocalVector<int> result_counts;
+		result_counts.resize(count);
+		const int result_count = space_state->intersect_shapes(parameters, origins.ptr(), count, results.ptr(), result_max, result_counts.ptr());
+
+		int expected_result_count = 0;
+		int missed_count = 0;
+		bool same_results = true;
+		bool hit_excluded = false;
+		for (int i = 0; i < count; i++) {
+			PhysicsDirectSpaceState3D::ShapeParameters single_parameters = parameters;
+			single_parameters.transform.origin = origins[i];
+			PhysicsDirectSpaceState3D::ShapeResult single_results[result_max];
+			const int single_count = space_state->intersect_shape(single_parameters, single_results, result_max);
+
+			expected_result_count += single_count;
+			if (single_count == 0) {
+				missed_count++;
+			}
+			same_results = same_results && result_counts[i] == single_count;
+			for (int j = 0; j < MIN(result_counts[i], single_count); j++) {
+				const PhysicsDirectSpaceState3D::ShapeResult &result = results[i * result_max + j];
+				same_results = same_results && result.rid == single_results[j].rid && result.collider_id == single_results[j].collider_id && result.shape == single_results[j].shape;
+				hit_excluded = hit_excluded || result.rid == scene.boxes[7];
+			}
+		}
+
+		CHECK_MESSAGE(same_results, "Every batched shape query should give the same results as a single one, with ", count, " queries.");
+		CHECK(result_count == expected_result_count);
+		CHECK_MESSAGE(!hit_excluded, "Batched shape queries should skip excluded bodies.");
+		// Make sure the batch has both hits and misses.
+		CHECK(missed_count > 0);
+		CHECK(missed_count < count);
+	}
+
+	// Without the exclusion, a sphere on top of the excluded box intersects it.
+	parameters.exclude.clear();
+	Vector3 origins[2] = { Vector3(2, 0, 2), Vector3(3, 0, 3) };
+	PhysicsDirectSpaceState3D::ShapeResult results[2 * result_max];
+	int result_counts[2];
+	CHECK(space_state->intersect_shapes(parameters, origins, 2, results, result_max, result_counts) == 1);
+	CHECK(result_counts[0] == 1);
+	CHECK(results[0].rid == scene.boxes[7]);
+	CHECK(result_counts[1] == 0);
+}
+
+} // namespace TestGodotSpace3D
+
+#endif // TEST_GODOT_SPACE_3D_H
@@ -0,0 +1,310 @@
+/**************************************************************************/
+/*  test_godot_space_snapshot_3d.h                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_GODOT_SPACE_SNAPSHOT_3D_H
+#define TEST_GODOT_SPACE_SNAPSHOT_3D_H
+
+#include "../godot_physics_server_3d.h"
+
+#include "core/templates/pair.h"
+#include "tests/test_macros.h"
+
+namespace TestGodotSpaceSnapshot3D {
+
+// A row of static boxes and a sphere, queried through a snapshot and through the space's direct state.
+struct SnapshotScene {
+	PhysicsServer3D *server = nullptr;
+	RID space;
+	RID box_shape;
+	RID sphere_shape;
+	RID query_shape;
+	LocalVector<RID> bodies;
+	PhysicsDirectSpaceState3D *direct_state = nullptr;
+	PhysicsDirectSpaceState3D *snapshot_state = nullptr;
+
+	SnapshotScene(PhysicsServer3D *p_server) {
+		server = p_server;
+
+		space = server->space_create();
+		server->space_set_active(space, true);
+
+		box_shape = server->box_shape_create();
+		server->shape_set_data(box_shape, Vector3(1, 1, 1));
+		sphere_shape = server->sphere_shape_create();
+		server->shape_set_data(sphere_shape, 1.0);
+		query_shape = server->sphere_shape_create();
+		server->shape_set_data(query_shape, 0.6);
+
+		for (int i = 0; i < 4; i++) {
+			bodies.push_back(_add_body(box_shape, Vector3(i * 3.0, 0, 0)));
+		}
+		bodies.push_back(_add_body(sphere_shape, Vector3(0, 0, 3)));
+
+		direct_state = server->space_get_direct_state(space);
+		snapshot_state = server->space_get_snapshot_state(space);
+
+		// Publishes the first snapshot.
+		step();
+	}
+
+	RID _add_body(const RID &p_shape, const Vector3 &p_position) {
+		RID body = server->body_create();
+		server->body_set_mode(body, PhysicsServer3D::BODY_MODE_STATIC);
+		server->body_add_shape(body, p_shape);
+		server->body_set_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), p_position));
+		server->body_set_space(body, space);
+		return body;
+	}
+
+	void step() {
+		server->step(1.0 / 60.0);
+		server->flush_queries();
+	}
+
+	~SnapshotScene() {
+		for (const RID &body : bodies) {
+			server->free(body);
+		}
+		server->free(space);
+		server->free(query_shape);
+		server->free(sphere_shape);
+		server->free(box_shape);
+	}
+};
+
+static bool _intersect_ray(PhysicsDirectSpaceState3D *p_state, const Vector3 &p_from, const Vector3 &p_to, PhysicsDirectSpaceState3D::RayResult &r_result) {
+	PhysicsDirectSpaceState3D::RayParameters parameters;
+	parameters.from = p_from;
+	parameters.to = p_to;
+	return p_state->intersect_ray(parameters, r_result);
+}
+
+// Order of results depends on how each state culls, so they're compared as sets.
+typedef HashSet<Pair<RID, int>, PairHash<RID, int>> ShapeResultSet;
+
+static ShapeResultSet _intersect_shape(PhysicsDirectSpaceState3D *p_state, const PhysicsDirectSpaceState3D::ShapeParameters &p_parameters) {
+	PhysicsDirectSpaceState3D::ShapeResult results[8];
+	int count = p_state->intersect_shape(p_parameters, results, 8);
+	ShapeResultSet result_set;
+	for (int i = 0; i < count; i++) {
+		result_set.insert(Pair<RID, int>(results[i].rid, results[i].shape));
+	}
+	return result_set;
+}
+
+static ShapeResultSet _intersect_point(PhysicsDirectSpaceState3D *p_state, const Vector3 &p_point) {
+	PhysicsDirectSpaceState3D::PointParameters parameters;
+	parameters.position = p_point;
+	PhysicsDirectSpaceState3D::ShapeResult results[8];
+	int count = p_state->intersect_point(parameters, results, 8);
+	ShapeResultSet result_set;
+	for (int i = 0; i < count; i++) {
+		result_set.insert(Pair<RID, int>(results[i].rid, results[i].shape));
+	}
+	return result_set;
+}
+
+static bool _same_sets(const ShapeResultSet &p_a, const ShapeResultSet &p_b) {
+	if (p_a.size() != p_b.size()) {
+		return false;
+	}
+	for (const Pair<RID, int> &E : p_a) {
+		if (!p_b.has(E)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+TEST_CASE("[SceneTree][GodotPhysicsDirectSpaceSnapshotState3D] Snapshot queries match the space's direct state") {
+	PhysicsServer3D *server = PhysicsServer3D::get_singleton();
+	REQUIRE_MESSAGE(Object::cast_to<GodotPhysicsServer3D>(server), "The tests must run with GodotPhysics3D as the physics server.");
+
+	SnapshotScene scene(server);
+	REQUIRE(scene.snapshot_state);
+
+	SUBCASE("Rays") {
+		const Vector3 from[4] = { Vector3(0, 5, 0), Vector3(3, 5, 0.5), Vector3(1.5, 5, 0), Vector3(-5, 0, 3) };
+		const Vector3 to[4] = { Vector3(0, -5, 0), Vector3(3, -5, 0.5), Vector3(1.5, -5, 0), Vector3(5, 0, 3) };
+		for (int i = 0; i < 4; i++) {
+			PhysicsDirectSpaceState3D::RayResult direct_result;
+			PhysicsDirectSpaceState3D::RayResult snapshot_result;
+			const bool direct_collided = _intersect_ray(scene.direct_state, from[i], to[i], direct_result);
+			const bool snapshot_collided = _intersect_ray(scene.snapshot_state, from[i], to[i], snapshot_result);
+			CHECK(snapshot_collided == direct_collided);
+			if (direct_collided && snapshot_collided) {
+				CHECK(snapshot_result.rid == direct_result.rid);
+				CHECK(snapshot_result.shape == direct_result.shape);
+				CHECK(snapshot_result.position.is_equal_approx(direct_result.position));
+				CHECK(snapshot_result.normal.is_equal_approx(direct_result.normal));
+			}
+		}
+	}
+
+	SUBCASE("Points") {
+		const Vector3 points[3] = { Vector3(0.5, 0.5, 0.5), Vector3(0, 0, 3.5), Vector3(1.5, 0, 0) };
+		for (const Vector3 &point : points) {
+			CHECK(_same_sets(_intersect_point(scene.snapshot_state, point), _intersect_point(scene.direct_state, point)));
+		}
+		CHECK(_intersect_point(scene.snapshot_state, points[0]).size() == 1);
+		CHECK(_intersect_point(scene.snapshot_state, points[2]).is_empty());
+	}
+
+	SUBCASE("Shapes") {
+		PhysicsDirectSpaceState3D::ShapeParameters parameters;
+		parameters.shape_rid = scene.query_shape;
+		const Vector3 origins[3] = { Vector3(1.5, 0, 0), Vector3(0, 0, 1.7), Vector3(-3, 0, -3) };
+		for (const Vector3 &origin : origins) {
+			parameters.transform.origin = origin;
+			CHECK(_same_sets(_intersect_shape(scene.snapshot_state, parameters), _intersect_shape(scene.direct_state, parameters)));
+		}
+		parameters.transform.origin = origins[0];
+		CHECK(_intersect_shape(scene.snapshot_state, parameters).size() == 2);
+	}
+
+	SUBCASE("Motion casts") {
+		PhysicsDirectSpaceState3D::ShapeParameters parameters;
+		parameters.shape_rid = scene.query_shape;
+		parameters.transform.origin = Vector3(3, 5, 0);
+		parameters.motion = Vector3(0, -10, 0);
+
+		real_t direct_safe = 1.0, direct_unsafe = 1.0;
+		PhysicsDirectSpaceState3D::ShapeRestInfo direct_info;
+		REQUIRE(scene.direct_state->cast_motion(parameters, direct_safe, direct_unsafe, &direct_info));
+		real_t snapshot_safe = 1.0, snapshot_unsafe = 1.0;
+		PhysicsDirectSpaceState3D::ShapeRestInfo snapshot_info;
+		REQUIRE(scene.snapshot_state->cast_motion(parameters, snapshot_safe, snapshot_unsafe, &snapshot_info));
+
+		CHECK(direct_safe < 1.0);
+		CHECK(snapshot_safe == direct_safe);
+		CHECK(snapshot_unsafe == direct_unsafe);
+		CHECK(snapshot_info.rid == direct_info.rid);
+		CHECK(snapshot_info.point.is_equal_approx(direct_info.point));
+	}
+
+	SUBCASE("Contacts and rest info") {
+		PhysicsDirectSpaceState3D::ShapeParameters parameters;
+		parameters.shape_rid = scene.query_shape;
+		parameters.transform.origin = Vector3(3, 1.4, 0);
+
+		Vector3 direct_points[16];
+		int direct_count = 0;
+		const bool direct_collided = scene.direct_state->collide_shape(parameters, direct_points, 8, direct_count);
+		Vector3 snapshot_points[16];
+		int snapshot_count = 0;
+		const bool snapshot_collided = scene.snapshot_state->collide_shape(parameters, snapshot_points, 8, snapshot_count);
+		CHECK(direct_collided);
+		CHECK(snapshot_collided == direct_collided);
+		CHECK(snapshot_count == direct_count);
+		for (int i = 0; i < MIN(snapshot_count, direct_count); i++) {
+			CHECK(snapshot_points[i].is_equal_approx(direct_points[i]));
+		}
+
+		PhysicsDirectSpaceState3D::ShapeRestInfo direct_info;
+		PhysicsDirectSpaceState3D::ShapeRestInfo snapshot_info;
+		REQUIRE(scene.direct_state->rest_info(parameters, &direct_info));
+		REQUIRE(scene.snapshot_state->rest_info(parameters, &snapshot_info));
+		CHECK(snapshot_info.rid == direct_info.rid);
+		CHECK(snapshot_info.rid == scene.bodies[1]);
+		CHECK(snapshot_info.point.is_equal_approx(direct_info.point));
+		CHECK(snapshot_info.normal.is_equal_approx(direct_info.normal));
+	}
+
+	SUBCASE("Closest point to an object") {
+		const Vector3 point(3, 4, 0);
+		const Vector3 direct_point = scene.direct_state->get_closest_point_to_object_volume(scene.bodies[1], point);
+		CHECK(direct_point.is_equal_approx(Vector3(3, 1, 0)));
+		CHECK(scene.snapshot_state->get_closest_point_to_object_volume(scene.bodies[1], point).is_equal_approx(direct_point));
+	}
+}
+
+TEST_CASE("[SceneTree][GodotPhysicsDirectSpaceSnapshotState3D] Snapshot queries stay the same until the next step") {
+	PhysicsServer3D *server = PhysicsServer3D::get_singleton();
+	REQUIRE_MESSAGE(Object::cast_to<GodotPhysicsServer3D>(server), "The tests must run with GodotPhysics3D as the physics server.");
+
+	SnapshotScene scene(server);
+	REQUIRE(scene.snapshot_state);
+
+	const Vector3 from(0, 5, 0);
+	const Vector3 to(0, -5, 0);
+	PhysicsDirectSpaceState3D::RayResult result;
+
+	SUBCASE("Moving a body") {
+		server->body_set_state(scene.bodies[0], PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(0, 0, -10)));
+
+		CHECK_FALSE(_intersect_ray(scene.direct_state, from, to, result));
+		REQUIRE(_intersect_ray(scene.snapshot_state, from, to, result));
+		CHECK(result.rid == scene.bodies[0]);
+		CHECK(result.position.is_equal_approx(Vector3(0, 1, 0)));
+		CHECK(scene.snapshot_state->get_closest_point_to_object_volume(scene.bodies[0], Vector3(0, 4, 0)).is_equal_approx(Vector3(0, 1, 0)));
+
+		scene.step();
+
+		CHECK_FALSE(_intersect_ray(scene.snapshot_state, from, to, result));
+		CHECK(scene.snapshot_state->get_closest_point_to_object_volume(scene.bodies[0], Vector3(0, 4, 0)).is_equal_approx(Vector3(0, 1, -9)));
+	}
+
+	SUBCASE("Changing a shape") {
+		server->shape_set_data(scene.box_shape, Vector3(2, 2, 2));
+
+		REQUIRE(_intersect_ray(scene.direct_state, from, to, result));
+		CHECK(result.position.is_equal_approx(Vector3(0, 2, 0)));
+		REQUIRE(_intersect_ray(scene.snapshot_state, from, to, result));
+		CHECK_MESSAGE(result.position.is_equal_approx(Vector3(0, 1, 0)), "The snapshot should keep the shape as it was when it was taken.");
+		CHECK(Vector3(server->shape_get_data(scene.box_shape)) == Vector3(2, 2, 2));
+
+		scene.step();
+
+		REQUIRE(_intersect_ray(scene.snapshot_state, from, to, result));
+		CHECK(result.position.is_equal_approx(Vector3(0, 2, 0)));
+	}
+
+	SUBCASE("Freeing a shape") {
+		PhysicsDirectSpaceState3D::ShapeParameters parameters;
+		parameters.shape_rid = scene.query_shape;
+		parameters.transform.origin = Vector3(1.5, 0, 0);
+		CHECK(_intersect_shape(scene.snapshot_state, parameters).size() == 2);
+
+		// The sphere body loses its shape, which stays in the snapshot until the next step.
+		server->free(scene.sphere_shape);
+		scene.sphere_shape = server->sphere_shape_create();
+
+		REQUIRE(_intersect_ray(scene.snapshot_state, Vector3(-5, 0, 3), Vector3(5, 0, 3), result));
+		CHECK(result.rid == scene.bodies[4]);
+
+		scene.step();
+
+		CHECK_FALSE(_intersect_ray(scene.snapshot_state, Vector3(-5, 0, 3), Vector3(5, 0, 3), result));
+	}
+}
+
+} // namespace TestGodotSpaceSnapshot3D
+
+#endif // TEST_GODOT_SPACE_SNAPSHOT_3D_H
@@ -0,0 +1,113 @@
+/**************************************************************************/
+/*  test_godot_step_3d.h                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_GODOT_STEP_3D_H
+#define TEST_GODOT_STEP_3D_H
+
+#include "../godot_area_3d.h"
+#include "../godot_body_3d.h"
+#include "../godot_space_3d.h"
+#include "../godot_step_3d.h"
+#include "../joints/godot_pin_joint_3d.h"
+
+#include "tests/test_macros.h"
+
+namespace TestGodotStep3D {
+
+TEST_CASE("[SceneTree][GodotStep3D] Islands merge when a static body connecting them becomes rigid") {
+	GodotSpace3D *space = memnew(GodotSpace3D);
+	GodotArea3D *default_area = memnew(GodotArea3D);
+	space->set_default_area(default_area);
+	default_area->set_space(space);
+	default_area->set_priority(-1);
+
+	GodotBody3D *body_a = memnew(GodotBody3D);
+	GodotBody3D *body_b = memnew(GodotBody3D);
+	GodotBody3D *hinge = memnew(GodotBody3D);
+	body_a->set_space(space);
+	body_b->set_space(space);
+	hinge->set_space(space);
+	body_a->set_mode(PhysicsServer3D::BODY_MODE_RIGID);
+	body_b->set_mode(PhysicsServer3D::BODY_MODE_RIGID);
+	hinge->set_mode(PhysicsServer3D::BODY_MODE_STATIC);
+
+	GodotPinJoint3D *joint_a = memnew(GodotPinJoint3D(body_a, Vector3(), hinge, Vector3(-1, 0, 0)));
+	GodotPinJoint3D *joint_b = memnew(GodotPinJoint3D(body_b, Vector3(), hinge, Vector3(1, 0, 0)));
+
+	GodotStep3D *stepper = memnew(GodotStep3D);
+	stepper->step(space, 1.0 / 60.0);
+
+	// The static body doesn't connect the two rigid bodies.
+	REQUIRE(body_a->get_island() != -1);
+	REQUIRE(body_b->get_island() != -1);
+	CHECK(body_a->get_island() != body_b->get_island());
+	CHECK(hinge->get_island() == -1);
+	CHECK(space->island_get(body_a->get_island()).constraints.size() == 1);
+	CHECK(space->island_get(body_b->get_island()).constraints.size() == 1);
+
+	hinge->set_mode(PhysicsServer3D::BODY_MODE_RIGID);
+	CHECK_MESSAGE(body_a->get_island() == -1, "Islands of bodies touching a body that stops being static must be invalidated.");
+	CHECK_MESSAGE(body_b->get_island() == -1, "Islands of bodies touching a body that stops being static must be invalidated.");
+
+	stepper->step(space, 1.0 / 60.0);
+
+	REQUIRE(body_a->get_island() != -1);
+	CHECK(body_b->get_island() == body_a->get_island());
+	CHECK(hinge->get_island() == body_a->get_island());
+	const GodotSpace3D::Island &merged = space->island_get(body_a->get_island());
+	CHECK(merged.bodies.size() == 3);
+	CHECK(merged.constraints.size() == 2);
+
+	// Removing a joint splits the island again on the next step.
+	memdelete(joint_b);
+	CHECK(body_a->get_island() == -1);
+	stepper->step(space, 1.0 / 60.0);
+	REQUIRE(body_a->get_island() != -1);
+	CHECK(hinge->get_island() == body_a->get_island());
+	CHECK(body_b->get_island() != body_a->get_island());
+	CHECK(space->island_get(body_a->get_island()).constraints.size() == 1);
+	CHECK(space->island_get(body_b->get_island()).constraints.is_empty());
+
+	memdelete(stepper);
+	memdelete(joint_a);
+	body_a->set_space(nullptr);
+	body_b->set_space(nullptr);
+	hinge->set_space(nullptr);
+	memdelete(body_a);
+	memdelete(body_b);
+	memdelete(hinge);
+	default_area->set_space(nullptr);
+	memdelete(default_area);
+	memdelete(space);
+}
+
+} // namespace TestGodotStep3D
+
+#endif // TEST_GODOT_STEP_3D_H
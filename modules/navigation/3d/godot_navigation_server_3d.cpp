@@ -1161,6 +1161,24 @@ void GodotNavigationServer3D::bake_from_source_geometry_data_async(const Ref<Nav
 #endif // _3D_DISABLED
 }
 
+void GodotNavigationServer3D::bake_tiles_from_source_geometry_data(const TypedArray<NavigationMesh> &p_navigation_meshes, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, const AABB &p_dirty_aabb, const Callable &p_callback) {
+#ifndef _3D_DISABLED
+	ERR_FAIL_COND_MSG(!p_source_geometry_data.is_valid(), "Invalid NavigationMeshSourceGeometryData3D.");
+
+	ERR_FAIL_NULL(NavMeshGenerator3D::get_singleton());
+	NavMeshGenerator3D::get_singleton()->bake_tiles_from_source_geometry_data(p_navigation_meshes, p_source_geometry_data, p_dirty_aabb, p_callback);
+#endif // _3D_DISABLED
+}
+
+void GodotNavigationServer3D::bake_tiles_from_source_geometry_data_async(const TypedArray<NavigationMesh> &p_navigation_meshes, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, const AABB &p_dirty_aabb, const Callable &p_callback) {
+#ifndef _3D_DISABLED
+	ERR_FAIL_COND_MSG(!p_source_geometry_data.is_valid(), "Invalid NavigationMeshSourceGeometryData3D.");
+
+	ERR_FAIL_NULL(NavMeshGenerator3D::get_singleton());
+	NavMeshGenerator3D::get_singleton()->bake_tiles_from_source_geometry_data_async(p_navigation_meshes, p_source_geometry_data, p_dirty_aabb, p_callback);
+#endif // _3D_DISABLED
+}
+
 bool GodotNavigationServer3D::is_baking_navigation_mesh(Ref<NavigationMesh> p_navigation_mesh) const {
 #ifdef _3D_DISABLED
 	return false;
@@ -1282,6 +1300,11 @@ void GodotNavigationServer3D::flush_queries() {
 	MutexLock lock(commands_mutex);
 	MutexLock lock2(operations_mutex);
 
+	if (!commands.is_empty()) {
+		// Commands can free the maps used by the running path queries.
+		_wait_async_path_queries();
+	}
+
 	for (SetCommand *command : commands) {
 		command->exec(this);
 		memdelete(command);
@@ -1295,6 +1318,9 @@ void GodotNavigationServer3D::map_force_update(RID p_map) {
 
 	flush_queries();
 
+	// The running path queries must not read the map while it syncs.
+	_wait_async_path_queries();
+
 	map->sync();
 }
 
@@ -1314,9 +1340,12 @@ void GodotNavigationServer3D::sync() {
 }
 
 void GodotNavigationServer3D::process(real_t p_delta_time) {
+	_dispatch_async_path_queries();
+
 	flush_queries();
 
 	if (!active) {
+		_start_async_path_queries();
 		return;
 	}
 
@@ -1365,6 +1394,8 @@ void GodotNavigationServer3D::process(real_t p_delta_time) {
 	pm_edge_connection_count = _new_pm_edge_connection_count;
 	pm_edge_free_count = _new_pm_edge_free_count;
 	pm_obstacle_count = _new_pm_obstacle_count;
+
+	_start_async_path_queries();
 }
 
 void GodotNavigationServer3D::init() {
@@ -1374,6 +1405,10 @@ void GodotNavigationServer3D::init() {
 }
 
 void GodotNavigationServer3D::finish() {
+	_wait_async_path_queries();
+	async_path_queries_running.clear();
+	async_path_queries_pending.clear();
+
 	flush_queries();
 #ifndef _3D_DISABLED
 	if (navmesh_generator_3d) {
@@ -1385,17 +1420,21 @@ void GodotNavigationServer3D::finish() {
 }
 
 PathQueryResult GodotNavigationServer3D::_query_path(const PathQueryParameters &p_parameters) const {
-	PathQueryResult r_query_result;
-
 	const NavMap *map = map_owner.get_or_null(p_parameters.map);
-	ERR_FAIL_NULL_V(map, r_query_result);
+	ERR_FAIL_NULL_V(map, PathQueryResult());
+
+	return _query_map_path(map, p_parameters);
+}
+
+PathQueryResult GodotNavigationServer3D::_query_map_path(const NavMap *p_map, const PathQueryParameters &p_parameters) const {
+	PathQueryResult r_query_result;
 
 	// run the pathfinding
 
 	if (p_parameters.pathfinding_algorithm == PathfindingAlgorithm::PATHFINDING_ALGORITHM_ASTAR) {
 		// while postprocessing is still part of map.get_path() need to check and route it here for the correct "optimize" post-processing
 		if (p_parameters.path_postprocessing == PathPostProcessing::PATH_POSTPROCESSING_CORRIDORFUNNEL) {
-			r_query_result.path = map->get_path(
+			r_query_result.path = p_map->get_path(
 					p_parameters.start_position,
 					p_parameters.target_position,
 					true,
@@ -1404,7 +1443,7 @@ PathQueryResult GodotNavigationServer3D::_query_path(const PathQueryParameters &
 					p_parameters.metadata_flags.has_flag(PathMetadataFlags::PATH_INCLUDE_RIDS) ? &r_query_result.path_rids : nullptr,
 					p_parameters.metadata_flags.has_flag(PathMetadataFlags::PATH_INCLUDE_OWNERS) ? &r_query_result.path_owner_ids : nullptr);
 		} else if (p_parameters.path_postprocessing == PathPostProcessing::PATH_POSTPROCESSING_EDGECENTERED) {
-			r_query_result.path = map->get_path(
+			r_query_result.path = p_map->get_path(
 					p_parameters.start_position,
 					p_parameters.target_position,
 					false,
@@ -1570,6 +1609,73 @@ void GodotNavigationServer3D::simplify_path_segment(int p_start_inx, int p_end_i
 	}
 }
 
+void GodotNavigationServer3D::query_path_async(const Ref<NavigationPathQueryParameters3D> &p_query_parameters, Ref<NavigationPathQueryResult3D> p_query_result, const Callable &p_callback) {
+	ERR_FAIL_COND(p_query_parameters.is_null());
+	ERR_FAIL_COND(p_query_result.is_null());
+
+	AsyncPathQuery query;
+	query.parameters = p_query_parameters->get_parameters();
+	query.query_result = p_query_result;
+	query.callback = p_callback;
+
+	MutexLock lock(async_path_queries_mutex);
+	async_path_queries_pending.push_back(query);
+}
+
+void GodotNavigationServer3D::_async_path_query(uint32_t p_index, AsyncPathQuery *p_queries) {
+	AsyncPathQuery &query = p_queries[p_index];
+	if (query.map) {
+		query.result = _query_map_path(query.map, query.parameters);
+	}
+}
+
+void GodotNavigationServer3D::_start_async_path_queries() {
+	ERR_FAIL_COND(async_path_queries_group_task != -1);
+
+	{
+		MutexLock lock(async_path_queries_mutex);
+		if (async_path_queries_pending.is_empty()) {
+			return;
+		}
+		async_path_queries_running = async_path_queries_pending;
+		async_path_queries_pending.clear();
+	}
+
+	// The maps are looked up here, map_owner is not safe to read while the main thread creates or frees maps.
+	for (AsyncPathQuery &query : async_path_queries_running) {
+		query.map = map_owner.get_or_null(query.parameters.map);
+		ERR_CONTINUE_MSG(query.map == nullptr, "Path query uses an invalid navigation map.");
+	}
+
+	// The batch runs until the next process(). Flushing commands, which can free the maps, and syncing
+	// a map, in process() or map_force_update(), both wait for it first.
+	async_path_queries_group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotNavigationServer3D::_async_path_query, async_path_queries_running.ptr(), async_path_queries_running.size(), -1, true, SNAME("NavigationServer3DPathQueries"));
+}
+
+void GodotNavigationServer3D::_wait_async_path_queries() {
+	if (async_path_queries_group_task == -1) {
+		return;
+	}
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(async_path_queries_group_task);
+	async_path_queries_group_task = -1;
+}
+
+void GodotNavigationServer3D::_dispatch_async_path_queries() {
+	_wait_async_path_queries();
+
+	for (AsyncPathQuery &query : async_path_queries_running) {
+		query.query_result->set_path(query.result.path);
+		query.query_result->set_path_types(query.result.path_types);
+		query.query_result->set_path_rids(query.result.path_rids);
+		query.query_result->set_path_owner_ids(query.result.path_owner_ids);
+
+		if (query.callback.is_valid()) {
+			query.callback.call();
+		}
+	}
+	async_path_queries_running.clear();
+}
+
 int GodotNavigationServer3D::get_process_info(ProcessInfo p_info) const {
 	switch (p_info) {
 		case INFO_ACTIVE_MAPS: {
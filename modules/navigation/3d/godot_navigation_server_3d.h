@@ -86,6 +86,19 @@ class GodotNavigationServer3D : public NavigationServer3D {
 	NavMeshGenerator3D *navmesh_generator_3d = nullptr;
 #endif // _3D_DISABLED
 
+	/// Path queries waiting for the next batch and the batch running on the worker threads.
+	struct AsyncPathQuery {
+		NavigationUtilities::PathQueryParameters parameters;
+		const NavMap *map = nullptr;
+		NavigationUtilities::PathQueryResult result;
+		Ref<NavigationPathQueryResult3D> query_result;
+		Callable callback;
+	};
+	Mutex async_path_queries_mutex;
+	LocalVector<AsyncPathQuery> async_path_queries_pending;
+	LocalVector<AsyncPathQuery> async_path_queries_running;
+	WorkerThreadPool::GroupID async_path_queries_group_task = -1;
+
 	// Performance Monitor
 	int pm_region_count = 0;
 	int pm_agent_count = 0;
@@ -266,6 +279,8 @@ public:
 	virtual void parse_source_geometry_data(const Ref<NavigationMesh> &p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, Node *p_root_node, const Callable &p_callback = Callable()) override;
 	virtual void bake_from_source_geometry_data(const Ref<NavigationMesh> &p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, const Callable &p_callback = Callable()) override;
 	virtual void bake_from_source_geometry_data_async(const Ref<NavigationMesh> &p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, const Callable &p_callback = Callable()) override;
+	virtual void bake_tiles_from_source_geometry_data(const TypedArray<NavigationMesh> &p_navigation_meshes, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, const AABB &p_dirty_aabb = AABB(), const Callable &p_callback = Callable()) override;
+	virtual void bake_tiles_from_source_geometry_data_async(const TypedArray<NavigationMesh> &p_navigation_meshes, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, const AABB &p_dirty_aabb = AABB(), const Callable &p_callback = Callable()) override;
 	virtual bool is_baking_navigation_mesh(Ref<NavigationMesh> p_navigation_mesh) const override;
 
 	virtual RID source_geometry_parser_create() override;
@@ -289,12 +304,19 @@ public:
 	virtual void finish() override;
 
 	virtual NavigationUtilities::PathQueryResult _query_path(const NavigationUtilities::PathQueryParameters &p_parameters) const override;
+	virtual void query_path_async(const Ref<NavigationPathQueryParameters3D> &p_query_parameters, Ref<NavigationPathQueryResult3D> p_query_result, const Callable &p_callback) override;
 
 	int get_process_info(ProcessInfo p_info) const override;
 
 private:
 	void internal_free_agent(RID p_object);
 	void internal_free_obstacle(RID p_object);
+
+	NavigationUtilities::PathQueryResult _query_map_path(const NavMap *p_map, const NavigationUtilities::PathQueryParameters &p_parameters) const;
+	void _async_path_query(uint32_t p_index, AsyncPathQuery *p_queries);
+	void _start_async_path_queries();
+	void _wait_async_path_queries();
+	void _dispatch_async_path_queries();
 };
 
 #undef COMMAND_1
@@ -72,6 +72,7 @@ bool NavMeshGenerator3D::baking_use_multiple_threads = true;
 bool NavMeshGenerator3D::baking_use_high_priority_threads = true;
 HashSet<Ref<NavigationMesh>> NavMeshGenerator3D::baking_navmeshes;
 HashMap<WorkerThreadPool::TaskID, NavMeshGenerator3D::NavMeshGeneratorTask3D *> NavMeshGenerator3D::generator_tasks;
+HashMap<WorkerThreadPool::GroupID, NavMeshGenerator3D::NavMeshGeneratorTileBake3D *> NavMeshGenerator3D::generator_tile_bakes;
 RID_Owner<NavMeshGenerator3D::NavMeshGeometryParser3D> NavMeshGenerator3D::generator_parser_owner;
 LocalVector<NavMeshGenerator3D::NavMeshGeometryParser3D *> NavMeshGenerator3D::generator_parsers;
 
@@ -96,7 +97,7 @@ NavMeshGenerator3D::~NavMeshGenerator3D() {
 }
 
 void NavMeshGenerator3D::sync() {
-	if (generator_tasks.size() == 0) {
+	if (generator_tasks.size() == 0 && generator_tile_bakes.size() == 0) {
 		return;
 	}
 
@@ -125,6 +126,28 @@ void NavMeshGenerator3D::sync() {
 		for (WorkerThreadPool::TaskID finished_task_id : finished_task_ids) {
 			generator_tasks.erase(finished_task_id);
 		}
+
+		LocalVector<WorkerThreadPool::GroupID> finished_group_ids;
+
+		for (KeyValue<WorkerThreadPool::GroupID, NavMeshGeneratorTileBake3D *> &E : generator_tile_bakes) {
+			if (WorkerThreadPool::get_singleton()->is_group_task_completed(E.key)) {
+				WorkerThreadPool::get_singleton()->wait_for_group_task_completion(E.key);
+				finished_group_ids.push_back(E.key);
+
+				NavMeshGeneratorTileBake3D *tile_bake = E.value;
+				for (const Ref<NavigationMesh> &navigation_mesh : tile_bake->navigation_meshes) {
+					baking_navmeshes.erase(navigation_mesh);
+				}
+				if (tile_bake->callback.is_valid()) {
+					generator_emit_callback(tile_bake->callback);
+				}
+				memdelete(tile_bake);
+			}
+		}
+
+		for (WorkerThreadPool::GroupID finished_group_id : finished_group_ids) {
+			generator_tile_bakes.erase(finished_group_id);
+		}
 	}
 }
 
@@ -142,6 +165,12 @@ void NavMeshGenerator3D::cleanup() {
 		}
 		generator_tasks.clear();
 
+		for (KeyValue<WorkerThreadPool::GroupID, NavMeshGeneratorTileBake3D *> &E : generator_tile_bakes) {
+			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(E.key);
+			memdelete(E.value);
+		}
+		generator_tile_bakes.clear();
+
 		generator_rid_rwlock.write_lock();
 		for (NavMeshGeometryParser3D *parser : generator_parsers) {
 			generator_parser_owner.free(parser->self);
@@ -234,6 +263,101 @@ void NavMeshGenerator3D::bake_from_source_geometry_data_async(Ref<NavigationMesh
 	generator_tasks.insert(generator_task->thread_task_id, generator_task);
 }
 
+void NavMeshGenerator3D::bake_tiles_from_source_geometry_data(const TypedArray<NavigationMesh> &p_navigation_meshes, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, const AABB &p_dirty_aabb, const Callable &p_callback) {
+	ERR_FAIL_COND(!p_source_geometry_data.is_valid());
+
+	NavMeshGeneratorTileBake3D tile_bake;
+	if (!generator_start_tile_bake(p_navigation_meshes, p_source_geometry_data, p_dirty_aabb, p_callback, tile_bake)) {
+		return;
+	}
+
+	if (use_threads && tile_bake.navigation_meshes.size() > 1) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_native_group_task(&NavMeshGenerator3D::generator_thread_bake_tile, &tile_bake, tile_bake.navigation_meshes.size(), -1, NavMeshGenerator3D::baking_use_high_priority_threads, SNAME("NavMeshGeneratorBakeTiles3D"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		for (uint32_t i = 0; i < tile_bake.navigation_meshes.size(); i++) {
+			generator_thread_bake_tile(&tile_bake, i);
+		}
+	}
+
+	generator_finish_tile_bake(tile_bake);
+}
+
+void NavMeshGenerator3D::bake_tiles_from_source_geometry_data_async(const TypedArray<NavigationMesh> &p_navigation_meshes, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, const AABB &p_dirty_aabb, const Callable &p_callback) {
+	ERR_FAIL_COND(!p_source_geometry_data.is_valid());
+
+	if (!use_threads) {
+		bake_tiles_from_source_geometry_data(p_navigation_meshes, p_source_geometry_data, p_dirty_aabb, p_callback);
+		return;
+	}
+
+	NavMeshGeneratorTileBake3D *tile_bake = memnew(NavMeshGeneratorTileBake3D);
+	if (!generator_start_tile_bake(p_navigation_meshes, p_source_geometry_data, p_dirty_aabb, p_callback, *tile_bake)) {
+		memdelete(tile_bake);
+		return;
+	}
+
+	// The tiles stay marked as baking until sync() finds the group completed and emits the callback.
+	MutexLock generator_task_lock(generator_task_mutex);
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_native_group_task(&NavMeshGenerator3D::generator_thread_bake_tile, tile_bake, tile_bake->navigation_meshes.size(), -1, NavMeshGenerator3D::baking_use_high_priority_threads, SNAME("NavMeshGeneratorBakeTiles3D"));
+	generator_tile_bakes.insert(group_task, tile_bake);
+}
+
+bool NavMeshGenerator3D::generator_start_tile_bake(const TypedArray<NavigationMesh> &p_navigation_meshes, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, const AABB &p_dirty_aabb, const Callable &p_callback, NavMeshGeneratorTileBake3D &r_tile_bake) {
+	r_tile_bake.source_geometry_data = p_source_geometry_data;
+	r_tile_bake.callback = p_callback;
+	r_tile_bake.navigation_meshes.reserve(p_navigation_meshes.size());
+
+	for (int i = 0; i < p_navigation_meshes.size(); i++) {
+		Ref<NavigationMesh> navigation_mesh = p_navigation_meshes[i];
+		ERR_CONTINUE(navigation_mesh.is_null());
+
+		AABB tile_aabb = navigation_mesh->get_filter_baking_aabb();
+		ERR_CONTINUE_MSG(!tile_aabb.has_volume(), "NavigationMesh tiles need a filter_baking_aabb with a volume to define the tile bounds.");
+
+		if (p_dirty_aabb.has_volume()) {
+			// Only the tiles that overlap the changed geometry need a rebake, the others keep their last result.
+			tile_aabb.position += navigation_mesh->get_filter_baking_aabb_offset();
+			if (!tile_aabb.intersects(p_dirty_aabb)) {
+				continue;
+			}
+		}
+
+		ERR_CONTINUE_MSG(is_baking(navigation_mesh), "NavigationMesh tile is already baking. Wait for current bake to finish.");
+		r_tile_bake.navigation_meshes.push_back(navigation_mesh);
+	}
+
+	if (r_tile_bake.navigation_meshes.is_empty() || !p_source_geometry_data->has_data()) {
+		for (const Ref<NavigationMesh> &navigation_mesh : r_tile_bake.navigation_meshes) {
+			navigation_mesh->clear();
+		}
+		if (p_callback.is_valid()) {
+			generator_emit_callback(p_callback);
+		}
+		return false;
+	}
+
+	baking_navmesh_mutex.lock();
+	for (const Ref<NavigationMesh> &navigation_mesh : r_tile_bake.navigation_meshes) {
+		baking_navmeshes.insert(navigation_mesh);
+	}
+	baking_navmesh_mutex.unlock();
+
+	return true;
+}
+
+void NavMeshGenerator3D::generator_finish_tile_bake(const NavMeshGeneratorTileBake3D &p_tile_bake) {
+	baking_navmesh_mutex.lock();
+	for (const Ref<NavigationMesh> &navigation_mesh : p_tile_bake.navigation_meshes) {
+		baking_navmeshes.erase(navigation_mesh);
+	}
+	baking_navmesh_mutex.unlock();
+
+	if (p_tile_bake.callback.is_valid()) {
+		generator_emit_callback(p_tile_bake.callback);
+	}
+}
+
 bool NavMeshGenerator3D::is_baking(Ref<NavigationMesh> p_navigation_mesh) {
 	MutexLock baking_navmesh_lock(baking_navmesh_mutex);
 	return baking_navmeshes.has(p_navigation_mesh);
@@ -247,6 +371,12 @@ void NavMeshGenerator3D::generator_thread_bake(void *p_arg) {
 	generator_task->status = NavMeshGeneratorTask3D::TaskStatus::BAKING_FINISHED;
 }
 
+void NavMeshGenerator3D::generator_thread_bake_tile(void *p_arg, uint32_t p_index) {
+	NavMeshGeneratorTileBake3D *tile_bake = static_cast<NavMeshGeneratorTileBake3D *>(p_arg);
+
+	generator_bake_from_source_geometry_data(tile_bake->navigation_meshes[p_index], tile_bake->source_geometry_data);
+}
+
 void NavMeshGenerator3D::generator_parse_geometry_node(const Ref<NavigationMesh> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, Node *p_node, bool p_recurse_children) {
 	generator_parse_meshinstance3d_node(p_navigation_mesh, p_source_geometry_data, p_node);
 	generator_parse_multimeshinstance3d_node(p_navigation_mesh, p_source_geometry_data, p_node);
@@ -695,7 +825,7 @@ void NavMeshGenerator3D::generator_bake_from_source_geometry_data(Ref<Navigation
 	const float *verts = source_geometry_vertices.ptr();
 	const int nverts = source_geometry_vertices.size() / 3;
 	const int *tris = source_geometry_indices.ptr();
-	const int ntris = source_geometry_indices.size() / 3;
+	int ntris = source_geometry_indices.size() / 3;
 
 	float bmin[3], bmax[3];
 	rcCalcBounds(verts, nverts, bmin, bmax);
@@ -766,6 +896,38 @@ void NavMeshGenerator3D::generator_bake_from_source_geometry_data(Ref<Navigation
 		cfg.bmax[2] = cfg.bmin[2] + baking_aabb.size[2];
 	}
 
+	// Triangles outside the baking bounds are skipped by the rasterization anyway.
+	// Culling them here keeps the cost of baking a tile of a large world proportional to the tile.
+	LocalVector<int> culled_tris;
+	if (baking_aabb.has_volume()) {
+		for (int i = 0; i < ntris; i++) {
+			const float *v0 = &verts[tris[i * 3 + 0] * 3];
+			const float *v1 = &verts[tris[i * 3 + 1] * 3];
+			const float *v2 = &verts[tris[i * 3 + 2] * 3];
+			bool overlaps = true;
+			for (int axis = 0; axis < 3; axis++) {
+				const float tri_min = MIN(v0[axis], MIN(v1[axis], v2[axis]));
+				const float tri_max = MAX(v0[axis], MAX(v1[axis], v2[axis]));
+				if (tri_min > cfg.bmax[axis] || tri_max < cfg.bmin[axis]) {
+					overlaps = false;
+					break;
+				}
+			}
+			if (overlaps) {
+				culled_tris.push_back(tris[i * 3 + 0]);
+				culled_tris.push_back(tris[i * 3 + 1]);
+				culled_tris.push_back(tris[i * 3 + 2]);
+			}
+		}
+
+		if (culled_tris.is_empty()) {
+			p_navigation_mesh->clear();
+			return;
+		}
+		tris = culled_tris.ptr();
+		ntris = culled_tris.size() / 3;
+	}
+
 	bake_state = "Calculating grid size..."; // step #2
 	rcCalcGridSize(cfg.bmin, cfg.bmax, cfg.cs, &cfg.width, &cfg.height);
 
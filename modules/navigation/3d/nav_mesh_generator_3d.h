@@ -36,6 +36,7 @@
 #include "core/object/class_db.h"
 #include "core/object/worker_thread_pool.h"
 #include "core/templates/rid_owner.h"
+#include "core/variant/typed_array.h"
 #include "modules/modules_enabled.gen.h" // For csg, gridmap.
 
 class Node;
@@ -78,7 +79,18 @@ class NavMeshGenerator3D : public Object {
 
 	static HashMap<WorkerThreadPool::TaskID, NavMeshGeneratorTask3D *> generator_tasks;
 
+	struct NavMeshGeneratorTileBake3D {
+		LocalVector<Ref<NavigationMesh>> navigation_meshes;
+		Ref<NavigationMeshSourceGeometryData3D> source_geometry_data;
+		Callable callback;
+	};
+
+	static HashMap<WorkerThreadPool::GroupID, NavMeshGeneratorTileBake3D *> generator_tile_bakes;
+
 	static void generator_thread_bake(void *p_arg);
+	static void generator_thread_bake_tile(void *p_arg, uint32_t p_index);
+	static bool generator_start_tile_bake(const TypedArray<NavigationMesh> &p_navigation_meshes, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, const AABB &p_dirty_aabb, const Callable &p_callback, NavMeshGeneratorTileBake3D &r_tile_bake);
+	static void generator_finish_tile_bake(const NavMeshGeneratorTileBake3D &p_tile_bake);
 
 	static HashSet<Ref<NavigationMesh>> baking_navmeshes;
 
@@ -109,6 +121,8 @@ public:
 	static void parse_source_geometry_data(Ref<NavigationMesh> p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, Node *p_root_node, const Callable &p_callback = Callable());
 	static void bake_from_source_geometry_data(Ref<NavigationMesh> p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, const Callable &p_callback = Callable());
 	static void bake_from_source_geometry_data_async(Ref<NavigationMesh> p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, const Callable &p_callback = Callable());
+	static void bake_tiles_from_source_geometry_data(const TypedArray<NavigationMesh> &p_navigation_meshes, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, const AABB &p_dirty_aabb = AABB(), const Callable &p_callback = Callable());
+	static void bake_tiles_from_source_geometry_data_async(const TypedArray<NavigationMesh> &p_navigation_meshes, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, const AABB &p_dirty_aabb = AABB(), const Callable &p_callback = Callable());
 	static bool is_baking(Ref<NavigationMesh> p_navigation_mesh);
 
 	static RID source_geometry_parser_create();
@@ -49,6 +49,16 @@
 		r_path_owners->push_back(poly->owner->get_owner_id()); \
 	}
 
+// Scratch buffers reused by all the path queries running on the same thread.
+struct PathQueryBuffers {
+	LocalVector<gd::NavigationPoly> navigation_polys;
+	LocalVector<uint32_t> touched_ids;
+	LocalVector<uint8_t> cluster_mask;
+	gd::Heap<gd::NavigationPoly *, gd::NavPolyTravelCostGreaterThan, gd::NavPolyHeapIndexer> traversable_polys;
+};
+
+static thread_local PathQueryBuffers path_query_buffers;
+
 Vector3 NavMeshQueries3D::polygons_get_random_point(const LocalVector<gd::Polygon> &p_polygons, uint32_t p_navigation_layers, bool p_uniformly) {
 	const LocalVector<gd::Polygon> &region_polygons = p_polygons;
 
@@ -127,7 +137,7 @@ Vector3 NavMeshQueries3D::polygons_get_random_point(const LocalVector<gd::Polygo
 	}
 }
 
-Vector<Vector3> NavMeshQueries3D::polygons_get_path(const LocalVector<gd::Polygon> &p_polygons, Vector3 p_origin, Vector3 p_destination, bool p_optimize, uint32_t p_navigation_layers, Vector<int32_t> *r_path_types, TypedArray<RID> *r_path_rids, Vector<int64_t> *r_path_owners, const Vector3 &p_map_up, uint32_t p_link_polygons_size) {
+Vector<Vector3> NavMeshQueries3D::polygons_get_path(const LocalVector<gd::Polygon> &p_polygons, Vector3 p_origin, Vector3 p_destination, bool p_optimize, uint32_t p_navigation_layers, Vector<int32_t> *r_path_types, TypedArray<RID> *r_path_rids, Vector<int64_t> *r_path_owners, const Vector3 &p_map_up, uint32_t p_link_polygons_size, const NavMapHierarchy *p_hierarchy) {
 	// Clear metadata outputs.
 	if (r_path_types) {
 		r_path_types->clear();
@@ -148,8 +158,8 @@ Vector<Vector3> NavMeshQueries3D::polygons_get_path(const LocalVector<gd::Polygo
 	real_t end_d = FLT_MAX;
 	// Find the initial poly and the end poly on this map.
 	for (const gd::Polygon &p : p_polygons) {
-		// Only consider the polygon if it in a region with compatible layers.
-		if ((p_navigation_layers & p.owner->get_navigation_layers()) == 0) {
+		// Only consider the polygon if it in a region with compatible layers, unused map polygons have no owner.
+		if (p.owner == nullptr || (p_navigation_layers & p.owner->get_navigation_layers()) == 0) {
 			continue;
 		}
 
@@ -205,20 +215,39 @@ Vector<Vector3> NavMeshQueries3D::polygons_get_path(const LocalVector<gd::Polygo
 		return path;
 	}
 
+	// Reuse the buffers of the previous query on this thread, only the polys it touched need a reset.
+	PathQueryBuffers &buffers = path_query_buffers;
+	gd::Heap<gd::NavigationPoly *, gd::NavPolyTravelCostGreaterThan, gd::NavPolyHeapIndexer> &traversable_polys = buffers.traversable_polys;
+	traversable_polys.clear();
+	for (uint32_t touched_id : buffers.touched_ids) {
+		buffers.navigation_polys[touched_id] = gd::NavigationPoly();
+	}
+	buffers.touched_ids.clear();
+
 	// List of all reachable navigation polys.
-	LocalVector<gd::NavigationPoly> navigation_polys;
-	navigation_polys.resize(p_polygons.size() + p_link_polygons_size);
+	LocalVector<gd::NavigationPoly> &navigation_polys = buffers.navigation_polys;
+	const uint32_t navigation_poly_count = p_polygons.size() + p_link_polygons_size;
+	if (navigation_polys.size() < navigation_poly_count) {
+		navigation_polys.resize(navigation_poly_count);
+	}
 
 	// Initialize the matching navigation polygon.
 	gd::NavigationPoly &begin_navigation_poly = navigation_polys[begin_poly->id];
+	buffers.touched_ids.push_back(begin_poly->id);
 	begin_navigation_poly.poly = begin_poly;
 	begin_navigation_poly.entry = begin_point;
 	begin_navigation_poly.back_navigation_edge_pathway_start = begin_point;
 	begin_navigation_poly.back_navigation_edge_pathway_end = begin_point;
 
+	// Search the map hierarchy first, the polygon search is then restricted to the clusters of the corridor.
+	const uint32_t *polygon_clusters = nullptr;
+	const uint8_t *cluster_mask = nullptr;
+	if (p_hierarchy && p_hierarchy->find_corridor(p_polygons, begin_poly, begin_point, end_poly, end_point, p_navigation_layers, buffers.cluster_mask)) {
+		polygon_clusters = p_hierarchy->get_polygon_clusters().ptr();
+		cluster_mask = buffers.cluster_mask.ptr();
+	}
+
 	// Heap of polygons to travel next.
-	gd::Heap<gd::NavigationPoly *, gd::NavPolyTravelCostGreaterThan, gd::NavPolyHeapIndexer>
-			traversable_polys;
 	traversable_polys.reserve(p_polygons.size() * 0.25);
 
 	// This is an implementation of the A* algorithm.
@@ -242,6 +271,11 @@ Vector<Vector3> NavMeshQueries3D::polygons_get_path(const LocalVector<gd::Polygo
 					continue;
 				}
 
+				// Stay inside the corridor found in the map hierarchy.
+				if (cluster_mask && !cluster_mask[polygon_clusters[connection.polygon->id]]) {
+					continue;
+				}
+
 				const gd::NavigationPoly &least_cost_poly = navigation_polys[least_cost_id];
 				real_t poly_enter_cost = 0.0;
 				real_t poly_travel_cost = least_cost_poly.poly->owner->get_travel_cost();
@@ -278,6 +312,7 @@ Vector<Vector3> NavMeshQueries3D::polygons_get_path(const LocalVector<gd::Polygo
 				} else {
 					// Initialize the matching navigation polygon.
 					neighbor_poly.poly = connection.polygon;
+					buffers.touched_ids.push_back(connection.polygon->id);
 					neighbor_poly.back_navigation_poly_id = least_cost_id;
 					neighbor_poly.back_navigation_edge = connection.edge;
 					neighbor_poly.back_navigation_edge_pathway_start = connection.pathway_start;
@@ -297,6 +332,23 @@ Vector<Vector3> NavMeshQueries3D::polygons_get_path(const LocalVector<gd::Polygo
 		// When the heap of traversable polygons is empty at this point it means the end polygon is
 		// unreachable.
 		if (traversable_polys.is_empty()) {
+			if (cluster_mask) {
+				// The corridor is not connected at the polygon level, search the whole map instead.
+				cluster_mask = nullptr;
+				for (uint32_t touched_id : buffers.touched_ids) {
+					navigation_polys[touched_id].poly = nullptr;
+				}
+				navigation_polys[begin_poly->id].poly = begin_poly;
+
+				least_cost_id = begin_poly->id;
+				prev_least_cost_id = -1;
+
+				reachable_end = nullptr;
+				distance_to_reachable_end = FLT_MAX;
+
+				continue;
+			}
+
 			// Thus use the further reachable polygon
 			ERR_BREAK_MSG(is_reachable == false, "It's not expect to not find the most reachable polygons");
 			is_reachable = false;
@@ -358,8 +410,8 @@ Vector<Vector3> NavMeshQueries3D::polygons_get_path(const LocalVector<gd::Polygo
 				return path;
 			}
 
-			for (gd::NavigationPoly &nav_poly : navigation_polys) {
-				nav_poly.poly = nullptr;
+			for (uint32_t touched_id : buffers.touched_ids) {
+				navigation_polys[touched_id].poly = nullptr;
 			}
 			navigation_polys[begin_poly->id].poly = begin_poly;
 
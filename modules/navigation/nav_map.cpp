@@ -51,6 +51,11 @@
 #define NAVMAP_ITERATION_ZERO_ERROR_MSG()
 #endif // DEBUG_ENABLED
 
+// Agent trees are only built in parallel above this many agents.
+static constexpr size_t RVO_AGENTS_TREE_PARALLEL_MIN_AGENTS = 4096;
+// Refitted agent trees are rebuilt once their leaves grow past this factor of their built size.
+static constexpr float RVO_AGENTS_TREE_MAX_REFIT_GROWTH = 1.5;
+
 void NavMap::set_up(Vector3 p_up) {
 	if (up == p_up) {
 		return;
@@ -107,7 +112,7 @@ void NavMap::set_link_connection_radius(real_t p_link_connection_radius) {
 		return;
 	}
 	link_connection_radius = p_link_connection_radius;
-	regenerate_links = true;
+	regenerate_link_polygons = true;
 }
 
 gd::PointKey NavMap::get_point_key(const Vector3 &p_pos) const {
@@ -132,7 +137,7 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 
 	return NavMeshQueries3D::polygons_get_path(
 			polygons, p_origin, p_destination, p_optimize, p_navigation_layers,
-			r_path_types, r_path_rids, r_path_owners, up, link_polygons.size());
+			r_path_types, r_path_rids, r_path_owners, up, link_polygons.size(), use_hierarchical_pathfinding ? &hierarchy : nullptr);
 }
 
 Vector3 NavMap::get_closest_point_to_segment(const Vector3 &p_from, const Vector3 &p_to, const bool p_use_collision) const {
@@ -183,27 +188,32 @@ gd::ClosestPointQueryResult NavMap::get_closest_point_info(const Vector3 &p_poin
 
 void NavMap::add_region(NavRegion *p_region) {
 	regions.push_back(p_region);
-	regenerate_links = true;
 }
 
 void NavMap::remove_region(NavRegion *p_region) {
 	int64_t region_index = regions.find(p_region);
 	if (region_index >= 0) {
 		regions.remove_at_unordered(region_index);
-		regenerate_links = true;
+	}
+
+	// The polygons of the region are left in the map until the next sync, its neighbors are reconnected then.
+	HashMap<NavRegion *, RegionSlot>::Iterator slot = region_slots.find(p_region);
+	if (slot) {
+		removed_region_slots.push_back(slot->value);
+		region_slots.remove(slot);
 	}
 }
 
 void NavMap::add_link(NavLink *p_link) {
 	links.push_back(p_link);
-	regenerate_links = true;
+	regenerate_link_polygons = true;
 }
 
 void NavMap::remove_link(NavLink *p_link) {
 	int64_t link_index = links.find(p_link);
 	if (link_index >= 0) {
 		links.remove_at_unordered(link_index);
-		regenerate_links = true;
+		regenerate_link_polygons = true;
 	}
 }
 
@@ -264,12 +274,14 @@ void NavMap::set_agent_as_controlled(NavAgent *agent) {
 		if (agent_3d_index < 0) {
 			active_3d_avoidance_agents.push_back(agent);
 			agents_dirty = true;
+			rvo_agents_trees_changed = true;
 		}
 	} else {
 		int64_t agent_2d_index = active_2d_avoidance_agents.find(agent);
 		if (agent_2d_index < 0) {
 			active_2d_avoidance_agents.push_back(agent);
 			agents_dirty = true;
+			rvo_agents_trees_changed = true;
 		}
 	}
 }
@@ -279,11 +291,13 @@ void NavMap::remove_agent_as_controlled(NavAgent *agent) {
 	if (agent_3d_index >= 0) {
 		active_3d_avoidance_agents.remove_at_unordered(agent_3d_index);
 		agents_dirty = true;
+		rvo_agents_trees_changed = true;
 	}
 	int64_t agent_2d_index = active_2d_avoidance_agents.find(agent);
 	if (agent_2d_index >= 0) {
 		active_2d_avoidance_agents.remove_at_unordered(agent_2d_index);
 		agents_dirty = true;
+		rvo_agents_trees_changed = true;
 	}
 }
 
@@ -375,274 +389,63 @@ void NavMap::sync() {
 		regenerate_links = true;
 	}
 
+	// Regions that changed or were added since the last sync, only they copy their polygons again.
+	sync_dirty_regions.clear();
 	for (NavRegion *region : regions) {
-		if (region->sync()) {
-			regenerate_links = true;
+		if (region->sync() || !region_slots.has(region)) {
+			sync_dirty_regions.push_back(region);
 		}
 	}
 
 	for (NavLink *link : links) {
 		if (link->check_dirty()) {
-			regenerate_links = true;
+			regenerate_link_polygons = true;
 		}
 	}
 
-	if (regenerate_links) {
-		_new_pm_polygon_count = 0;
+	if (regenerate_links || !sync_dirty_regions.is_empty() || !removed_region_slots.is_empty()) {
+		// Links point into the region polygons, they are connected again after the regions.
+		_clear_link_connections();
+
+		// Changed regions are synced in place when their slots allow it, otherwise all regions are.
+		const bool sync_all = regenerate_links || !_sync_region_slots(sync_dirty_regions);
+		if (sync_all) {
+			_reset_region_slots();
+		}
+		_connect_region_slots(sync_all);
+
+		_new_pm_polygon_count = region_slots_polygon_count;
 		_new_pm_edge_count = 0;
 		_new_pm_edge_merge_count = 0;
 		_new_pm_edge_connection_count = 0;
 		_new_pm_edge_free_count = 0;
 
-		// Remove regions connections.
-		region_external_connections.clear();
+		sync_regions.clear();
+		sync_region_polygon_offsets.clear();
 		for (NavRegion *region : regions) {
-			region_external_connections[region] = LocalVector<gd::Edge::Connection>();
-		}
-
-		// Resize the polygon count.
-		int polygon_count = 0;
-		for (const NavRegion *region : regions) {
+			const RegionSlot &slot = region_slots[region];
 			if (!region->get_enabled()) {
 				continue;
 			}
-			polygon_count += region->get_polygons().size();
-		}
-		polygons.resize(polygon_count);
-
-		// Copy all region polygons in the map.
-		polygon_count = 0;
-		for (const NavRegion *region : regions) {
-			if (!region->get_enabled()) {
-				continue;
-			}
-			const LocalVector<gd::Polygon> &polygons_source = region->get_polygons();
-			for (uint32_t n = 0; n < polygons_source.size(); n++) {
-				polygons[polygon_count] = polygons_source[n];
-				polygons[polygon_count].id = polygon_count;
-				polygon_count++;
-			}
-		}
-
-		_new_pm_polygon_count = polygon_count;
-
-		// Group all edges per key.
-		HashMap<gd::EdgeKey, Vector<gd::Edge::Connection>, gd::EdgeKey> connections;
-		for (gd::Polygon &poly : polygons) {
-			for (uint32_t p = 0; p < poly.points.size(); p++) {
-				int next_point = (p + 1) % poly.points.size();
-				gd::EdgeKey ek(poly.points[p].key, poly.points[next_point].key);
-
-				HashMap<gd::EdgeKey, Vector<gd::Edge::Connection>, gd::EdgeKey>::Iterator connection = connections.find(ek);
-				if (!connection) {
-					connections[ek] = Vector<gd::Edge::Connection>();
-					_new_pm_edge_count += 1;
-				}
-				if (connections[ek].size() <= 1) {
-					// Add the polygon/edge tuple to this key.
-					gd::Edge::Connection new_connection;
-					new_connection.polygon = &poly;
-					new_connection.edge = p;
-					new_connection.pathway_start = poly.points[p].pos;
-					new_connection.pathway_end = poly.points[next_point].pos;
-					connections[ek].push_back(new_connection);
-				} else {
-					// The edge is already connected with another edge, skip.
-					ERR_PRINT_ONCE("Navigation map synchronization error. Attempted to merge a navigation mesh polygon edge with another already-merged edge. This is usually caused by crossing edges, overlapping polygons, or a mismatch of the NavigationMesh / NavigationPolygon baked 'cell_size' and navigation map 'cell_size'. If you're certain none of above is the case, change 'navigation/3d/merge_rasterizer_cell_scale' to 0.001.");
-				}
-			}
-		}
-
-		Vector<gd::Edge::Connection> free_edges;
-		for (KeyValue<gd::EdgeKey, Vector<gd::Edge::Connection>> &E : connections) {
-			if (E.value.size() == 2) {
-				// Connect edge that are shared in different polygons.
-				gd::Edge::Connection &c1 = E.value.write[0];
-				gd::Edge::Connection &c2 = E.value.write[1];
-				c1.polygon->edges[c1.edge].connections.push_back(c2);
-				c2.polygon->edges[c2.edge].connections.push_back(c1);
-				// Note: The pathway_start/end are full for those connection and do not need to be modified.
-				_new_pm_edge_merge_count += 1;
-			} else {
-				CRASH_COND_MSG(E.value.size() != 1, vformat("Number of connection != 1. Found: %d", E.value.size()));
-				if (use_edge_connections && E.value[0].polygon->owner->get_use_edge_connections()) {
-					free_edges.push_back(E.value[0]);
-				}
-			}
-		}
-
-		// Find the compatible near edges.
-		//
-		// Note:
-		// Considering that the edges must be compatible (for obvious reasons)
-		// to be connected, create new polygons to remove that small gap is
-		// not really useful and would result in wasteful computation during
-		// connection, integration and path finding.
-		_new_pm_edge_free_count = free_edges.size();
-
-		for (int i = 0; i < free_edges.size(); i++) {
-			const gd::Edge::Connection &free_edge = free_edges[i];
-			Vector3 edge_p1 = free_edge.polygon->points[free_edge.edge].pos;
-			Vector3 edge_p2 = free_edge.polygon->points[(free_edge.edge + 1) % free_edge.polygon->points.size()].pos;
-
-			for (int j = 0; j < free_edges.size(); j++) {
-				const gd::Edge::Connection &other_edge = free_edges[j];
-				if (i == j || free_edge.polygon->owner == other_edge.polygon->owner) {
-					continue;
-				}
-
-				Vector3 other_edge_p1 = other_edge.polygon->points[other_edge.edge].pos;
-				Vector3 other_edge_p2 = other_edge.polygon->points[(other_edge.edge + 1) % other_edge.polygon->points.size()].pos;
-
-				// Compute the projection of the opposite edge on the current one
-				Vector3 edge_vector = edge_p2 - edge_p1;
-				real_t projected_p1_ratio = edge_vector.dot(other_edge_p1 - edge_p1) / (edge_vector.length_squared());
-				real_t projected_p2_ratio = edge_vector.dot(other_edge_p2 - edge_p1) / (edge_vector.length_squared());
-				if ((projected_p1_ratio < 0.0 && projected_p2_ratio < 0.0) || (projected_p1_ratio > 1.0 && projected_p2_ratio > 1.0)) {
-					continue;
-				}
+			sync_regions.push_back(region);
+			sync_region_polygon_offsets.push_back(slot.offset);
 
-				// Check if the two edges are close to each other enough and compute a pathway between the two regions.
-				Vector3 self1 = edge_vector * CLAMP(projected_p1_ratio, 0.0, 1.0) + edge_p1;
-				Vector3 other1;
-				if (projected_p1_ratio >= 0.0 && projected_p1_ratio <= 1.0) {
-					other1 = other_edge_p1;
-				} else {
-					other1 = other_edge_p1.lerp(other_edge_p2, (1.0 - projected_p1_ratio) / (projected_p2_ratio - projected_p1_ratio));
-				}
-				if (other1.distance_to(self1) > edge_connection_margin) {
-					continue;
-				}
-
-				Vector3 self2 = edge_vector * CLAMP(projected_p2_ratio, 0.0, 1.0) + edge_p1;
-				Vector3 other2;
-				if (projected_p2_ratio >= 0.0 && projected_p2_ratio <= 1.0) {
-					other2 = other_edge_p2;
-				} else {
-					other2 = other_edge_p1.lerp(other_edge_p2, (0.0 - projected_p1_ratio) / (projected_p2_ratio - projected_p1_ratio));
-				}
-				if (other2.distance_to(self2) > edge_connection_margin) {
-					continue;
-				}
-
-				// The edges can now be connected.
-				gd::Edge::Connection new_connection = other_edge;
-				new_connection.pathway_start = (self1 + other1) / 2.0;
-				new_connection.pathway_end = (self2 + other2) / 2.0;
-				free_edge.polygon->edges[free_edge.edge].connections.push_back(new_connection);
-
-				// Add the connection to the region_connection map.
-				region_external_connections[(NavRegion *)free_edge.polygon->owner].push_back(new_connection);
-				_new_pm_edge_connection_count += 1;
-			}
+			_new_pm_edge_count += slot.edge_count;
+			_new_pm_edge_merge_count += slot.edge_merge_count;
+			_new_pm_edge_connection_count += slot.external_connections.size();
+			_new_pm_edge_free_count += slot.edge_free_count;
 		}
 
-		uint32_t link_poly_idx = 0;
-		link_polygons.resize(links.size());
-
-		// Search for polygons within range of a nav link.
-		for (const NavLink *link : links) {
-			if (!link->get_enabled()) {
-				continue;
-			}
-			const Vector3 start = link->get_start_position();
-			const Vector3 end = link->get_end_position();
-
-			gd::Polygon *closest_start_polygon = nullptr;
-			real_t closest_start_distance = link_connection_radius;
-			Vector3 closest_start_point;
-
-			gd::Polygon *closest_end_polygon = nullptr;
-			real_t closest_end_distance = link_connection_radius;
-			Vector3 closest_end_point;
-
-			// Create link to any polygons within the search radius of the start point.
-			for (uint32_t start_index = 0; start_index < polygons.size(); start_index++) {
-				gd::Polygon &start_poly = polygons[start_index];
-
-				// For each face check the distance to the start
-				for (uint32_t start_point_id = 2; start_point_id < start_poly.points.size(); start_point_id += 1) {
-					const Face3 start_face(start_poly.points[0].pos, start_poly.points[start_point_id - 1].pos, start_poly.points[start_point_id].pos);
-					const Vector3 start_point = start_face.get_closest_point_to(start);
-					const real_t start_distance = start_point.distance_to(start);
-
-					// Pick the polygon that is within our radius and is closer than anything we've seen yet.
-					if (start_distance <= link_connection_radius && start_distance < closest_start_distance) {
-						closest_start_distance = start_distance;
-						closest_start_point = start_point;
-						closest_start_polygon = &start_poly;
-					}
-				}
-			}
-
-			// Find any polygons within the search radius of the end point.
-			for (gd::Polygon &end_poly : polygons) {
-				// For each face check the distance to the end
-				for (uint32_t end_point_id = 2; end_point_id < end_poly.points.size(); end_point_id += 1) {
-					const Face3 end_face(end_poly.points[0].pos, end_poly.points[end_point_id - 1].pos, end_poly.points[end_point_id].pos);
-					const Vector3 end_point = end_face.get_closest_point_to(end);
-					const real_t end_distance = end_point.distance_to(end);
-
-					// Pick the polygon that is within our radius and is closer than anything we've seen yet.
-					if (end_distance <= link_connection_radius && end_distance < closest_end_distance) {
-						closest_end_distance = end_distance;
-						closest_end_point = end_point;
-						closest_end_polygon = &end_poly;
-					}
-				}
-			}
+		regenerate_link_polygons = true;
+	}
 
-			// If we have both a start and end point, then create a synthetic polygon to route through.
-			if (closest_start_polygon && closest_end_polygon) {
-				gd::Polygon &new_polygon = link_polygons[link_poly_idx++];
-				new_polygon.id = polygon_count++;
-				new_polygon.owner = link;
-
-				new_polygon.edges.clear();
-				new_polygon.edges.resize(4);
-				new_polygon.points.clear();
-				new_polygon.points.reserve(4);
-
-				// Build a set of vertices that create a thin polygon going from the start to the end point.
-				new_polygon.points.push_back({ closest_start_point, get_point_key(closest_start_point) });
-				new_polygon.points.push_back({ closest_start_point, get_point_key(closest_start_point) });
-				new_polygon.points.push_back({ closest_end_point, get_point_key(closest_end_point) });
-				new_polygon.points.push_back({ closest_end_point, get_point_key(closest_end_point) });
-
-				// Setup connections to go forward in the link.
-				{
-					gd::Edge::Connection entry_connection;
-					entry_connection.polygon = &new_polygon;
-					entry_connection.edge = -1;
-					entry_connection.pathway_start = new_polygon.points[0].pos;
-					entry_connection.pathway_end = new_polygon.points[1].pos;
-					closest_start_polygon->edges[0].connections.push_back(entry_connection);
-
-					gd::Edge::Connection exit_connection;
-					exit_connection.polygon = closest_end_polygon;
-					exit_connection.edge = -1;
-					exit_connection.pathway_start = new_polygon.points[2].pos;
-					exit_connection.pathway_end = new_polygon.points[3].pos;
-					new_polygon.edges[2].connections.push_back(exit_connection);
-				}
+	if (regenerate_link_polygons) {
+		_sync_link_polygons();
 
-				// If the link is bi-directional, create connections from the end to the start.
-				if (link->is_bidirectional()) {
-					gd::Edge::Connection entry_connection;
-					entry_connection.polygon = &new_polygon;
-					entry_connection.edge = -1;
-					entry_connection.pathway_start = new_polygon.points[2].pos;
-					entry_connection.pathway_end = new_polygon.points[3].pos;
-					closest_end_polygon->edges[0].connections.push_back(entry_connection);
-
-					gd::Edge::Connection exit_connection;
-					exit_connection.polygon = closest_start_polygon;
-					exit_connection.edge = -1;
-					exit_connection.pathway_start = new_polygon.points[0].pos;
-					exit_connection.pathway_end = new_polygon.points[1].pos;
-					new_polygon.edges[0].connections.push_back(exit_connection);
-				}
-			}
+		if (use_hierarchical_pathfinding) {
+			hierarchy.build(sync_regions, sync_region_polygon_offsets, polygons, link_polygons, link_polygon_count);
+		} else {
+			hierarchy.clear();
 		}
 
 		// Some code treats 0 as a failure case, so we avoid returning 0 and modulo wrap UINT32_MAX manually.
@@ -669,6 +472,7 @@ void NavMap::sync() {
 
 	regenerate_polygons = false;
 	regenerate_links = false;
+	regenerate_link_polygons = false;
 	obstacles_dirty = false;
 	agents_dirty = false;
 
@@ -763,23 +567,622 @@ void NavMap::_update_rvo_obstacles_tree_2d() {
 }
 
 void NavMap::_update_rvo_agents_tree_2d() {
+	RVO2D::KdTree2D *kd_tree = rvo_simulation_2d.kdTree_;
+
+	// Moving agents only loosen the bounds of the existing tree, refit it until it gets too inefficient.
+	if (!rvo_agents_trees_changed && kd_tree->agents_.size() == active_2d_avoidance_agents.size()) {
+		const float extents = kd_tree->refitAgentTree();
+		if (extents <= rvo_agents_tree_2d_extents * RVO_AGENTS_TREE_MAX_REFIT_GROWTH) {
+			return;
+		}
+	}
+
 	// Cannot use LocalVector here as RVO library expects std::vector to build KdTree.
 	std::vector<RVO2D::Agent2D *> raw_agents;
 	raw_agents.reserve(active_2d_avoidance_agents.size());
 	for (NavAgent *agent : active_2d_avoidance_agents) {
 		raw_agents.push_back(agent->get_rvo_agent_2d());
 	}
-	rvo_simulation_2d.kdTree_->buildAgentTree(raw_agents);
+
+	if (use_threads && avoidance_use_multiple_threads && raw_agents.size() >= RVO_AGENTS_TREE_PARALLEL_MIN_AGENTS) {
+		kd_tree->buildAgentTreeTop(raw_agents, MAX(raw_agents.size() / 64, RVO_AGENTS_TREE_PARALLEL_MIN_AGENTS / 4), rvo_agents_tree_2d_tasks);
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &NavMap::_build_rvo_agents_subtree_2d, rvo_agents_tree_2d_tasks.data(), rvo_agents_tree_2d_tasks.size(), -1, true, SNAME("RVOAgentsTree2D"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+		kd_tree->updateAgentPositions();
+	} else {
+		kd_tree->buildAgentTree(raw_agents);
+	}
+
+	rvo_agents_tree_2d_extents = kd_tree->getAgentTreeLeafExtents();
 }
 
 void NavMap::_update_rvo_agents_tree_3d() {
+	RVO3D::KdTree3D *kd_tree = rvo_simulation_3d.kdTree_;
+
+	// Moving agents only loosen the bounds of the existing tree, refit it until it gets too inefficient.
+	if (!rvo_agents_trees_changed && kd_tree->agents_.size() == active_3d_avoidance_agents.size()) {
+		const float extents = kd_tree->refitAgentTree();
+		if (extents <= rvo_agents_tree_3d_extents * RVO_AGENTS_TREE_MAX_REFIT_GROWTH) {
+			return;
+		}
+	}
+
 	// Cannot use LocalVector here as RVO library expects std::vector to build KdTree.
 	std::vector<RVO3D::Agent3D *> raw_agents;
 	raw_agents.reserve(active_3d_avoidance_agents.size());
 	for (NavAgent *agent : active_3d_avoidance_agents) {
 		raw_agents.push_back(agent->get_rvo_agent_3d());
 	}
-	rvo_simulation_3d.kdTree_->buildAgentTree(raw_agents);
+
+	if (use_threads && avoidance_use_multiple_threads && raw_agents.size() >= RVO_AGENTS_TREE_PARALLEL_MIN_AGENTS) {
+		kd_tree->buildAgentTreeTop(raw_agents, MAX(raw_agents.size() / 64, RVO_AGENTS_TREE_PARALLEL_MIN_AGENTS / 4), rvo_agents_tree_3d_tasks);
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &NavMap::_build_rvo_agents_subtree_3d, rvo_agents_tree_3d_tasks.data(), rvo_agents_tree_3d_tasks.size(), -1, true, SNAME("RVOAgentsTree3D"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+		kd_tree->updateAgentPositions();
+	} else {
+		kd_tree->buildAgentTree(raw_agents);
+	}
+
+	rvo_agents_tree_3d_extents = kd_tree->getAgentTreeLeafExtents();
+}
+
+void NavMap::_build_rvo_agents_subtree_2d(uint32_t p_index, RVO2D::KdTree2D::AgentTreeTask *p_tasks) {
+	rvo_simulation_2d.kdTree_->buildAgentSubtree(p_tasks[p_index]);
+}
+
+void NavMap::_build_rvo_agents_subtree_3d(uint32_t p_index, RVO3D::KdTree3D::AgentTreeTask *p_tasks) {
+	rvo_simulation_3d.kdTree_->buildAgentSubtree(p_tasks[p_index]);
+}
+
+bool NavMap::_sync_region_slots(const LocalVector<NavRegion *> &p_dirty_regions) {
+	// Check first that the changed regions fit without moving the other regions. Growing the polygons
+	// would move all of them, and compacting the unused polygons too, so both sync all regions instead.
+	uint32_t polygon_count = region_slots_polygon_count;
+	uint32_t append_count = 0;
+	for (const RegionSlot &slot : removed_region_slots) {
+		polygon_count -= slot.count;
+	}
+	for (NavRegion *region : p_dirty_regions) {
+		const uint32_t count = region->get_enabled() ? region->get_polygons().size() : 0;
+		const RegionSlot *slot = region_slots.getptr(region);
+		if (slot) {
+			polygon_count -= slot->count;
+		}
+		polygon_count += count;
+		if (!slot || count > slot->capacity) {
+			append_count += count + count / 4;
+		}
+	}
+	const uint32_t new_size = polygons.size() + append_count;
+	if (new_size > polygons.get_capacity() || new_size > polygon_count * 2 + 256) {
+		return false;
+	}
+
+	sync_changed_bounds.clear();
+	for (const RegionSlot &slot : removed_region_slots) {
+		_remove_region_slot_edges(slot);
+		_clear_region_slot_polygons(slot.offset, slot.offset + slot.capacity);
+		if (slot.count > 0) {
+			sync_changed_bounds.push_back(slot.bounds);
+		}
+	}
+	removed_region_slots.clear();
+
+	sync_dirty_slots.clear();
+	for (NavRegion *region : p_dirty_regions) {
+		const uint32_t count = region->get_enabled() ? region->get_polygons().size() : 0;
+		RegionSlot *slot = region_slots.getptr(region);
+		if (slot) {
+			_remove_region_slot_edges(*slot);
+			if (slot->count > 0) {
+				sync_changed_bounds.push_back(slot->bounds);
+			}
+		} else {
+			slot = &region_slots.insert(region, RegionSlot())->value;
+			slot->region = region;
+			slot->offset = polygons.size();
+		}
+		if (count > slot->capacity) {
+			// Move the region at the end, with some room to grow in place the next time.
+			_clear_region_slot_polygons(slot->offset, slot->offset + slot->capacity);
+			slot->offset = polygons.size();
+			slot->capacity = count + count / 4;
+			polygons.resize(polygons.size() + slot->capacity);
+		}
+		slot->count = count;
+		sync_dirty_slots.push_back(slot);
+	}
+	region_slots_polygon_count = polygon_count;
+
+	return true;
+}
+
+void NavMap::_reset_region_slots() {
+	region_slots.clear();
+	removed_region_slots.clear();
+	edge_buckets.clear();
+	sync_changed_bounds.clear();
+
+	uint32_t polygon_count = 0;
+	for (NavRegion *region : regions) {
+		if (region->get_enabled()) {
+			polygon_count += region->get_polygons().size();
+		}
+	}
+
+	// Leave room for the regions to grow, or be added, without syncing all of them again.
+	polygons.clear();
+	polygons.reserve(polygon_count + polygon_count / 2 + 64);
+	polygons.resize(polygon_count);
+	region_slots_polygon_count = polygon_count;
+
+	sync_dirty_slots.clear();
+	uint32_t offset = 0;
+	for (NavRegion *region : regions) {
+		RegionSlot &slot = region_slots.insert(region, RegionSlot())->value;
+		slot.region = region;
+		slot.offset = offset;
+		slot.count = region->get_enabled() ? region->get_polygons().size() : 0;
+		slot.capacity = slot.count;
+		offset += slot.count;
+		sync_dirty_slots.push_back(&slot);
+	}
+}
+
+void NavMap::_remove_region_slot_edges(const RegionSlot &p_slot) {
+	for (const gd::RegionEdge &region_edge : p_slot.external_edges) {
+		HashMap<gd::EdgeKey, LocalVector<EdgeBucketEntry>, gd::EdgeKey>::Iterator bucket = edge_buckets.find(region_edge.key);
+		if (!bucket) {
+			continue;
+		}
+		// Keep the order of the other edges, the first two of a key are the merged ones.
+		LocalVector<EdgeBucketEntry> &entries = bucket->value;
+		const uint32_t polygon_id = p_slot.offset + region_edge.polygon;
+		for (uint32_t i = 0; i < entries.size(); i++) {
+			if (entries[i].polygon == polygon_id && entries[i].edge == region_edge.edge) {
+				entries.remove_at(i);
+				break;
+			}
+		}
+		if (entries.is_empty()) {
+			edge_buckets.remove(bucket);
+		}
+	}
+}
+
+void NavMap::_clear_region_slot_polygons(uint32_t p_from, uint32_t p_to) {
+	for (uint32_t id = p_from; id < p_to; id++) {
+		polygons[id] = gd::Polygon();
+		polygons[id].id = id;
+	}
+}
+
+void NavMap::_connect_region_slots(bool p_all) {
+	// Copy the polygons of the changed regions and merge the edges shared inside each region.
+	// Those merges are cached by the regions and only recomputed for regions that changed.
+	if (use_threads && sync_dirty_slots.size() > 1) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &NavMap::_sync_region_polygons, sync_dirty_slots.ptr(), sync_dirty_slots.size(), -1, true, SNAME("NavMapSyncRegions"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		for (uint32_t i = 0; i < sync_dirty_slots.size(); i++) {
+			_sync_region_polygons(i, sync_dirty_slots.ptr());
+		}
+	}
+
+	// Only edges not merged inside their own region are grouped per key.
+	for (RegionSlot *slot : sync_dirty_slots) {
+		slot->external_edges.clear();
+		if (slot->count == 0) {
+			continue;
+		}
+		slot->external_edges = slot->region->get_external_edges();
+		for (const gd::RegionEdge &region_edge : slot->external_edges) {
+			HashMap<gd::EdgeKey, LocalVector<EdgeBucketEntry>, gd::EdgeKey>::Iterator bucket = edge_buckets.find(region_edge.key);
+			if (!bucket) {
+				bucket = edge_buckets.insert(region_edge.key, LocalVector<EdgeBucketEntry>());
+			}
+			EdgeBucketEntry entry;
+			entry.polygon = slot->offset + region_edge.polygon;
+			entry.edge = region_edge.edge;
+			bucket->value.push_back(entry);
+		}
+	}
+
+	// Reconnect the changed regions and the regions that were near them, before or after the change.
+	sync_reconnect_slots.clear();
+	if (p_all) {
+		for (KeyValue<NavRegion *, RegionSlot> &E : region_slots) {
+			if (E.value.count > 0) {
+				sync_reconnect_slots.push_back(&E.value);
+			}
+		}
+	} else {
+		for (const RegionSlot *slot : sync_dirty_slots) {
+			if (slot->count > 0) {
+				sync_changed_bounds.push_back(slot->bounds);
+			}
+		}
+		for (KeyValue<NavRegion *, RegionSlot> &E : region_slots) {
+			RegionSlot &slot = E.value;
+			if (slot.count == 0) {
+				continue;
+			}
+			for (const AABB &changed_bounds : sync_changed_bounds) {
+				if (slot.bounds.intersects_inclusive(changed_bounds)) {
+					sync_reconnect_slots.push_back(&slot);
+					break;
+				}
+			}
+		}
+
+		// Strip the connections of the unchanged neighbors to other regions, they are made again below.
+		for (const RegionSlot *slot : sync_reconnect_slots) {
+			for (uint32_t id = slot->offset; id < slot->offset + slot->count; id++) {
+				for (gd::Edge &edge : polygons[id].edges) {
+					for (int i = edge.connections.size() - 1; i >= 0; i--) {
+						if (edge.connections[i].polygon->owner != slot->region) {
+							edge.connections.remove_at(i);
+						}
+					}
+				}
+			}
+		}
+	}
+
+	// Connect edges that are shared in different regions, each region only writes its own side.
+	sync_free_edges.clear();
+	for (RegionSlot *slot : sync_reconnect_slots) {
+		const NavRegion *region = slot->region;
+		const bool use_free_edges = use_edge_connections && region->get_use_edge_connections();
+		slot->edge_count = region->get_edge_count() - slot->external_edges.size();
+		slot->edge_merge_count = region->get_internal_edge_merges().size();
+		slot->edge_free_count = 0;
+		slot->external_connections.clear();
+
+		for (const gd::RegionEdge &region_edge : slot->external_edges) {
+			const LocalVector<EdgeBucketEntry> *entries = edge_buckets.getptr(region_edge.key);
+			ERR_CONTINUE(entries == nullptr);
+
+			const uint32_t polygon_id = slot->offset + region_edge.polygon;
+			uint32_t index = 0;
+			while (index < entries->size() && ((*entries)[index].polygon != polygon_id || (*entries)[index].edge != region_edge.edge)) {
+				index++;
+			}
+			if (index == 0) {
+				slot->edge_count += 1;
+			} else if (index > 1) {
+				// The edge is already connected with another edge, skip.
+				ERR_PRINT_ONCE("Navigation map synchronization error. Attempted to merge a navigation mesh polygon edge with another already-merged edge. This is usually caused by crossing edges, overlapping polygons, or a mismatch of the NavigationMesh / NavigationPolygon baked 'cell_size' and navigation map 'cell_size'. If you're certain none of above is the case, change 'navigation/3d/merge_rasterizer_cell_scale' to 0.001.");
+				continue;
+			}
+
+			gd::Polygon &poly = polygons[polygon_id];
+			if (entries->size() >= 2) {
+				const EdgeBucketEntry &other = (*entries)[1 - index];
+				gd::Polygon &other_poly = polygons[other.polygon];
+
+				// Note: The pathway_start/end are full for those connection and do not need to be modified.
+				gd::Edge::Connection connection;
+				connection.polygon = &other_poly;
+				connection.edge = other.edge;
+				connection.pathway_start = other_poly.points[other.edge].pos;
+				connection.pathway_end = other_poly.points[(other.edge + 1) % other_poly.points.size()].pos;
+				poly.edges[region_edge.edge].connections.push_back(connection);
+				if (index == 1) {
+					slot->edge_merge_count += 1;
+				}
+			} else if (use_free_edges) {
+				gd::Edge::Connection free_edge;
+				free_edge.polygon = &poly;
+				free_edge.edge = region_edge.edge;
+				free_edge.pathway_start = poly.points[region_edge.edge].pos;
+				free_edge.pathway_end = poly.points[(region_edge.edge + 1) % poly.points.size()].pos;
+				sync_free_edges.push_back(free_edge);
+				slot->edge_free_count += 1;
+			}
+		}
+	}
+
+	// Find the compatible near edges.
+	//
+	// Note:
+	// Considering that the edges must be compatible (for obvious reasons)
+	// to be connected, create new polygons to remove that small gap is
+	// not really useful and would result in wasteful computation during
+	// connection, integration and path finding.
+	sync_free_edge_bounds.resize(sync_free_edges.size());
+	for (uint32_t i = 0; i < sync_free_edges.size(); i++) {
+		sync_free_edge_bounds[i] = AABB(sync_free_edges[i].pathway_start, Vector3()).expand(sync_free_edges[i].pathway_end).grow(edge_connection_margin);
+	}
+
+	// The free edges of the reconnected regions can only connect to free edges of regions near them.
+	sync_free_edge_targets.clear();
+	sync_free_edge_target_bounds.clear();
+	if (!sync_free_edges.is_empty()) {
+		for (KeyValue<NavRegion *, RegionSlot> &E : region_slots) {
+			const RegionSlot &slot = E.value;
+			if (slot.count == 0 || !use_edge_connections || !slot.region->get_use_edge_connections()) {
+				continue;
+			}
+			bool near = p_all;
+			for (uint32_t i = 0; !near && i < sync_reconnect_slots.size(); i++) {
+				near = slot.bounds.intersects_inclusive(sync_reconnect_slots[i]->bounds);
+			}
+			if (!near) {
+				continue;
+			}
+			for (const gd::RegionEdge &region_edge : slot.external_edges) {
+				const LocalVector<EdgeBucketEntry> *entries = edge_buckets.getptr(region_edge.key);
+				if (entries == nullptr || entries->size() != 1) {
+					continue;
+				}
+				gd::Polygon &poly = polygons[slot.offset + region_edge.polygon];
+				gd::Edge::Connection target;
+				target.polygon = &poly;
+				target.edge = region_edge.edge;
+				target.pathway_start = poly.points[region_edge.edge].pos;
+				target.pathway_end = poly.points[(region_edge.edge + 1) % poly.points.size()].pos;
+				sync_free_edge_targets.push_back(target);
+				sync_free_edge_target_bounds.push_back(AABB(target.pathway_start, Vector3()).expand(target.pathway_end).grow(edge_connection_margin));
+			}
+		}
+	}
+
+	// Each free edge only writes its own connections, so they can be searched in parallel.
+	if (use_threads && sync_free_edges.size() > 64) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &NavMap::_sync_free_edge, sync_free_edges.ptr(), sync_free_edges.size(), -1, true, SNAME("NavMapSyncFreeEdges"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		for (uint32_t i = 0; i < sync_free_edges.size(); i++) {
+			_sync_free_edge(i, sync_free_edges.ptr());
+		}
+	}
+
+	// Add the connections to the region_connection map.
+	for (const gd::Edge::Connection &free_edge : sync_free_edges) {
+		RegionSlot *slot = region_slots.getptr((NavRegion *)free_edge.polygon->owner);
+		for (const gd::Edge::Connection &new_connection : free_edge.polygon->edges[free_edge.edge].connections) {
+			slot->external_connections.push_back(new_connection);
+		}
+	}
+}
+
+void NavMap::_sync_region_polygons(uint32_t p_index, RegionSlot **p_slots) {
+	RegionSlot *slot = p_slots[p_index];
+	const NavRegion *region = slot->region;
+	const uint32_t polygon_offset = slot->offset;
+
+	AABB bounds;
+	if (slot->count > 0) {
+		const LocalVector<gd::Polygon> &polygons_source = region->get_polygons();
+		bool first_point = true;
+		for (uint32_t n = 0; n < polygons_source.size(); n++) {
+			polygons[polygon_offset + n] = polygons_source[n];
+			polygons[polygon_offset + n].id = polygon_offset + n;
+			for (const gd::Point &point : polygons_source[n].points) {
+				if (first_point) {
+					bounds.position = point.pos;
+					first_point = false;
+				} else {
+					bounds.expand_to(point.pos);
+				}
+			}
+		}
+
+		// Connect the edges shared by different polygons of this region.
+		for (const gd::RegionEdgeMerge &merge : region->get_internal_edge_merges()) {
+			gd::Polygon &poly_a = polygons[polygon_offset + merge.polygon_a];
+			gd::Polygon &poly_b = polygons[polygon_offset + merge.polygon_b];
+
+			gd::Edge::Connection c1;
+			c1.polygon = &poly_a;
+			c1.edge = merge.edge_a;
+			c1.pathway_start = poly_a.points[merge.edge_a].pos;
+			c1.pathway_end = poly_a.points[(merge.edge_a + 1) % poly_a.points.size()].pos;
+
+			gd::Edge::Connection c2;
+			c2.polygon = &poly_b;
+			c2.edge = merge.edge_b;
+			c2.pathway_start = poly_b.points[merge.edge_b].pos;
+			c2.pathway_end = poly_b.points[(merge.edge_b + 1) % poly_b.points.size()].pos;
+
+			poly_a.edges[merge.edge_a].connections.push_back(c2);
+			poly_b.edges[merge.edge_b].connections.push_back(c1);
+		}
+	}
+
+	// The rest of the slot is left for the region to grow.
+	_clear_region_slot_polygons(polygon_offset + slot->count, polygon_offset + slot->capacity);
+
+	// Edges are keyed on the merge rasterizer cells, so shared edges can be that far apart too.
+	slot->bounds = bounds.grow(edge_connection_margin + MAX(merge_rasterizer_cell_size, merge_rasterizer_cell_height));
+}
+
+void NavMap::_sync_free_edge(uint32_t p_index, gd::Edge::Connection *p_free_edges) {
+	const gd::Edge::Connection &free_edge = p_free_edges[p_index];
+	const AABB &free_edge_bounds = sync_free_edge_bounds[p_index];
+	Vector3 edge_p1 = free_edge.polygon->points[free_edge.edge].pos;
+	Vector3 edge_p2 = free_edge.polygon->points[(free_edge.edge + 1) % free_edge.polygon->points.size()].pos;
+
+	for (uint32_t j = 0; j < sync_free_edge_targets.size(); j++) {
+		const gd::Edge::Connection &other_edge = sync_free_edge_targets[j];
+		if (free_edge.polygon->owner == other_edge.polygon->owner) {
+			continue;
+		}
+		if (!free_edge_bounds.intersects_inclusive(sync_free_edge_target_bounds[j])) {
+			continue;
+		}
+
+		Vector3 other_edge_p1 = other_edge.polygon->points[other_edge.edge].pos;
+		Vector3 other_edge_p2 = other_edge.polygon->points[(other_edge.edge + 1) % other_edge.polygon->points.size()].pos;
+
+		// Compute the projection of the opposite edge on the current one
+		Vector3 edge_vector = edge_p2 - edge_p1;
+		real_t projected_p1_ratio = edge_vector.dot(other_edge_p1 - edge_p1) / (edge_vector.length_squared());
+		real_t projected_p2_ratio = edge_vector.dot(other_edge_p2 - edge_p1) / (edge_vector.length_squared());
+		if ((projected_p1_ratio < 0.0 && projected_p2_ratio < 0.0) || (projected_p1_ratio > 1.0 && projected_p2_ratio > 1.0)) {
+			continue;
+		}
+
+		// Check if the two edges are close to each other enough and compute a pathway between the two regions.
+		Vector3 self1 = edge_vector * CLAMP(projected_p1_ratio, 0.0, 1.0) + edge_p1;
+		Vector3 other1;
+		if (projected_p1_ratio >= 0.0 && projected_p1_ratio <= 1.0) {
+			other1 = other_edge_p1;
+		} else {
+			other1 = other_edge_p1.lerp(other_edge_p2, (1.0 - projected_p1_ratio) / (projected_p2_ratio - projected_p1_ratio));
+		}
+		if (other1.distance_to(self1) > edge_connection_margin) {
+			continue;
+		}
+
+		Vector3 self2 = edge_vector * CLAMP(projected_p2_ratio, 0.0, 1.0) + edge_p1;
+		Vector3 other2;
+		if (projected_p2_ratio >= 0.0 && projected_p2_ratio <= 1.0) {
+			other2 = other_edge_p2;
+		} else {
+			other2 = other_edge_p1.lerp(other_edge_p2, (0.0 - projected_p1_ratio) / (projected_p2_ratio - projected_p1_ratio));
+		}
+		if (other2.distance_to(self2) > edge_connection_margin) {
+			continue;
+		}
+
+		// The edges can now be connected.
+		gd::Edge::Connection new_connection = other_edge;
+		new_connection.pathway_start = (self1 + other1) / 2.0;
+		new_connection.pathway_end = (self2 + other2) / 2.0;
+		free_edge.polygon->edges[free_edge.edge].connections.push_back(new_connection);
+	}
+}
+
+void NavMap::_clear_link_connections() {
+	// Strip the connections of the previous link polygons, region polygons never use an edge of -1.
+	for (gd::Polygon *polygon : link_connected_polygons) {
+		Vector<gd::Edge::Connection> &connections = polygon->edges[0].connections;
+		for (int i = connections.size() - 1; i >= 0; i--) {
+			if (connections[i].edge == -1) {
+				connections.remove_at(i);
+			}
+		}
+	}
+	link_connected_polygons.clear();
+}
+
+void NavMap::_sync_link_polygons() {
+	_clear_link_connections();
+
+	uint32_t polygon_count = polygons.size();
+	uint32_t link_poly_idx = 0;
+	link_polygons.resize(links.size());
+
+	// Search for polygons within range of a nav link.
+	for (const NavLink *link : links) {
+		if (!link->get_enabled()) {
+			continue;
+		}
+		const Vector3 start = link->get_start_position();
+		const Vector3 end = link->get_end_position();
+
+		gd::Polygon *closest_start_polygon = nullptr;
+		real_t closest_start_distance = link_connection_radius;
+		Vector3 closest_start_point;
+
+		gd::Polygon *closest_end_polygon = nullptr;
+		real_t closest_end_distance = link_connection_radius;
+		Vector3 closest_end_point;
+
+		// Create link to any polygons within the search radius of the start point.
+		for (uint32_t start_index = 0; start_index < polygons.size(); start_index++) {
+			gd::Polygon &start_poly = polygons[start_index];
+
+			// For each face check the distance to the start
+			for (uint32_t start_point_id = 2; start_point_id < start_poly.points.size(); start_point_id += 1) {
+				const Face3 start_face(start_poly.points[0].pos, start_poly.points[start_point_id - 1].pos, start_poly.points[start_point_id].pos);
+				const Vector3 start_point = start_face.get_closest_point_to(start);
+				const real_t start_distance = start_point.distance_to(start);
+
+				// Pick the polygon that is within our radius and is closer than anything we've seen yet.
+				if (start_distance <= link_connection_radius && start_distance < closest_start_distance) {
+					closest_start_distance = start_distance;
+					closest_start_point = start_point;
+					closest_start_polygon = &start_poly;
+				}
+			}
+		}
+
+		// Find any polygons within the search radius of the end point.
+		for (gd::Polygon &end_poly : polygons) {
+			// For each face check the distance to the end
+			for (uint32_t end_point_id = 2; end_point_id < end_poly.points.size(); end_point_id += 1) {
+				const Face3 end_face(end_poly.points[0].pos, end_poly.points[end_point_id - 1].pos, end_poly.points[end_point_id].pos);
+				const Vector3 end_point = end_face.get_closest_point_to(end);
+				const real_t end_distance = end_point.distance_to(end);
+
+				// Pick the polygon that is within our radius and is closer than anything we've seen yet.
+				if (end_distance <= link_connection_radius && end_distance < closest_end_distance) {
+					closest_end_distance = end_distance;
+					closest_end_point = end_point;
+					closest_end_polygon = &end_poly;
+				}
+			}
+		}
+
+		// If we have both a start and end point, then create a synthetic polygon to route through.
+		if (closest_start_polygon && closest_end_polygon) {
+			gd::Polygon &new_polygon = link_polygons[link_poly_idx++];
+			new_polygon.id = polygon_count++;
+			new_polygon.owner = link;
+
+			new_polygon.edges.clear();
+			new_polygon.edges.resize(4);
+			new_polygon.points.clear();
+			new_polygon.points.reserve(4);
+
+			// Build a set of vertices that create a thin polygon going from the start to the end point.
+			new_polygon.points.push_back({ closest_start_point, get_point_key(closest_start_point) });
+			new_polygon.points.push_back({ closest_start_point, get_point_key(closest_start_point) });
+			new_polygon.points.push_back({ closest_end_point, get_point_key(closest_end_point) });
+			new_polygon.points.push_back({ closest_end_point, get_point_key(closest_end_point) });
+
+			// Setup connections to go forward in the link.
+			{
+				gd::Edge::Connection entry_connection;
+				entry_connection.polygon = &new_polygon;
+				entry_connection.edge = -1;
+				entry_connection.pathway_start = new_polygon.points[0].pos;
+				entry_connection.pathway_end = new_polygon.points[1].pos;
+				closest_start_polygon->edges[0].connections.push_back(entry_connection);
+				link_connected_polygons.push_back(closest_start_polygon);
+
+				gd::Edge::Connection exit_connection;
+				exit_connection.polygon = closest_end_polygon;
+				exit_connection.edge = -1;
+				exit_connection.pathway_start = new_polygon.points[2].pos;
+				exit_connection.pathway_end = new_polygon.points[3].pos;
+				new_polygon.edges[2].connections.push_back(exit_connection);
+			}
+
+			// If the link is bi-directional, create connections from the end to the start.
+			if (link->is_bidirectional()) {
+				gd::Edge::Connection entry_connection;
+				entry_connection.polygon = &new_polygon;
+				entry_connection.edge = -1;
+				entry_connection.pathway_start = new_polygon.points[2].pos;
+				entry_connection.pathway_end = new_polygon.points[3].pos;
+				closest_end_polygon->edges[0].connections.push_back(entry_connection);
+				link_connected_polygons.push_back(closest_end_polygon);
+
+				gd::Edge::Connection exit_connection;
+				exit_connection.polygon = closest_start_polygon;
+				exit_connection.edge = -1;
+				exit_connection.pathway_start = new_polygon.points[0].pos;
+				exit_connection.pathway_end = new_polygon.points[1].pos;
+				new_polygon.edges[0].connections.push_back(exit_connection);
+			}
+		}
+	}
+
+	link_polygon_count = link_poly_idx;
 }
 
 void NavMap::_update_rvo_simulation() {
@@ -789,6 +1192,7 @@ void NavMap::_update_rvo_simulation() {
 	if (agents_dirty) {
 		_update_rvo_agents_tree_2d();
 		_update_rvo_agents_tree_3d();
+		rvo_agents_trees_changed = false;
 	}
 }
 
@@ -859,9 +1263,9 @@ void NavMap::_update_merge_rasterizer_cell_dimensions() {
 int NavMap::get_region_connections_count(NavRegion *p_region) const {
 	ERR_FAIL_NULL_V(p_region, 0);
 
-	HashMap<NavRegion *, LocalVector<gd::Edge::Connection>>::ConstIterator found_connections = region_external_connections.find(p_region);
-	if (found_connections) {
-		return found_connections->value.size();
+	const RegionSlot *slot = region_slots.getptr(p_region);
+	if (slot) {
+		return slot->external_connections.size();
 	}
 	return 0;
 }
@@ -869,10 +1273,10 @@ int NavMap::get_region_connections_count(NavRegion *p_region) const {
 Vector3 NavMap::get_region_connection_pathway_start(NavRegion *p_region, int p_connection_id) const {
 	ERR_FAIL_NULL_V(p_region, Vector3());
 
-	HashMap<NavRegion *, LocalVector<gd::Edge::Connection>>::ConstIterator found_connections = region_external_connections.find(p_region);
-	if (found_connections) {
-		ERR_FAIL_INDEX_V(p_connection_id, int(found_connections->value.size()), Vector3());
-		return found_connections->value[p_connection_id].pathway_start;
+	const RegionSlot *slot = region_slots.getptr(p_region);
+	if (slot) {
+		ERR_FAIL_INDEX_V(p_connection_id, int(slot->external_connections.size()), Vector3());
+		return slot->external_connections[p_connection_id].pathway_start;
 	}
 
 	return Vector3();
@@ -881,10 +1285,10 @@ Vector3 NavMap::get_region_connection_pathway_start(NavRegion *p_region, int p_c
 Vector3 NavMap::get_region_connection_pathway_end(NavRegion *p_region, int p_connection_id) const {
 	ERR_FAIL_NULL_V(p_region, Vector3());
 
-	HashMap<NavRegion *, LocalVector<gd::Edge::Connection>>::ConstIterator found_connections = region_external_connections.find(p_region);
-	if (found_connections) {
-		ERR_FAIL_INDEX_V(p_connection_id, int(found_connections->value.size()), Vector3());
-		return found_connections->value[p_connection_id].pathway_end;
+	const RegionSlot *slot = region_slots.getptr(p_region);
+	if (slot) {
+		ERR_FAIL_INDEX_V(p_connection_id, int(slot->external_connections.size()), Vector3());
+		return slot->external_connections[p_connection_id].pathway_end;
 	}
 
 	return Vector3();
@@ -893,6 +1297,7 @@ Vector3 NavMap::get_region_connection_pathway_end(NavRegion *p_region, int p_con
 NavMap::NavMap() {
 	avoidance_use_multiple_threads = GLOBAL_GET("navigation/avoidance/thread_model/avoidance_use_multiple_threads");
 	avoidance_use_high_priority_threads = GLOBAL_GET("navigation/avoidance/thread_model/avoidance_use_high_priority_threads");
+	use_hierarchical_pathfinding = GLOBAL_GET("navigation/pathfinding/use_hierarchical_pathfinding");
 }
 
 NavMap::~NavMap() {
@@ -31,6 +31,7 @@
 #ifndef NAV_MAP_H
 #define NAV_MAP_H
 
+#include "nav_map_hierarchy.h"
 #include "nav_rid.h"
 #include "nav_utils.h"
 
@@ -74,6 +75,8 @@ class NavMap : public NavRid {
 
 	bool regenerate_polygons = true;
 	bool regenerate_links = true;
+	/// Only the link polygons need to be rebuilt, region connections are still valid.
+	bool regenerate_link_polygons = true;
 
 	/// Map regions
 	LocalVector<NavRegion *> regions;
@@ -81,10 +84,61 @@ class NavMap : public NavRid {
 	/// Map links
 	LocalVector<NavLink *> links;
 	LocalVector<gd::Polygon> link_polygons;
+	uint32_t link_polygon_count = 0;
 
-	/// Map polygons
+	/// Map polygons. Each region owns a range of them, so a region that changes only rewrites
+	/// its own range. Unused polygons in between have no owner and no points.
 	LocalVector<gd::Polygon> polygons;
 
+	/// Where the polygons of a region are in the map, and what it was connected with.
+	struct RegionSlot {
+		NavRegion *region = nullptr; // Only compared, the region may already be freed once it was removed.
+		uint32_t offset = 0;
+		uint32_t capacity = 0;
+		uint32_t count = 0;
+		/// Bounds of the polygons grown by how far edges can connect, regions with disjoint bounds are never connected.
+		AABB bounds;
+		/// The region external edges in the edge buckets, kept since the region replaces its own when it changes.
+		LocalVector<gd::RegionEdge> external_edges;
+		/// Connections from the free edges of this region to other regions.
+		LocalVector<gd::Edge::Connection> external_connections;
+
+		// Performance Monitor
+		uint32_t edge_count = 0;
+		uint32_t edge_merge_count = 0;
+		uint32_t edge_free_count = 0;
+	};
+	HashMap<NavRegion *, RegionSlot> region_slots;
+	/// Slots of the regions removed since the last sync, their neighbors must be reconnected.
+	LocalVector<RegionSlot> removed_region_slots;
+	uint32_t region_slots_polygon_count = 0;
+
+	/// External edges of all regions grouped per key. The first two edges of a key are merged together.
+	struct EdgeBucketEntry {
+		uint32_t polygon = 0; // Map polygon id.
+		int edge = -1;
+	};
+	HashMap<gd::EdgeKey, LocalVector<EdgeBucketEntry>, gd::EdgeKey> edge_buckets;
+
+	/// Abstract graph of the map polygons used by long path queries.
+	NavMapHierarchy hierarchy;
+	bool use_hierarchical_pathfinding = false;
+
+	/// Map polygons that received connections from links, to strip them when only links change.
+	LocalVector<gd::Polygon *> link_connected_polygons;
+
+	/// Sync scratch data, kept to reuse allocations.
+	LocalVector<NavRegion *> sync_regions;
+	LocalVector<uint32_t> sync_region_polygon_offsets;
+	LocalVector<NavRegion *> sync_dirty_regions;
+	LocalVector<RegionSlot *> sync_dirty_slots;
+	LocalVector<RegionSlot *> sync_reconnect_slots;
+	LocalVector<AABB> sync_changed_bounds;
+	LocalVector<gd::Edge::Connection> sync_free_edges;
+	LocalVector<AABB> sync_free_edge_bounds;
+	LocalVector<gd::Edge::Connection> sync_free_edge_targets;
+	LocalVector<AABB> sync_free_edge_target_bounds;
+
 	/// RVO avoidance worlds
 	RVO2D::RVOSimulator2D rvo_simulation_2d;
 	RVO3D::RVOSimulator3D rvo_simulation_3d;
@@ -96,6 +150,16 @@ class NavMap : public NavRid {
 	/// dirty flag when one of the agent's arrays are modified
 	bool agents_dirty = true;
 
+	/// The avoidance controlled agents changed, so their trees can't just be refitted
+	bool rvo_agents_trees_changed = true;
+
+	/// Summed leaf extents of the agent trees when they were last built, to detect when refitting degrades them
+	float rvo_agents_tree_2d_extents = 0.0;
+	float rvo_agents_tree_3d_extents = 0.0;
+
+	std::vector<RVO2D::KdTree2D::AgentTreeTask> rvo_agents_tree_2d_tasks;
+	std::vector<RVO3D::KdTree3D::AgentTreeTask> rvo_agents_tree_3d_tasks;
+
 	/// All the Agents (even the controlled one)
 	LocalVector<NavAgent *> agents;
 
@@ -126,8 +190,6 @@ class NavMap : public NavRid {
 	int pm_edge_free_count = 0;
 	int pm_obstacle_count = 0;
 
-	HashMap<NavRegion *, LocalVector<gd::Edge::Connection>> region_external_connections;
-
 public:
 	NavMap();
 	~NavMap();
@@ -232,10 +294,22 @@ private:
 	void compute_single_avoidance_step_2d(uint32_t index, NavAgent **agent);
 	void compute_single_avoidance_step_3d(uint32_t index, NavAgent **agent);
 
+	bool _sync_region_slots(const LocalVector<NavRegion *> &p_dirty_regions);
+	void _reset_region_slots();
+	void _remove_region_slot_edges(const RegionSlot &p_slot);
+	void _clear_region_slot_polygons(uint32_t p_from, uint32_t p_to);
+	void _connect_region_slots(bool p_all);
+	void _sync_region_polygons(uint32_t p_index, RegionSlot **p_slots);
+	void _sync_free_edge(uint32_t p_index, gd::Edge::Connection *p_free_edges);
+	void _clear_link_connections();
+	void _sync_link_polygons();
+
 	void _update_rvo_simulation();
 	void _update_rvo_obstacles_tree_2d();
 	void _update_rvo_agents_tree_2d();
 	void _update_rvo_agents_tree_3d();
+	void _build_rvo_agents_subtree_2d(uint32_t p_index, RVO2D::KdTree2D::AgentTreeTask *p_tasks);
+	void _build_rvo_agents_subtree_3d(uint32_t p_index, RVO3D::KdTree3D::AgentTreeTask *p_tasks);
 
 	void _update_merge_rasterizer_cell_dimensions();
 };
@@ -0,0 +1,431 @@
+/**************************************************************************/
+/*  nav_map_hierarchy.cpp                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "nav_map_hierarchy.h"
+
+#include "nav_base.h"
+#include "nav_region.h"
+
+namespace {
+
+struct SearchEntry {
+	real_t cost = 0.0;
+	uint32_t index = 0;
+};
+
+struct SearchEntryGreaterThan {
+	bool operator()(const SearchEntry &p_a, const SearchEntry &p_b) const {
+		return p_a.cost > p_b.cost;
+	}
+};
+
+typedef gd::Heap<SearchEntry, SearchEntryGreaterThan> SearchHeap;
+
+// Scratch buffers reused by the corridor searches running on the same thread.
+struct CorridorSearchBuffers {
+	LocalVector<real_t> node_costs;
+	LocalVector<uint32_t> node_parents;
+	LocalVector<uint8_t> node_closed;
+	SearchHeap heap;
+
+	// Distances from the begin and end polygons inside their regions.
+	LocalVector<real_t> begin_distances;
+	LocalVector<real_t> end_distances;
+	SearchHeap cluster_heap;
+};
+
+thread_local CorridorSearchBuffers corridor_search_buffers;
+
+} //namespace
+
+void NavMapHierarchy::clear() {
+	clusters.clear();
+	nodes.clear();
+	node_edge_offsets.clear();
+	node_edges.clear();
+	polygon_clusters.clear();
+	polygon_nodes.clear();
+	polygon_centers.clear();
+	min_travel_cost = 1.0;
+}
+
+void NavMapHierarchy::_compute_cluster_distances(const LocalVector<gd::Polygon> &p_polygons, const Cluster &p_cluster, uint32_t p_from_polygon_id, real_t *r_distances) const {
+	// Dijkstra over the polygons of a single region, using the distances between the polygon centers.
+	const uint32_t cluster_index = polygon_clusters[p_from_polygon_id];
+	const uint32_t polygon_count = p_cluster.polygon_end - p_cluster.polygon_begin;
+
+	for (uint32_t i = 0; i < polygon_count; i++) {
+		r_distances[i] = FLT_MAX;
+	}
+
+	uint32_t portals_left = p_cluster.node_end - p_cluster.node_begin;
+	if (portals_left == 0) {
+		return;
+	}
+
+	SearchHeap &heap = corridor_search_buffers.cluster_heap;
+	heap.clear();
+	SearchEntry from;
+	from.cost = 0.0;
+	from.index = p_from_polygon_id - p_cluster.polygon_begin;
+	r_distances[from.index] = from.cost;
+	heap.push(from);
+
+	while (!heap.is_empty()) {
+		const SearchEntry current = heap.pop();
+		if (current.cost > r_distances[current.index]) {
+			continue;
+		}
+
+		const uint32_t polygon_id = p_cluster.polygon_begin + current.index;
+		if (polygon_nodes[polygon_id] != UINT32_MAX) {
+			portals_left--;
+			if (portals_left == 0) {
+				break;
+			}
+		}
+
+		const gd::Polygon &polygon = p_polygons[polygon_id];
+		for (const gd::Edge &edge : polygon.edges) {
+			for (const gd::Edge::Connection &connection : edge.connections) {
+				const uint32_t other_id = connection.polygon->id;
+				if (other_id >= polygon_clusters.size() || polygon_clusters[other_id] != cluster_index) {
+					continue;
+				}
+
+				SearchEntry next;
+				next.index = other_id - p_cluster.polygon_begin;
+				next.cost = current.cost + polygon_centers[polygon_id].distance_to(polygon_centers[other_id]);
+				if (next.cost < r_distances[next.index]) {
+					r_distances[next.index] = next.cost;
+					heap.push(next);
+				}
+			}
+		}
+	}
+}
+
+void NavMapHierarchy::build(const LocalVector<NavRegion *> &p_regions, const LocalVector<uint32_t> &p_region_polygon_offsets, const LocalVector<gd::Polygon> &p_polygons, const LocalVector<gd::Polygon> &p_link_polygons, uint32_t p_link_polygon_count) {
+	clear();
+
+	const uint32_t polygon_count = p_polygons.size() + p_link_polygon_count;
+	polygon_clusters.resize(polygon_count);
+	polygon_nodes.resize(polygon_count);
+	polygon_centers.resize(polygon_count);
+
+	// Polygons left unused between the regions belong to no cluster.
+	for (uint32_t &cluster_index : polygon_clusters) {
+		cluster_index = UINT32_MAX;
+	}
+
+	// Clusters, one per region and one per link polygon.
+	for (uint32_t i = 0; i < p_regions.size(); i++) {
+		Cluster cluster;
+		cluster.owner = p_regions[i];
+		cluster.polygon_begin = p_region_polygon_offsets[i];
+		cluster.polygon_end = cluster.polygon_begin + p_regions[i]->get_polygons().size();
+		for (uint32_t id = cluster.polygon_begin; id < cluster.polygon_end; id++) {
+			polygon_clusters[id] = clusters.size();
+		}
+		clusters.push_back(cluster);
+	}
+	for (uint32_t i = 0; i < p_link_polygon_count; i++) {
+		Cluster cluster;
+		cluster.owner = p_link_polygons[i].owner;
+		cluster.polygon_begin = p_link_polygons[i].id;
+		cluster.polygon_end = cluster.polygon_begin + 1;
+		polygon_clusters[cluster.polygon_begin] = clusters.size();
+		clusters.push_back(cluster);
+	}
+
+	for (const Cluster &cluster : clusters) {
+		min_travel_cost = MIN(min_travel_cost, cluster.owner->get_travel_cost());
+	}
+
+	for (uint32_t id = 0; id < polygon_count; id++) {
+		const gd::Polygon &polygon = id < p_polygons.size() ? p_polygons[id] : p_link_polygons[id - p_polygons.size()];
+		Vector3 center;
+		for (const gd::Point &point : polygon.points) {
+			center += point.pos;
+		}
+		if (!polygon.points.is_empty()) {
+			center /= polygon.points.size();
+		}
+		polygon_centers[id] = center;
+		polygon_nodes[id] = UINT32_MAX;
+	}
+
+	// Portals are the polygons connected to another cluster, in either direction.
+	for (uint32_t id = 0; id < polygon_count; id++) {
+		const gd::Polygon &polygon = id < p_polygons.size() ? p_polygons[id] : p_link_polygons[id - p_polygons.size()];
+		for (const gd::Edge &edge : polygon.edges) {
+			for (const gd::Edge::Connection &connection : edge.connections) {
+				const uint32_t other_id = connection.polygon->id;
+				if (polygon_clusters[other_id] != polygon_clusters[id]) {
+					polygon_nodes[id] = 0;
+					polygon_nodes[other_id] = 0;
+				}
+			}
+		}
+	}
+
+	for (uint32_t id = 0; id < polygon_count; id++) {
+		if (polygon_nodes[id] == UINT32_MAX) {
+			continue;
+		}
+		Cluster &cluster = clusters[polygon_clusters[id]];
+		if (cluster.node_begin == cluster.node_end) {
+			cluster.node_begin = nodes.size();
+		}
+		cluster.node_end = nodes.size() + 1;
+		polygon_nodes[id] = nodes.size();
+		Node node;
+		node.polygon_id = id;
+		node.cluster = polygon_clusters[id];
+		node.position = polygon_centers[id];
+		nodes.push_back(node);
+	}
+
+	LocalVector<LocalVector<Edge>> edges;
+	edges.resize(nodes.size());
+
+	// Edges between clusters follow the polygon connections.
+	for (uint32_t n = 0; n < nodes.size(); n++) {
+		const uint32_t id = nodes[n].polygon_id;
+		const gd::Polygon &polygon = id < p_polygons.size() ? p_polygons[id] : p_link_polygons[id - p_polygons.size()];
+		for (const gd::Edge &edge : polygon.edges) {
+			for (const gd::Edge::Connection &connection : edge.connections) {
+				const uint32_t other_id = connection.polygon->id;
+				if (polygon_clusters[other_id] == polygon_clusters[id]) {
+					continue;
+				}
+				Edge new_edge;
+				new_edge.to = polygon_nodes[other_id];
+				new_edge.cost = polygon_centers[id].distance_to(polygon_centers[other_id]) * polygon.owner->get_travel_cost() + connection.polygon->owner->get_enter_cost();
+				edges[n].push_back(new_edge);
+			}
+		}
+	}
+
+	// Edges inside the regions. The portal distances only depend on the region polygons and on
+	// which of them are portals, so they are cached by the region and only recomputed when either
+	// changes. Only the distances between portals are kept, queries search the distances from their
+	// begin and end polygons to the portals of those two regions.
+	LocalVector<uint32_t> portals;
+	LocalVector<real_t> polygon_distances;
+	for (uint32_t i = 0; i < p_regions.size(); i++) {
+		NavRegion *region = p_regions[i];
+		Cluster &cluster = clusters[i];
+		if (cluster.node_begin == cluster.node_end) {
+			continue;
+		}
+
+		portals.clear();
+		for (uint32_t n = cluster.node_begin; n < cluster.node_end; n++) {
+			portals.push_back(nodes[n].polygon_id - cluster.polygon_begin);
+		}
+
+		const uint32_t portal_count = portals.size();
+		const LocalVector<uint32_t> &cached_portals = region->get_hierarchy_portals();
+		bool cache_valid = cached_portals.size() == portal_count && region->get_hierarchy_portal_distances().size() == portal_count * portal_count;
+		for (uint32_t p = 0; cache_valid && p < portal_count; p++) {
+			cache_valid = cached_portals[p] == portals[p];
+		}
+
+		if (!cache_valid) {
+			polygon_distances.resize(cluster.polygon_end - cluster.polygon_begin);
+			LocalVector<real_t> portal_distances;
+			portal_distances.resize(portal_count * portal_count);
+			for (uint32_t a = 0; a < portal_count; a++) {
+				_compute_cluster_distances(p_polygons, cluster, cluster.polygon_begin + portals[a], polygon_distances.ptr());
+				for (uint32_t b = 0; b < portal_count; b++) {
+					portal_distances[a * portal_count + b] = polygon_distances[portals[b]];
+				}
+			}
+			region->set_hierarchy_portal_distances(portals, portal_distances);
+		}
+		cluster.portal_distances = region->get_hierarchy_portal_distances().ptr();
+
+		const real_t travel_cost = region->get_travel_cost();
+		for (uint32_t a = 0; a < portal_count; a++) {
+			for (uint32_t b = 0; b < portal_count; b++) {
+				const real_t distance = cluster.portal_distances[a * portal_count + b];
+				if (a == b || distance == FLT_MAX) {
+					continue;
+				}
+				Edge new_edge;
+				new_edge.to = cluster.node_begin + b;
+				new_edge.cost = distance * travel_cost;
+				edges[cluster.node_begin + a].push_back(new_edge);
+			}
+		}
+	}
+
+	node_edge_offsets.resize(nodes.size() + 1);
+	uint32_t edge_count = 0;
+	for (uint32_t n = 0; n < nodes.size(); n++) {
+		node_edge_offsets[n] = edge_count;
+		edge_count += edges[n].size();
+	}
+	node_edge_offsets[nodes.size()] = edge_count;
+
+	node_edges.resize(edge_count);
+	for (uint32_t n = 0; n < nodes.size(); n++) {
+		Edge *w = node_edges.ptr() + node_edge_offsets[n];
+		for (uint32_t e = 0; e < edges[n].size(); e++) {
+			w[e] = edges[n][e];
+		}
+	}
+}
+
+bool NavMapHierarchy::find_corridor(const LocalVector<gd::Polygon> &p_polygons, const gd::Polygon *p_begin_poly, const Vector3 &p_begin_point, const gd::Polygon *p_end_poly, const Vector3 &p_end_point, uint32_t p_navigation_layers, LocalVector<uint8_t> &r_cluster_mask) const {
+	if (nodes.is_empty() || p_begin_poly->id >= polygon_clusters.size() || p_end_poly->id >= polygon_clusters.size()) {
+		return false;
+	}
+
+	const uint32_t begin_cluster_index = polygon_clusters[p_begin_poly->id];
+	const uint32_t end_cluster_index = polygon_clusters[p_end_poly->id];
+	if (begin_cluster_index == end_cluster_index) {
+		return false;
+	}
+
+	CorridorSearchBuffers &buffers = corridor_search_buffers;
+	const Cluster &begin_cluster = clusters[begin_cluster_index];
+	const Cluster &end_cluster = clusters[end_cluster_index];
+
+	// The begin and end regions connect to the search through the distances from the begin and end polygons to their portals.
+	if (begin_cluster.portal_distances == nullptr || end_cluster.portal_distances == nullptr) {
+		return false;
+	}
+	buffers.begin_distances.resize(begin_cluster.polygon_end - begin_cluster.polygon_begin);
+	_compute_cluster_distances(p_polygons, begin_cluster, p_begin_poly->id, buffers.begin_distances.ptr());
+	// Connections inside a region go both ways, so the distances from the end polygon are also the distances to it.
+	buffers.end_distances.resize(end_cluster.polygon_end - end_cluster.polygon_begin);
+	_compute_cluster_distances(p_polygons, end_cluster, p_end_poly->id, buffers.end_distances.ptr());
+	const real_t begin_center_distance = p_begin_point.distance_to(polygon_centers[p_begin_poly->id]);
+	const real_t end_center_distance = p_end_point.distance_to(polygon_centers[p_end_poly->id]);
+	const real_t begin_travel_cost = begin_cluster.owner->get_travel_cost();
+	const real_t end_travel_cost = end_cluster.owner->get_travel_cost();
+
+	// A* over the portals, the last two nodes are the begin and end points.
+	const uint32_t begin_node = nodes.size();
+	const uint32_t end_node = nodes.size() + 1;
+	const uint32_t node_count = nodes.size() + 2;
+
+	buffers.node_costs.resize(node_count);
+	buffers.node_parents.resize(node_count);
+	buffers.node_closed.resize(node_count);
+	for (uint32_t n = 0; n < node_count; n++) {
+		buffers.node_costs[n] = FLT_MAX;
+		buffers.node_parents[n] = UINT32_MAX;
+		buffers.node_closed[n] = 0;
+	}
+	buffers.heap.clear();
+
+	buffers.node_costs[begin_node] = 0.0;
+	SearchEntry begin_entry;
+	begin_entry.index = begin_node;
+	begin_entry.cost = p_begin_point.distance_to(p_end_point) * min_travel_cost;
+	buffers.heap.push(begin_entry);
+
+	bool found = false;
+	while (!buffers.heap.is_empty()) {
+		const uint32_t current = buffers.heap.pop().index;
+		if (buffers.node_closed[current]) {
+			continue;
+		}
+		buffers.node_closed[current] = 1;
+
+		if (current == end_node) {
+			found = true;
+			break;
+		}
+
+		const real_t current_cost = buffers.node_costs[current];
+
+		auto relax = [&](uint32_t p_to, real_t p_cost) {
+			const real_t new_cost = current_cost + p_cost;
+			if (buffers.node_closed[p_to] || new_cost >= buffers.node_costs[p_to]) {
+				return;
+			}
+			buffers.node_costs[p_to] = new_cost;
+			buffers.node_parents[p_to] = current;
+			SearchEntry entry;
+			entry.index = p_to;
+			const Vector3 &position = p_to == end_node ? p_end_point : nodes[p_to].position;
+			entry.cost = new_cost + position.distance_to(p_end_point) * min_travel_cost;
+			buffers.heap.push(entry);
+		};
+
+		if (current == begin_node) {
+			// Enter the portals of the begin region.
+			for (uint32_t n = begin_cluster.node_begin; n < begin_cluster.node_end; n++) {
+				const real_t distance = buffers.begin_distances[nodes[n].polygon_id - begin_cluster.polygon_begin];
+				if (distance != FLT_MAX) {
+					relax(n, (begin_center_distance + distance) * begin_travel_cost);
+				}
+			}
+			continue;
+		}
+
+		const Node &node = nodes[current];
+		if (node.cluster == end_cluster_index) {
+			const real_t distance = buffers.end_distances[node.polygon_id - end_cluster.polygon_begin];
+			if (distance != FLT_MAX) {
+				relax(end_node, (distance + end_center_distance) * end_travel_cost);
+			}
+		}
+
+		for (uint32_t e = node_edge_offsets[current]; e < node_edge_offsets[current + 1]; e++) {
+			const Edge &edge = node_edges[e];
+			const Cluster &to_cluster = clusters[nodes[edge.to].cluster];
+			if ((p_navigation_layers & to_cluster.owner->get_navigation_layers()) == 0) {
+				continue;
+			}
+			relax(edge.to, edge.cost);
+		}
+	}
+
+	if (!found) {
+		return false;
+	}
+
+	r_cluster_mask.resize(clusters.size());
+	for (uint32_t c = 0; c < clusters.size(); c++) {
+		r_cluster_mask[c] = 0;
+	}
+	r_cluster_mask[begin_cluster_index] = 1;
+	r_cluster_mask[end_cluster_index] = 1;
+	for (uint32_t n = buffers.node_parents[end_node]; n != begin_node && n != UINT32_MAX; n = buffers.node_parents[n]) {
+		r_cluster_mask[nodes[n].cluster] = 1;
+	}
+
+	return true;
+}
@@ -0,0 +1,102 @@
+/**************************************************************************/
+/*  nav_map_hierarchy.h                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef NAV_MAP_HIERARCHY_H
+#define NAV_MAP_HIERARCHY_H
+
+#include "nav_utils.h"
+
+#include "core/templates/local_vector.h"
+
+class NavBase;
+class NavRegion;
+
+/// Abstract graph over the map polygons for hierarchical pathfinding.
+/// Each region and each link polygon is a cluster. The polygons connected to another
+/// cluster are portals, and the graph stores the portal to portal travel costs.
+/// Long path queries search this graph first to find the corridor of clusters to
+/// refine at the polygon level.
+class NavMapHierarchy {
+	struct Cluster {
+		const NavBase *owner = nullptr;
+		/// Range of the map polygon ids of this cluster.
+		uint32_t polygon_begin = 0;
+		uint32_t polygon_end = 0;
+		/// Range of the portal nodes of this cluster, they are in the order of their polygon ids.
+		uint32_t node_begin = 0;
+		uint32_t node_end = 0;
+		/// Distances between the portals of a region, one row per portal.
+		/// Cached by the region, so only regions whose polygons or portals changed are searched again.
+		const real_t *portal_distances = nullptr;
+	};
+
+	struct Node {
+		uint32_t polygon_id = 0;
+		uint32_t cluster = 0;
+		Vector3 position;
+	};
+
+	struct Edge {
+		uint32_t to = 0;
+		real_t cost = 0.0;
+	};
+
+	LocalVector<Cluster> clusters;
+	LocalVector<Node> nodes;
+	/// Node edges in CSR layout, the edges of node `n` are in `[node_edge_offsets[n], node_edge_offsets[n + 1])`.
+	LocalVector<uint32_t> node_edge_offsets;
+	LocalVector<Edge> node_edges;
+
+	LocalVector<uint32_t> polygon_clusters;
+	LocalVector<uint32_t> polygon_nodes;
+	LocalVector<Vector3> polygon_centers;
+
+	/// Lowest travel cost of all clusters, keeps the search heuristic admissible.
+	real_t min_travel_cost = 1.0;
+
+	/// Distances from a polygon to the polygons of its region. Stops once the distances to all the region portals are known,
+	/// so the distances to the other polygons may be unfinished.
+	void _compute_cluster_distances(const LocalVector<gd::Polygon> &p_polygons, const Cluster &p_cluster, uint32_t p_from_polygon_id, real_t *r_distances) const;
+
+public:
+	void clear();
+	void build(const LocalVector<NavRegion *> &p_regions, const LocalVector<uint32_t> &p_region_polygon_offsets, const LocalVector<gd::Polygon> &p_polygons, const LocalVector<gd::Polygon> &p_link_polygons, uint32_t p_link_polygon_count);
+
+	bool is_empty() const { return nodes.is_empty(); }
+	uint32_t get_cluster_count() const { return clusters.size(); }
+	uint32_t get_portal_count() const { return nodes.size(); }
+	const LocalVector<uint32_t> &get_polygon_clusters() const { return polygon_clusters; }
+
+	/// Searches the abstract graph between two polygons of different clusters.
+	/// Fills `r_cluster_mask` with the clusters the refined search may use and returns `false` when no corridor is found.
+	bool find_corridor(const LocalVector<gd::Polygon> &p_polygons, const gd::Polygon *p_begin_poly, const Vector3 &p_begin_point, const gd::Polygon *p_end_poly, const Vector3 &p_end_point, uint32_t p_navigation_layers, LocalVector<uint8_t> &r_cluster_mask) const;
+};
+
+#endif // NAV_MAP_HIERARCHY_H
@@ -143,6 +143,11 @@ void NavRegion::update_polygons() {
 		return;
 	}
 	polygons.clear();
+	internal_edge_merges.clear();
+	external_edges.clear();
+	edge_count = 0;
+	hierarchy_portals.clear();
+	hierarchy_portal_distances.clear();
 	surface_area = 0.0;
 	polygons_dirty = false;
 
@@ -219,4 +224,61 @@ void NavRegion::update_polygons() {
 	}
 
 	surface_area = _new_region_surface_area;
+
+	update_edges();
+}
+
+void NavRegion::update_edges() {
+	// Group the polygon edges per key. Edges shared by two polygons of this region are
+	// merged once here, so the map only has to match the remaining edges across regions.
+	uint32_t total_edge_count = 0;
+	for (const gd::Polygon &polygon : polygons) {
+		total_edge_count += polygon.points.size();
+	}
+
+	HashMap<gd::EdgeKey, uint32_t, gd::EdgeKey> edge_indices;
+	edge_indices.reserve(total_edge_count);
+
+	LocalVector<gd::RegionEdge> unique_edges;
+	LocalVector<uint8_t> unique_edge_uses;
+	unique_edges.reserve(total_edge_count);
+	unique_edge_uses.reserve(total_edge_count);
+
+	for (uint32_t polygon_index = 0; polygon_index < polygons.size(); polygon_index++) {
+		const gd::Polygon &polygon = polygons[polygon_index];
+		for (uint32_t p = 0; p < polygon.points.size(); p++) {
+			int next_point = (p + 1) % polygon.points.size();
+			gd::EdgeKey ek(polygon.points[p].key, polygon.points[next_point].key);
+
+			HashMap<gd::EdgeKey, uint32_t, gd::EdgeKey>::Iterator found = edge_indices.find(ek);
+			if (!found) {
+				edge_indices.insert(ek, unique_edges.size());
+				gd::RegionEdge region_edge;
+				region_edge.key = ek;
+				region_edge.polygon = polygon_index;
+				region_edge.edge = p;
+				unique_edges.push_back(region_edge);
+				unique_edge_uses.push_back(1);
+			} else if (unique_edge_uses[found->value] == 1) {
+				const gd::RegionEdge &other_edge = unique_edges[found->value];
+				gd::RegionEdgeMerge merge;
+				merge.polygon_a = other_edge.polygon;
+				merge.edge_a = other_edge.edge;
+				merge.polygon_b = polygon_index;
+				merge.edge_b = p;
+				internal_edge_merges.push_back(merge);
+				unique_edge_uses[found->value] = 2;
+			} else {
+				// The edge is already connected with another edge, skip.
+				ERR_PRINT_ONCE("Navigation map synchronization error. Attempted to merge a navigation mesh polygon edge with another already-merged edge. This is usually caused by crossing edges, overlapping polygons, or a mismatch of the NavigationMesh / NavigationPolygon baked 'cell_size' and navigation map 'cell_size'. If you're certain none of above is the case, change 'navigation/3d/merge_rasterizer_cell_scale' to 0.001.");
+			}
+		}
+	}
+
+	edge_count = unique_edges.size();
+	for (uint32_t i = 0; i < unique_edges.size(); i++) {
+		if (unique_edge_uses[i] == 1) {
+			external_edges.push_back(unique_edges[i]);
+		}
+	}
 }
@@ -51,6 +51,16 @@ class NavRegion : public NavBase {
 	/// Cache
 	LocalVector<gd::Polygon> polygons;
 
+	/// Edges merged between polygons of this region. They only change with the polygons.
+	LocalVector<gd::RegionEdgeMerge> internal_edge_merges;
+	/// Edges not merged inside this region, candidates for connections to other regions.
+	LocalVector<gd::RegionEdge> external_edges;
+	uint32_t edge_count = 0;
+
+	/// Portal to portal distances cached by the map hierarchy, they only change with the polygons or the portals.
+	LocalVector<uint32_t> hierarchy_portals;
+	LocalVector<real_t> hierarchy_portal_distances;
+
 	real_t surface_area = 0.0;
 
 	RWLock navmesh_rwlock;
@@ -90,6 +100,25 @@ public:
 		return polygons;
 	}
 
+	const LocalVector<gd::RegionEdgeMerge> &get_internal_edge_merges() const {
+		return internal_edge_merges;
+	}
+	const LocalVector<gd::RegionEdge> &get_external_edges() const {
+		return external_edges;
+	}
+	uint32_t get_edge_count() const { return edge_count; }
+
+	void set_hierarchy_portal_distances(const LocalVector<uint32_t> &p_portals, const LocalVector<real_t> &p_distances) {
+		hierarchy_portals = p_portals;
+		hierarchy_portal_distances = p_distances;
+	}
+	const LocalVector<uint32_t> &get_hierarchy_portals() const {
+		return hierarchy_portals;
+	}
+	const LocalVector<real_t> &get_hierarchy_portal_distances() const {
+		return hierarchy_portal_distances;
+	}
+
 	Vector3 get_closest_point_to_segment(const Vector3 &p_from, const Vector3 &p_to, bool p_use_collision) const;
 	gd::ClosestPointQueryResult get_closest_point_info(const Vector3 &p_point) const;
 	Vector3 get_random_point(uint32_t p_navigation_layers, bool p_uniformly) const;
@@ -100,6 +129,7 @@ public:
 
 private:
 	void update_polygons();
+	void update_edges();
 };
 
 #endif // NAV_REGION_H
@@ -113,6 +113,21 @@ struct Polygon {
 	real_t surface_area = 0.0;
 };
 
+/// Edge of a region polygon, indexed locally to the region polygons.
+struct RegionEdge {
+	EdgeKey key;
+	uint32_t polygon = 0;
+	int edge = -1;
+};
+
+/// Two region polygon edges that share the same key and are merged together.
+struct RegionEdgeMerge {
+	uint32_t polygon_a = 0;
+	int edge_a = -1;
+	uint32_t polygon_b = 0;
+	int edge_b = -1;
+};
+
 struct NavigationPoly {
 	/// This poly.
 	const Polygon *poly = nullptr;
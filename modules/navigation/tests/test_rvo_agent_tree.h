@@ -0,0 +1,117 @@
+#ifndef TEST_RVO_AGENT_TREE_H
+#define TEST_RVO_AGENT_TREE_H
+
+#include "core/math/random_pcg.h"
+#include "core/object/worker_thread_pool.h"
+
+#include "thirdparty/rvo2/rvo2_2d/Agent2d.h"
+#include "thirdparty/rvo2/rvo2_2d/KdTree2d.h"
+#include "thirdparty/rvo2/rvo2_2d/RVOSimulator2d.h"
+#include "thirdparty/rvo2/rvo2_3d/Agent3d.h"
+#include "thirdparty/rvo2/rvo2_3d/KdTree3d.h"
+#include "thirdparty/rvo2/rvo2_3d/RVOSimulator3d.h"
+
+#include "tests/test_macros.h"
+
+namespace TestRVOAgentTree {
+
+template <typename T_KdTree>
+class AgentTreeBuilder {
+public:
+	T_KdTree *tree = nullptr;
+
+	void build_subtree(uint32_t p_index, typename T_KdTree::AgentTreeTask *p_tasks) {
+		tree->buildAgentSubtree(p_tasks[p_index]);
+	}
+
+	void build(const decltype(T_KdTree::agents_) &p_agents) {
+		std::vector<typename T_KdTree::AgentTreeTask> tasks;
+		tree->buildAgentTreeTop(p_agents, 64, tasks);
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &AgentTreeBuilder::build_subtree, tasks.data(), tasks.size(), -1, true);
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+		tree->updateAgentPositions();
+	}
+};
+
+// Both trees must find the same nearest neighbors, in the same order, for every agent.
+template <typename T_Agent, typename T_KdTree>
+bool agent_neighbors_match(const std::vector<T_Agent *> &p_agents, const T_KdTree &p_tree, const T_KdTree &p_reference_tree) {
+	for (T_Agent *agent : p_agents) {
+		float range_sq = agent->neighborDist_ * agent->neighborDist_;
+		agent->agentNeighbors_.clear();
+		p_tree.computeAgentNeighbors(agent, range_sq);
+		const std::vector<std::pair<float, const T_Agent *>> neighbors = agent->agentNeighbors_;
+
+		range_sq = agent->neighborDist_ * agent->neighborDist_;
+		agent->agentNeighbors_.clear();
+		p_reference_tree.computeAgentNeighbors(agent, range_sq);
+		if (neighbors != agent->agentNeighbors_) {
+			return false;
+		}
+	}
+	return true;
+}
+
+TEST_CASE("[Navigation] RVO 3D agent tree refit and parallel build match a full rebuild") {
+	RVO3D::RVOSimulator3D simulator;
+	RandomPCG rng(42);
+	for (int i = 0; i < 2000; i++) {
+		simulator.addAgent(RVO3D::Vector3(rng.random(-50.0f, 50.0f), rng.random(-5.0f, 5.0f), rng.random(-50.0f, 50.0f)), 10.0, 8, 1.0, 0.5, 1.0);
+	}
+	const std::vector<RVO3D::Agent3D *> &agents = simulator.agents_;
+
+	RVO3D::KdTree3D tree(&simulator);
+	tree.buildAgentTree(agents);
+
+	RVO3D::KdTree3D parallel_tree(&simulator);
+	AgentTreeBuilder<RVO3D::KdTree3D> builder;
+	builder.tree = &parallel_tree;
+	builder.build(agents);
+	CHECK(agent_neighbors_match(agents, parallel_tree, tree));
+
+	// Move the agents far enough to cross the split planes of the tree.
+	for (int step = 0; step < 4; step++) {
+		for (RVO3D::Agent3D *agent : agents) {
+			agent->position_ = agent->position_ + RVO3D::Vector3(rng.random(-5.0f, 5.0f), rng.random(-1.0f, 1.0f), rng.random(-5.0f, 5.0f));
+		}
+		tree.refitAgentTree();
+
+		RVO3D::KdTree3D rebuilt_tree(&simulator);
+		rebuilt_tree.buildAgentTree(agents);
+		CHECK(agent_neighbors_match(agents, tree, rebuilt_tree));
+	}
+}
+
+TEST_CASE("[Navigation] RVO 2D agent tree refit and parallel build match a full rebuild") {
+	RVO2D::RVOSimulator2D simulator;
+	RandomPCG rng(42);
+	for (int i = 0; i < 2000; i++) {
+		simulator.addAgent(RVO2D::Vector2(rng.random(-50.0f, 50.0f), rng.random(-50.0f, 50.0f)), 10.0, 8, 1.0, 1.0, 0.5, 1.0);
+	}
+	const std::vector<RVO2D::Agent2D *> &agents = simulator.agents_;
+
+	RVO2D::KdTree2D tree(&simulator);
+	tree.buildAgentTree(agents);
+
+	RVO2D::KdTree2D parallel_tree(&simulator);
+	AgentTreeBuilder<RVO2D::KdTree2D> builder;
+	builder.tree = &parallel_tree;
+	builder.build(agents);
+	CHECK(agent_neighbors_match(agents, parallel_tree, tree));
+
+	// Move the agents far enough to cross the split planes of the tree.
+	for (int step = 0; step < 4; step++) {
+		for (RVO2D::Agent2D *agent : agents) {
+			agent->position_ = agent->position_ + RVO2D::Vector2(rng.random(-5.0f, 5.0f), rng.random(-5.0f, 5.0f));
+		}
+		tree.refitAgentTree();
+
+		RVO2D::KdTree2D rebuilt_tree(&simulator);
+		rebuilt_tree.buildAgentTree(agents);
+		CHECK(agent_neighbors_match(agents, tree, rebuilt_tree));
+	}
+}
+
+} // namespace TestRVOAgentTree
+
+#endif // TEST_RVO_AGENT_TREE_H
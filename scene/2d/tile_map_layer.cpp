@@ -244,6 +244,7 @@ void TileMapLayer::_rendering_update(bool p_force_cleanup) {
 		}
 
 		// Update all dirty quadrants.
+		bool draw_indices_dirty = false;
 		bool needs_set_not_interpolated = is_inside_tree() && get_tree()->is_physics_interpolation_enabled() && !is_physics_interpolated();
 		for (SelfList<RenderingQuadrant> *quadrant_list_element = dirty_rendering_quadrant_list.first(); quadrant_list_element;) {
 			SelfList<RenderingQuadrant> *next_quadrant_list_element = quadrant_list_element->next(); // "Hack" to clear the list while iterating.
@@ -263,11 +264,10 @@ void TileMapLayer::_rendering_update(bool p_force_cleanup) {
 			if (has_a_tile) {
 				// Process the quadrant.
 
-				// First, clear the quadrant's canvas items.
-				for (RID &ci : rendering_quadrant->canvas_items) {
-					rs->free(ci);
-				}
-				rendering_quadrant->canvas_items.clear();
+				// The quadrant's canvas items are kept and redrawn in order, so editing cells
+				// doesn't recreate them. Only the ones left over at the end are freed.
+				uint32_t reused_canvas_item_count = rendering_quadrant->canvas_items.size();
+				uint32_t canvas_item_count = 0;
 
 				// Sort the quadrant cells.
 				if (is_y_sort_enabled() && x_draw_order_reversed) {
@@ -304,28 +304,39 @@ void TileMapLayer::_rendering_update(bool p_force_cleanup) {
 
 					// Check if the material or the z_index changed.
 					if (prev_ci == RID() || prev_material != mat || prev_z_index != tile_z_index) {
-						// If so, create a new CanvasItem.
-						ci = rs->canvas_item_create();
-						if (needs_set_not_interpolated) {
-							rs->canvas_item_set_interpolated(ci, false);
-						}
-						if (mat.is_valid()) {
-							rs->canvas_item_set_material(ci, mat->get_rid());
-						}
-						rs->canvas_item_set_parent(ci, get_canvas_item());
-						rs->canvas_item_set_use_parent_material(ci, !mat.is_valid());
+						if (canvas_item_count < reused_canvas_item_count) {
+							// If so, redraw the next existing CanvasItem.
+							ci = rendering_quadrant->canvas_items[canvas_item_count];
+							rs->canvas_item_clear(ci);
+							rs->canvas_item_set_material(ci, mat.is_valid() ? mat->get_rid() : RID());
+							rs->canvas_item_set_use_parent_material(ci, !mat.is_valid());
+							rs->canvas_item_set_z_index(ci, tile_z_index);
+						} else {
+							// Or create a new one.
+							ci = rs->canvas_item_create();
+							if (needs_set_not_interpolated) {
+								rs->canvas_item_set_interpolated(ci, false);
+							}
+							if (mat.is_valid()) {
+								rs->canvas_item_set_material(ci, mat->get_rid());
+							}
+							rs->canvas_item_set_parent(ci, get_canvas_item());
+							rs->canvas_item_set_use_parent_material(ci, !mat.is_valid());
 
-						Transform2D xform(0, rendering_quadrant->canvas_items_position);
-						rs->canvas_item_set_transform(ci, xform);
+							Transform2D xform(0, rendering_quadrant->canvas_items_position);
+							rs->canvas_item_set_transform(ci, xform);
 
-						rs->canvas_item_set_light_mask(ci, get_light_mask());
-						rs->canvas_item_set_z_as_relative_to_parent(ci, true);
-						rs->canvas_item_set_z_index(ci, tile_z_index);
+							rs->canvas_item_set_light_mask(ci, get_light_mask());
+							rs->canvas_item_set_z_as_relative_to_parent(ci, true);
+							rs->canvas_item_set_z_index(ci, tile_z_index);
 
-						rs->canvas_item_set_default_texture_filter(ci, RS::CanvasItemTextureFilter(get_texture_filter_in_tree()));
-						rs->canvas_item_set_default_texture_repeat(ci, RS::CanvasItemTextureRepeat(get_texture_repeat_in_tree()));
+							rs->canvas_item_set_default_texture_filter(ci, RS::CanvasItemTextureFilter(get_texture_filter_in_tree()));
+							rs->canvas_item_set_default_texture_repeat(ci, RS::CanvasItemTextureRepeat(get_texture_repeat_in_tree()));
 
-						rendering_quadrant->canvas_items.push_back(ci);
+							rendering_quadrant->canvas_items.push_back(ci);
+							draw_indices_dirty = true;
+						}
+						canvas_item_count++;
 
 						prev_ci = ci;
 						prev_material = mat;
@@ -351,10 +362,18 @@ void TileMapLayer::_rendering_update(bool p_force_cleanup) {
 					draw_tile(ci, local_tile_pos - rendering_quadrant->canvas_items_position, tile_set, cell_data.cell.source_id, cell_data.cell.get_atlas_coords(), cell_data.cell.alternative_tile, -1, get_self_modulate(), tile_data, random_animation_offset);
 				}
 
-				// Reset physics interpolation for any recreated canvas items.
+				// Free the canvas items that were not needed anymore.
+				if (canvas_item_count < reused_canvas_item_count) {
+					for (uint32_t i = canvas_item_count; i < reused_canvas_item_count; i++) {
+						rs->free(rendering_quadrant->canvas_items[i]);
+					}
+					rendering_quadrant->canvas_items.resize(canvas_item_count);
+				}
+
+				// Reset physics interpolation for any created canvas items.
 				if (is_physics_interpolated_and_enabled() && is_visible_in_tree()) {
-					for (const RID &ci : rendering_quadrant->canvas_items) {
-						rs->canvas_item_reset_physics_interpolation(ci);
+					for (uint32_t i = reused_canvas_item_count; i < rendering_quadrant->canvas_items.size(); i++) {
+						rs->canvas_item_reset_physics_interpolation(rendering_quadrant->canvas_items[i]);
 					}
 				}
 
@@ -374,8 +393,9 @@ void TileMapLayer::_rendering_update(bool p_force_cleanup) {
 
 		dirty_rendering_quadrant_list.clear();
 
-		// Reset the drawing indices.
-		{
+		// Reset the drawing indices, only needed when canvas items were created.
+		// Freeing canvas items or quadrants keeps the order of the remaining ones.
+		if (draw_indices_dirty) {
 			int index = -(int64_t)0x80000000; // Always must be drawn below children.
 
 			// Sort the quadrants coords per local coordinates.
@@ -1783,6 +1803,7 @@ void TileMapLayer::_bind_methods() {
 	// --- Cells manipulation ---
 	// Generic cells manipulations and access.
 	ClassDB::bind_method(D_METHOD("set_cell", "coords", "source_id", "atlas_coords", "alternative_tile"), &TileMapLayer::set_cell, DEFVAL(TileSet::INVALID_SOURCE), DEFVAL(TileSetSource::INVALID_ATLAS_COORDS), DEFVAL(0));
+	ClassDB::bind_method(D_METHOD("set_cells_batch", "coords", "source_ids", "atlas_coords", "alternative_tiles"), &TileMapLayer::set_cells_batch);
 	ClassDB::bind_method(D_METHOD("erase_cell", "coords"), &TileMapLayer::erase_cell);
 	ClassDB::bind_method(D_METHOD("fix_invalid_tiles"), &TileMapLayer::fix_invalid_tiles);
 	ClassDB::bind_method(D_METHOD("clear"), &TileMapLayer::clear);
@@ -1800,6 +1821,15 @@ void TileMapLayer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_used_cells_by_id", "source_id", "atlas_coords", "alternative_tile"), &TileMapLayer::get_used_cells_by_id, DEFVAL(TileSet::INVALID_SOURCE), DEFVAL(TileSetSource::INVALID_ATLAS_COORDS), DEFVAL(TileSetSource::INVALID_TILE_ALTERNATIVE));
 	ClassDB::bind_method(D_METHOD("get_used_rect"), &TileMapLayer::get_used_rect);
 
+	// Chunks.
+	ClassDB::bind_method(D_METHOD("get_chunk_coords", "coords"), &TileMapLayer::get_chunk_coords);
+	ClassDB::bind_method(D_METHOD("get_used_chunks"), &TileMapLayer::get_used_chunks);
+	ClassDB::bind_method(D_METHOD("get_chunk_data", "chunk_coords"), &TileMapLayer::get_chunk_data);
+	ClassDB::bind_method(D_METHOD("set_chunk_data", "chunk_coords", "data"), &TileMapLayer::set_chunk_data);
+	ClassDB::bind_method(D_METHOD("unload_chunk", "chunk_coords"), &TileMapLayer::unload_chunk);
+	ClassDB::bind_method(D_METHOD("set_chunk_active", "chunk_coords", "active"), &TileMapLayer::set_chunk_active);
+	ClassDB::bind_method(D_METHOD("is_chunk_active", "chunk_coords"), &TileMapLayer::is_chunk_active);
+
 	// Patterns.
 	ClassDB::bind_method(D_METHOD("get_pattern", "coords_array"), &TileMapLayer::get_pattern);
 	ClassDB::bind_method(D_METHOD("set_pattern", "position", "pattern"), &TileMapLayer::set_pattern);
@@ -2245,7 +2275,10 @@ HashMap<Vector2i, TileSet::TerrainsPattern> TileMapLayer::terrain_fill_pattern(c
 }
 
 TileMapCell TileMapLayer::get_cell(const Vector2i &p_coords) const {
-	if (!tile_map_layer_data.has(p_coords)) {
+	const TileMapCell *inactive_cell = _get_inactive_cell(p_coords);
+	if (inactive_cell) {
+		return *inactive_cell;
+	} else if (!tile_map_layer_data.has(p_coords)) {
 		return TileMapCell();
 	} else {
 		return tile_map_layer_data.find(p_coords)->value.cell;
@@ -2338,10 +2371,6 @@ void TileMapLayer::draw_tile(RID p_canvas_item, const Vector2 &p_position, const
 }
 
 void TileMapLayer::set_cell(const Vector2i &p_coords, int p_source_id, const Vector2i &p_atlas_coords, int p_alternative_tile) {
-	// Set the current cell tile (using integer position).
-	Vector2i pk(p_coords);
-	HashMap<Vector2i, CellData>::Iterator E = tile_map_layer_data.find(pk);
-
 	int source_id = p_source_id;
 	Vector2i atlas_coords = p_atlas_coords;
 	int alternative_tile = p_alternative_tile;
@@ -2353,6 +2382,20 @@ void TileMapLayer::set_cell(const Vector2i &p_coords, int p_source_id, const Vec
 		alternative_tile = TileSetSource::INVALID_TILE_ALTERNATIVE;
 	}
 
+	// Cells of inactive chunks only have their IDs stored.
+	if (!inactive_chunks.is_empty()) {
+		HashMap<Vector2i, PackedChunk>::Iterator C = inactive_chunks.find(get_chunk_coords(p_coords));
+		if (C) {
+			C->value.set_cell(_get_packed_cell_index(p_coords), TileMapCell(source_id, atlas_coords, alternative_tile));
+			used_rect_cache_dirty = true;
+			return;
+		}
+	}
+
+	// Set the current cell tile (using integer position).
+	Vector2i pk(p_coords);
+	HashMap<Vector2i, CellData>::Iterator E = tile_map_layer_data.find(pk);
+
 	if (!E) {
 		if (source_id == TileSet::INVALID_SOURCE) {
 			return; // Nothing to do, the tile is already empty.
@@ -2382,6 +2425,159 @@ void TileMapLayer::set_cell(const Vector2i &p_coords, int p_source_id, const Vec
 	used_rect_cache_dirty = true;
 }
 
+void TileMapLayer::set_cells_batch(const PackedVector2Array &p_coords, const PackedInt32Array &p_source_ids, const PackedVector2Array &p_atlas_coords, const PackedInt32Array &p_alternative_tiles) {
+	int count = p_coords.size();
+	ERR_FAIL_COND_MSG(p_source_ids.size() != count || p_atlas_coords.size() != count || p_alternative_tiles.size() != count, "All arrays passed to set_cells_batch() must have the same size.");
+
+	const Vector2 *coords_ptr = p_coords.ptr();
+	const int32_t *source_ids_ptr = p_source_ids.ptr();
+	const Vector2 *atlas_coords_ptr = p_atlas_coords.ptr();
+	const int32_t *alternative_tiles_ptr = p_alternative_tiles.ptr();
+
+	// Only cells that don't exist yet are inserted. Erasing keeps the cell until the next update.
+	uint32_t new_cell_count = 0;
+	for (int i = 0; i < count; i++) {
+		if (source_ids_ptr[i] != TileSet::INVALID_SOURCE && Vector2i(atlas_coords_ptr[i]) != TileSetSource::INVALID_ATLAS_COORDS && alternative_tiles_ptr[i] != TileSetSource::INVALID_TILE_ALTERNATIVE && !tile_map_layer_data.has(Vector2i(coords_ptr[i])) && (inactive_chunks.is_empty() || !inactive_chunks.has(get_chunk_coords(Vector2i(coords_ptr[i]))))) {
+			new_cell_count++;
+		}
+	}
+	if (new_cell_count > 0) {
+		tile_map_layer_data.reserve(tile_map_layer_data.size() + new_cell_count);
+	}
+
+	// Changed cells are only added to the dirty list, so all of them are processed in a single update.
+	for (int i = 0; i < count; i++) {
+		set_cell(Vector2i(coords_ptr[i]), source_ids_ptr[i], Vector2i(atlas_coords_ptr[i]), alternative_tiles_ptr[i]);
+	}
+}
+
+Vector2i TileMapLayer::get_chunk_coords(const Vector2i &p_coords) const {
+	// Arithmetic shifts round down, so negative coords map to negative chunks.
+	return Vector2i(p_coords.x >> CHUNK_SIZE_SHIFT, p_coords.y >> CHUNK_SIZE_SHIFT);
+}
+
+TypedArray<Vector2i> TileMapLayer::get_used_chunks() const {
+	HashSet<Vector2i> chunks;
+	for (const KeyValue<Vector2i, CellData> &E : tile_map_layer_data) {
+		if (E.value.cell.source_id != TileSet::INVALID_SOURCE) {
+			chunks.insert(get_chunk_coords(E.key));
+		}
+	}
+	for (const KeyValue<Vector2i, PackedChunk> &E : inactive_chunks) {
+		if (E.value.cell_count > 0) {
+			chunks.insert(E.key);
+		}
+	}
+
+	TypedArray<Vector2i> a;
+	a.resize(chunks.size());
+	int i = 0;
+	for (const Vector2i &E : chunks) {
+		a[i++] = E;
+	}
+	return a;
+}
+
+Vector<uint8_t> TileMapLayer::get_chunk_data(const Vector2i &p_chunk_coords) const {
+	const PackedChunk *chunk = inactive_chunks.getptr(p_chunk_coords);
+	PackedChunk active_chunk;
+	if (!chunk) {
+		_pack_active_chunk(p_chunk_coords, active_chunk);
+		chunk = &active_chunk;
+	}
+
+	Vector<uint8_t> chunk_data;
+	if (chunk->cell_count == 0) {
+		return chunk_data;
+	}
+
+	chunk_data.resize(2 + CHUNK_HEADER_SIZE + chunk->cell_count * CHUNK_CELL_SIZE);
+	uint8_t *ptr = chunk_data.ptrw();
+	encode_uint16(TileMapLayerDataFormat::TILE_MAP_LAYER_DATA_FORMAT_MAX - 1, &ptr[0]);
+	_encode_chunk(p_chunk_coords, *chunk, &ptr[2]);
+	return chunk_data;
+}
+
+void TileMapLayer::set_chunk_data(const Vector2i &p_chunk_coords, const Vector<uint8_t> &p_data) {
+	if (p_data.is_empty()) {
+		unload_chunk(p_chunk_coords);
+		return;
+	}
+
+	// Validate everything first, so invalid data leaves the chunk untouched.
+	ERR_FAIL_COND_MSG(p_data.size() < 2, "Corrupted chunk data: not enough bytes.");
+	uint16_t format = decode_uint16(&p_data.ptr()[0]);
+	ERR_FAIL_COND_MSG(format < TileMapLayerDataFormat::TILE_MAP_LAYER_DATA_FORMAT_1 || format >= TileMapLayerDataFormat::TILE_MAP_LAYER_DATA_FORMAT_MAX, vformat("Unsupported chunk data format: %s.", format));
+	if (_validate_chunk(&p_data.ptr()[2], p_data.size() - 2) == 0) {
+		return;
+	}
+
+	unload_chunk(p_chunk_coords);
+	_decode_chunk(&p_data.ptr()[2], p_data.size() - 2, &p_chunk_coords);
+}
+
+void TileMapLayer::unload_chunk(const Vector2i &p_chunk_coords) {
+	Vector2i chunk_origin = p_chunk_coords * CHUNK_SIZE;
+	for (int y = 0; y < CHUNK_SIZE; y++) {
+		for (int x = 0; x < CHUNK_SIZE; x++) {
+			erase_cell(chunk_origin + Vector2i(x, y));
+		}
+	}
+}
+
+void TileMapLayer::set_chunk_active(const Vector2i &p_chunk_coords, bool p_active) {
+	if (p_active) {
+		HashMap<Vector2i, PackedChunk>::Iterator C = inactive_chunks.find(p_chunk_coords);
+		if (!C) {
+			return;
+		}
+
+		// Move the cells back to the per-cell storage, where they get their runtime state on the next update.
+		PackedChunk chunk = C->value;
+		inactive_chunks.remove(C);
+		for (int i = 0; i < CHUNK_SIZE * CHUNK_SIZE; i++) {
+			const TileMapCell &c = chunk.cells[i];
+			if (c.source_id != TileSet::INVALID_SOURCE) {
+				set_cell(_get_packed_cell_coords(p_chunk_coords, i), c.source_id, c.get_atlas_coords(), c.alternative_tile);
+			}
+		}
+	} else {
+		if (inactive_chunks.has(p_chunk_coords)) {
+			return;
+		}
+
+		// Erasing the cells frees their runtime state on the next update. This has to be done before the chunk is
+		// marked inactive, as set_cell() would modify the packed cells otherwise.
+		PackedChunk chunk;
+		_pack_active_chunk(p_chunk_coords, chunk);
+		if (chunk.cell_count > 0) {
+			unload_chunk(p_chunk_coords);
+		}
+		inactive_chunks.insert(p_chunk_coords, chunk);
+	}
+}
+
+bool TileMapLayer::is_chunk_active(const Vector2i &p_chunk_coords) const {
+	return !inactive_chunks.has(p_chunk_coords);
+}
+
+const TileMapCell *TileMapLayer::_get_inactive_cell(const Vector2i &p_coords) const {
+	if (inactive_chunks.is_empty()) {
+		return nullptr;
+	}
+	const PackedChunk *chunk = inactive_chunks.getptr(get_chunk_coords(p_coords));
+	return chunk ? &chunk->cells[_get_packed_cell_index(p_coords)] : nullptr;
+}
+
+void TileMapLayer::_pack_active_chunk(const Vector2i &p_chunk_coords, PackedChunk &r_chunk) const {
+	for (int i = 0; i < CHUNK_SIZE * CHUNK_SIZE; i++) {
+		HashMap<Vector2i, CellData>::ConstIterator E = tile_map_layer_data.find(_get_packed_cell_coords(p_chunk_coords, i));
+		if (E) {
+			r_chunk.set_cell(i, E->value.cell);
+		}
+	}
+}
+
 void TileMapLayer::erase_cell(const Vector2i &p_coords) {
 	set_cell(p_coords, TileSet::INVALID_SOURCE, TileSetSource::INVALID_ATLAS_COORDS, TileSetSource::INVALID_TILE_ALTERNATIVE);
 }
@@ -2396,6 +2592,18 @@ void TileMapLayer::fix_invalid_tiles() {
 			coords.insert(E.key);
 		}
 	}
+	for (const KeyValue<Vector2i, PackedChunk> &E : inactive_chunks) {
+		for (int i = 0; i < CHUNK_SIZE * CHUNK_SIZE; i++) {
+			const TileMapCell &c = E.value.cells[i];
+			if (c.source_id == TileSet::INVALID_SOURCE) {
+				continue;
+			}
+			TileSetSource *source = *tile_set->get_source(c.source_id);
+			if (!source || !source->has_tile(c.get_atlas_coords()) || !source->has_alternative_tile(c.get_atlas_coords(), c.alternative_tile)) {
+				coords.insert(_get_packed_cell_coords(E.key, i));
+			}
+		}
+	}
 	for (const Vector2i &E : coords) {
 		set_cell(E, TileSet::INVALID_SOURCE, TileSetSource::INVALID_ATLAS_COORDS, TileSetSource::INVALID_TILE_ALTERNATIVE);
 	}
@@ -2406,10 +2614,16 @@ void TileMapLayer::clear() {
 	for (KeyValue<Vector2i, CellData> &kv : tile_map_layer_data) {
 		erase_cell(kv.key);
 	}
+	inactive_chunks.clear();
 	used_rect_cache_dirty = true;
 }
 
 int TileMapLayer::get_cell_source_id(const Vector2i &p_coords) const {
+	const TileMapCell *inactive_cell = _get_inactive_cell(p_coords);
+	if (inactive_cell) {
+		return inactive_cell->source_id;
+	}
+
 	// Get a cell source id from position.
 	HashMap<Vector2i, CellData>::ConstIterator E = tile_map_layer_data.find(p_coords);
 
@@ -2421,6 +2635,11 @@ int TileMapLayer::get_cell_source_id(const Vector2i &p_coords) const {
 }
 
 Vector2i TileMapLayer::get_cell_atlas_coords(const Vector2i &p_coords) const {
+	const TileMapCell *inactive_cell = _get_inactive_cell(p_coords);
+	if (inactive_cell) {
+		return inactive_cell->get_atlas_coords();
+	}
+
 	// Get a cell source id from position.
 	HashMap<Vector2i, CellData>::ConstIterator E = tile_map_layer_data.find(p_coords);
 
@@ -2432,6 +2651,11 @@ Vector2i TileMapLayer::get_cell_atlas_coords(const Vector2i &p_coords) const {
 }
 
 int TileMapLayer::get_cell_alternative_tile(const Vector2i &p_coords) const {
+	const TileMapCell *inactive_cell = _get_inactive_cell(p_coords);
+	if (inactive_cell) {
+		return inactive_cell->alternative_tile;
+	}
+
 	// Get a cell source id from position.
 	HashMap<Vector2i, CellData>::ConstIterator E = tile_map_layer_data.find(p_coords);
 
@@ -2466,6 +2690,13 @@ TypedArray<Vector2i> TileMapLayer::get_used_cells() const {
 		}
 		a.push_back(E.key);
 	}
+	for (const KeyValue<Vector2i, PackedChunk> &E : inactive_chunks) {
+		for (int i = 0; i < CHUNK_SIZE * CHUNK_SIZE; i++) {
+			if (E.value.cells[i].source_id != TileSet::INVALID_SOURCE) {
+				a.push_back(_get_packed_cell_coords(E.key, i));
+			}
+		}
+	}
 
 	return a;
 }
@@ -2484,6 +2715,19 @@ TypedArray<Vector2i> TileMapLayer::get_used_cells_by_id(int p_source_id, const V
 			a.push_back(E.key);
 		}
 	}
+	for (const KeyValue<Vector2i, PackedChunk> &E : inactive_chunks) {
+		for (int i = 0; i < CHUNK_SIZE * CHUNK_SIZE; i++) {
+			const TileMapCell &c = E.value.cells[i];
+			if (c.source_id == TileSet::INVALID_SOURCE) {
+				continue;
+			}
+			if ((p_source_id == TileSet::INVALID_SOURCE || p_source_id == c.source_id) &&
+					(p_atlas_coords == TileSetSource::INVALID_ATLAS_COORDS || p_atlas_coords == c.get_atlas_coords()) &&
+					(p_alternative_tile == TileSetSource::INVALID_TILE_ALTERNATIVE || p_alternative_tile == c.alternative_tile)) {
+				a.push_back(_get_packed_cell_coords(E.key, i));
+			}
+		}
+	}
 
 	return a;
 }
@@ -2506,6 +2750,20 @@ Rect2i TileMapLayer::get_used_rect() const {
 				used_rect_cache.expand_to(E.key);
 			}
 		}
+		for (const KeyValue<Vector2i, PackedChunk> &E : inactive_chunks) {
+			for (int i = 0; i < CHUNK_SIZE * CHUNK_SIZE; i++) {
+				if (E.value.cells[i].source_id == TileSet::INVALID_SOURCE) {
+					continue;
+				}
+				Vector2i coords = _get_packed_cell_coords(E.key, i);
+				if (first) {
+					used_rect_cache = Rect2i(coords, Size2i());
+					first = false;
+				} else {
+					used_rect_cache.expand_to(coords);
+				}
+			}
+		}
 		if (!first) {
 			// Only if we have at least one cell.
 			// The cache expands to top-left coordinate, so we add one full tile.
@@ -2778,8 +3036,6 @@ void TileMapLayer::set_tile_map_data_from_array(const Vector<uint8_t> &p_data) {
 		return;
 	}
 
-	const int cell_data_struct_size = 12;
-
 	int size = p_data.size();
 	const uint8_t *ptr = p_data.ptr();
 
@@ -2795,6 +3051,19 @@ void TileMapLayer::set_tile_map_data_from_array(const Vector<uint8_t> &p_data) {
 	// Clear the TileMap.
 	clear();
 
+	if (format >= TileMapLayerDataFormat::TILE_MAP_LAYER_DATA_FORMAT_1) {
+		while (index < size) {
+			int chunk_size = _decode_chunk(&ptr[index], size - index);
+			if (chunk_size == 0) {
+				return;
+			}
+			index += chunk_size;
+		}
+		return;
+	}
+
+	const int cell_data_struct_size = 12;
+
 	while (index < size) {
 		ERR_FAIL_COND_MSG(index + cell_data_struct_size > size, vformat("Corrupted tile map data: tiles might be missing."));
 
@@ -2817,14 +3086,33 @@ void TileMapLayer::set_tile_map_data_from_array(const Vector<uint8_t> &p_data) {
 }
 
 Vector<uint8_t> TileMapLayer::get_tile_map_data_as_array() const {
-	const int cell_data_struct_size = 12;
-
 	Vector<uint8_t> tile_map_data_array;
-	if (tile_map_layer_data.is_empty()) {
+
+	// Group the cells of active chunks per chunk. Inactive chunks are already packed.
+	HashMap<Vector2i, PackedChunk> active_chunks;
+	for (const KeyValue<Vector2i, CellData> &E : tile_map_layer_data) {
+		if (E.value.cell.source_id == TileSet::INVALID_SOURCE) {
+			continue; // Erased, but not removed yet.
+		}
+		active_chunks[get_chunk_coords(E.key)].set_cell(_get_packed_cell_index(E.key), E.value.cell);
+	}
+
+	LocalVector<Pair<Vector2i, const PackedChunk *>> chunks;
+	uint32_t cell_count = 0;
+	const HashMap<Vector2i, PackedChunk> *chunk_maps[] = { &active_chunks, &inactive_chunks };
+	for (const HashMap<Vector2i, PackedChunk> *chunk_map : chunk_maps) {
+		for (const KeyValue<Vector2i, PackedChunk> &E : *chunk_map) {
+			if (E.value.cell_count > 0) {
+				chunks.push_back(Pair<Vector2i, const PackedChunk *>(E.key, &E.value));
+				cell_count += E.value.cell_count;
+			}
+		}
+	}
+	if (chunks.is_empty()) {
 		return tile_map_data_array;
 	}
 
-	tile_map_data_array.resize(2 + tile_map_layer_data.size() * cell_data_struct_size);
+	tile_map_data_array.resize(2 + chunks.size() * CHUNK_HEADER_SIZE + cell_count * CHUNK_CELL_SIZE);
 	uint8_t *ptr = tile_map_data_array.ptrw();
 
 	// Index in the array.
@@ -2835,24 +3123,84 @@ Vector<uint8_t> TileMapLayer::get_tile_map_data_as_array() const {
 	index += 2;
 
 	// Save in highest format.
-	for (const KeyValue<Vector2i, CellData> &E : tile_map_layer_data) {
-		// Get a pointer at the start of the cell data.
-		uint8_t *cell_data_ptr = (uint8_t *)&ptr[index];
+	for (const Pair<Vector2i, const PackedChunk *> &E : chunks) {
+		_encode_chunk(E.first, *E.second, &ptr[index]);
+		index += CHUNK_HEADER_SIZE + E.second->cell_count * CHUNK_CELL_SIZE;
+	}
+
+	return tile_map_data_array;
+}
+
+void TileMapLayer::_encode_chunk(const Vector2i &p_chunk_coords, const PackedChunk &p_chunk, uint8_t *r_ptr) const {
+	// Store the chunk position and its cell count.
+	encode_uint16((int16_t)(p_chunk_coords.x), &r_ptr[0]);
+	encode_uint16((int16_t)(p_chunk_coords.y), &r_ptr[2]);
+	encode_uint16(p_chunk.cell_count, &r_ptr[4]);
+
+	uint8_t *cell_data_ptr = &r_ptr[CHUNK_HEADER_SIZE];
+	for (int i = 0; i < CHUNK_SIZE * CHUNK_SIZE; i++) {
+		const TileMapCell &c = p_chunk.cells[i];
+		if (c.source_id == TileSet::INVALID_SOURCE) {
+			continue;
+		}
 
-		// Store position in TileMap.
-		encode_uint16((int16_t)(E.key.x), &cell_data_ptr[0]);
-		encode_uint16((int16_t)(E.key.y), &cell_data_ptr[2]);
+		// Store the position in the chunk.
+		cell_data_ptr[0] = i & (CHUNK_SIZE - 1);
+		cell_data_ptr[1] = i >> CHUNK_SIZE_SHIFT;
 
 		// Store the tile identifiers.
-		encode_uint16(E.value.cell.source_id, &cell_data_ptr[4]);
-		encode_uint16(E.value.cell.coord_x, &cell_data_ptr[6]);
-		encode_uint16(E.value.cell.coord_y, &cell_data_ptr[8]);
-		encode_uint16(E.value.cell.alternative_tile, &cell_data_ptr[10]);
+		encode_uint16(c.source_id, &cell_data_ptr[2]);
+		encode_uint16(c.coord_x, &cell_data_ptr[4]);
+		encode_uint16(c.coord_y, &cell_data_ptr[6]);
+		encode_uint16(c.alternative_tile, &cell_data_ptr[8]);
 
-		index += cell_data_struct_size;
+		cell_data_ptr += CHUNK_CELL_SIZE;
+	}
+}
+
+int TileMapLayer::_validate_chunk(const uint8_t *p_ptr, int p_size) const {
+	ERR_FAIL_COND_V_MSG(p_size < CHUNK_HEADER_SIZE, 0, "Corrupted tile map data: not enough bytes for a chunk.");
+
+	int cell_count = decode_uint16(&p_ptr[4]);
+	int chunk_size = CHUNK_HEADER_SIZE + cell_count * CHUNK_CELL_SIZE;
+	ERR_FAIL_COND_V_MSG(chunk_size > p_size, 0, "Corrupted tile map data: tiles might be missing.");
+
+	const uint8_t *cell_data_ptr = &p_ptr[CHUNK_HEADER_SIZE];
+	for (int i = 0; i < cell_count; i++) {
+		ERR_FAIL_COND_V_MSG(cell_data_ptr[0] >= CHUNK_SIZE || cell_data_ptr[1] >= CHUNK_SIZE, 0, "Corrupted tile map data: cell outside of its chunk.");
+		cell_data_ptr += CHUNK_CELL_SIZE;
 	}
 
-	return tile_map_data_array;
+	return chunk_size;
+}
+
+int TileMapLayer::_decode_chunk(const uint8_t *p_ptr, int p_size, const Vector2i *p_chunk_coords_override) {
+	int chunk_size = _validate_chunk(p_ptr, p_size);
+	if (chunk_size == 0) {
+		return 0;
+	}
+
+	// Extracts the chunk position and its cell count.
+	Vector2i chunk_coords = Vector2i((int16_t)decode_uint16(&p_ptr[0]), (int16_t)decode_uint16(&p_ptr[2]));
+	if (p_chunk_coords_override) {
+		chunk_coords = *p_chunk_coords_override;
+	}
+	int cell_count = decode_uint16(&p_ptr[4]);
+
+	Vector2i chunk_origin = chunk_coords * CHUNK_SIZE;
+	const uint8_t *cell_data_ptr = &p_ptr[CHUNK_HEADER_SIZE];
+	for (int i = 0; i < cell_count; i++) {
+		// Extracts the tile identifiers.
+		uint16_t source_id = decode_uint16(&cell_data_ptr[2]);
+		uint16_t atlas_coords_x = decode_uint16(&cell_data_ptr[4]);
+		uint16_t atlas_coords_y = decode_uint16(&cell_data_ptr[6]);
+		uint16_t alternative_tile = decode_uint16(&cell_data_ptr[8]);
+
+		set_cell(chunk_origin + Vector2i(cell_data_ptr[0], cell_data_ptr[1]), source_id, Vector2i(atlas_coords_x, atlas_coords_y), alternative_tile);
+		cell_data_ptr += CHUNK_CELL_SIZE;
+	}
+
+	return chunk_size;
 }
 
 void TileMapLayer::set_self_modulate(const Color &p_self_modulate) {
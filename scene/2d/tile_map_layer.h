@@ -38,6 +38,7 @@ class TileMap;
 
 enum TileMapLayerDataFormat {
 	TILE_MAP_LAYER_DATA_FORMAT_0 = 0,
+	TILE_MAP_LAYER_DATA_FORMAT_1, // Cells grouped per chunk.
 	TILE_MAP_LAYER_DATA_FORMAT_MAX,
 };
 
@@ -205,7 +206,7 @@ public:
 
 	Vector2i quadrant_coords;
 	SelfList<CellData>::List cells;
-	List<RID> canvas_items;
+	LocalVector<RID> canvas_items;
 	Vector2 canvas_items_position;
 
 	SelfList<RenderingQuadrant> dirty_quadrant_list_element;
@@ -271,6 +272,8 @@ public:
 	};
 
 private:
+	friend class TestTileMapLayerInternalsAccessor;
+
 	static constexpr float FP_ADJUST = 0.00001;
 
 	// Properties.
@@ -308,6 +311,37 @@ private:
 		SelfList<CellData>::List cell_list;
 	} dirty;
 
+	// Chunks. Cells of active chunks are kept in tile_map_layer_data, with their runtime state.
+	static constexpr int CHUNK_SIZE_SHIFT = 5;
+	static constexpr int CHUNK_SIZE = 1 << CHUNK_SIZE_SHIFT;
+	static constexpr int CHUNK_HEADER_SIZE = 6;
+	static constexpr int CHUNK_CELL_SIZE = 10;
+
+	// Dense tile IDs of a chunk, indexed by the cell's position in the chunk.
+	struct PackedChunk {
+		TileMapCell cells[CHUNK_SIZE * CHUNK_SIZE];
+		int cell_count = 0;
+
+		void set_cell(int p_index, const TileMapCell &p_cell) {
+			cell_count += int(p_cell.source_id != TileSet::INVALID_SOURCE) - int(cells[p_index].source_id != TileSet::INVALID_SOURCE);
+			cells[p_index] = p_cell;
+		}
+	};
+	// Inactive chunks only store their tile IDs, without any rendering, physics or navigation state.
+	HashMap<Vector2i, PackedChunk> inactive_chunks;
+	_FORCE_INLINE_ int _get_packed_cell_index(const Vector2i &p_coords) const {
+		return ((p_coords.y & (CHUNK_SIZE - 1)) << CHUNK_SIZE_SHIFT) | (p_coords.x & (CHUNK_SIZE - 1));
+	}
+	_FORCE_INLINE_ Vector2i _get_packed_cell_coords(const Vector2i &p_chunk_coords, int p_index) const {
+		return p_chunk_coords * CHUNK_SIZE + Vector2i(p_index & (CHUNK_SIZE - 1), p_index >> CHUNK_SIZE_SHIFT);
+	}
+	const TileMapCell *_get_inactive_cell(const Vector2i &p_coords) const;
+	void _pack_active_chunk(const Vector2i &p_chunk_coords, PackedChunk &r_chunk) const;
+
+	int _validate_chunk(const uint8_t *p_ptr, int p_size) const;
+	void _encode_chunk(const Vector2i &p_chunk_coords, const PackedChunk &p_chunk, uint8_t *r_ptr) const;
+	int _decode_chunk(const uint8_t *p_ptr, int p_size, const Vector2i *p_chunk_coords_override = nullptr);
+
 	// Rect cache.
 	mutable Rect2 rect_cache;
 	mutable bool rect_cache_dirty = true;
@@ -428,6 +462,7 @@ public:
 	// --- Cells manipulation ---
 	// Generic cells manipulations and data access.
 	void set_cell(const Vector2i &p_coords, int p_source_id = TileSet::INVALID_SOURCE, const Vector2i &p_atlas_coords = TileSetSource::INVALID_ATLAS_COORDS, int p_alternative_tile = 0);
+	void set_cells_batch(const PackedVector2Array &p_coords, const PackedInt32Array &p_source_ids, const PackedVector2Array &p_atlas_coords, const PackedInt32Array &p_alternative_tiles);
 	void erase_cell(const Vector2i &p_coords);
 	void fix_invalid_tiles();
 	void clear();
@@ -445,6 +480,15 @@ public:
 	bool is_cell_flipped_v(const Vector2i &p_coords) const;
 	bool is_cell_transposed(const Vector2i &p_coords) const;
 
+	// Chunks.
+	Vector2i get_chunk_coords(const Vector2i &p_coords) const;
+	TypedArray<Vector2i> get_used_chunks() const;
+	Vector<uint8_t> get_chunk_data(const Vector2i &p_chunk_coords) const;
+	void set_chunk_data(const Vector2i &p_chunk_coords, const Vector<uint8_t> &p_data);
+	void unload_chunk(const Vector2i &p_chunk_coords);
+	void set_chunk_active(const Vector2i &p_chunk_coords, bool p_active);
+	bool is_chunk_active(const Vector2i &p_chunk_coords) const;
+
 	// Patterns.
 	Ref<TileMapPattern> get_pattern(TypedArray<Vector2i> p_coords_array);
 	void set_pattern(const Vector2i &p_position, const Ref<TileMapPattern> p_pattern);
@@ -31,8 +31,10 @@
 #include "node_3d.h"
 
 #include "core/math/transform_interpolator.h"
+#include "core/object/worker_thread_pool.h"
 #include "scene/3d/visual_instance_3d.h"
 #include "scene/main/viewport.h"
+#include "scene/main/window.h"
 #include "scene/property_utils.h"
 
 /*
@@ -72,6 +74,126 @@ future: no idea
 Node3DGizmo::Node3DGizmo() {
 }
 
+// Depth ordered copy of the Node3D hierarchy, used when global transform batching is enabled.
+// Nodes are stored level by level, so each level only reads the global transforms of levels that are already resolved.
+// Setting a transform on the main thread only queues the node as a pending root. The dirty state is propagated to its
+// subtree by update_global_transforms(), or eagerly by _flush_pending_transform_changes() if a global transform is read first.
+struct Node3DTransformHierarchy {
+	static constexpr uint32_t PARALLEL_MIN_NODES = 1024;
+
+	bool enabled = false;
+	bool layout_dirty = false;
+	// Set when the dirty state is propagated eagerly, possibly from a thread group.
+	SafeFlag dirty_marked;
+
+	// Only accessed from the main thread. Other threads check has_pending_roots instead.
+	LocalVector<Node3D *> pending_roots;
+	SafeFlag has_pending_roots;
+
+	// Indexed by Node3D::data.transform_batch_index. Removed nodes leave a null entry until the layout is rebuilt.
+	LocalVector<Node3D *> nodes;
+	LocalVector<uint8_t> dirty;
+	LocalVector<uint32_t> parents;
+	LocalVector<Transform3D> local_transforms;
+	LocalVector<Transform3D> global_transforms;
+	LocalVector<uint32_t> level_offsets;
+
+	LocalVector<Node3D *> order;
+
+	void rebuild_layout() {
+		// Walk the hierarchy breadth first from the roots, so every depth level is stored contiguously.
+		order.clear();
+		for (Node3D *node : nodes) {
+			if (node && (!node->data.parent || node->data.top_level)) {
+				order.push_back(node);
+			}
+		}
+
+		level_offsets.clear();
+		level_offsets.push_back(0);
+		uint32_t level_begin = 0;
+		while (level_begin < order.size()) {
+			const uint32_t level_end = order.size();
+			level_offsets.push_back(level_end);
+			for (uint32_t i = level_begin; i < level_end; i++) {
+				for (Node3D *child : order[i]->data.children) {
+					if (!child->data.top_level) {
+						order.push_back(child);
+					}
+				}
+			}
+			level_begin = level_end;
+		}
+
+		const uint32_t node_count = order.size();
+		nodes = order;
+		dirty.resize(node_count);
+		parents.resize(node_count);
+		local_transforms.resize(node_count);
+		global_transforms.resize(node_count);
+
+		// Parents come first, so their new index is known when the children are placed.
+		for (uint32_t i = 0; i < node_count; i++) {
+			Node3D *node = nodes[i];
+			node->data.transform_batch_index = i;
+			parents[i] = (node->data.parent && !node->data.top_level) ? node->data.parent->data.transform_batch_index : UINT32_MAX;
+
+			// Clean nodes keep their cached global transform. Nodes below a pending root are still clean here,
+			// they are marked dirty when the levels are resolved.
+			if (node->_test_dirty_bits(Node3D::DIRTY_GLOBAL_TRANSFORM)) {
+				dirty[i] = 1;
+			} else {
+				dirty[i] = 0;
+				global_transforms[i] = node->data.global_transform;
+			}
+		}
+
+		layout_dirty = false;
+	}
+
+	void resolve(uint32_t p_index, uint32_t p_level_begin) {
+		const uint32_t index = p_level_begin + p_index;
+		const uint32_t parent = parents[index];
+		if (!dirty[index]) {
+			if (parent == UINT32_MAX || !dirty[parent]) {
+				return;
+			}
+			dirty[index] = 1;
+		}
+
+		const Node3D *node = nodes[index];
+		if (node->_test_dirty_bits(Node3D::DIRTY_LOCAL_TRANSFORM)) {
+			node->_update_local_transform();
+		}
+		local_transforms[index] = node->data.local_transform;
+
+		Transform3D &global_transform = global_transforms[index];
+		if (parent != UINT32_MAX) {
+			global_transform = global_transforms[parent] * local_transforms[index];
+		} else {
+			global_transform = local_transforms[index];
+		}
+		if (node->data.disable_scale) {
+			global_transform.basis.orthonormalize();
+		}
+
+		node->data.global_transform = global_transform;
+		node->_clear_dirty_bits(Node3D::DIRTY_GLOBAL_TRANSFORM);
+	}
+};
+
+static Node3DTransformHierarchy transform_hierarchy;
+
+// Instance transforms recorded between begin_instance_transform_batch() and end_instance_transform_batch(),
+// submitted to the RenderingServer as a single command.
+struct Node3DInstanceTransformBatch {
+	uint32_t depth = 0;
+	Vector<RID> instances;
+	Vector<Transform3D> transforms;
+};
+
+static Node3DInstanceTransformBatch instance_transform_batch;
+
 void Node3D::_notify_dirty() {
 #ifdef TOOLS_ENABLED
 	if ((!data.gizmos.is_empty() || data.notify_transform) && !data.ignore_notification && !xform_change.in_list()) {
@@ -108,6 +230,10 @@ void Node3D::_propagate_transform_changed(Node3D *p_origin) {
 		return;
 	}
 
+	if (p_origin == this && _defer_transform_changed()) {
+		return;
+	}
+
 	for (Node3D *&E : data.children) {
 		if (E->data.top_level) {
 			continue; //don't propagate to a top_level
@@ -127,6 +253,10 @@ void Node3D::_propagate_transform_changed(Node3D *p_origin) {
 		}
 	}
 	_set_dirty_bits(DIRTY_GLOBAL_TRANSFORM);
+	if (data.transform_batch_index != UINT32_MAX) {
+		transform_hierarchy.dirty[data.transform_batch_index] = 1;
+		transform_hierarchy.dirty_marked.set();
+	}
 }
 
 void Node3D::_notification(int p_what) {
@@ -160,6 +290,10 @@ void Node3D::_notification(int p_what) {
 			_set_dirty_bits(DIRTY_GLOBAL_TRANSFORM); // Global is always dirty upon entering a scene.
 			_notify_dirty();
 
+			if (transform_hierarchy.enabled) {
+				_add_to_transform_hierarchy();
+			}
+
 			notification(NOTIFICATION_ENTER_WORLD);
 			_update_visibility_parent(true);
 		} break;
@@ -168,6 +302,7 @@ void Node3D::_notification(int p_what) {
 			ERR_MAIN_THREAD_GUARD;
 
 			notification(NOTIFICATION_EXIT_WORLD, true);
+			_remove_from_transform_hierarchy();
 			if (xform_change.in_list()) {
 				get_tree()->xform_change_list.remove(&xform_change);
 			}
@@ -465,6 +600,10 @@ Transform3D Node3D::get_global_transform_interpolated() {
 Transform3D Node3D::get_global_transform() const {
 	ERR_FAIL_COND_V(!is_inside_tree(), Transform3D());
 
+	if (unlikely(transform_hierarchy.has_pending_roots.is_set())) {
+		_flush_pending_transform_changes();
+	}
+
 	/* Due to how threads work at scene level, while this global transform won't be able to be changed from outside a thread,
 	 * it is possible that multiple threads can access it while it's dirty from previous work. Due to this, we must ensure that
 	 * the dirty/update process is thread safe by utilizing atomic copies.
@@ -871,6 +1010,9 @@ void Node3D::set_as_top_level(bool p_enabled) {
 		}
 	}
 	data.top_level = p_enabled;
+	if (data.transform_batch_index != UINT32_MAX) {
+		transform_hierarchy.layout_dirty = true;
+	}
 }
 
 void Node3D::set_as_top_level_keep_local(bool p_enabled) {
@@ -879,6 +1021,9 @@ void Node3D::set_as_top_level_keep_local(bool p_enabled) {
 		return;
 	}
 	data.top_level = p_enabled;
+	if (data.transform_batch_index != UINT32_MAX) {
+		transform_hierarchy.layout_dirty = true;
+	}
 	_propagate_transform_changed(this);
 }
 
@@ -1108,6 +1253,7 @@ bool Node3D::is_local_transform_notification_enabled() const {
 void Node3D::force_update_transform() {
 	ERR_THREAD_GUARD;
 	ERR_FAIL_COND(!is_inside_tree());
+	_flush_pending_transform_changes();
 	if (!xform_change.in_list()) {
 		return; //nothing to update
 	}
@@ -1116,6 +1262,196 @@ void Node3D::force_update_transform() {
 	notification(NOTIFICATION_TRANSFORM_CHANGED);
 }
 
+void Node3D::set_global_transform_batching_enabled(bool p_enabled) {
+	ERR_FAIL_COND(!Thread::is_main_thread());
+
+	Node3DTransformHierarchy &hierarchy = transform_hierarchy;
+	if (hierarchy.enabled == p_enabled) {
+		return;
+	}
+
+	if (p_enabled) {
+		hierarchy.enabled = true;
+
+		SceneTree *tree = SceneTree::get_singleton();
+		if (!tree || !tree->get_root()) {
+			return;
+		}
+
+		// Nodes entering the tree from now on add themselves, add the ones already inside it.
+		LocalVector<Node *> stack;
+		stack.push_back(tree->get_root());
+		while (!stack.is_empty()) {
+			Node *node = stack[stack.size() - 1];
+			stack.remove_at(stack.size() - 1);
+
+			Node3D *node_3d = Object::cast_to<Node3D>(node);
+			if (node_3d && node_3d->is_inside_tree()) {
+				node_3d->_add_to_transform_hierarchy();
+			}
+			for (int i = 0; i < node->get_child_count(); i++) {
+				stack.push_back(node->get_child(i));
+			}
+		}
+	} else {
+		_flush_pending_transform_changes();
+
+		for (Node3D *node : hierarchy.nodes) {
+			if (node) {
+				node->data.transform_batch_index = UINT32_MAX;
+			}
+		}
+		hierarchy.nodes.clear();
+		hierarchy.dirty.clear();
+		hierarchy.parents.clear();
+		hierarchy.local_transforms.clear();
+		hierarchy.global_transforms.clear();
+		hierarchy.level_offsets.clear();
+		hierarchy.layout_dirty = false;
+		hierarchy.dirty_marked.clear();
+		hierarchy.enabled = false;
+	}
+}
+
+bool Node3D::is_global_transform_batching_enabled() {
+	return transform_hierarchy.enabled;
+}
+
+void Node3D::update_global_transforms() {
+	Node3DTransformHierarchy &hierarchy = transform_hierarchy;
+	if (!hierarchy.enabled) {
+		return;
+	}
+	ERR_FAIL_COND(!Thread::is_main_thread());
+
+	if (hierarchy.pending_roots.is_empty() && !hierarchy.layout_dirty && !hierarchy.dirty_marked.is_set()) {
+		return;
+	}
+
+	if (hierarchy.layout_dirty) {
+		hierarchy.rebuild_layout();
+	}
+	hierarchy.dirty_marked.clear();
+
+	for (Node3D *node : hierarchy.pending_roots) {
+		node->data.transform_pending = false;
+		hierarchy.dirty[node->data.transform_batch_index] = 1;
+	}
+	hierarchy.pending_roots.clear();
+	hierarchy.has_pending_roots.clear();
+
+	// Propagate the dirty state and resolve the global transforms one depth level at a time.
+	for (uint32_t level = 0; level + 1 < hierarchy.level_offsets.size(); level++) {
+		const uint32_t level_begin = hierarchy.level_offsets[level];
+		const uint32_t level_size = hierarchy.level_offsets[level + 1] - level_begin;
+		if (level_size >= Node3DTransformHierarchy::PARALLEL_MIN_NODES) {
+			WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(&hierarchy, &Node3DTransformHierarchy::resolve, level_begin, level_size, -1, true, SNAME("Node3DGlobalTransforms"));
+			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+		} else {
+			for (uint32_t i = 0; i < level_size; i++) {
+				hierarchy.resolve(i, level_begin);
+			}
+		}
+	}
+
+	for (uint32_t i = 0; i < hierarchy.nodes.size(); i++) {
+		if (hierarchy.dirty[i]) {
+			hierarchy.dirty[i] = 0;
+			hierarchy.nodes[i]->_notify_dirty();
+		}
+	}
+}
+
+bool Node3D::_defer_transform_changed() {
+	if (data.transform_batch_index == UINT32_MAX || is_group_processing() || !Thread::is_main_thread()) {
+		return false;
+	}
+
+	if (!data.transform_pending) {
+		data.transform_pending = true;
+		transform_hierarchy.pending_roots.push_back(this);
+		transform_hierarchy.has_pending_roots.set();
+	}
+	_set_dirty_bits(DIRTY_GLOBAL_TRANSFORM);
+	return true;
+}
+
+void Node3D::_flush_pending_transform_changes() {
+	if (is_group_processing() || !Thread::is_main_thread()) {
+		return;
+	}
+
+	// A global transform is read before the next batch, propagate the dirty state the regular way.
+	LocalVector<Node3D *> &pending_roots = transform_hierarchy.pending_roots;
+	for (uint32_t i = 0; i < pending_roots.size(); i++) {
+		Node3D *node = pending_roots[i];
+		node->data.transform_pending = false;
+		node->_propagate_transform_changed(nullptr);
+	}
+	pending_roots.clear();
+	transform_hierarchy.has_pending_roots.clear();
+}
+
+void Node3D::_add_to_transform_hierarchy() {
+	Node3DTransformHierarchy &hierarchy = transform_hierarchy;
+	data.transform_batch_index = hierarchy.nodes.size();
+	hierarchy.nodes.push_back(this);
+	hierarchy.dirty.push_back(1);
+	hierarchy.layout_dirty = true;
+}
+
+void Node3D::_remove_from_transform_hierarchy() {
+	if (data.transform_batch_index == UINT32_MAX) {
+		return;
+	}
+
+	if (data.transform_pending) {
+		_flush_pending_transform_changes();
+	}
+
+	Node3DTransformHierarchy &hierarchy = transform_hierarchy;
+	hierarchy.nodes[data.transform_batch_index] = nullptr;
+	data.transform_batch_index = UINT32_MAX;
+	hierarchy.layout_dirty = true;
+}
+
+void Node3D::begin_instance_transform_batch() {
+	ERR_FAIL_COND(!Thread::is_main_thread());
+	instance_transform_batch.depth++;
+}
+
+void Node3D::end_instance_transform_batch() {
+	ERR_FAIL_COND(!Thread::is_main_thread());
+	ERR_FAIL_COND(instance_transform_batch.depth == 0);
+	instance_transform_batch.depth--;
+
+	if (instance_transform_batch.depth > 0) {
+		return;
+	}
+
+	_submit_instance_transform_batch();
+}
+
+void Node3D::_submit_instance_transform_batch() {
+	if (instance_transform_batch.instances.is_empty() || !Thread::is_main_thread()) {
+		return;
+	}
+
+	// The arrays are handed over to the command queue, start new ones for the next batch.
+	RS::get_singleton()->instance_set_transforms(instance_transform_batch.instances, instance_transform_batch.transforms);
+	instance_transform_batch.instances = Vector<RID>();
+	instance_transform_batch.transforms = Vector<Transform3D>();
+}
+
+void Node3D::_set_instance_transform(RID p_instance, const Transform3D &p_transform) {
+	if (instance_transform_batch.depth > 0 && Thread::is_main_thread()) {
+		instance_transform_batch.instances.push_back(p_instance);
+		instance_transform_batch.transforms.push_back(p_transform);
+	} else {
+		RS::get_singleton()->instance_set_transform(p_instance, p_transform);
+	}
+}
+
 void Node3D::_update_visibility_parent(bool p_update_root) {
 	RID new_parent;
 
@@ -1363,6 +1699,7 @@ Node3D::Node3D() :
 
 	data.top_level = false;
 	data.inside_world = false;
+	data.transform_pending = false;
 
 	data.ignore_notification = false;
 	data.notify_local_transform = false;
@@ -62,6 +62,9 @@ public:
 	};
 
 private:
+	friend struct Node3DTransformHierarchy;
+	friend class TestNode3DInternalsAccessor;
+
 	// For the sake of ease of use, Node3D can operate with Transforms (Basis+Origin), Quaternion/Scale and Euler Rotation/Scale.
 	// Transform and Quaternion are stored in data.local_transform Basis (so quaternion is not really stored, but converted back/forth from 3x3 matrix on demand).
 	// Euler needs to be kept separate because converting to Basis and back may result in a different vector (which is troublesome for users
@@ -107,10 +110,14 @@ private:
 
 		mutable MTNumeric<uint32_t> dirty;
 
+		// Index in the depth ordered transform hierarchy, UINT32_MAX if global transform batching is disabled or the node is outside the tree.
+		uint32_t transform_batch_index = UINT32_MAX;
+
 		Viewport *viewport = nullptr;
 
 		bool top_level : 1;
 		bool inside_world : 1;
+		bool transform_pending : 1;
 
 		// This is cached, and only currently kept up to date in visual instances.
 		// This is set if a visual instance is (a) in the tree AND (b) visible via is_visible_in_tree() call.
@@ -151,6 +158,10 @@ private:
 	void _update_gizmos();
 	void _notify_dirty();
 	void _propagate_transform_changed(Node3D *p_origin);
+	bool _defer_transform_changed();
+	static void _flush_pending_transform_changes();
+	void _add_to_transform_hierarchy();
+	void _remove_from_transform_hierarchy();
 
 	void _propagate_visibility_changed();
 
@@ -167,6 +178,9 @@ protected:
 	void _set_vi_visible(bool p_visible) { data.vi_visible = p_visible; }
 	bool _is_vi_visible() const { return data.vi_visible; }
 	Transform3D _get_global_transform_interpolated(real_t p_interpolation_fraction);
+	static void _set_instance_transform(RID p_instance, const Transform3D &p_transform);
+	// Submits the transforms recorded so far, so the batch doesn't outlive an instance about to be freed.
+	static void _submit_instance_transform_batch();
 	void _disable_client_physics_interpolation();
 
 	void _notification(int p_what);
@@ -297,6 +311,12 @@ public:
 
 	void force_update_transform();
 
+	static void set_global_transform_batching_enabled(bool p_enabled);
+	static bool is_global_transform_batching_enabled();
+	static void update_global_transforms();
+	static void begin_instance_transform_batch();
+	static void end_instance_transform_batch();
+
 	void set_visibility_parent(const NodePath &p_path);
 	NodePath get_visibility_parent() const;
 
@@ -88,15 +88,17 @@ void VisualInstance3D::_notification(int p_what) {
 		case NOTIFICATION_TRANSFORM_CHANGED: {
 			if (_is_vi_visible() || is_physics_interpolated_and_enabled()) {
 				if (!_is_using_identity_transform()) {
-					RenderingServer::get_singleton()->instance_set_transform(instance, get_global_transform());
-
 					// For instance when first adding to the tree, when the previous transform is
 					// unset, to prevent streaking from the origin.
 					if (_is_physics_interpolation_reset_requested() && is_physics_interpolated_and_enabled() && is_inside_tree()) {
+						// The reset must see the new transform, so it can't wait for a batched submission.
+						RenderingServer::get_singleton()->instance_set_transform(instance, get_global_transform());
 						if (_is_vi_visible()) {
 							_notification(NOTIFICATION_RESET_PHYSICS_INTERPOLATION);
 						}
 						_set_physics_interpolation_reset_requested(false);
+					} else {
+						_set_instance_transform(instance, get_global_transform());
 					}
 				}
 			}
@@ -233,6 +235,7 @@ VisualInstance3D::VisualInstance3D() {
 
 VisualInstance3D::~VisualInstance3D() {
 	ERR_FAIL_NULL(RenderingServer::get_singleton());
+	_submit_instance_transform_batch();
 	RenderingServer::get_singleton()->free(instance);
 }
 
@@ -202,6 +202,18 @@ void SceneTree::make_group_changed(const StringName &p_group) {
 void SceneTree::flush_transform_notifications() {
 	_THREAD_SAFE_METHOD_
 
+#ifndef _3D_DISABLED
+	const bool batch_3d = Node3D::is_global_transform_batching_enabled();
+	if (batch_3d) {
+		// Propagate the pending 3D transform changes and resolve the global transforms in one pass, so the
+		// notifications below read them back instead of walking up the parent chain node by node.
+		Node3D::update_global_transforms();
+
+		// The RenderingServer transforms sent by the notifications are collected and submitted together.
+		Node3D::begin_instance_transform_batch();
+	}
+#endif // _3D_DISABLED
+
 	SelfList<Node> *n = xform_change_list.first();
 	while (n) {
 		Node *node = n->self();
@@ -210,6 +222,12 @@ void SceneTree::flush_transform_notifications() {
 		n = nx;
 		node->notification(NOTIFICATION_TRANSFORM_CHANGED);
 	}
+
+#ifndef _3D_DISABLED
+	if (batch_3d) {
+		Node3D::end_instance_transform_batch();
+	}
+#endif // _3D_DISABLED
 }
 
 void SceneTree::_flush_ugc() {
@@ -1108,6 +1126,10 @@ void SceneTree::_process(bool p_physics) {
 				}
 
 				if (using_threads) {
+#ifndef _3D_DISABLED
+					// Thread groups can't flush pending 3D transform changes when they read a global transform.
+					Node3D::update_global_transforms();
+#endif // _3D_DISABLED
 					WorkerThreadPool::GroupID id = WorkerThreadPool::get_singleton()->add_template_group_task(this, &SceneTree::_process_groups_thread, p_physics, local_process_group_cache.size(), -1, true);
 					WorkerThreadPool::get_singleton()->wait_for_group_task_completion(id);
 				}
@@ -1827,6 +1849,10 @@ SceneTree::SceneTree() {
 
 	set_physics_interpolation_enabled(GLOBAL_DEF("physics/common/physics_interpolation", false));
 
+#ifndef _3D_DISABLED
+	Node3D::set_global_transform_batching_enabled(GLOBAL_DEF("application/run/batch_3d_transform_updates", false));
+#endif // _3D_DISABLED
+
 	// Always disable jitter fix if physics interpolation is enabled -
 	// Jitter fix will interfere with interpolation, and is not necessary
 	// when interpolation is active.
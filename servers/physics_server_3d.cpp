@@ -377,6 +377,78 @@ Dictionary PhysicsDirectSpaceState3D::_intersect_ray(const Ref<PhysicsRayQueryPa
 	return d;
 }
 
+int PhysicsDirectSpaceState3D::intersect_rays(const RayParameters &p_parameters, const Vector3 *p_from, const Vector3 *p_to, int p_count, RayResult *r_results, bool *r_collided) {
+	RayParameters parameters = p_parameters;
+	int collided_count = 0;
+	for (int i = 0; i < p_count; i++) {
+		parameters.from = p_from[i];
+		parameters.to = p_to[i];
+		r_collided[i] = intersect_ray(parameters, r_results[i]);
+		if (r_collided[i]) {
+			collided_count++;
+		}
+	}
+	return collided_count;
+}
+
+Dictionary PhysicsDirectSpaceState3D::_intersect_rays(const Ref<PhysicsRayQueryParameters3D> &p_ray_query, const PackedVector3Array &p_from, const PackedVector3Array &p_to) {
+	ERR_FAIL_COND_V(!p_ray_query.is_valid(), Dictionary());
+	ERR_FAIL_COND_V_MSG(p_from.size() != p_to.size(), Dictionary(), "The from and to arrays must have the same size.");
+
+	int count = p_from.size();
+
+	Vector<RayResult> results;
+	results.resize(count);
+	LocalVector<bool> collided;
+	collided.resize(count);
+
+	intersect_rays(p_ray_query->get_parameters(), p_from.ptr(), p_to.ptr(), count, results.ptrw(), collided.ptr());
+
+	PackedVector3Array positions;
+	positions.resize(count);
+	PackedVector3Array normals;
+	normals.resize(count);
+	PackedInt64Array collider_ids;
+	collider_ids.resize(count);
+	PackedInt32Array shapes;
+	shapes.resize(count);
+	PackedInt32Array face_indices;
+	face_indices.resize(count);
+
+	Vector3 *positions_ptrw = positions.ptrw();
+	Vector3 *normals_ptrw = normals.ptrw();
+	int64_t *collider_ids_ptrw = collider_ids.ptrw();
+	int32_t *shapes_ptrw = shapes.ptrw();
+	int32_t *face_indices_ptrw = face_indices.ptrw();
+
+	const RayResult *results_ptr = results.ptr();
+	for (int i = 0; i < count; i++) {
+		if (collided[i]) {
+			const RayResult &result = results_ptr[i];
+			positions_ptrw[i] = result.position;
+			normals_ptrw[i] = result.normal;
+			collider_ids_ptrw[i] = (int64_t)result.collider_id;
+			shapes_ptrw[i] = result.shape;
+			face_indices_ptrw[i] = result.face_index;
+		} else {
+			positions_ptrw[i] = Vector3();
+			normals_ptrw[i] = Vector3();
+			collider_ids_ptrw[i] = 0;
+			shapes_ptrw[i] = -1;
+			face_indices_ptrw[i] = -1;
+		}
+	}
+
+	Dictionary d;
+	d["position"] = positions;
+	d["normal"] = normals;
+	d["face_index"] = face_indices;
+	d["collider_id"] = collider_ids;
+	d["shape"] = shapes;
+
+	return d;
+}
+
 TypedArray<Dictionary> PhysicsDirectSpaceState3D::_intersect_point(const Ref<PhysicsPointQueryParameters3D> &p_point_query, int p_max_results) {
 	ERR_FAIL_COND_V(p_point_query.is_null(), TypedArray<Dictionary>());
 
@@ -422,6 +494,57 @@ TypedArray<Dictionary> PhysicsDirectSpaceState3D::_intersect_shape(const Ref<Phy
 	return ret;
 }
 
+int PhysicsDirectSpaceState3D::intersect_shapes(const ShapeParameters &p_parameters, const Vector3 *p_origins, int p_count, ShapeResult *r_results, int p_result_max, int *r_result_counts) {
+	ShapeParameters parameters = p_parameters;
+	int result_count = 0;
+	for (int i = 0; i < p_count; i++) {
+		parameters.transform.origin = p_origins[i];
+		r_result_counts[i] = intersect_shape(parameters, r_results + i * p_result_max, p_result_max);
+		result_count += r_result_counts[i];
+	}
+	return result_count;
+}
+
+Dictionary PhysicsDirectSpaceState3D::_intersect_shapes(const Ref<PhysicsShapeQueryParameters3D> &p_shape_query, const PackedVector3Array &p_origins, int p_max_results) {
+	ERR_FAIL_COND_V(!p_shape_query.is_valid(), Dictionary());
+	ERR_FAIL_COND_V(p_max_results < 0, Dictionary());
+
+	int count = p_origins.size();
+
+	Vector<ShapeResult> results;
+	results.resize(count * p_max_results);
+	PackedInt32Array counts;
+	counts.resize(count);
+
+	int result_count = intersect_shapes(p_shape_query->get_parameters(), p_origins.ptr(), count, results.ptrw(), p_max_results, counts.ptrw());
+
+	PackedInt64Array collider_ids;
+	collider_ids.resize(result_count);
+	PackedInt32Array shapes;
+	shapes.resize(result_count);
+
+	int64_t *collider_ids_ptrw = collider_ids.ptrw();
+	int32_t *shapes_ptrw = shapes.ptrw();
+
+	// Results are packed one query after another, so the counts are enough to find where each query starts.
+	const ShapeResult *results_ptr = results.ptr();
+	int index = 0;
+	for (int i = 0; i < count; i++) {
+		for (int j = 0; j < counts[i]; j++) {
+			const ShapeResult &result = results_ptr[i * p_max_results + j];
+			collider_ids_ptrw[index] = (int64_t)result.collider_id;
+			shapes_ptrw[index] = result.shape;
+			index++;
+		}
+	}
+
+	Dictionary ret;
+	ret["count"] = counts;
+	ret["collider_id"] = collider_ids;
+	ret["shape"] = shapes;
+	return ret;
+}
+
 Vector<real_t> PhysicsDirectSpaceState3D::_cast_motion(const Ref<PhysicsShapeQueryParameters3D> &p_shape_query) {
 	ERR_FAIL_COND_V(!p_shape_query.is_valid(), Vector<real_t>());
 
@@ -437,6 +560,44 @@ Vector<real_t> PhysicsDirectSpaceState3D::_cast_motion(const Ref<PhysicsShapeQue
 	return ret;
 }
 
+bool PhysicsDirectSpaceState3D::cast_motions(const ShapeParameters &p_parameters, const Vector3 *p_origins, const Vector3 *p_motions, int p_count, real_t *r_closest_safe, real_t *r_closest_unsafe) {
+	ShapeParameters parameters = p_parameters;
+	for (int i = 0; i < p_count; i++) {
+		parameters.transform.origin = p_origins[i];
+		parameters.motion = p_motions[i];
+		r_closest_safe[i] = 1.0;
+		r_closest_unsafe[i] = 1.0;
+		if (!cast_motion(parameters, r_closest_safe[i], r_closest_unsafe[i])) {
+			return false;
+		}
+	}
+	return true;
+}
+
+Vector<real_t> PhysicsDirectSpaceState3D::_cast_motions(const Ref<PhysicsShapeQueryParameters3D> &p_shape_query, const PackedVector3Array &p_origins, const PackedVector3Array &p_motions) {
+	ERR_FAIL_COND_V(!p_shape_query.is_valid(), Vector<real_t>());
+	ERR_FAIL_COND_V_MSG(p_origins.size() != p_motions.size(), Vector<real_t>(), "The origins and motions arrays must have the same size.");
+
+	int count = p_origins.size();
+
+	Vector<real_t> closest_safe;
+	closest_safe.resize(count);
+	Vector<real_t> closest_unsafe;
+	closest_unsafe.resize(count);
+	if (!cast_motions(p_shape_query->get_parameters(), p_origins.ptr(), p_motions.ptr(), count, closest_safe.ptrw(), closest_unsafe.ptrw())) {
+		return Vector<real_t>();
+	}
+
+	Vector<real_t> ret;
+	ret.resize(count * 2);
+	real_t *ret_ptrw = ret.ptrw();
+	for (int i = 0; i < count; i++) {
+		ret_ptrw[i * 2 + 0] = closest_safe[i];
+		ret_ptrw[i * 2 + 1] = closest_unsafe[i];
+	}
+	return ret;
+}
+
 TypedArray<Vector3> PhysicsDirectSpaceState3D::_collide_shape(const Ref<PhysicsShapeQueryParameters3D> &p_shape_query, int p_max_results) {
 	ERR_FAIL_COND_V(!p_shape_query.is_valid(), TypedArray<Vector3>());
 
@@ -484,6 +645,9 @@ void PhysicsDirectSpaceState3D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("intersect_ray", "parameters"), &PhysicsDirectSpaceState3D::_intersect_ray);
 	ClassDB::bind_method(D_METHOD("intersect_shape", "parameters", "max_results"), &PhysicsDirectSpaceState3D::_intersect_shape, DEFVAL(32));
 	ClassDB::bind_method(D_METHOD("cast_motion", "parameters"), &PhysicsDirectSpaceState3D::_cast_motion);
+	ClassDB::bind_method(D_METHOD("intersect_rays", "parameters", "from", "to"), &PhysicsDirectSpaceState3D::_intersect_rays);
+	ClassDB::bind_method(D_METHOD("intersect_shapes", "parameters", "origins", "max_results"), &PhysicsDirectSpaceState3D::_intersect_shapes, DEFVAL(32));
+	ClassDB::bind_method(D_METHOD("cast_motions", "parameters", "origins", "motions"), &PhysicsDirectSpaceState3D::_cast_motions);
 	ClassDB::bind_method(D_METHOD("collide_shape", "parameters", "max_results"), &PhysicsDirectSpaceState3D::_collide_shape, DEFVAL(32));
 	ClassDB::bind_method(D_METHOD("get_rest_info", "parameters"), &PhysicsDirectSpaceState3D::_get_rest_info);
 }
@@ -716,6 +880,7 @@ void PhysicsServer3D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("space_set_param", "space", "param", "value"), &PhysicsServer3D::space_set_param);
 	ClassDB::bind_method(D_METHOD("space_get_param", "space", "param"), &PhysicsServer3D::space_get_param);
 	ClassDB::bind_method(D_METHOD("space_get_direct_state", "space"), &PhysicsServer3D::space_get_direct_state);
+	ClassDB::bind_method(D_METHOD("space_get_snapshot_state", "space"), &PhysicsServer3D::space_get_snapshot_state);
 
 	ClassDB::bind_method(D_METHOD("area_create"), &PhysicsServer3D::area_create);
 	ClassDB::bind_method(D_METHOD("area_set_space", "area", "space"), &PhysicsServer3D::area_set_space);
@@ -1134,6 +1299,7 @@ PhysicsServer3D::PhysicsServer3D() {
 	GLOBAL_DEF("physics/3d/sleep_threshold_linear", 0.1);
 	GLOBAL_DEF("physics/3d/sleep_threshold_angular", Math::deg_to_rad(8.0));
 	GLOBAL_DEF(PropertyInfo(Variant::FLOAT, "physics/3d/time_before_sleep", PROPERTY_HINT_RANGE, "0,5,0.01,or_greater"), 0.5);
+	GLOBAL_DEF("physics/3d/step_spaces_in_parallel", false);
 	GLOBAL_DEF(PropertyInfo(Variant::INT, "physics/3d/solver/solver_iterations", PROPERTY_HINT_RANGE, "1,32,1,or_greater"), 16);
 	GLOBAL_DEF(PropertyInfo(Variant::FLOAT, "physics/3d/solver/contact_recycle_radius", PROPERTY_HINT_RANGE, "0,0.1,0.001,or_greater"), 0.01);
 	GLOBAL_DEF(PropertyInfo(Variant::FLOAT, "physics/3d/solver/contact_max_separation", PROPERTY_HINT_RANGE, "0,0.1,0.001,or_greater"), 0.05);
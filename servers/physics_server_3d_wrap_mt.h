@@ -117,6 +117,11 @@ public:
 		return physics_server_3d->space_get_direct_state(p_space);
 	}
 
+	// Snapshots are double-buffered by the server, so they can be queried from any thread without syncing.
+	PhysicsDirectSpaceState3D *space_get_snapshot_state(RID p_space) override {
+		return physics_server_3d->space_get_snapshot_state(p_space);
+	}
+
 	FUNC2(space_set_debug_contacts, RID, int);
 	virtual Vector<Vector3> space_get_contacts(RID p_space) const override {
 		ERR_FAIL_COND_V(!Thread::is_main_thread(), Vector<Vector3>());
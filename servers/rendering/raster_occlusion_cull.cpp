@@ -0,0 +1,482 @@
+/**************************************************************************/
+/*  raster_occlusion_cull.cpp                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "raster_occlusion_cull.h"
+
+#include "core/object/worker_thread_pool.h"
+
+RasterOcclusionCull *RasterOcclusionCull::raster_singleton = nullptr;
+
+void RasterOcclusionCull::RasterHZBuffer::clear() {
+	HZBuffer::clear();
+
+	instance_triangles.clear();
+}
+
+void RasterOcclusionCull::RasterHZBuffer::_add_triangle(InstanceTriangles &r_triangles, const Vector3 *p_view, const RasterThreadData *p_data) const {
+	const Size2i &buffer_size = sizes[0];
+
+	Vector2 screen[3];
+	float depth[3];
+	for (int i = 0; i < 3; i++) {
+		Vector3 ndc = p_data->cam_projection.xform(p_view[i]);
+		screen[i] = Vector2((ndc.x * 0.5f + 0.5f) * buffer_size.x, (ndc.y * 0.5f + 0.5f) * buffer_size.y);
+		// Store a value which interpolates linearly in screen space and is smallest
+		// closest to the camera: view depth when orthogonal, -1 / view depth otherwise.
+		depth[i] = p_data->cam_orthogonal ? -p_view[i].z : 1.0f / p_view[i].z;
+	}
+
+	Vector2 min_screen = screen[0].min(screen[1]).min(screen[2]);
+	Vector2 max_screen = screen[0].max(screen[1]).max(screen[2]);
+	if (max_screen.x < 0 || max_screen.y < 0 || min_screen.x > buffer_size.x || min_screen.y > buffer_size.y) {
+		return;
+	}
+
+	float area = (screen[1].x - screen[0].x) * (screen[2].y - screen[0].y) - (screen[1].y - screen[0].y) * (screen[2].x - screen[0].x);
+	if (Math::abs(area) < CMP_EPSILON) {
+		return; // Degenerate or seen edge-on.
+	}
+
+	// Occluders are double sided, so make the winding consistent for the edge tests.
+	if (area < 0.0f) {
+		SWAP(screen[1], screen[2]);
+		SWAP(depth[1], depth[2]);
+		area = -area;
+	}
+
+	ScreenTriangle triangle;
+	triangle.depth_a = 0.0f;
+	triangle.depth_b = 0.0f;
+	triangle.depth_c = 0.0f;
+
+	for (int i = 0; i < 3; i++) {
+		// Edge opposite to vertex i, positive on the inside.
+		const Vector2 &a = screen[(i + 1) % 3];
+		const Vector2 &b = screen[(i + 2) % 3];
+		triangle.edge_a[i] = a.y - b.y;
+		triangle.edge_b[i] = b.x - a.x;
+		triangle.edge_c[i] = (b.y - a.y) * a.x - (b.x - a.x) * a.y;
+
+		// The normalized edge function is the barycentric weight of vertex i.
+		float weight = depth[i] / area;
+		triangle.depth_a += triangle.edge_a[i] * weight;
+		triangle.depth_b += triangle.edge_b[i] * weight;
+		triangle.depth_c += triangle.edge_c[i] * weight;
+	}
+
+	triangle.min_x = Math::floor(CLAMP(min_screen.x, 0.0f, buffer_size.x - 1.0f));
+	triangle.max_x = Math::floor(CLAMP(max_screen.x, 0.0f, buffer_size.x - 1.0f));
+	triangle.min_y = Math::floor(CLAMP(min_screen.y, 0.0f, buffer_size.y - 1.0f));
+	triangle.max_y = Math::floor(CLAMP(max_screen.y, 0.0f, buffer_size.y - 1.0f));
+
+	r_triangles.triangles.push_back(triangle);
+}
+
+void RasterOcclusionCull::RasterHZBuffer::_setup_instance_triangles(uint32_t p_idx, const RasterThreadData *p_data) {
+	const OccluderInstance *occ_inst = p_data->instances[p_idx];
+	InstanceTriangles &instance = instance_triangles[p_idx];
+	instance.triangles.clear();
+
+	uint32_t vertex_count = occ_inst->xformed_vertices.size();
+	instance.view_vertices.resize(vertex_count);
+	const Vector3 *world = occ_inst->xformed_vertices.ptr();
+	Vector3 *view = instance.view_vertices.ptr();
+	for (uint32_t i = 0; i < vertex_count; i++) {
+		view[i] = p_data->cam_inv_transform.xform(world[i]);
+	}
+
+	const uint32_t *indices = occ_inst->indices.ptr();
+	uint32_t index_count = occ_inst->indices.size() / 3 * 3;
+
+	for (uint32_t i = 0; i < index_count; i += 3) {
+		if (indices[i] >= vertex_count || indices[i + 1] >= vertex_count || indices[i + 2] >= vertex_count) {
+			continue;
+		}
+
+		Vector3 tri[3] = { view[indices[i]], view[indices[i + 1]], view[indices[i + 2]] };
+
+		float distance[3];
+		int in_front = 0;
+		for (int j = 0; j < 3; j++) {
+			distance[j] = -tri[j].z - p_data->z_near;
+			if (distance[j] >= 0.0f) {
+				in_front++;
+			}
+		}
+
+		if (in_front == 3) {
+			_add_triangle(instance, tri, p_data);
+			continue;
+		}
+
+		if (in_front == 0) {
+			continue;
+		}
+
+		// Clip against the near plane, which leaves either a triangle or a quad.
+		Vector3 clipped[4];
+		int clipped_count = 0;
+		for (int j = 0; j < 3; j++) {
+			int next = (j + 1) % 3;
+			if (distance[j] >= 0.0f) {
+				clipped[clipped_count++] = tri[j];
+			}
+			if ((distance[j] >= 0.0f) != (distance[next] >= 0.0f)) {
+				float t = distance[j] / (distance[j] - distance[next]);
+				clipped[clipped_count++] = tri[j].lerp(tri[next], t);
+			}
+		}
+
+		_add_triangle(instance, clipped, p_data);
+		if (clipped_count == 4) {
+			Vector3 second[3] = { clipped[0], clipped[2], clipped[3] };
+			_add_triangle(instance, second, p_data);
+		}
+	}
+}
+
+void RasterOcclusionCull::RasterHZBuffer::_raster_band(uint32_t p_band, const RasterThreadData *p_data) {
+	const int width = sizes[0].x;
+	const int height = sizes[0].y;
+	const int from_y = p_band * height / p_data->band_count;
+	const int to_y = (p_band + 1) * height / p_data->band_count;
+
+	float *depth = mips[0];
+	for (int i = from_y * width; i < to_y * width; i++) {
+		depth[i] = FLT_MAX;
+	}
+
+	for (uint32_t i = 0; i < p_data->instance_count; i++) {
+		for (const ScreenTriangle &triangle : instance_triangles[i].triangles) {
+			const int min_y = MAX(triangle.min_y, from_y);
+			const int max_y = MIN(triangle.max_y, to_y - 1);
+
+			for (int y = min_y; y <= max_y; y++) {
+				const float py = y + 0.5f;
+				const float row_edge0 = triangle.edge_b[0] * py + triangle.edge_c[0];
+				const float row_edge1 = triangle.edge_b[1] * py + triangle.edge_c[1];
+				const float row_edge2 = triangle.edge_b[2] * py + triangle.edge_c[2];
+				const float row_depth = triangle.depth_b * py + triangle.depth_c;
+				float *row = &depth[y * width];
+
+				// Branchless so the compiler can vectorize the span.
+				for (int x = triangle.min_x; x <= triangle.max_x; x++) {
+					const float px = x + 0.5f;
+					const bool inside = triangle.edge_a[0] * px + row_edge0 >= 0.0f && triangle.edge_a[1] * px + row_edge1 >= 0.0f && triangle.edge_a[2] * px + row_edge2 >= 0.0f;
+					const float d = inside ? triangle.depth_a * px + row_depth : FLT_MAX;
+					row[x] = MIN(row[x], d);
+				}
+			}
+		}
+	}
+
+	if (!p_data->cam_orthogonal) {
+		for (int i = from_y * width; i < to_y * width; i++) {
+			depth[i] = depth[i] < 0.0f ? -1.0f / depth[i] : FLT_MAX;
+		}
+	}
+}
+
+void RasterOcclusionCull::RasterHZBuffer::rasterize(const LocalVector<const OccluderInstance *> &p_instances, const Transform3D &p_cam_transform, const Projection &p_cam_projection, bool p_cam_orthogonal) {
+	ERR_FAIL_COND(is_empty());
+
+	RasterThreadData td;
+	td.instances = p_instances.ptr();
+	td.instance_count = p_instances.size();
+	td.cam_inv_transform = p_cam_transform.inverse();
+	td.cam_projection = p_cam_projection;
+	td.cam_orthogonal = p_cam_orthogonal;
+	td.z_near = p_cam_projection.get_z_near();
+	td.band_count = CLAMP(WorkerThreadPool::get_singleton()->get_thread_count(), 1, sizes[0].y);
+
+	debug_tex_range = p_cam_projection.get_z_far();
+
+	if (instance_triangles.size() < td.instance_count) {
+		instance_triangles.resize(td.instance_count);
+	}
+
+	if (td.instance_count > 0) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &RasterHZBuffer::_setup_instance_triangles, &td, td.instance_count, -1, true, SNAME("RasterOcclusionCullSetup"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	}
+
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &RasterHZBuffer::_raster_band, &td, td.band_count, -1, true, SNAME("RasterOcclusionCullRaster"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+}
+
+////////////////////////////////////////////////////////
+
+bool RasterOcclusionCull::is_occluder(RID p_rid) {
+	return occluder_owner.owns(p_rid);
+}
+
+RID RasterOcclusionCull::occluder_allocate() {
+	return occluder_owner.allocate_rid();
+}
+
+void RasterOcclusionCull::occluder_initialize(RID p_occluder) {
+	Occluder *occluder = memnew(Occluder);
+	occluder_owner.initialize_rid(p_occluder, occluder);
+}
+
+void RasterOcclusionCull::occluder_set_mesh(RID p_occluder, const PackedVector3Array &p_vertices, const PackedInt32Array &p_indices) {
+	Occluder *occluder = occluder_owner.get_or_null(p_occluder);
+	ERR_FAIL_NULL(occluder);
+
+	occluder->vertices = p_vertices;
+	occluder->indices = p_indices;
+
+	for (const InstanceID &E : occluder->users) {
+		ERR_CONTINUE(!scenarios.has(E.scenario));
+		Scenario &scenario = scenarios[E.scenario];
+		ERR_CONTINUE(!scenario.instances.has(E.instance));
+
+		if (!scenario.dirty_instances.has(E.instance)) {
+			scenario.dirty_instances.insert(E.instance);
+			scenario.dirty_instances_array.push_back(E.instance);
+		}
+	}
+}
+
+void RasterOcclusionCull::free_occluder(RID p_occluder) {
+	Occluder *occluder = occluder_owner.get_or_null(p_occluder);
+	ERR_FAIL_NULL(occluder);
+	memdelete(occluder);
+	occluder_owner.free(p_occluder);
+}
+
+////////////////////////////////////////////////////////
+
+void RasterOcclusionCull::add_scenario(RID p_scenario) {
+	ERR_FAIL_COND(scenarios.has(p_scenario));
+	scenarios[p_scenario] = Scenario();
+}
+
+void RasterOcclusionCull::remove_scenario(RID p_scenario) {
+	ERR_FAIL_COND(!scenarios.has(p_scenario));
+	scenarios.erase(p_scenario);
+}
+
+void RasterOcclusionCull::scenario_set_instance(RID p_scenario, RID p_instance, RID p_occluder, const Transform3D &p_xform, bool p_enabled) {
+	ERR_FAIL_COND(!scenarios.has(p_scenario));
+	Scenario &scenario = scenarios[p_scenario];
+
+	if (!scenario.instances.has(p_instance)) {
+		scenario.instances[p_instance] = OccluderInstance();
+		scenario.dirty = true;
+	}
+
+	OccluderInstance &instance = scenario.instances[p_instance];
+
+	bool changed = false;
+
+	if (instance.removed) {
+		instance.removed = false;
+		scenario.removed_instances.erase(p_instance);
+		changed = true; // It was removed and re-added, we might have missed some changes
+	}
+
+	if (instance.occluder != p_occluder) {
+		Occluder *old_occluder = occluder_owner.get_or_null(instance.occluder);
+		if (old_occluder) {
+			old_occluder->users.erase(InstanceID(p_scenario, p_instance));
+		}
+
+		instance.occluder = p_occluder;
+
+		if (p_occluder.is_valid()) {
+			Occluder *occluder = occluder_owner.get_or_null(p_occluder);
+			ERR_FAIL_NULL(occluder);
+			occluder->users.insert(InstanceID(p_scenario, p_instance));
+		}
+		changed = true;
+	}
+
+	if (instance.xform != p_xform) {
+		instance.xform = p_xform;
+		changed = true;
+	}
+
+	if (instance.enabled != p_enabled) {
+		instance.enabled = p_enabled;
+		scenario.dirty = true; // The raster list needs a rebuild, but the instance doesn't need update
+	}
+
+	if (changed && !scenario.dirty_instances.has(p_instance)) {
+		scenario.dirty_instances.insert(p_instance);
+		scenario.dirty_instances_array.push_back(p_instance);
+		scenario.dirty = true;
+	}
+}
+
+void RasterOcclusionCull::scenario_remove_instance(RID p_scenario, RID p_instance) {
+	ERR_FAIL_COND(!scenarios.has(p_scenario));
+	Scenario &scenario = scenarios[p_scenario];
+
+	if (scenario.instances.has(p_instance)) {
+		OccluderInstance &instance = scenario.instances[p_instance];
+
+		if (!instance.removed) {
+			Occluder *occluder = occluder_owner.get_or_null(instance.occluder);
+			if (occluder) {
+				occluder->users.erase(InstanceID(p_scenario, p_instance));
+			}
+
+			scenario.removed_instances.push_back(p_instance);
+			instance.removed = true;
+		}
+	}
+}
+
+void RasterOcclusionCull::Scenario::_update_dirty_instance(uint32_t p_idx, RID *p_instances) {
+	OccluderInstance *occ_inst = instances.getptr(p_instances[p_idx]);
+
+	if (!occ_inst) {
+		return;
+	}
+
+	const Occluder *occ = raster_singleton->occluder_owner.get_or_null(occ_inst->occluder);
+
+	if (!occ) {
+		occ_inst->xformed_vertices.clear();
+		occ_inst->indices.clear();
+		return;
+	}
+
+	int vertices_size = occ->vertices.size();
+	occ_inst->xformed_vertices.resize(vertices_size);
+
+	const Vector3 *read_ptr = occ->vertices.ptr();
+	Vector3 *write_ptr = occ_inst->xformed_vertices.ptr();
+	for (int i = 0; i < vertices_size; i++) {
+		write_ptr[i] = occ_inst->xform.xform(read_ptr[i]);
+	}
+
+	occ_inst->indices.resize(occ->indices.size());
+	memcpy(occ_inst->indices.ptr(), occ->indices.ptr(), occ->indices.size() * sizeof(int32_t));
+}
+
+void RasterOcclusionCull::Scenario::update() {
+	ERR_FAIL_NULL(raster_singleton);
+
+	if (!dirty && removed_instances.is_empty() && dirty_instances_array.is_empty()) {
+		return;
+	}
+
+	for (const RID &instance : removed_instances) {
+		instances.erase(instance);
+	}
+
+	if (dirty_instances_array.size() > 1) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &Scenario::_update_dirty_instance, dirty_instances_array.ptr(), dirty_instances_array.size(), -1, true, SNAME("RasterOcclusionCullUpdate"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else if (dirty_instances_array.size() == 1) {
+		_update_dirty_instance(0, dirty_instances_array.ptr());
+	}
+
+	dirty_instances.clear();
+	dirty_instances_array.clear();
+	removed_instances.clear();
+
+	raster_instances.clear();
+	for (const KeyValue<RID, OccluderInstance> &E : instances) {
+		const OccluderInstance &occ_inst = E.value;
+		if (occ_inst.enabled && occ_inst.indices.size() >= 3) {
+			raster_instances.push_back(&occ_inst);
+		}
+	}
+
+	dirty = false;
+}
+
+////////////////////////////////////////////////////////
+
+void RasterOcclusionCull::add_buffer(RID p_buffer) {
+	ERR_FAIL_COND(buffers.has(p_buffer));
+	buffers[p_buffer] = RasterHZBuffer();
+}
+
+void RasterOcclusionCull::remove_buffer(RID p_buffer) {
+	ERR_FAIL_COND(!buffers.has(p_buffer));
+	buffers.erase(p_buffer);
+}
+
+void RasterOcclusionCull::buffer_set_scenario(RID p_buffer, RID p_scenario) {
+	ERR_FAIL_COND(!buffers.has(p_buffer));
+	ERR_FAIL_COND(p_scenario.is_valid() && !scenarios.has(p_scenario));
+	buffers[p_buffer].scenario_rid = p_scenario;
+}
+
+void RasterOcclusionCull::buffer_set_size(RID p_buffer, const Vector2i &p_size) {
+	ERR_FAIL_COND(!buffers.has(p_buffer));
+	buffers[p_buffer].resize(p_size);
+}
+
+void RasterOcclusionCull::buffer_update(RID p_buffer, const Transform3D &p_cam_transform, const Projection &p_cam_projection, bool p_cam_orthogonal) {
+	if (!buffers.has(p_buffer)) {
+		return;
+	}
+
+	RasterHZBuffer &buffer = buffers[p_buffer];
+
+	if (buffer.is_empty() || !scenarios.has(buffer.scenario_rid)) {
+		return;
+	}
+
+	Scenario &scenario = scenarios[buffer.scenario_rid];
+	scenario.update();
+
+	Projection jittered_proj = _jitter_projection(p_cam_projection, buffer.get_occlusion_buffer_size());
+
+	buffer.rasterize(scenario.raster_instances, p_cam_transform, jittered_proj, p_cam_orthogonal);
+	buffer.update_mips();
+}
+
+RasterOcclusionCull::HZBuffer *RasterOcclusionCull::buffer_get_ptr(RID p_buffer) {
+	if (!buffers.has(p_buffer)) {
+		return nullptr;
+	}
+	return &buffers[p_buffer];
+}
+
+RID RasterOcclusionCull::buffer_get_debug_texture(RID p_buffer) {
+	ERR_FAIL_COND_V(!buffers.has(p_buffer), RID());
+	return buffers[p_buffer].get_debug_texture();
+}
+
+////////////////////////////////////////////////////////
+
+RasterOcclusionCull::RasterOcclusionCull() {
+	raster_singleton = this;
+}
+
+RasterOcclusionCull::~RasterOcclusionCull() {
+	raster_singleton = nullptr;
+}
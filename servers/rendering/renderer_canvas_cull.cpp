@@ -50,8 +50,24 @@ void RendererCanvasCull::_render_canvas_item_tree(RID p_to_render_target, Canvas
 	memset(z_list, 0, z_range * sizeof(RendererCanvasRender::Item *));
 	memset(z_last_list, 0, z_range * sizeof(RendererCanvasRender::Item *));
 
-	for (int i = 0; i < p_child_item_count; i++) {
-		_cull_canvas_item(p_child_items[i].item, p_transform, p_clip_rect, Color(1, 1, 1, 1), 0, z_list, z_last_list, nullptr, nullptr, true, p_canvas_cull_mask, Point2(), 1, nullptr);
+	if (_use_threaded_cull(p_child_item_count)) {
+		threaded_cull_root_items.resize(p_child_item_count);
+		for (int i = 0; i < p_child_item_count; i++) {
+			threaded_cull_root_items[i] = p_child_items[i].item;
+		}
+
+		ThreadedCullData cull_data;
+		cull_data.items = threaded_cull_root_items.ptr();
+		cull_data.item_count = p_child_item_count;
+		cull_data.xform = p_transform;
+		cull_data.clip_rect = p_clip_rect;
+		cull_data.modulate = Color(1, 1, 1, 1);
+		cull_data.canvas_cull_mask = p_canvas_cull_mask;
+		_cull_canvas_items_threaded(cull_data, z_list, z_last_list);
+	} else {
+		for (int i = 0; i < p_child_item_count; i++) {
+			_cull_canvas_item(p_child_items[i].item, p_transform, p_clip_rect, Color(1, 1, 1, 1), 0, z_list, z_last_list, nullptr, nullptr, true, p_canvas_cull_mask, Point2(), 1, nullptr);
+		}
 	}
 
 	RendererCanvasRender::Item *list = nullptr;
@@ -124,6 +140,239 @@ void _mark_ysort_dirty(RendererCanvasCull::Item *ysort_owner, RID_Owner<Renderer
 	} while (ysort_owner && ysort_owner->sort_y);
 }
 
+bool RendererCanvasCull::_is_canvas_item_indexable(const Item *p_item) {
+	if (!p_item->child_items.is_empty() || p_item->clip || p_item->sort_y || p_item->canvas_group || p_item->copy_back_buffer || p_item->vp_render || p_item->repeat_source) {
+		return false;
+	}
+
+	if (p_item->custom_rect) {
+		return true;
+	}
+
+	if (p_item->update_when_visible || p_item->skeleton.is_valid()) {
+		return false;
+	}
+
+	// The rect of these commands depends on other resources, so it can change without the item being touched.
+	for (const Item::Command *c = p_item->commands; c; c = c->next) {
+		if (c->type == Item::Command::TYPE_MESH || c->type == Item::Command::TYPE_MULTIMESH || c->type == Item::Command::TYPE_PARTICLES) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void RendererCanvasCull::_canvas_item_child_index_remove(Item *p_parent, Item *p_item) {
+	Item::ChildIndex *index = p_parent->child_index;
+	if (!index) {
+		return;
+	}
+
+	p_item->parent_child_index = nullptr;
+	if (p_item->child_index_id.is_valid()) {
+		index->bvh.remove(p_item->child_index_id);
+		p_item->child_index_id = DynamicBVH::ID();
+	}
+	index->dirty_items.erase(p_item);
+	index->unindexed_items.erase(p_item);
+}
+
+void RendererCanvasCull::_canvas_item_free_child_index(Item *p_item) {
+	if (!p_item->child_index) {
+		return;
+	}
+
+	for (Item *child : p_item->child_items) {
+		child->parent_child_index = nullptr;
+		child->child_index_id = DynamicBVH::ID();
+	}
+
+	memdelete(p_item->child_index);
+	p_item->child_index = nullptr;
+}
+
+bool RendererCanvasCull::_cull_child_index(Item *p_item, const Transform2D &p_xform, const Rect2 &p_clip_rect, LocalVector<Item *> &r_items) {
+	if (p_xform.determinant() == 0) {
+		return false;
+	}
+
+	if (!p_item->child_index) {
+		p_item->child_index = memnew(Item::ChildIndex);
+		for (Item *child : p_item->child_items) {
+			child->parent_child_index = p_item->child_index;
+			p_item->child_index->dirty_items.insert(child);
+		}
+	}
+
+	Item::ChildIndex *index = p_item->child_index;
+
+	for (Item *child : index->dirty_items) {
+		if (_is_canvas_item_indexable(child)) {
+			index->unindexed_items.erase(child);
+
+			// Same rect _cull_canvas_item() computes, in this item's local space.
+			Rect2 rect = child->get_rect();
+			if (child->visibility_notifier && child->visibility_notifier->area.size != Vector2()) {
+				rect = rect.merge(child->visibility_notifier->area);
+			}
+			rect = child->xform_curr.xform(rect);
+
+			AABB aabb(Vector3(rect.position.x, rect.position.y, 0), Vector3(rect.size.x, rect.size.y, 0));
+			if (child->child_index_id.is_valid()) {
+				index->bvh.update(child->child_index_id, aabb);
+			} else {
+				child->child_index_id = index->bvh.insert(aabb, child);
+			}
+		} else {
+			if (child->child_index_id.is_valid()) {
+				index->bvh.remove(child->child_index_id);
+				child->child_index_id = DynamicBVH::ID();
+			}
+			index->unindexed_items.insert(child);
+		}
+	}
+	index->dirty_items.clear();
+
+	// Bring the viewport into local space. Grow it on both sides to account for transform snapping.
+	Rect2 local_clip_rect = p_xform.affine_inverse().xform(Rect2(Point2(), p_clip_rect.size).grow(1.0)).grow(1.0);
+
+	struct CullResult {
+		LocalVector<Item *> *items = nullptr;
+		_FORCE_INLINE_ bool operator()(void *p_data) {
+			items->push_back((Item *)p_data);
+			return false;
+		}
+	};
+
+	CullResult cull_result;
+	cull_result.items = &r_items;
+	index->bvh.aabb_query(AABB(Vector3(local_clip_rect.position.x, local_clip_rect.position.y, 0), Vector3(local_clip_rect.size.x, local_clip_rect.size.y, 0)), cull_result);
+
+	for (Item *child : index->unindexed_items) {
+		r_items.push_back(child);
+	}
+
+	r_items.sort_custom<ItemIndexSort>();
+	return true;
+}
+
+// Y keys drop the low 6 mantissa bits, so positions in the same bucket keep their
+// tree order. Buckets are relative (about 1e-5 of the value), unlike the absolute
+// tolerance of Math::is_equal_approx(): they get much finer near zero, and nearly
+// equal positions on either side of a bucket boundary are still sorted by Y.
+// Positions within CMP_EPSILON of zero are snapped to it, so rounding noise around
+// the origin doesn't reorder items that are meant to be at the same height.
+static constexpr uint32_t YSORT_KEY_DROPPED_BITS = 6;
+static constexpr uint32_t YSORT_RADIX_BITS = 9;
+static constexpr uint32_t YSORT_RADIX_PASSES = 3;
+static constexpr uint32_t YSORT_RADIX_MASK = (1 << YSORT_RADIX_BITS) - 1;
+
+uint32_t RendererCanvasCull::_ysort_key(real_t p_y) {
+	float y = p_y;
+	if (Math::abs(p_y) < (real_t)CMP_EPSILON) {
+		y = 0.0f; // Also keeps -0.0 from sorting before 0.0.
+	}
+	uint32_t bits;
+	memcpy(&bits, &y, sizeof(uint32_t));
+	// Flip the bits so that unsigned comparison matches float comparison.
+	bits = (bits & 0x80000000) ? ~bits : (bits | 0x80000000);
+	return bits >> YSORT_KEY_DROPPED_BITS;
+}
+
+void RendererCanvasCull::_radix_sort_ysort_records(uint64_t *p_records, uint64_t *p_scratch, uint32_t p_count) {
+	uint32_t histograms[YSORT_RADIX_PASSES][YSORT_RADIX_MASK + 1] = {};
+	for (uint32_t i = 0; i < p_count; i++) {
+		uint32_t key = p_records[i] >> 32;
+		for (uint32_t pass = 0; pass < YSORT_RADIX_PASSES; pass++) {
+			histograms[pass][(key >> (pass * YSORT_RADIX_BITS)) & YSORT_RADIX_MASK]++;
+		}
+	}
+
+	uint64_t *src = p_records;
+	uint64_t *dst = p_scratch;
+	for (uint32_t pass = 0; pass < YSORT_RADIX_PASSES; pass++) {
+		uint32_t shift = 32 + pass * YSORT_RADIX_BITS;
+		uint32_t *histogram = histograms[pass];
+		if (histogram[(src[0] >> shift) & YSORT_RADIX_MASK] == p_count) {
+			continue; // All keys share this digit.
+		}
+
+		uint32_t offset = 0;
+		for (uint32_t digit = 0; digit <= YSORT_RADIX_MASK; digit++) {
+			uint32_t count = histogram[digit];
+			histogram[digit] = offset;
+			offset += count;
+		}
+		for (uint32_t i = 0; i < p_count; i++) {
+			dst[histogram[(src[i] >> shift) & YSORT_RADIX_MASK]++] = src[i];
+		}
+		SWAP(src, dst);
+	}
+
+	if (src != p_records) {
+		memcpy(p_records, src, p_count * sizeof(uint64_t));
+	}
+}
+
+void RendererCanvasCull::_sort_ysort_items(Item *p_owner, Item **r_items, int p_count) {
+	if (!p_owner->ysort_cache) {
+		p_owner->ysort_cache = memnew(Item::YSortCache);
+	}
+	Item::YSortCache &cache = *p_owner->ysort_cache;
+	cache.items.resize(p_count);
+	cache.records.resize(p_count);
+	cache.scratch.resize(p_count);
+
+	// Items arrive in tree order, which is also their ysort_index.
+	for (int i = 0; i < p_count; i++) {
+		cache.items[i] = r_items[i];
+		cache.scratch[i] = (uint64_t(_ysort_key(r_items[i]->ysort_pos.y)) << 32) | uint32_t(i);
+	}
+
+	uint64_t *records = cache.records.ptr();
+	bool sorted = false;
+	if (cache.order.size() == uint32_t(p_count)) {
+		// Most items stay in place between frames, so start from the last order and
+		// re-insert the items that moved. Records compare by key, then ysort_index,
+		// so this gives the same result as the stable radix sort. If too many items
+		// moved, give up and radix sort instead.
+		for (int i = 0; i < p_count; i++) {
+			records[i] = cache.scratch[cache.order[i]];
+		}
+
+		int64_t move_budget = p_count;
+		sorted = true;
+		for (int i = 1; i < p_count; i++) {
+			uint64_t record = records[i];
+			int j = i;
+			while (j > 0 && records[j - 1] > record) {
+				records[j] = records[j - 1];
+				j--;
+			}
+			records[j] = record;
+
+			move_budget -= i - j;
+			if (move_budget < 0) {
+				sorted = false;
+				break;
+			}
+		}
+	}
+
+	if (!sorted) {
+		memcpy(records, cache.scratch.ptr(), p_count * sizeof(uint64_t));
+		_radix_sort_ysort_records(records, cache.scratch.ptr(), p_count);
+	}
+
+	cache.order.resize(p_count);
+	for (int i = 0; i < p_count; i++) {
+		uint32_t index = uint32_t(records[i]);
+		cache.order[i] = index;
+		r_items[i] = cache.items[index];
+	}
+}
+
 void RendererCanvasCull::_attach_canvas_item_for_draw(RendererCanvasCull::Item *ci, RendererCanvasCull::Item *p_canvas_clip, RendererCanvasRender::Item **r_z_list, RendererCanvasRender::Item **r_z_last_list, const Transform2D &p_transform, const Rect2 &p_clip_rect, Rect2 p_global_rect, const Color &p_modulate, int p_z, RendererCanvasCull::Item *p_material_owner, bool p_use_canvas_group, RendererCanvasRender::Item *r_canvas_group_from) {
 	if (ci->copy_back_buffer) {
 		ci->copy_back_buffer->screen_rect = p_transform.xform(ci->copy_back_buffer->rect).intersection(p_clip_rect);
@@ -196,7 +445,9 @@ void RendererCanvasCull::_attach_canvas_item_for_draw(RendererCanvasCull::Item *
 		//something to draw?
 
 		if (ci->update_when_visible) {
+			redraw_request_lock.lock();
 			RenderingServerDefault::redraw_request();
+			redraw_request_lock.unlock();
 		}
 
 		if (ci->commands != nullptr || ci->copy_back_buffer) {
@@ -224,7 +475,9 @@ void RendererCanvasCull::_attach_canvas_item_for_draw(RendererCanvasCull::Item *
 
 		if (ci->visibility_notifier) {
 			if (!ci->visibility_notifier->visible_element.in_list()) {
+				visibility_notifier_list_lock.lock();
 				visibility_notifier_list.add(&ci->visibility_notifier->visible_element);
+				visibility_notifier_list_lock.unlock();
 				ci->visibility_notifier->just_visible = true;
 			}
 
@@ -236,6 +489,52 @@ void RendererCanvasCull::_attach_canvas_item_for_draw(RendererCanvasCull::Item *
 	}
 }
 
+void RendererCanvasCull::_cull_canvas_items_chunk(uint32_t p_chunk, ThreadedCullData *p_data) {
+	RendererCanvasRender::Item **chunk_z_list = &threaded_cull_z_lists[p_chunk * z_range * 2];
+	RendererCanvasRender::Item **chunk_z_last_list = chunk_z_list + z_range;
+	memset(chunk_z_list, 0, z_range * 2 * sizeof(RendererCanvasRender::Item *));
+
+	uint32_t from = (uint64_t)p_data->item_count * p_chunk / p_data->chunk_count;
+	uint32_t to = (uint64_t)p_data->item_count * (p_chunk + 1) / p_data->chunk_count;
+
+	for (uint32_t i = from; i < to; i++) {
+		Item *child = p_data->items[i];
+		if (p_data->skip_behind && child->behind) {
+			continue;
+		}
+		_cull_canvas_item(child, p_data->xform, p_data->clip_rect, p_data->modulate, p_data->z, chunk_z_list, chunk_z_last_list, p_data->canvas_clip, p_data->material_owner, true, p_data->canvas_cull_mask, p_data->repeat_size, p_data->repeat_times, p_data->repeat_source_item);
+	}
+}
+
+void RendererCanvasCull::_cull_canvas_items_threaded(ThreadedCullData &p_data, RendererCanvasRender::Item **r_z_list, RendererCanvasRender::Item **r_z_last_list) {
+	p_data.chunk_count = MIN(p_data.item_count, (uint32_t)WorkerThreadPool::get_singleton()->get_thread_count());
+	if (threaded_cull_z_lists.size() < p_data.chunk_count * z_range * 2) {
+		threaded_cull_z_lists.resize(p_data.chunk_count * z_range * 2);
+	}
+
+	// Nested subtrees are culled serially within their chunk.
+	threaded_cull_active = true;
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &RendererCanvasCull::_cull_canvas_items_chunk, &p_data, p_data.chunk_count, -1, true, SNAME("RenderCullCanvasItems"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	threaded_cull_active = false;
+
+	for (uint32_t chunk = 0; chunk < p_data.chunk_count; chunk++) {
+		RendererCanvasRender::Item **chunk_z_list = &threaded_cull_z_lists[chunk * z_range * 2];
+		RendererCanvasRender::Item **chunk_z_last_list = chunk_z_list + z_range;
+		for (int i = 0; i < z_range; i++) {
+			if (!chunk_z_list[i]) {
+				continue;
+			}
+			if (r_z_last_list[i]) {
+				r_z_last_list[i]->next = chunk_z_list[i];
+			} else {
+				r_z_list[i] = chunk_z_list[i];
+			}
+			r_z_last_list[i] = chunk_z_last_list[i];
+		}
+	}
+}
+
 void RendererCanvasCull::_cull_canvas_item(Item *p_canvas_item, const Transform2D &p_parent_xform, const Rect2 &p_clip_rect, const Color &p_modulate, int p_z, RendererCanvasRender::Item **r_z_list, RendererCanvasRender::Item **r_z_last_list, Item *p_canvas_clip, Item *p_material_owner, bool p_allow_y_sort, uint32_t p_canvas_cull_mask, const Point2 &p_repeat_size, int p_repeat_times, RendererCanvasRender::Item *p_repeat_source_item) {
 	Item *ci = p_canvas_item;
 
@@ -373,8 +672,7 @@ void RendererCanvasCull::_cull_canvas_item(Item *p_canvas_item, const Transform2
 			int i = 1;
 			_collect_ysort_children(ci, Transform2D(), p_material_owner, Color(1, 1, 1, 1), child_items, i, p_z);
 
-			SortArray<Item *, ItemPtrSort> sorter;
-			sorter.sort(child_items, child_item_count);
+			_sort_ysort_items(ci, child_items, child_item_count);
 
 			for (i = 0; i < child_item_count; i++) {
 				_cull_canvas_item(child_items[i], final_xform * child_items[i]->ysort_xform, p_clip_rect, modulate * child_items[i]->ysort_modulate, child_items[i]->ysort_parent_abs_z_index, r_z_list, r_z_last_list, (Item *)ci->final_clip_owner, (Item *)child_items[i]->material_owner, false, p_canvas_cull_mask, child_items[i]->repeat_size, child_items[i]->repeat_times, child_items[i]->repeat_source_item);
@@ -397,6 +695,16 @@ void RendererCanvasCull::_cull_canvas_item(Item *p_canvas_item, const Transform2
 			canvas_group_from = r_z_last_list[zidx];
 		}
 
+		// With many children, only visit the ones whose rect can reach the viewport.
+		// Physics interpolation and repeating move children away from their indexed rect, so the index isn't used then.
+		LocalVector<Item *> visible_child_items;
+		if (child_index_min_children > 0 && child_item_count >= child_index_min_children && !use_canvas_group && !_interpolation_data.interpolation_enabled && !(repeat_source_item && (repeat_size.x || repeat_size.y))) {
+			if (_cull_child_index(ci, final_xform, p_clip_rect, visible_child_items)) {
+				child_items = visible_child_items.ptr();
+				child_item_count = visible_child_items.size();
+			}
+		}
+
 		for (int i = 0; i < child_item_count; i++) {
 			if (!child_items[i]->behind && !use_canvas_group) {
 				continue;
@@ -404,11 +712,29 @@ void RendererCanvasCull::_cull_canvas_item(Item *p_canvas_item, const Transform2
 			_cull_canvas_item(child_items[i], final_xform, p_clip_rect, modulate, p_z, r_z_list, r_z_last_list, (Item *)ci->final_clip_owner, p_material_owner, true, p_canvas_cull_mask, repeat_size, repeat_times, repeat_source_item);
 		}
 		_attach_canvas_item_for_draw(ci, p_canvas_clip, r_z_list, r_z_last_list, final_xform, p_clip_rect, global_rect, modulate, p_z, p_material_owner, use_canvas_group, canvas_group_from);
-		for (int i = 0; i < child_item_count; i++) {
-			if (child_items[i]->behind || use_canvas_group) {
-				continue;
+		if (!use_canvas_group && _use_threaded_cull(child_item_count)) {
+			ThreadedCullData cull_data;
+			cull_data.items = child_items;
+			cull_data.item_count = child_item_count;
+			cull_data.skip_behind = true;
+			cull_data.xform = final_xform;
+			cull_data.clip_rect = p_clip_rect;
+			cull_data.modulate = modulate;
+			cull_data.z = p_z;
+			cull_data.canvas_clip = (Item *)ci->final_clip_owner;
+			cull_data.material_owner = p_material_owner;
+			cull_data.canvas_cull_mask = p_canvas_cull_mask;
+			cull_data.repeat_size = repeat_size;
+			cull_data.repeat_times = repeat_times;
+			cull_data.repeat_source_item = repeat_source_item;
+			_cull_canvas_items_threaded(cull_data, r_z_list, r_z_last_list);
+		} else {
+			for (int i = 0; i < child_item_count; i++) {
+				if (child_items[i]->behind || use_canvas_group) {
+					continue;
+				}
+				_cull_canvas_item(child_items[i], final_xform, p_clip_rect, modulate, p_z, r_z_list, r_z_last_list, (Item *)ci->final_clip_owner, p_material_owner, true, p_canvas_cull_mask, repeat_size, repeat_times, repeat_source_item);
 			}
-			_cull_canvas_item(child_items[i], final_xform, p_clip_rect, modulate, p_z, r_z_list, r_z_last_list, (Item *)ci->final_clip_owner, p_material_owner, true, p_canvas_cull_mask, repeat_size, repeat_times, repeat_source_item);
 		}
 	}
 }
@@ -469,6 +795,8 @@ void RendererCanvasCull::canvas_set_item_repeat(RID p_item, const Point2 &p_repe
 	canvas_item->repeat_source_item = is_repeat_source ? canvas_item : nullptr;
 	canvas_item->repeat_size = p_repeat_size;
 	canvas_item->repeat_times = p_repeat_times;
+
+	_canvas_item_child_index_dirty(canvas_item);
 }
 
 void RendererCanvasCull::canvas_set_modulate(RID p_canvas, const Color &p_color) {
@@ -507,6 +835,8 @@ void RendererCanvasCull::canvas_item_set_parent(RID p_item, RID p_parent) {
 		} else if (canvas_item_owner.owns(canvas_item->parent)) {
 			Item *item_owner = canvas_item_owner.get_or_null(canvas_item->parent);
 			item_owner->child_items.erase(canvas_item);
+			_canvas_item_child_index_remove(item_owner, canvas_item);
+			_canvas_item_child_index_dirty(item_owner);
 
 			if (item_owner->sort_y) {
 				_mark_ysort_dirty(item_owner, canvas_item_owner);
@@ -527,6 +857,9 @@ void RendererCanvasCull::canvas_item_set_parent(RID p_item, RID p_parent) {
 			Item *item_owner = canvas_item_owner.get_or_null(p_parent);
 			item_owner->child_items.push_back(canvas_item);
 			item_owner->children_order_dirty = true;
+			canvas_item->parent_child_index = item_owner->child_index;
+			_canvas_item_child_index_dirty(canvas_item);
+			_canvas_item_child_index_dirty(item_owner);
 
 			if (item_owner->sort_y) {
 				_mark_ysort_dirty(item_owner, canvas_item_owner);
@@ -560,6 +893,8 @@ void RendererCanvasCull::canvas_item_set_transform(RID p_item, const Transform2D
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
 
+	_canvas_item_child_index_dirty(canvas_item);
+
 	if (_interpolation_data.interpolation_enabled && canvas_item->interpolated) {
 		if (!canvas_item->on_interpolate_transform_list) {
 			_interpolation_data.canvas_item_transform_update_list_curr->push_back(p_item);
@@ -590,6 +925,8 @@ void RendererCanvasCull::canvas_item_set_clip(RID p_item, bool p_clip) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
 
+	_canvas_item_child_index_dirty(canvas_item);
+
 	canvas_item->clip = p_clip;
 }
 
@@ -604,6 +941,8 @@ void RendererCanvasCull::canvas_item_set_custom_rect(RID p_item, bool p_custom_r
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
 
+	_canvas_item_child_index_dirty(canvas_item);
+
 	canvas_item->custom_rect = p_custom_rect;
 	canvas_item->rect = p_rect;
 }
@@ -633,6 +972,8 @@ void RendererCanvasCull::canvas_item_set_update_when_visible(RID p_item, bool p_
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
 
+	_canvas_item_child_index_dirty(canvas_item);
+
 	canvas_item->update_when_visible = p_update;
 }
 
@@ -640,6 +981,8 @@ void RendererCanvasCull::canvas_item_add_line(RID p_item, const Point2 &p_from,
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
 
+	_canvas_item_child_index_dirty(canvas_item);
+
 	Item::CommandPrimitive *line = canvas_item->alloc_command<Item::CommandPrimitive>();
 	ERR_FAIL_NULL(line);
 
@@ -869,6 +1212,8 @@ void RendererCanvasCull::canvas_item_add_polyline(RID p_item, const Vector<Point
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
 
+	_canvas_item_child_index_dirty(canvas_item);
+
 	Color color = Color(1, 1, 1, 1);
 
 	Vector<int> indices;
@@ -1139,6 +1484,8 @@ void RendererCanvasCull::canvas_item_add_multiline(RID p_item, const Vector<Poin
 		Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 		ERR_FAIL_NULL(canvas_item);
 
+		_canvas_item_child_index_dirty(canvas_item);
+
 		Vector<Color> colors;
 		if (p_colors.size() == 1) {
 			colors = p_colors;
@@ -1181,6 +1528,8 @@ void RendererCanvasCull::canvas_item_add_rect(RID p_item, const Rect2 &p_rect, c
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
 
+	_canvas_item_child_index_dirty(canvas_item);
+
 	Item::CommandRect *rect = canvas_item->alloc_command<Item::CommandRect>();
 	ERR_FAIL_NULL(rect);
 	rect->modulate = p_color;
@@ -1345,6 +1694,8 @@ void RendererCanvasCull::canvas_item_add_circle(RID p_item, const Point2 &p_pos,
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
 
+	_canvas_item_child_index_dirty(canvas_item);
+
 	static const int circle_segments = 64;
 
 	{
@@ -1436,6 +1787,8 @@ void RendererCanvasCull::canvas_item_add_texture_rect(RID p_item, const Rect2 &p
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
 
+	_canvas_item_child_index_dirty(canvas_item);
+
 	Item::CommandRect *rect = canvas_item->alloc_command<Item::CommandRect>();
 	ERR_FAIL_NULL(rect);
 	rect->modulate = p_modulate;
@@ -1467,6 +1820,8 @@ void RendererCanvasCull::canvas_item_add_msdf_texture_rect_region(RID p_item, co
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
 
+	_canvas_item_child_index_dirty(canvas_item);
+
 	Item::CommandRect *rect = canvas_item->alloc_command<Item::CommandRect>();
 	ERR_FAIL_NULL(rect);
 	rect->modulate = p_modulate;
@@ -1501,6 +1856,8 @@ void RendererCanvasCull::canvas_item_add_lcd_texture_rect_region(RID p_item, con
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
 
+	_canvas_item_child_index_dirty(canvas_item);
+
 	Item::CommandRect *rect = canvas_item->alloc_command<Item::CommandRect>();
 	ERR_FAIL_NULL(rect);
 	rect->modulate = p_modulate;
@@ -1533,6 +1890,8 @@ void RendererCanvasCull::canvas_item_add_texture_rect_region(RID p_item, const R
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
 
+	_canvas_item_child_index_dirty(canvas_item);
+
 	Item::CommandRect *rect = canvas_item->alloc_command<Item::CommandRect>();
 	ERR_FAIL_NULL(rect);
 	rect->modulate = p_modulate;
@@ -1574,6 +1933,8 @@ void RendererCanvasCull::canvas_item_add_nine_patch(RID p_item, const Rect2 &p_r
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
 
+	_canvas_item_child_index_dirty(canvas_item);
+
 	Item::CommandNinePatch *style = canvas_item->alloc_command<Item::CommandNinePatch>();
 	ERR_FAIL_NULL(style);
 
@@ -1598,6 +1959,8 @@ void RendererCanvasCull::canvas_item_add_primitive(RID p_item, const Vector<Poin
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
 
+	_canvas_item_child_index_dirty(canvas_item);
+
 	Item::CommandPrimitive *prim = canvas_item->alloc_command<Item::CommandPrimitive>();
 	ERR_FAIL_NULL(prim);
 
@@ -1623,6 +1986,9 @@ void RendererCanvasCull::canvas_item_add_primitive(RID p_item, const Vector<Poin
 void RendererCanvasCull::canvas_item_add_polygon(RID p_item, const Vector<Point2> &p_points, const Vector<Color> &p_colors, const Vector<Point2> &p_uvs, RID p_texture) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+
+	_canvas_item_child_index_dirty(canvas_item);
+
 #ifdef DEBUG_ENABLED
 	int pointcount = p_points.size();
 	ERR_FAIL_COND(pointcount < 3);
@@ -1645,6 +2011,8 @@ void RendererCanvasCull::canvas_item_add_triangle_array(RID p_item, const Vector
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
 
+	_canvas_item_child_index_dirty(canvas_item);
+
 	int vertex_count = p_points.size();
 	ERR_FAIL_COND(vertex_count == 0);
 	ERR_FAIL_COND(!p_colors.is_empty() && p_colors.size() != vertex_count && p_colors.size() != 1);
@@ -1666,6 +2034,8 @@ void RendererCanvasCull::canvas_item_add_set_transform(RID p_item, const Transfo
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
 
+	_canvas_item_child_index_dirty(canvas_item);
+
 	Item::CommandTransform *tr = canvas_item->alloc_command<Item::CommandTransform>();
 	ERR_FAIL_NULL(tr);
 	tr->xform = p_transform;
@@ -1674,6 +2044,9 @@ void RendererCanvasCull::canvas_item_add_set_transform(RID p_item, const Transfo
 void RendererCanvasCull::canvas_item_add_mesh(RID p_item, const RID &p_mesh, const Transform2D &p_transform, const Color &p_modulate, RID p_texture) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+
+	_canvas_item_child_index_dirty(canvas_item);
+
 	ERR_FAIL_COND(!p_mesh.is_valid());
 
 	Item::CommandMesh *m = canvas_item->alloc_command<Item::CommandMesh>();
@@ -1694,6 +2067,8 @@ void RendererCanvasCull::canvas_item_add_particles(RID p_item, RID p_particles,
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
 
+	_canvas_item_child_index_dirty(canvas_item);
+
 	Item::CommandParticles *part = canvas_item->alloc_command<Item::CommandParticles>();
 	ERR_FAIL_NULL(part);
 	part->particles = p_particles;
@@ -1708,6 +2083,8 @@ void RendererCanvasCull::canvas_item_add_multimesh(RID p_item, RID p_mesh, RID p
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
 
+	_canvas_item_child_index_dirty(canvas_item);
+
 	Item::CommandMultiMesh *mm = canvas_item->alloc_command<Item::CommandMultiMesh>();
 	ERR_FAIL_NULL(mm);
 	mm->multimesh = p_mesh;
@@ -1719,6 +2096,8 @@ void RendererCanvasCull::canvas_item_add_clip_ignore(RID p_item, bool p_ignore)
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
 
+	_canvas_item_child_index_dirty(canvas_item);
+
 	Item::CommandClipIgnore *ci = canvas_item->alloc_command<Item::CommandClipIgnore>();
 	ERR_FAIL_NULL(ci);
 	ci->ignore = p_ignore;
@@ -1728,6 +2107,8 @@ void RendererCanvasCull::canvas_item_add_animation_slice(RID p_item, double p_an
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
 
+	_canvas_item_child_index_dirty(canvas_item);
+
 	Item::CommandAnimationSlice *as = canvas_item->alloc_command<Item::CommandAnimationSlice>();
 	ERR_FAIL_NULL(as);
 	as->animation_length = p_animation_length;
@@ -1740,7 +2121,13 @@ void RendererCanvasCull::canvas_item_set_sort_children_by_y(RID p_item, bool p_e
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
 
+	_canvas_item_child_index_dirty(canvas_item);
+
 	canvas_item->sort_y = p_enable;
+	if (!p_enable && canvas_item->ysort_cache) {
+		memdelete(canvas_item->ysort_cache);
+		canvas_item->ysort_cache = nullptr;
+	}
 
 	_mark_ysort_dirty(canvas_item, canvas_item_owner);
 }
@@ -1764,6 +2151,9 @@ void RendererCanvasCull::canvas_item_set_z_as_relative_to_parent(RID p_item, boo
 void RendererCanvasCull::canvas_item_attach_skeleton(RID p_item, RID p_skeleton) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+
+	_canvas_item_child_index_dirty(canvas_item);
+
 	if (canvas_item->skeleton == p_skeleton) {
 		return;
 	}
@@ -1793,6 +2183,9 @@ void RendererCanvasCull::canvas_item_attach_skeleton(RID p_item, RID p_skeleton)
 void RendererCanvasCull::canvas_item_set_copy_to_backbuffer(RID p_item, bool p_enable, const Rect2 &p_rect) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+
+	_canvas_item_child_index_dirty(canvas_item);
+
 	if (p_enable && (canvas_item->copy_back_buffer == nullptr)) {
 		canvas_item->copy_back_buffer = memnew(RendererCanvasRender::Item::CopyBackBuffer);
 	}
@@ -1811,6 +2204,8 @@ void RendererCanvasCull::canvas_item_clear(RID p_item) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
 
+	_canvas_item_child_index_dirty(canvas_item);
+
 	canvas_item->clear();
 #ifdef DEBUG_ENABLED
 	if (debug_redraw) {
@@ -1856,6 +2251,8 @@ void RendererCanvasCull::canvas_item_set_visibility_notifier(RID p_item, bool p_
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
 
+	_canvas_item_child_index_dirty(canvas_item);
+
 	if (p_enable) {
 		if (!canvas_item->visibility_notifier) {
 			canvas_item->visibility_notifier = visibility_notifier_allocator.alloc();
@@ -1897,6 +2294,9 @@ void RendererCanvasCull::canvas_item_reset_physics_interpolation(RID p_item) {
 void RendererCanvasCull::canvas_item_transform_physics_interpolation(RID p_item, const Transform2D &p_transform) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+
+	_canvas_item_child_index_dirty(canvas_item);
+
 	canvas_item->xform_prev = p_transform * canvas_item->xform_prev;
 	canvas_item->xform_curr = p_transform * canvas_item->xform_curr;
 }
@@ -1905,6 +2305,8 @@ void RendererCanvasCull::canvas_item_set_canvas_group_mode(RID p_item, RS::Canva
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
 
+	_canvas_item_child_index_dirty(canvas_item);
+
 	if (p_mode == RS::CANVAS_GROUP_MODE_DISABLED) {
 		if (canvas_item->canvas_group != nullptr) {
 			memdelete(canvas_item->canvas_group);
@@ -2421,6 +2823,8 @@ bool RendererCanvasCull::free(RID p_rid) {
 			} else if (canvas_item_owner.owns(canvas_item->parent)) {
 				Item *item_owner = canvas_item_owner.get_or_null(canvas_item->parent);
 				item_owner->child_items.erase(canvas_item);
+				_canvas_item_child_index_remove(item_owner, canvas_item);
+				_canvas_item_child_index_dirty(item_owner);
 
 				if (item_owner->sort_y) {
 					_mark_ysort_dirty(item_owner, canvas_item_owner);
@@ -2428,6 +2832,11 @@ bool RendererCanvasCull::free(RID p_rid) {
 			}
 		}
 
+		_canvas_item_free_child_index(canvas_item);
+		if (canvas_item->ysort_cache) {
+			memdelete(canvas_item->ysort_cache);
+		}
+
 		for (int i = 0; i < canvas_item->child_items.size(); i++) {
 			canvas_item->child_items[i]->parent = RID();
 		}
@@ -2609,6 +3018,9 @@ RendererCanvasCull::RendererCanvasCull() {
 
 	debug_redraw_time = GLOBAL_DEF("debug/canvas_items/debug_redraw_time", 1.0);
 	debug_redraw_color = GLOBAL_DEF("debug/canvas_items/debug_redraw_color", Color(1.0, 0.2, 0.2, 0.5));
+
+	child_index_min_children = GLOBAL_DEF(PropertyInfo(Variant::INT, "rendering/2d/culling/spatial_index_min_children", PROPERTY_HINT_RANGE, "0,65536,1,or_greater"), 0);
+	threaded_cull_min_children = GLOBAL_DEF(PropertyInfo(Variant::INT, "rendering/2d/culling/threaded_cull_min_children", PROPERTY_HINT_RANGE, "0,65536,1,or_greater"), 0);
 }
 
 RendererCanvasCull::~RendererCanvasCull() {
@@ -31,11 +31,16 @@
 #ifndef RENDERER_CANVAS_CULL_H
 #define RENDERER_CANVAS_CULL_H
 
+#include "core/math/dynamic_bvh.h"
+#include "core/object/worker_thread_pool.h"
+#include "core/os/spin_lock.h"
 #include "core/templates/paged_allocator.h"
 #include "renderer_compositor.h"
 #include "renderer_viewport.h"
 
 class RendererCanvasCull {
+	friend class TestRendererCanvasCullInternalsAccessor;
+
 public:
 	struct Item : public RendererCanvasRender::Item {
 		RID parent; // canvas it belongs to
@@ -72,6 +77,28 @@ public:
 
 		VisibilityNotifierData *visibility_notifier = nullptr;
 
+		// Spatial index over the rects of the children in this item's local space,
+		// so items with many children only visit the ones that can be on screen.
+		struct ChildIndex {
+			DynamicBVH bvh;
+			HashSet<Item *> dirty_items; // Children whose rect must be refreshed before culling.
+			HashSet<Item *> unindexed_items; // Children that can't be culled by their own rect.
+		};
+
+		ChildIndex *child_index = nullptr;
+		ChildIndex *parent_child_index = nullptr; // The parent's child index, if it has one.
+		DynamicBVH::ID child_index_id; // Leaf in the parent's child index.
+
+		// Sorting state kept between frames when this item y-sorts its children.
+		struct YSortCache {
+			LocalVector<Item *> items; // Items in collection order, so ysort_index indexes them.
+			LocalVector<uint64_t> records; // Quantized Y key in the high bits, ysort_index in the low bits.
+			LocalVector<uint64_t> scratch;
+			LocalVector<uint32_t> order; // ysort_index of each item in the last sorted order.
+		};
+
+		YSortCache *ysort_cache = nullptr;
+
 		Item() {
 			children_order_dirty = true;
 			E = nullptr;
@@ -96,16 +123,6 @@ public:
 		}
 	};
 
-	struct ItemPtrSort {
-		_FORCE_INLINE_ bool operator()(const Item *p_left, const Item *p_right) const {
-			if (Math::is_equal_approx(p_left->ysort_pos.y, p_right->ysort_pos.y)) {
-				return p_left->ysort_index < p_right->ysort_index;
-			}
-
-			return p_left->ysort_pos.y < p_right->ysort_pos.y;
-		}
-	};
-
 	struct LightOccluderPolygon {
 		bool active;
 		Rect2 aabb;
@@ -182,6 +199,56 @@ public:
 
 	PagedAllocator<Item::VisibilityNotifierData> visibility_notifier_allocator;
 	SelfList<Item::VisibilityNotifierData>::List visibility_notifier_list;
+	SpinLock visibility_notifier_list_lock;
+	// RenderingServerDefault::changes is a plain int, and threaded culling can request redraws concurrently.
+	SpinLock redraw_request_lock;
+
+	int child_index_min_children = 0;
+
+	static bool _is_canvas_item_indexable(const Item *p_item);
+	_FORCE_INLINE_ void _canvas_item_child_index_dirty(Item *p_item) {
+		if (p_item->parent_child_index) {
+			p_item->parent_child_index->dirty_items.insert(p_item);
+		}
+	}
+	void _canvas_item_child_index_remove(Item *p_parent, Item *p_item);
+	void _canvas_item_free_child_index(Item *p_item);
+	bool _cull_child_index(Item *p_item, const Transform2D &p_xform, const Rect2 &p_clip_rect, LocalVector<Item *> &r_items);
+
+	static uint32_t _ysort_key(real_t p_y);
+	static void _radix_sort_ysort_records(uint64_t *p_records, uint64_t *p_scratch, uint32_t p_count);
+	void _sort_ysort_items(Item *p_owner, Item **r_items, int p_count);
+
+	// Sibling subtrees are independent, so with enough of them they are culled in
+	// chunks on the WorkerThreadPool, each into its own z lists. The chunk lists
+	// are then appended in sibling order, giving the same draw order as a serial cull.
+	struct ThreadedCullData {
+		Item **items = nullptr;
+		uint32_t item_count = 0;
+		uint32_t chunk_count = 0;
+		bool skip_behind = false;
+		Transform2D xform;
+		Rect2 clip_rect;
+		Color modulate;
+		int z = 0;
+		Item *canvas_clip = nullptr;
+		Item *material_owner = nullptr;
+		uint32_t canvas_cull_mask = 0;
+		Point2 repeat_size;
+		int repeat_times = 1;
+		RendererCanvasRender::Item *repeat_source_item = nullptr;
+	};
+
+	int threaded_cull_min_children = 0;
+	bool threaded_cull_active = false;
+	LocalVector<RendererCanvasRender::Item *> threaded_cull_z_lists;
+	LocalVector<Item *> threaded_cull_root_items;
+
+	_FORCE_INLINE_ bool _use_threaded_cull(int p_child_count) const {
+		return threaded_cull_min_children > 0 && p_child_count >= threaded_cull_min_children && !threaded_cull_active;
+	}
+	void _cull_canvas_items_chunk(uint32_t p_chunk, ThreadedCullData *p_data);
+	void _cull_canvas_items_threaded(ThreadedCullData &p_data, RendererCanvasRender::Item **r_z_list, RendererCanvasRender::Item **r_z_last_list);
 
 	_FORCE_INLINE_ void _attach_canvas_item_for_draw(Item *ci, Item *p_canvas_clip, RendererCanvasRender::Item **r_z_list, RendererCanvasRender::Item **r_z_last_list, const Transform2D &p_transform, const Rect2 &p_clip_rect, Rect2 p_global_rect, const Color &modulate, int p_z, RendererCanvasCull::Item *p_material_owner, bool p_use_canvas_group, RendererCanvasRender::Item *r_canvas_group_from);
 
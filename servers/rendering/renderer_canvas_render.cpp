@@ -32,6 +32,7 @@
 #include "servers/rendering/rendering_server_globals.h"
 
 RendererCanvasRender *RendererCanvasRender::singleton = nullptr;
+BinaryMutex RendererCanvasRender::Item::storage_rect_mutex;
 
 const Rect2 &RendererCanvasRender::Item::get_rect() const {
 	if (custom_rect || (!rect_dirty && !update_when_visible && skeleton == RID())) {
@@ -82,6 +83,7 @@ const Rect2 &RendererCanvasRender::Item::get_rect() const {
 			} break;
 			case Item::Command::TYPE_MESH: {
 				const Item::CommandMesh *mesh = static_cast<const Item::CommandMesh *>(c);
+				MutexLock lock(storage_rect_mutex);
 				AABB aabb = RSG::mesh_storage->mesh_get_aabb(mesh->mesh, skeleton);
 
 				r = Rect2(aabb.position.x, aabb.position.y, aabb.size.x, aabb.size.y);
@@ -89,6 +91,7 @@ const Rect2 &RendererCanvasRender::Item::get_rect() const {
 			} break;
 			case Item::Command::TYPE_MULTIMESH: {
 				const Item::CommandMultiMesh *multimesh = static_cast<const Item::CommandMultiMesh *>(c);
+				MutexLock lock(storage_rect_mutex);
 				AABB aabb = RSG::mesh_storage->multimesh_get_aabb(multimesh->multimesh);
 
 				r = Rect2(aabb.position.x, aabb.position.y, aabb.size.x, aabb.size.y);
@@ -97,6 +100,7 @@ const Rect2 &RendererCanvasRender::Item::get_rect() const {
 			case Item::Command::TYPE_PARTICLES: {
 				const Item::CommandParticles *particles_cmd = static_cast<const Item::CommandParticles *>(c);
 				if (particles_cmd->particles.is_valid()) {
+					MutexLock lock(storage_rect_mutex);
 					AABB aabb = RSG::particles_storage->particles_get_aabb(particles_cmd->particles);
 					r = Rect2(aabb.position.x, aabb.position.y, aabb.size.x, aabb.size.y);
 				}
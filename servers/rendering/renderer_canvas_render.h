@@ -368,6 +368,10 @@ public:
 
 		Rect2 global_rect_cache;
 
+		// Storage AABB queries may update caches in the storage, so they are
+		// serialized when canvas items are culled on several threads.
+		static BinaryMutex storage_rect_mutex;
+
 		const Rect2 &get_rect() const;
 
 		Command *commands = nullptr;
@@ -33,6 +33,7 @@
 #include "core/config/project_settings.h"
 #include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
+#include "raster_occlusion_cull.h"
 #include "rendering_light_culler.h"
 #include "rendering_server_constants.h"
 #include "rendering_server_default.h"
@@ -1038,6 +1039,17 @@ void RendererSceneCull::instance_set_transform(RID p_instance, const Transform3D
 #endif
 }
 
+void RendererSceneCull::instance_set_transforms(const Vector<RID> &p_instances, const Vector<Transform3D> &p_transforms) {
+	ERR_FAIL_COND(p_instances.size() != p_transforms.size());
+
+	const RID *instances = p_instances.ptr();
+	const Transform3D *transforms = p_transforms.ptr();
+	for (int i = 0; i < p_instances.size(); i++) {
+		ERR_CONTINUE(!instance_owner.owns(instances[i]));
+		instance_set_transform(instances[i], transforms[i]);
+	}
+}
+
 void RendererSceneCull::instance_set_interpolated(RID p_instance, bool p_interpolated) {
 	Instance *instance = instance_owner.get_or_null(p_instance);
 	ERR_FAIL_NULL(instance);
@@ -1841,8 +1853,12 @@ void RendererSceneCull::_update_instance(Instance *p_instance) {
 		geom->geometry_instance->set_transform(*instance_xform, p_instance->aabb, p_instance->transformed_aabb);
 	}
 
+	_update_instance_indexer(p_instance, *instance_xform);
+}
+
+void RendererSceneCull::_update_instance_indexer(Instance *p_instance, const Transform3D &p_transform) {
 	// note: we had to remove is equal approx check here, it meant that det == 0.000004 won't work, which is the case for some of our scenes.
-	if (p_instance->scenario == nullptr || !p_instance->visible || instance_xform->basis.determinant() == 0) {
+	if (p_instance->scenario == nullptr || !p_instance->visible || p_transform.basis.determinant() == 0) {
 		p_instance->prev_transformed_aabb = p_instance->transformed_aabb;
 		return;
 	}
@@ -2923,23 +2939,45 @@ void RendererSceneCull::_scene_cull(CullData &cull_data, InstanceCullResult &cul
 	Transform3D inv_cam_transform = cull_data.cam_transform.inverse();
 	float z_near = cull_data.camera_matrix->get_z_near();
 
+	// Frustum tests are resolved a block of instances at a time, so the
+	// per-instance loop below only reads back a bit from these masks.
+	InstanceBoundsBlock bounds_block;
+	uint64_t block_from = p_from;
+	uint64_t block_to = p_from;
+	uint32_t frustum_mask = 0;
+	uint32_t cascade_frustum_masks[RendererSceneRender::MAX_DIRECTIONAL_LIGHTS][RendererSceneRender::MAX_DIRECTIONAL_LIGHT_CASCADES];
+
 	for (uint64_t i = p_from; i < p_to; i++) {
 		bool mesh_visible = false;
 
+		if (i == block_to) {
+			block_from = i;
+			block_to = MIN(p_to, block_from + InstanceBoundsBlock::SIZE);
+			bounds_block.load(cull_data.scenario->instance_aabbs, block_from, block_to);
+
+			frustum_mask = bounds_block.in_frustum(cull_data.cull->frustum);
+			for (uint32_t j = 0; j < cull_data.cull->shadow_count; j++) {
+				for (uint32_t k = 0; k < cull_data.cull->shadows[j].cascade_count; k++) {
+					cascade_frustum_masks[j][k] = bounds_block.in_frustum(cull_data.cull->shadows[j].cascades[k].frustum);
+				}
+			}
+		}
+		const uint32_t block_bit = 1u << (i - block_from);
+
 		InstanceData &idata = cull_data.scenario->instance_data[i];
 		uint32_t visibility_flags = idata.flags & (InstanceData::FLAG_VISIBILITY_DEPENDENCY_HIDDEN_CLOSE_RANGE | InstanceData::FLAG_VISIBILITY_DEPENDENCY_HIDDEN | InstanceData::FLAG_VISIBILITY_DEPENDENCY_FADE_CHILDREN);
 		int32_t visibility_check = -1;
 
 #define HIDDEN_BY_VISIBILITY_CHECKS (visibility_flags == InstanceData::FLAG_VISIBILITY_DEPENDENCY_HIDDEN_CLOSE_RANGE || visibility_flags == InstanceData::FLAG_VISIBILITY_DEPENDENCY_HIDDEN)
 #define LAYER_CHECK (cull_data.visible_layers & idata.layer_mask)
-#define IN_FRUSTUM(f) (cull_data.scenario->instance_aabbs[i].in_frustum(f))
+#define IN_FRUSTUM(m) ((m) & block_bit)
 #define VIS_RANGE_CHECK ((idata.visibility_index == -1) || _visibility_range_check<false>(cull_data.scenario->instance_visibility[idata.visibility_index], cull_data.cam_transform.origin, cull_data.visibility_viewport_mask) == 0)
 #define VIS_PARENT_CHECK (_visibility_parent_check(cull_data, idata))
 #define VIS_CHECK (visibility_check < 0 ? (visibility_check = (visibility_flags != InstanceData::FLAG_VISIBILITY_DEPENDENCY_NEEDS_CHECK || (VIS_RANGE_CHECK && VIS_PARENT_CHECK))) : visibility_check)
 #define OCCLUSION_CULLED (cull_data.occlusion_buffer != nullptr && (cull_data.scenario->instance_data[i].flags & InstanceData::FLAG_IGNORE_OCCLUSION_CULLING) == 0 && cull_data.occlusion_buffer->is_occluded(cull_data.scenario->instance_aabbs[i].bounds, cull_data.cam_transform.origin, inv_cam_transform, *cull_data.camera_matrix, z_near, cull_data.scenario->instance_data[i].occlusion_timeout))
 
 		if (!HIDDEN_BY_VISIBILITY_CHECKS) {
-			if ((LAYER_CHECK && IN_FRUSTUM(cull_data.cull->frustum) && VIS_CHECK && !OCCLUSION_CULLED) || (cull_data.scenario->instance_data[i].flags & InstanceData::FLAG_IGNORE_ALL_CULLING)) {
+			if ((LAYER_CHECK && IN_FRUSTUM(frustum_mask) && VIS_CHECK && !OCCLUSION_CULLED) || (cull_data.scenario->instance_data[i].flags & InstanceData::FLAG_IGNORE_ALL_CULLING)) {
 				uint32_t base_type = idata.flags & InstanceData::FLAG_BASE_TYPE_MASK;
 				if (base_type == RS::INSTANCE_LIGHT) {
 					cull_result.lights.push_back(idata.instance);
@@ -3134,7 +3172,7 @@ void RendererSceneCull::_scene_cull(CullData &cull_data, InstanceCullResult &cul
 					continue;
 				}
 				for (uint32_t k = 0; k < cull_data.cull->shadows[j].cascade_count; k++) {
-					if (IN_FRUSTUM(cull_data.cull->shadows[j].cascades[k].frustum) && VIS_CHECK) {
+					if (IN_FRUSTUM(cascade_frustum_masks[j][k]) && VIS_CHECK) {
 						uint32_t base_type = idata.flags & InstanceData::FLAG_BASE_TYPE_MASK;
 
 						if (((1 << base_type) & RS::INSTANCE_GEOMETRY_MASK) && idata.flags & InstanceData::FLAG_CAST_SHADOWS && LAYER_CHECK) {
@@ -4278,7 +4316,85 @@ void RendererSceneCull::_update_dirty_instance(Instance *p_instance) {
 	p_instance->update_dependencies = false;
 }
 
+bool RendererSceneCull::_instance_can_update_transform_threaded(const Instance *p_instance) const {
+	if (p_instance->update_dependencies) {
+		return false;
+	}
+	if (p_instance->base_type != RS::INSTANCE_MESH && p_instance->base_type != RS::INSTANCE_MULTIMESH) {
+		return false;
+	}
+
+	const InstanceGeometryData *geom = static_cast<const InstanceGeometryData *>(p_instance->base_data);
+	if (!geom->geometry_instance) {
+		return false;
+	}
+
+	// Lightmap capture updates go through the renderer, keep those on the regular path.
+	return !(!p_instance->lightmap && geom->lightmap_captures.size()) && p_instance->lightmap_sh.is_empty();
+}
+
+void RendererSceneCull::_update_instance_transform_threaded(uint32_t p_index, Instance **p_instances) {
+	Instance *instance = p_instances[p_index];
+	instance->version++;
+	instance->transformed_aabb = instance->transform.xform(instance->aabb);
+
+	InstanceGeometryData *geom = static_cast<InstanceGeometryData *>(instance->base_data);
+	geom->geometry_instance->set_transform(instance->transform, instance->aabb, instance->transformed_aabb);
+}
+
+void RendererSceneCull::_update_dirty_instance_transforms() {
+	_instance_transform_update_list.clear();
+
+	// Storage queries for the base AABB are not thread safe, so those still happen here.
+	SelfList<Instance> *E = _instance_update_list.first();
+	while (E) {
+		Instance *instance = E->self();
+		E = E->next();
+
+		if (!_instance_can_update_transform_threaded(instance)) {
+			continue;
+		}
+		if (instance->update_aabb) {
+			_update_instance_aabb(instance);
+			instance->update_aabb = false;
+		}
+		if (!instance->aabb.has_surface()) {
+			continue;
+		}
+
+		_instance_update_list.remove(&instance->update_item);
+		_instance_transform_update_list.push_back(instance);
+	}
+
+	const uint32_t instance_count = _instance_transform_update_list.size();
+	if (instance_count > thread_cull_threshold) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &RendererSceneCull::_update_instance_transform_threaded, _instance_transform_update_list.ptr(), instance_count, -1, true, SNAME("RenderUpdateInstanceTransforms"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		for (uint32_t i = 0; i < instance_count; i++) {
+			_update_instance_transform_threaded(i, _instance_transform_update_list.ptr());
+		}
+	}
+
+	// Lights, indexers and pairing are shared between instances and are updated afterwards, in order.
+	for (Instance *instance : _instance_transform_update_list) {
+		InstanceGeometryData *geom = static_cast<InstanceGeometryData *>(instance->base_data);
+		if (geom->can_cast_shadows) {
+			for (const Instance *F : geom->lights) {
+				InstanceLightData *light = static_cast<InstanceLightData *>(F->base_data);
+				light->make_shadow_dirty();
+			}
+		}
+
+		_update_instance_indexer(instance, instance->transform);
+	}
+}
+
 void RendererSceneCull::update_dirty_instances() {
+	if (_instance_update_list.first()) {
+		_update_dirty_instance_transforms();
+	}
+
 	while (_instance_update_list.first()) {
 		_update_dirty_instance(_instance_update_list.first()->self());
 	}
@@ -4528,7 +4644,8 @@ RendererSceneCull::RendererSceneCull() {
 	thread_cull_threshold = MAX(thread_cull_threshold, (uint32_t)WorkerThreadPool::get_singleton()->get_thread_count()); //make sure there is at least one thread per CPU
 	RendererSceneOcclusionCull::HZBuffer::occlusion_jitter_enabled = GLOBAL_GET("rendering/occlusion_culling/jitter_projection");
 
-	dummy_occlusion_culling = memnew(RendererSceneOcclusionCull);
+	// Software fallback, replaced by modules which register a faster implementation.
+	raster_occlusion_culling = memnew(RasterOcclusionCull);
 
 	light_culler = memnew(RenderingLightCuller);
 
@@ -4554,8 +4671,8 @@ RendererSceneCull::~RendererSceneCull() {
 	}
 	scene_cull_result_threads.clear();
 
-	if (dummy_occlusion_culling) {
-		memdelete(dummy_occlusion_culling);
+	if (raster_occlusion_culling) {
+		memdelete(raster_occlusion_culling);
 	}
 
 	if (light_culler) {
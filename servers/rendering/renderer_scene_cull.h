@@ -129,7 +129,7 @@ public:
 
 	/* VISIBILITY NOTIFIER API */
 
-	RendererSceneOcclusionCull *dummy_occlusion_culling = nullptr;
+	RendererSceneOcclusionCull *raster_occlusion_culling = nullptr;
 
 	/* SCENARIO API */
 
@@ -254,6 +254,62 @@ public:
 		}
 	};
 
+	struct InstanceBoundsBlock {
+		// Transposes a run of consecutive InstanceBounds into one array per bound
+		// component, so a frustum plane can be tested against every lane of the
+		// block with straight-line code the compiler can vectorize.
+		// The result matches InstanceBounds::in_frustum() for each lane.
+
+		static constexpr uint32_t SIZE = 8;
+
+		real_t bounds[6][SIZE];
+		uint32_t count = 0;
+
+		_ALWAYS_INLINE_ void load(const PagedArray<InstanceBounds> &p_instance_aabbs, uint64_t p_from, uint64_t p_to) {
+			count = p_to - p_from;
+			for (uint32_t i = 0; i < count; i++) {
+				const InstanceBounds &instance_bounds = p_instance_aabbs[p_from + i];
+				for (uint32_t j = 0; j < 6; j++) {
+					bounds[j][i] = instance_bounds.bounds[j];
+				}
+			}
+			for (uint32_t i = count; i < SIZE; i++) {
+				for (uint32_t j = 0; j < 6; j++) {
+					bounds[j][i] = 0.0;
+				}
+			}
+		}
+
+		// Returns a bitmask with bit N set when lane N is inside the frustum.
+		_ALWAYS_INLINE_ uint32_t in_frustum(const Frustum &p_frustum) const {
+			uint8_t inside[SIZE];
+			for (uint32_t i = 0; i < SIZE; i++) {
+				inside[i] = 1;
+			}
+
+			for (uint32_t i = 0; i < p_frustum.plane_count; i++) {
+				const Plane &plane = p_frustum.planes_ptr[i];
+				const PlaneSign &plane_sign = p_frustum.plane_signs_ptr[i];
+				// The sign of each normal component is the same for all lanes,
+				// so picking the nearest corner is a choice of arrays, not a branch per lane.
+				const real_t *x = bounds[plane_sign.signs[0]];
+				const real_t *y = bounds[plane_sign.signs[1]];
+				const real_t *z = bounds[plane_sign.signs[2]];
+
+				for (uint32_t j = 0; j < SIZE; j++) {
+					const real_t distance = plane.normal.x * x[j] + plane.normal.y * y[j] + plane.normal.z * z[j] - plane.d;
+					inside[j] &= !(distance >= 0.0);
+				}
+			}
+
+			uint32_t mask = 0;
+			for (uint32_t i = 0; i < SIZE; i++) {
+				mask |= uint32_t(inside[i]) << i;
+			}
+			return mask & ((1u << count) - 1);
+		}
+	};
+
 	struct InstanceVisibilityNotifierData;
 
 	struct InstanceData {
@@ -654,6 +710,10 @@ public:
 	SelfList<Instance>::List _instance_update_list;
 	void _instance_queue_update(Instance *p_instance, bool p_update_aabb, bool p_update_dependencies = false);
 
+	// Dirty geometry instances that only need their transform updated, split from the update list
+	// so their transformed AABBs can be computed on multiple threads.
+	LocalVector<Instance *> _instance_transform_update_list;
+
 	struct InstanceGeometryData : public InstanceBaseData {
 		RenderGeometryInstance *geometry_instance = nullptr;
 		HashSet<Instance *> lights;
@@ -1059,6 +1119,7 @@ public:
 	virtual void instance_set_layer_mask(RID p_instance, uint32_t p_mask);
 	virtual void instance_set_pivot_data(RID p_instance, float p_sorting_offset, bool p_use_aabb_center);
 	virtual void instance_set_transform(RID p_instance, const Transform3D &p_transform);
+	virtual void instance_set_transforms(const Vector<RID> &p_instances, const Vector<Transform3D> &p_transforms);
 	virtual void instance_set_interpolated(RID p_instance, bool p_interpolated);
 	virtual void instance_reset_physics_interpolation(RID p_instance);
 	virtual void instance_attach_object_instance_id(RID p_instance, ObjectID p_id);
@@ -1106,8 +1167,12 @@ public:
 	virtual uint32_t get_pipeline_compilations(RS::PipelineSource p_source);
 
 	_FORCE_INLINE_ void _update_instance(Instance *p_instance);
+	_FORCE_INLINE_ void _update_instance_indexer(Instance *p_instance, const Transform3D &p_transform);
 	_FORCE_INLINE_ void _update_instance_aabb(Instance *p_instance);
 	_FORCE_INLINE_ void _update_dirty_instance(Instance *p_instance);
+	_FORCE_INLINE_ bool _instance_can_update_transform_threaded(const Instance *p_instance) const;
+	void _update_instance_transform_threaded(uint32_t p_index, Instance **p_instances);
+	void _update_dirty_instance_transforms();
 	_FORCE_INLINE_ void _update_instance_lightmap_captures(Instance *p_instance);
 	void _unpair_instance(Instance *p_instance);
 
@@ -104,6 +104,23 @@ PackedInt64Array RenderingServer::_instances_cull_convex_bind(const TypedArray<P
 	return to_int_array(ids);
 }
 
+void RenderingServer::_instance_set_transforms_bind(const TypedArray<RID> &p_instances, const TypedArray<Transform3D> &p_transforms) {
+	ERR_FAIL_COND(p_instances.size() != p_transforms.size());
+
+	Vector<RID> instances;
+	Vector<Transform3D> transforms;
+	instances.resize(p_instances.size());
+	transforms.resize(p_transforms.size());
+	RID *instances_ptrw = instances.ptrw();
+	Transform3D *transforms_ptrw = transforms.ptrw();
+	for (int i = 0; i < p_instances.size(); ++i) {
+		instances_ptrw[i] = p_instances[i];
+		transforms_ptrw[i] = p_transforms[i];
+	}
+
+	instance_set_transforms(instances, transforms);
+}
+
 RID RenderingServer::get_test_texture() {
 	if (test_texture.is_valid()) {
 		return test_texture;
@@ -3129,6 +3146,7 @@ void RenderingServer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("instance_set_layer_mask", "instance", "mask"), &RenderingServer::instance_set_layer_mask);
 	ClassDB::bind_method(D_METHOD("instance_set_pivot_data", "instance", "sorting_offset", "use_aabb_center"), &RenderingServer::instance_set_pivot_data);
 	ClassDB::bind_method(D_METHOD("instance_set_transform", "instance", "transform"), &RenderingServer::instance_set_transform);
+	ClassDB::bind_method(D_METHOD("instance_set_transforms", "instances", "transforms"), &RenderingServer::_instance_set_transforms_bind);
 	ClassDB::bind_method(D_METHOD("instance_set_interpolated", "instance", "interpolated"), &RenderingServer::instance_set_interpolated);
 	ClassDB::bind_method(D_METHOD("instance_reset_physics_interpolation", "instance"), &RenderingServer::instance_reset_physics_interpolation);
 	ClassDB::bind_method(D_METHOD("instance_attach_object_instance_id", "instance", "id"), &RenderingServer::instance_attach_object_instance_id);
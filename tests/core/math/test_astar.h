@@ -32,6 +32,7 @@
 #define TEST_ASTAR_H
 
 #include "core/math/a_star.h"
+#include "core/math/a_star_grid_2d.h"
 
 #include "tests/test_macros.h"
 
@@ -85,6 +86,69 @@ TEST_CASE("[AStar3D] ABCX path") {
 	CHECK(path[3] == ABCX::C);
 }
 
+TEST_CASE("[AStar3D] Compact graph") {
+	ABCX abcx;
+	abcx.compact();
+	CHECK(abcx.is_compacted());
+	Vector<int64_t> path = abcx.get_id_path(ABCX::X, ABCX::C);
+	REQUIRE(path.size() == 4);
+	CHECK(path[0] == ABCX::X);
+	CHECK(path[1] == ABCX::A);
+	CHECK(path[2] == ABCX::B);
+	CHECK(path[3] == ABCX::C);
+
+	// Grid graphs with dense and sparse ids, searched with and without compaction.
+	for (int64_t id_step : { 1, 3 }) {
+		AStar3D regular;
+		AStar3D compacted;
+		const int64_t size = 8;
+		for (AStar3D *a : { &regular, &compacted }) {
+			for (int64_t y = 0; y < size; y++) {
+				for (int64_t x = 0; x < size; x++) {
+					const int64_t id = (y * size + x) * id_step;
+					a->add_point(id, Vector3(x, y, 0));
+					if (x > 0) {
+						a->connect_points(id, id - id_step);
+					}
+					if (y > 0) {
+						a->connect_points(id, id - size * id_step);
+					}
+				}
+			}
+		}
+		compacted.compact();
+		REQUIRE(compacted.is_compacted());
+		CHECK_FALSE(regular.is_compacted());
+
+		const int64_t last_id = (size * size - 1) * id_step;
+		CHECK(compacted.get_id_path(0, last_id) == regular.get_id_path(0, last_id));
+		CHECK(compacted.get_point_path(0, last_id) == regular.get_point_path(0, last_id));
+		CHECK(compacted.get_id_path(0, last_id).size() == size * 2 - 1);
+
+		// Wall off the last column except for its last point.
+		for (AStar3D *a : { &regular, &compacted }) {
+			for (int64_t y = 0; y < size - 1; y++) {
+				a->set_point_disabled((y * size + size - 2) * id_step);
+			}
+			a->set_point_weight_scale(size * id_step, 4.0);
+		}
+		CHECK(compacted.is_compacted());
+		const int64_t corner_id = (size - 1) * id_step;
+		CHECK(compacted.get_id_path(0, corner_id) == regular.get_id_path(0, corner_id));
+		CHECK(compacted.get_id_path(0, corner_id).size() == size * 3 - 2);
+
+		for (AStar3D *a : { &regular, &compacted }) {
+			a->set_point_disabled(((size - 1) * size + size - 2) * id_step);
+		}
+		CHECK(compacted.get_id_path(0, corner_id).is_empty());
+		CHECK(compacted.get_id_path(0, corner_id, true) == regular.get_id_path(0, corner_id, true));
+
+		// Changing the topology reverts to the regular storage.
+		compacted.disconnect_points(0, id_step);
+		CHECK_FALSE(compacted.is_compacted());
+	}
+}
+
 TEST_CASE("[AStar3D] Add/Remove") {
 	AStar3D a;
 
@@ -357,6 +421,58 @@ TEST_CASE("[Stress][AStar3D] Find paths") {
 		CHECK_MESSAGE(match, "Found all paths.");
 	}
 }
+
+TEST_CASE("[AStarGrid2D] Find paths") {
+	Ref<AStarGrid2D> a;
+	a.instantiate();
+	a->set_region(Rect2i(0, 0, 5, 5));
+	a->set_cell_size(Size2(16, 16));
+	a->set_diagonal_mode(AStarGrid2D::DIAGONAL_MODE_NEVER);
+	a->set_default_compute_heuristic(AStarGrid2D::HEURISTIC_MANHATTAN);
+	a->set_default_estimate_heuristic(AStarGrid2D::HEURISTIC_MANHATTAN);
+	a->update();
+	CHECK_FALSE(a->is_dirty());
+	CHECK(a->get_point_position(Vector2i(3, 2)) == Vector2(48, 32));
+	CHECK(a->get_point_data_in_region(Rect2i(-1, -1, 3, 3)).size() == 4);
+
+	// Wall with a single gap at the bottom.
+	a->fill_solid_region(Rect2i(2, 0, 1, 4));
+	CHECK(a->is_point_solid(Vector2i(2, 3)));
+	CHECK_FALSE(a->is_point_solid(Vector2i(2, 4)));
+
+	TypedArray<Vector2i> path = a->get_id_path(Vector2i(0, 0), Vector2i(4, 0));
+	REQUIRE(path.size() == 13);
+	CHECK(path[0] == Variant(Vector2i(0, 0)));
+	CHECK(path.has(Vector2i(2, 4)));
+	CHECK(path[12] == Variant(Vector2i(4, 0)));
+	CHECK(a->get_point_path(Vector2i(0, 0), Vector2i(4, 0)).size() == 13);
+
+	// Repeated queries must not see the state of the previous ones.
+	CHECK(a->get_id_path(Vector2i(4, 0), Vector2i(0, 0)).size() == 13);
+	CHECK(a->get_id_path(Vector2i(1, 1), Vector2i(1, 1)).size() == 1);
+
+	a->set_jumping_enabled(true);
+	path = a->get_id_path(Vector2i(0, 0), Vector2i(4, 0));
+	REQUIRE(path.size() >= 2);
+	CHECK(path[0] == Variant(Vector2i(0, 0)));
+	CHECK(path[path.size() - 1] == Variant(Vector2i(4, 0)));
+	a->set_jumping_enabled(false);
+
+	// Weighted cells are avoided when a cheaper detour exists.
+	a->fill_weight_scale_region(Rect2i(1, 1, 1, 3), 10.0);
+	CHECK(a->get_point_weight_scale(Vector2i(1, 2)) == doctest::Approx(10.0));
+	path = a->get_id_path(Vector2i(0, 0), Vector2i(4, 0));
+	CHECK(path.size() == 13);
+	CHECK(path.has(Vector2i(0, 3)));
+	CHECK_FALSE(path.has(Vector2i(1, 2)));
+
+	// Close the gap.
+	a->set_point_solid(Vector2i(2, 4));
+	CHECK(a->get_id_path(Vector2i(0, 0), Vector2i(4, 0)).is_empty());
+	path = a->get_id_path(Vector2i(0, 0), Vector2i(4, 0), true);
+	REQUIRE_FALSE(path.is_empty());
+	CHECK(path[path.size() - 1] == Variant(Vector2i(1, 0)));
+}
 } // namespace TestAStar
 
 #endif // TEST_ASTAR_H
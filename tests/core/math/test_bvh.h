@@ -0,0 +1,156 @@
+/**************************************************************************/
+/*  test_bvh.h                                                            */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_BVH_H
+#define TEST_BVH_H
+
+#include "core/math/bvh.h"
+#include "core/math/random_number_generator.h"
+
+#include "tests/test_macros.h"
+
+namespace TestBVH {
+
+struct TestItem {
+	int index = 0;
+};
+
+class TestPairFunction {
+public:
+	static bool user_pair_check(const TestItem *p_a, const TestItem *p_b) {
+		return true;
+	}
+};
+
+class TestCullFunction {
+public:
+	static bool user_cull_check(const TestItem *p_a, const TestItem *p_b) {
+		return true;
+	}
+};
+
+typedef BVH_Manager<TestItem, 2, true, 32, TestPairFunction, TestCullFunction> TestBVH;
+
+// Pair and unpair callbacks, in the order they were received.
+struct PairLog {
+	LocalVector<Vector3i> events; // Pair (1) or unpair (0), then the indices of both items.
+};
+
+static void *_pair_callback(void *p_userdata, uint32_t p_id_a, TestItem *p_item_a, int p_subindex_a, uint32_t p_id_b, TestItem *p_item_b, int p_subindex_b) {
+	((PairLog *)p_userdata)->events.push_back(Vector3i(1, p_item_a->index, p_item_b->index));
+	return nullptr;
+}
+
+static void _unpair_callback(void *p_userdata, uint32_t p_id_a, TestItem *p_item_a, int p_subindex_a, uint32_t p_id_b, TestItem *p_item_b, int p_subindex_b, void *p_pair_data) {
+	((PairLog *)p_userdata)->events.push_back(Vector3i(0, p_item_a->index, p_item_b->index));
+}
+
+static AABB _random_aabb(RandomNumberGenerator &p_rng) {
+	return AABB(Vector3(p_rng.randf_range(-25, 25), p_rng.randf_range(-25, 25), p_rng.randf_range(-25, 25)), Vector3(p_rng.randf_range(1, 8), p_rng.randf_range(1, 8), p_rng.randf_range(1, 8)));
+}
+
+TEST_CASE("[BVH] Parallel pairing gives the same callbacks as serial pairing") {
+	const int item_count = 512;
+	LocalVector<TestItem> items;
+	items.resize(item_count);
+	for (int i = 0; i < item_count; i++) {
+		items[i].index = i;
+	}
+
+	// Same scene in both, only the pairing path differs.
+	TestBVH serial;
+	TestBVH parallel;
+	serial.params_set_parallel_pairing_threshold(0);
+	parallel.params_set_parallel_pairing_threshold(1);
+	PairLog serial_log;
+	PairLog parallel_log;
+	serial.set_pair_callback(_pair_callback, &serial_log);
+	serial.set_unpair_callback(_unpair_callback, &serial_log);
+	parallel.set_pair_callback(_pair_callback, &parallel_log);
+	parallel.set_unpair_callback(_unpair_callback, &parallel_log);
+
+	RandomNumberGenerator rng;
+	rng.set_seed(42);
+	LocalVector<AABB> aabbs;
+	LocalVector<BVHHandle> serial_handles;
+	LocalVector<BVHHandle> parallel_handles;
+	for (int i = 0; i < item_count; i++) {
+		aabbs.push_back(_random_aabb(rng));
+		serial_handles.push_back(serial.create(&items[i], true, 0, 1, aabbs[i]));
+		parallel_handles.push_back(parallel.create(&items[i], true, 0, 1, aabbs[i]));
+	}
+	serial.update();
+	parallel.update();
+
+	// Enough moved items to go over the threshold in a single update.
+	for (int round = 0; round < 4; round++) {
+		for (int i = 0; i < item_count; i++) {
+			if (rng.randi() % 2) {
+				aabbs[i] = _random_aabb(rng);
+				serial.move(serial_handles[i], aabbs[i]);
+				parallel.move(parallel_handles[i], aabbs[i]);
+			}
+		}
+		serial.update();
+		parallel.update();
+	}
+
+	// Removed items unpair from everything they touched.
+	for (int i = 0; i < item_count; i += 3) {
+		serial.erase(serial_handles[i]);
+		parallel.erase(parallel_handles[i]);
+	}
+	serial.update();
+	parallel.update();
+
+	int pair_count = 0;
+	int unpair_count = 0;
+	for (const Vector3i &event : serial_log.events) {
+		if (event.x) {
+			pair_count++;
+		} else {
+			unpair_count++;
+		}
+	}
+	// Make sure both kinds of callbacks happened, so the comparison below means something.
+	CHECK(pair_count > item_count);
+	CHECK(unpair_count > item_count / 3);
+
+	REQUIRE(parallel_log.events.size() == serial_log.events.size());
+	bool same_events = true;
+	for (uint32_t i = 0; i < serial_log.events.size(); i++) {
+		same_events = same_events && parallel_log.events[i] == serial_log.events[i];
+	}
+	CHECK_MESSAGE(same_events, "Parallel pairing should send the same callbacks in the same order as serial pairing.");
+}
+
+} // namespace TestBVH
+
+#endif // TEST_BVH_H
@@ -173,6 +173,184 @@ TEST_CASE("[WorkerThreadPool] Run a yielding daemon as the only hope for other t
 	CHECK_MESSAGE(all_needed_yield, "All legit tasks should have needed the daemon yielding to run.");
 }
 
+static void static_yield_once_test(void *p_arg) {
+	WorkerThreadPool::get_singleton()->yield();
+	counter[0].increment();
+}
+
+TEST_CASE("[WorkerThreadPool] Yield-over notifications racing task start are not lost") {
+	counter.clear();
+	counter.resize(1);
+
+	// Notify right after adding, so the notification lands before, while or after the task starts.
+	// A lost notification leaves the task yielding forever, which hangs this test.
+	// Only one task yields at a time: a thread yielding in a nested task shares its
+	// yield-over flag with the outer one, which is not what this is testing.
+	const int rounds = 2000;
+	for (int round = 0; round < rounds; round++) {
+		WorkerThreadPool::TaskID task_id = WorkerThreadPool::get_singleton()->add_native_task(static_yield_once_test, nullptr, true);
+		WorkerThreadPool::get_singleton()->notify_yield_over(task_id);
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(task_id);
+	}
+
+	CHECK(counter[0].get() == rounds);
+}
+
+static void static_nested_leaf_test(void *p_arg) {
+	counter[0].increment();
+}
+
+static void static_nested_test(void *p_arg) {
+	// Posted from a pool thread, so these go to its local queue and get stolen by the others.
+	// Waiting on individual tasks is collaborative, so this can't starve the pool.
+	const int leaves = (int)(uintptr_t)p_arg;
+	WorkerThreadPool::TaskID *leaf_tasks = (WorkerThreadPool::TaskID *)alloca(sizeof(WorkerThreadPool::TaskID) * (leaves + 1));
+	for (int i = 0; i < leaves; i++) {
+		leaf_tasks[i] = WorkerThreadPool::get_singleton()->add_native_task(static_nested_leaf_test, nullptr, true);
+	}
+	leaf_tasks[leaves] = WorkerThreadPool::get_singleton()->add_native_task(static_test, (void *)(uintptr_t)1, true);
+	for (int i = 0; i <= leaves; i++) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(leaf_tasks[i]);
+	}
+}
+
+TEST_CASE("[WorkerThreadPool] Nested tasks posted from pool threads") {
+	const int outer_count = 256;
+	const int leaf_count = 64;
+
+	counter.clear();
+	counter.resize(2);
+
+	LocalVector<WorkerThreadPool::TaskID> tasks;
+	tasks.resize(outer_count);
+	for (int i = 0; i < outer_count; i++) {
+		tasks[i] = WorkerThreadPool::get_singleton()->add_native_task(static_nested_test, (void *)(uintptr_t)leaf_count, true);
+	}
+	for (int i = 0; i < outer_count; i++) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(tasks[i]);
+	}
+
+	// Each outer task adds one per leaf, plus two from the last nested task.
+	CHECK(counter[0].get() == outer_count * (leaf_count + 2));
+	CHECK(counter[1].get() == outer_count);
+}
+
+struct StealTestData {
+	static const int LEAVES = 32;
+	int poster_thread_index = -1;
+	SafeNumeric<int> done;
+	int leaf_thread_index[LEAVES] = {};
+	bool timed_out = false;
+};
+
+static void static_steal_leaf_test(void *p_arg) {
+	StealTestData *data = (StealTestData *)p_arg;
+	data->leaf_thread_index[data->done.postincrement()] = WorkerThreadPool::get_singleton()->get_thread_index();
+}
+
+static void static_steal_poster_test(void *p_arg) {
+	StealTestData *data = (StealTestData *)p_arg;
+	data->poster_thread_index = WorkerThreadPool::get_singleton()->get_thread_index();
+
+	WorkerThreadPool::TaskID leaf_tasks[StealTestData::LEAVES];
+	for (int i = 0; i < StealTestData::LEAVES; i++) {
+		leaf_tasks[i] = WorkerThreadPool::get_singleton()->add_native_task(static_steal_leaf_test, data, true);
+	}
+
+	// Not waiting collaboratively, so this thread never pops its own queue:
+	// the leaves can only run if other threads steal them.
+	uint64_t timeout_usec = OS::get_singleton()->get_ticks_usec() + 10000000;
+	while (data->done.get() != StealTestData::LEAVES) {
+		if (OS::get_singleton()->get_ticks_usec() > timeout_usec) {
+			data->timed_out = true;
+			break;
+		}
+		OS::get_singleton()->delay_usec(100);
+	}
+
+	for (int i = 0; i < StealTestData::LEAVES; i++) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(leaf_tasks[i]);
+	}
+}
+
+TEST_CASE("[WorkerThreadPool] Tasks posted from a pool thread are stolen by idle threads") {
+	if (WorkerThreadPool::get_singleton()->get_thread_count() < 2) {
+		return;
+	}
+
+	StealTestData data;
+	WorkerThreadPool::TaskID poster = WorkerThreadPool::get_singleton()->add_native_task(static_steal_poster_test, &data, true);
+	WorkerThreadPool::get_singleton()->wait_for_task_completion(poster);
+
+	CHECK(data.poster_thread_index != -1);
+	CHECK_FALSE_MESSAGE(data.timed_out, "Idle threads should have stolen the tasks.");
+	CHECK(data.done.get() == StealTestData::LEAVES);
+
+	bool all_stolen = true;
+	for (int i = 0; i < StealTestData::LEAVES; i++) {
+		if (data.leaf_thread_index[i] == data.poster_thread_index) {
+			all_stolen = false;
+		}
+	}
+	CHECK_MESSAGE(all_stolen, "Tasks should have run on threads other than the one that posted them.");
+}
+
+static void static_stage_test(void *p_arg, uint32_t p_index) {
+	// Each stage must only see the previous one fully done.
+	const int stage = (int)(uintptr_t)p_arg;
+	if (counter[p_index].get() == stage) {
+		counter[p_index].increment();
+	}
+}
+
+static void static_final_test(void *p_arg) {
+	const int elements = (int)(uintptr_t)p_arg;
+	for (int i = 0; i < elements; i++) {
+		if (counter[i].get() != 2) {
+			return;
+		}
+	}
+	exit.set();
+}
+
+TEST_CASE("[WorkerThreadPool] Run tasks and group tasks after their dependencies") {
+	for (int iterations = 0; iterations < 100; iterations++) {
+		const int count = Math::pow(2.0f, Math::random(0.0f, 5.0f));
+		const int tasks = Math::pow(2.0f, Math::random(0.0f, 5.0f));
+		const bool low_priority = Math::rand() % 2;
+
+		exit.clear();
+		counter.clear();
+		counter.resize(count);
+
+		Vector<WorkerThreadPool::TaskID> dependencies;
+		WorkerThreadPool::GroupID first = WorkerThreadPool::get_singleton()->add_native_group_task(static_stage_test, (void *)0, count, tasks, !low_priority);
+		dependencies.push_back(first);
+		WorkerThreadPool::GroupID second = WorkerThreadPool::get_singleton()->add_native_dependent_group_task(static_stage_test, (void *)1, count, dependencies, tasks, !low_priority);
+		dependencies.push_back(second);
+		WorkerThreadPool::TaskID last = WorkerThreadPool::get_singleton()->add_native_dependent_task(static_final_test, (void *)(uintptr_t)count, dependencies, !low_priority);
+
+		// Only the end of the chain is awaited before the rest.
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(last);
+		CHECK(exit.is_set());
+
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(first);
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(second);
+	}
+
+	// Dependencies already awaited count as completed.
+	exit.clear();
+	counter.clear();
+	counter.resize(1);
+	WorkerThreadPool::GroupID done = WorkerThreadPool::get_singleton()->add_native_group_task(static_stage_test, (void *)0, 1);
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(done);
+	Vector<WorkerThreadPool::TaskID> dependencies;
+	dependencies.push_back(done);
+	WorkerThreadPool::GroupID after = WorkerThreadPool::get_singleton()->add_native_dependent_group_task(static_stage_test, (void *)1, 1, dependencies);
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(after);
+	CHECK(counter[0].get() == 2);
+}
+
 } // namespace TestWorkerThreadPool
 
 #endif // TEST_WORKER_THREAD_POOL_H
@@ -0,0 +1,164 @@
+/**************************************************************************/
+/*  test_node_3d.h                                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_NODE_3D_H
+#define TEST_NODE_3D_H
+
+#include "scene/3d/node_3d.h"
+#include "scene/main/window.h"
+
+#include "tests/test_macros.h"
+
+class TestNode3DInternalsAccessor {
+public:
+	static bool is_global_transform_dirty(const Node3D *p_node) {
+		return p_node->_test_dirty_bits(Node3D::DIRTY_GLOBAL_TRANSFORM);
+	}
+	static bool is_transform_pending(const Node3D *p_node) {
+		return p_node->data.transform_pending;
+	}
+	static bool is_transform_notification_queued(const Node3D *p_node) {
+		return p_node->xform_change.in_list();
+	}
+	// The cached value, without resolving it like get_global_transform() does.
+	static Transform3D cached_global_transform(const Node3D *p_node) {
+		return p_node->data.global_transform;
+	}
+};
+
+namespace TestNode3D {
+
+TEST_CASE("[SceneTree][Node3D] Batched global transform updates") {
+	typedef TestNode3DInternalsAccessor Accessor;
+
+	Node3D::set_global_transform_batching_enabled(true);
+
+	Node3D *main = memnew(Node3D);
+	Node3D *outer = memnew(Node3D);
+	Node3D *inner = memnew(Node3D);
+	Node3D *top_level = memnew(Node3D);
+	SceneTree::get_singleton()->get_root()->add_child(main);
+	main->add_child(outer);
+	outer->add_child(inner);
+	outer->add_child(top_level);
+	top_level->set_as_top_level(true);
+
+	const Transform3D main_transform = Transform3D(Basis(Vector3(0, 1, 0), Math_PI * 0.5), Vector3(1, 0, 0));
+	const Transform3D outer_transform = Transform3D(Basis().scaled(Vector3(2, 2, 2)), Vector3(0, 2, 0));
+	const Transform3D inner_transform = Transform3D(Basis(), Vector3(0, 0, 3));
+	const Transform3D top_level_transform = Transform3D(Basis(), Vector3(4, 5, 6));
+	main->set_transform(main_transform);
+	outer->set_transform(outer_transform);
+	inner->set_transform(inner_transform);
+	top_level->set_transform(top_level_transform);
+
+	Node3D::update_global_transforms();
+
+	// The batch itself resolves and caches the global transforms.
+	CHECK_FALSE(Accessor::is_global_transform_dirty(main));
+	CHECK_FALSE(Accessor::is_global_transform_dirty(outer));
+	CHECK_FALSE(Accessor::is_global_transform_dirty(inner));
+	CHECK_FALSE(Accessor::is_global_transform_dirty(top_level));
+	CHECK(Accessor::cached_global_transform(main).is_equal_approx(main_transform));
+	CHECK(Accessor::cached_global_transform(outer).is_equal_approx(main_transform * outer_transform));
+	CHECK(Accessor::cached_global_transform(inner).is_equal_approx(main_transform * outer_transform * inner_transform));
+	CHECK(Accessor::cached_global_transform(top_level).is_equal_approx(top_level_transform));
+
+	SUBCASE("Changing a transform should only queue the node until the batch") {
+		inner->set_notify_transform(true);
+		const Transform3D new_main_transform = Transform3D(Basis(), Vector3(-1, 0, 0));
+		main->set_transform(new_main_transform);
+
+		CHECK(Accessor::is_transform_pending(main));
+		CHECK_FALSE(Accessor::is_global_transform_dirty(outer));
+		CHECK_FALSE(Accessor::is_global_transform_dirty(inner));
+		CHECK_FALSE(Accessor::is_transform_notification_queued(inner));
+
+		Node3D::update_global_transforms();
+
+		CHECK_FALSE(Accessor::is_transform_pending(main));
+		CHECK_FALSE(Accessor::is_global_transform_dirty(inner));
+		CHECK(Accessor::is_transform_notification_queued(inner));
+		CHECK(Accessor::cached_global_transform(outer).is_equal_approx(new_main_transform * outer_transform));
+		CHECK(Accessor::cached_global_transform(inner).is_equal_approx(new_main_transform * outer_transform * inner_transform));
+		CHECK(Accessor::cached_global_transform(top_level).is_equal_approx(top_level_transform));
+	}
+
+	SUBCASE("Reading a global transform before the batch should see the pending change") {
+		const Transform3D new_outer_transform = Transform3D(Basis(), Vector3(0, -2, 0));
+		outer->set_transform(new_outer_transform);
+
+		CHECK(inner->get_global_transform().is_equal_approx(main_transform * new_outer_transform * inner_transform));
+		CHECK_FALSE(Accessor::is_transform_pending(outer));
+
+		Node3D::update_global_transforms();
+
+		CHECK_FALSE(Accessor::is_global_transform_dirty(inner));
+		CHECK(Accessor::cached_global_transform(inner).is_equal_approx(main_transform * new_outer_transform * inner_transform));
+	}
+
+	SUBCASE("Scale should be removed when disabled") {
+		outer->set_disable_scale(true);
+		outer->set_transform(outer_transform);
+
+		Node3D::update_global_transforms();
+
+		const Transform3D unscaled_outer_transform = Transform3D(Basis(), outer_transform.origin);
+		CHECK(Accessor::cached_global_transform(outer).is_equal_approx(main_transform * unscaled_outer_transform));
+		CHECK(Accessor::cached_global_transform(inner).is_equal_approx(main_transform * unscaled_outer_transform * inner_transform));
+	}
+
+	SUBCASE("Moved nodes should be resolved against their new parent") {
+		outer->remove_child(inner);
+		top_level->add_child(inner);
+
+		Node3D::update_global_transforms();
+
+		CHECK_FALSE(Accessor::is_global_transform_dirty(inner));
+		CHECK(Accessor::cached_global_transform(inner).is_equal_approx(top_level_transform * inner_transform));
+
+		const Transform3D new_top_level_transform = Transform3D(Basis(), Vector3(-4, -5, -6));
+		top_level->set_transform(new_top_level_transform);
+		main->set_transform(Transform3D());
+
+		Node3D::update_global_transforms();
+
+		CHECK(Accessor::cached_global_transform(inner).is_equal_approx(new_top_level_transform * inner_transform));
+		CHECK(Accessor::cached_global_transform(outer).is_equal_approx(outer_transform));
+	}
+
+	memdelete(main);
+
+	Node3D::set_global_transform_batching_enabled(false);
+}
+
+} // namespace TestNode3D
+
+#endif // TEST_NODE_3D_H
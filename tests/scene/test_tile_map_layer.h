@@ -0,0 +1,324 @@
+/**************************************************************************/
+/*  test_tile_map_layer.h                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_TILE_MAP_LAYER_H
+#define TEST_TILE_MAP_LAYER_H
+
+#include "scene/2d/tile_map_layer.h"
+#include "scene/main/window.h"
+#include "scene/resources/image_texture.h"
+#include "servers/rendering/renderer_canvas_cull.h"
+#include "servers/rendering/rendering_server_globals.h"
+
+#include "tests/test_macros.h"
+
+class TestTileMapLayerInternalsAccessor {
+public:
+	static LocalVector<RID> get_quadrant_canvas_items(const TileMapLayer *p_layer, const Vector2i &p_quadrant_coords) {
+		const Ref<RenderingQuadrant> *rendering_quadrant = p_layer->rendering_quadrant_map.getptr(p_quadrant_coords);
+		return rendering_quadrant ? (*rendering_quadrant)->canvas_items : LocalVector<RID>();
+	}
+	// The canvas items of all quadrants, with quadrants ordered by their X coordinate.
+	static LocalVector<RID> get_canvas_items(const TileMapLayer *p_layer) {
+		LocalVector<Vector2i> quadrant_coords;
+		for (const KeyValue<Vector2i, Ref<RenderingQuadrant>> &kv : p_layer->rendering_quadrant_map) {
+			quadrant_coords.push_back(kv.key);
+		}
+		quadrant_coords.sort();
+		LocalVector<RID> canvas_items;
+		for (const Vector2i &coords : quadrant_coords) {
+			for (const RID &ci : get_quadrant_canvas_items(p_layer, coords)) {
+				canvas_items.push_back(ci);
+			}
+		}
+		return canvas_items;
+	}
+	static int get_draw_index(const RID &p_canvas_item) {
+		return static_cast<RendererCanvasCull *>(RSG::canvas)->canvas_item_owner.get_or_null(p_canvas_item)->index;
+	}
+	static int get_z_index(const RID &p_canvas_item) {
+		return static_cast<RendererCanvasCull *>(RSG::canvas)->canvas_item_owner.get_or_null(p_canvas_item)->z_index;
+	}
+};
+
+namespace TestTileMapLayer {
+
+TEST_CASE("[SceneTree][TileMapLayer] Chunk coordinates") {
+	TileMapLayer *layer = memnew(TileMapLayer);
+
+	CHECK(layer->get_chunk_coords(Vector2i(0, 0)) == Vector2i(0, 0));
+	CHECK(layer->get_chunk_coords(Vector2i(31, 31)) == Vector2i(0, 0));
+	CHECK(layer->get_chunk_coords(Vector2i(32, 64)) == Vector2i(1, 2));
+	CHECK(layer->get_chunk_coords(Vector2i(-1, -32)) == Vector2i(-1, -1));
+	CHECK(layer->get_chunk_coords(Vector2i(-33, 5)) == Vector2i(-2, 0));
+
+	memdelete(layer);
+}
+
+TEST_CASE("[SceneTree][TileMapLayer] Tile map data") {
+	TileMapLayer *layer = memnew(TileMapLayer);
+	layer->set_cell(Vector2i(0, 0), 1, Vector2i(2, 3), 4);
+	layer->set_cell(Vector2i(-1, 40), 0, Vector2i(5, 0), 0);
+	layer->set_cell(Vector2i(100, -100), 2, Vector2i(0, 1), 2);
+
+	SUBCASE("Data survives a round trip") {
+		TileMapLayer *copy = memnew(TileMapLayer);
+		copy->set_tile_map_data_from_array(layer->get_tile_map_data_as_array());
+
+		CHECK(copy->get_used_cells().size() == 3);
+		CHECK(copy->get_cell_source_id(Vector2i(0, 0)) == 1);
+		CHECK(copy->get_cell_atlas_coords(Vector2i(0, 0)) == Vector2i(2, 3));
+		CHECK(copy->get_cell_alternative_tile(Vector2i(0, 0)) == 4);
+		CHECK(copy->get_cell_atlas_coords(Vector2i(-1, 40)) == Vector2i(5, 0));
+		CHECK(copy->get_cell_source_id(Vector2i(100, -100)) == 2);
+		CHECK(copy->get_cell_alternative_tile(Vector2i(100, -100)) == 2);
+
+		memdelete(copy);
+	}
+
+	SUBCASE("Data in the old per-cell format can still be loaded") {
+		// Format 0, then x, y, source, atlas x, atlas y and alternative as 16-bit values.
+		const uint8_t data[] = { 0, 0, 0xfe, 0xff, 3, 0, 1, 0, 2, 0, 3, 0, 4, 0 };
+		Vector<uint8_t> data_array;
+		data_array.resize(sizeof(data));
+		memcpy(data_array.ptrw(), data, sizeof(data));
+
+		TileMapLayer *copy = memnew(TileMapLayer);
+		copy->set_tile_map_data_from_array(data_array);
+
+		CHECK(copy->get_used_cells().size() == 1);
+		CHECK(copy->get_cell_source_id(Vector2i(-2, 3)) == 1);
+		CHECK(copy->get_cell_atlas_coords(Vector2i(-2, 3)) == Vector2i(2, 3));
+		CHECK(copy->get_cell_alternative_tile(Vector2i(-2, 3)) == 4);
+
+		memdelete(copy);
+	}
+
+	SUBCASE("Chunks can be saved, unloaded and loaded back") {
+		CHECK(layer->get_used_chunks().size() == 3);
+		CHECK(layer->get_chunk_data(Vector2i(5, 5)).is_empty());
+
+		Vector<uint8_t> chunk_data = layer->get_chunk_data(Vector2i(-1, 1));
+		CHECK_FALSE(chunk_data.is_empty());
+
+		layer->unload_chunk(Vector2i(-1, 1));
+		CHECK(layer->get_cell_source_id(Vector2i(-1, 40)) == TileSet::INVALID_SOURCE);
+		CHECK(layer->get_used_chunks().size() == 2);
+
+		layer->set_chunk_data(Vector2i(-1, 1), chunk_data);
+		CHECK(layer->get_cell_source_id(Vector2i(-1, 40)) == 0);
+		CHECK(layer->get_cell_atlas_coords(Vector2i(-1, 40)) == Vector2i(5, 0));
+
+		// Chunk data is relative to the chunk it is set to.
+		layer->set_chunk_data(Vector2i(0, 0), chunk_data);
+		CHECK(layer->get_cell_source_id(Vector2i(31, 8)) == 0);
+		CHECK(layer->get_cell_source_id(Vector2i(0, 0)) == TileSet::INVALID_SOURCE);
+	}
+
+	SUBCASE("Invalid chunk data leaves the chunk unchanged") {
+		Vector<uint8_t> chunk_data = layer->get_chunk_data(Vector2i(-1, 1));
+
+		ERR_PRINT_OFF;
+		// Missing the last byte of the cell.
+		Vector<uint8_t> truncated = chunk_data;
+		truncated.resize(truncated.size() - 1);
+		layer->set_chunk_data(Vector2i(0, 0), truncated);
+		CHECK(layer->get_cell_source_id(Vector2i(0, 0)) == 1);
+
+		// Cell outside of its chunk. The header is 2 bytes of format and 6 bytes of chunk header.
+		Vector<uint8_t> out_of_chunk = chunk_data;
+		out_of_chunk.write[8] = 32;
+		layer->set_chunk_data(Vector2i(0, 0), out_of_chunk);
+		CHECK(layer->get_cell_source_id(Vector2i(0, 0)) == 1);
+
+		// Unsupported format.
+		Vector<uint8_t> old_format = chunk_data;
+		old_format.write[0] = 0;
+		layer->set_chunk_data(Vector2i(0, 0), old_format);
+		CHECK(layer->get_cell_source_id(Vector2i(0, 0)) == 1);
+		ERR_PRINT_ON;
+	}
+
+	memdelete(layer);
+}
+
+TEST_CASE("[SceneTree][TileMapLayer] Inactive chunks keep their cells packed") {
+	TileMapLayer *layer = memnew(TileMapLayer);
+	layer->set_cell(Vector2i(1, 2), 1, Vector2i(2, 3), 4);
+	layer->set_cell(Vector2i(-1, 40), 0, Vector2i(5, 0), 0);
+	Vector<uint8_t> chunk_data = layer->get_chunk_data(Vector2i(0, 0));
+	Vector<uint8_t> tile_map_data = layer->get_tile_map_data_as_array();
+
+	layer->set_chunk_active(Vector2i(0, 0), false);
+	CHECK_FALSE(layer->is_chunk_active(Vector2i(0, 0)));
+	CHECK(layer->is_chunk_active(Vector2i(-1, 1)));
+
+	// The cells are not kept with a runtime state anymore.
+	for (const KeyValue<Vector2i, CellData> &E : layer->get_tile_map_layer_data()) {
+		CHECK((layer->get_chunk_coords(E.key) != Vector2i(0, 0) || E.value.cell.source_id == TileSet::INVALID_SOURCE));
+	}
+
+	SUBCASE("Cells can be read") {
+		CHECK(layer->get_cell_source_id(Vector2i(1, 2)) == 1);
+		CHECK(layer->get_cell_atlas_coords(Vector2i(1, 2)) == Vector2i(2, 3));
+		CHECK(layer->get_cell_alternative_tile(Vector2i(1, 2)) == 4);
+		CHECK(layer->get_cell_source_id(Vector2i(2, 1)) == TileSet::INVALID_SOURCE);
+		CHECK(layer->get_used_cells().size() == 2);
+		CHECK(layer->get_used_cells_by_id(1).size() == 1);
+		CHECK(layer->get_used_chunks().size() == 2);
+		CHECK(layer->get_used_rect() == Rect2i(-1, 2, 3, 39));
+		CHECK(layer->get_chunk_data(Vector2i(0, 0)) == chunk_data);
+		CHECK(layer->get_tile_map_data_as_array().size() == tile_map_data.size());
+	}
+
+	SUBCASE("Cells can be modified") {
+		layer->set_cell(Vector2i(31, 31), 2, Vector2i(0, 1), 0);
+		layer->erase_cell(Vector2i(1, 2));
+		CHECK(layer->get_cell_source_id(Vector2i(31, 31)) == 2);
+		CHECK(layer->get_cell_source_id(Vector2i(1, 2)) == TileSet::INVALID_SOURCE);
+		CHECK_FALSE(layer->get_tile_map_layer_data().has(Vector2i(31, 31)));
+
+		layer->erase_cell(Vector2i(31, 31));
+		CHECK(layer->get_used_chunks().size() == 1);
+		CHECK(layer->get_chunk_data(Vector2i(0, 0)).is_empty());
+	}
+
+	SUBCASE("Activating the chunk restores its cells") {
+		layer->set_chunk_active(Vector2i(0, 0), true);
+		CHECK(layer->is_chunk_active(Vector2i(0, 0)));
+		const HashMap<Vector2i, CellData> &cells = layer->get_tile_map_layer_data();
+		REQUIRE(cells.has(Vector2i(1, 2)));
+		CHECK(cells[Vector2i(1, 2)].cell.source_id == 1);
+		CHECK(layer->get_chunk_data(Vector2i(0, 0)) == chunk_data);
+	}
+
+	SUBCASE("Loading the data makes the chunks active") {
+		TileMapLayer *copy = memnew(TileMapLayer);
+		copy->set_chunk_active(Vector2i(0, 0), false);
+		copy->set_tile_map_data_from_array(layer->get_tile_map_data_as_array());
+		CHECK(copy->is_chunk_active(Vector2i(0, 0)));
+		CHECK(copy->get_tile_map_layer_data().has(Vector2i(1, 2)));
+		CHECK(copy->get_cell_source_id(Vector2i(-1, 40)) == 0);
+		memdelete(copy);
+	}
+
+	memdelete(layer);
+}
+
+TEST_CASE("[SceneTree][TileMapLayer] Cells can be set in a batch") {
+	TileMapLayer *layer = memnew(TileMapLayer);
+	layer->set_cell(Vector2i(0, 0), 1, Vector2i(2, 3), 4);
+
+	PackedVector2Array coords = { Vector2(7, 7), Vector2(0, 0) };
+	PackedInt32Array source_ids = { 3, -1 };
+	PackedVector2Array atlas_coords = { Vector2(1, 1), Vector2(-1, -1) };
+	PackedInt32Array alternative_tiles = { 0, -1 };
+	layer->set_cells_batch(coords, source_ids, atlas_coords, alternative_tiles);
+
+	CHECK(layer->get_cell_source_id(Vector2i(7, 7)) == 3);
+	CHECK(layer->get_cell_atlas_coords(Vector2i(7, 7)) == Vector2i(1, 1));
+	CHECK(layer->get_cell_source_id(Vector2i(0, 0)) == TileSet::INVALID_SOURCE);
+
+	ERR_PRINT_OFF;
+	layer->set_cells_batch(coords, PackedInt32Array(), atlas_coords, alternative_tiles);
+	ERR_PRINT_ON;
+	CHECK(layer->get_cell_source_id(Vector2i(7, 7)) == 3);
+
+	memdelete(layer);
+}
+
+TEST_CASE("[SceneTree][TileMapLayer] Reused canvas items keep their draw order") {
+	// Two tiles, the second one on a higher z-index so it needs its own canvas item.
+	Ref<Image> image = Image::create_empty(32, 16, false, Image::FORMAT_RGBA8);
+	Ref<TileSetAtlasSource> atlas_source;
+	atlas_source.instantiate();
+	atlas_source->set_texture(ImageTexture::create_from_image(image));
+	atlas_source->create_tile(Vector2i(0, 0));
+	atlas_source->create_tile(Vector2i(1, 0));
+	atlas_source->get_tile_data(Vector2i(1, 0), 0)->set_z_index(1);
+	Ref<TileSet> tile_set;
+	tile_set.instantiate();
+	int source_id = tile_set->add_source(atlas_source);
+
+	TileMapLayer *layer = memnew(TileMapLayer);
+	layer->set_tile_set(tile_set);
+	SceneTree::get_singleton()->get_root()->add_child(layer);
+
+	const Vector2i low = Vector2i(0, 0);
+	const Vector2i high = Vector2i(1, 0);
+	// Checks the z-index of each canvas item of the first quadrant, and that the canvas items of all
+	// quadrants are drawn in order.
+	auto check_canvas_items = [&](const Vector<int> &p_z_indices) {
+		layer->update_internals();
+		const LocalVector<RID> canvas_items = TestTileMapLayerInternalsAccessor::get_canvas_items(layer);
+		const LocalVector<RID> first_quadrant = TestTileMapLayerInternalsAccessor::get_quadrant_canvas_items(layer, Vector2i(0, 0));
+		bool in_order = true;
+		for (uint32_t i = 1; i < canvas_items.size(); i++) {
+			in_order = in_order && TestTileMapLayerInternalsAccessor::get_draw_index(canvas_items[i - 1]) < TestTileMapLayerInternalsAccessor::get_draw_index(canvas_items[i]);
+		}
+		bool same_z_indices = first_quadrant.size() == uint32_t(p_z_indices.size());
+		for (uint32_t i = 0; same_z_indices && i < first_quadrant.size(); i++) {
+			same_z_indices = TestTileMapLayerInternalsAccessor::get_z_index(first_quadrant[i]) == p_z_indices[i];
+		}
+		return in_order && same_z_indices;
+	};
+
+	layer->set_cell(Vector2i(0, 0), source_id, low);
+	layer->set_cell(Vector2i(1, 0), source_id, low);
+	CHECK(check_canvas_items({ 0 }));
+
+	// A new group creates a canvas item.
+	layer->set_cell(Vector2i(1, 0), source_id, high);
+	CHECK(check_canvas_items({ 0, 1 }));
+
+	// A new quadrant after the first one.
+	layer->set_cell(Vector2i(20, 0), source_id, low);
+	CHECK(check_canvas_items({ 0, 1 }));
+
+	// The groups swap, so both canvas items are reused with the other z-index.
+	layer->set_cell(Vector2i(0, 0), source_id, high);
+	layer->set_cell(Vector2i(1, 0), source_id, low);
+	CHECK(check_canvas_items({ 1, 0 }));
+
+	// Three groups, so one more canvas item is created after the reused ones.
+	layer->set_cell(Vector2i(2, 0), source_id, high);
+	CHECK(check_canvas_items({ 1, 0, 1 }));
+
+	// A single group again, the extra canvas items are freed.
+	layer->set_cell(Vector2i(1, 0), source_id, high);
+	layer->erase_cell(Vector2i(2, 0));
+	CHECK(check_canvas_items({ 1 }));
+
+	memdelete(layer);
+}
+
+} // namespace TestTileMapLayer
+
+#endif // TEST_TILE_MAP_LAYER_H
@@ -0,0 +1,101 @@
+/**************************************************************************/
+/*  test_raster_occlusion_cull.h                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_RASTER_OCCLUSION_CULL_H
+#define TEST_RASTER_OCCLUSION_CULL_H
+
+#include "servers/rendering/raster_occlusion_cull.h"
+
+#include "tests/test_macros.h"
+
+namespace TestRasterOcclusionCull {
+
+static bool is_box_occluded(RasterOcclusionCull::HZBuffer *p_buffer, const AABB &p_box, const Projection &p_projection) {
+	const real_t bounds[6] = {
+		p_box.position.x, p_box.position.y, p_box.position.z,
+		p_box.position.x + p_box.size.x, p_box.position.y + p_box.size.y, p_box.position.z + p_box.size.z
+	};
+	uint64_t occlusion_timeout = 0;
+	return p_buffer->is_occluded(bounds, Vector3(), Transform3D(), p_projection, p_projection.get_z_near(), occlusion_timeout);
+}
+
+TEST_CASE("[RasterOcclusionCull] Boxes behind an occluder quad are occluded") {
+	RasterOcclusionCull occlusion_cull;
+
+	// A 10x10 quad facing a camera at the origin, which looks down -Z.
+	PackedVector3Array vertices = { Vector3(-5, -5, 0), Vector3(5, -5, 0), Vector3(5, 5, 0), Vector3(-5, 5, 0) };
+	PackedInt32Array indices = { 0, 1, 2, 0, 2, 3 };
+	RID occluder = occlusion_cull.occluder_allocate();
+	occlusion_cull.occluder_initialize(occluder);
+	occlusion_cull.occluder_set_mesh(occluder, vertices, indices);
+
+	const RID scenario = RID::from_uint64(1);
+	const RID instance = RID::from_uint64(2);
+	const RID buffer = RID::from_uint64(3);
+	occlusion_cull.add_scenario(scenario);
+	occlusion_cull.scenario_set_instance(scenario, instance, occluder, Transform3D(Basis(), Vector3(0, 0, -10)), true);
+	occlusion_cull.add_buffer(buffer);
+	occlusion_cull.buffer_set_scenario(buffer, scenario);
+	occlusion_cull.buffer_set_size(buffer, Vector2i(64, 64));
+
+	const AABB behind_box = AABB(Vector3(-1, -1, -21), Vector3(2, 2, 2));
+	const AABB in_front_box = AABB(Vector3(-1, -1, -7), Vector3(2, 2, 2));
+
+	SUBCASE("Perspective camera") {
+		Projection projection;
+		projection.set_perspective(60.0, 1.0, 0.1, 100.0);
+		occlusion_cull.buffer_update(buffer, Transform3D(), projection, false);
+		RasterOcclusionCull::HZBuffer *hz_buffer = occlusion_cull.buffer_get_ptr(buffer);
+
+		CHECK(is_box_occluded(hz_buffer, behind_box, projection));
+		CHECK_FALSE(is_box_occluded(hz_buffer, in_front_box, projection));
+		CHECK_FALSE_MESSAGE(is_box_occluded(hz_buffer, AABB(Vector3(9, -1, -21), Vector3(2, 2, 2)), projection), "A box only partially behind the quad should stay visible.");
+	}
+
+	SUBCASE("Orthogonal camera") {
+		Projection projection;
+		projection.set_orthogonal(-8.0, 8.0, -8.0, 8.0, 0.1, 100.0);
+		occlusion_cull.buffer_update(buffer, Transform3D(), projection, true);
+		RasterOcclusionCull::HZBuffer *hz_buffer = occlusion_cull.buffer_get_ptr(buffer);
+
+		CHECK(is_box_occluded(hz_buffer, behind_box, projection));
+		CHECK_FALSE(is_box_occluded(hz_buffer, in_front_box, projection));
+		CHECK_FALSE_MESSAGE(is_box_occluded(hz_buffer, AABB(Vector3(4, -1, -21), Vector3(2, 2, 2)), projection), "A box only partially behind the quad should stay visible.");
+	}
+
+	occlusion_cull.remove_buffer(buffer);
+	occlusion_cull.scenario_remove_instance(scenario, instance);
+	occlusion_cull.remove_scenario(scenario);
+	occlusion_cull.free_occluder(occluder);
+}
+
+} // namespace TestRasterOcclusionCull
+
+#endif // TEST_RASTER_OCCLUSION_CULL_H
@@ -0,0 +1,308 @@
+/**************************************************************************/
+/*  test_renderer_canvas_cull.h                                           */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_RENDERER_CANVAS_CULL_H
+#define TEST_RENDERER_CANVAS_CULL_H
+
+#include "servers/rendering/renderer_canvas_cull.h"
+#include "servers/rendering/rendering_server_globals.h"
+#include "servers/rendering_server.h"
+
+#include "tests/test_macros.h"
+
+class TestRendererCanvasCullInternalsAccessor {
+public:
+	// Culls the subtree of p_item and returns the items to draw, in draw order.
+	static LocalVector<RendererCanvasRender::Item *> cull(RendererCanvasCull *p_canvas_cull, RendererCanvasCull::Item *p_item, const Rect2 &p_clip_rect) {
+		RendererCanvasRender::Item *z_list[RendererCanvasCull::z_range] = {};
+		RendererCanvasRender::Item *z_last_list[RendererCanvasCull::z_range] = {};
+		p_canvas_cull->_cull_canvas_item(p_item, Transform2D(), p_clip_rect, Color(1, 1, 1, 1), 0, z_list, z_last_list, nullptr, nullptr, true, 0xFFFFFFFF, Point2(), 1, nullptr);
+
+		LocalVector<RendererCanvasRender::Item *> items;
+		for (int i = 0; i < RendererCanvasCull::z_range; i++) {
+			for (RendererCanvasRender::Item *item = z_list[i]; item; item = item->next) {
+				items.push_back(item);
+			}
+		}
+		return items;
+	}
+};
+
+namespace TestRendererCanvasCull {
+
+TEST_CASE("[SceneTree][RendererCanvasCull] Child index only returns children that can be on screen") {
+	RenderingServer *rs = RenderingServer::get_singleton();
+	RendererCanvasCull *canvas_cull = static_cast<RendererCanvasCull *>(RSG::canvas);
+
+	RID parent = rs->canvas_item_create();
+	RID on_screen = rs->canvas_item_create();
+	RID off_screen = rs->canvas_item_create();
+	const RID children[2] = { on_screen, off_screen };
+	for (const RID &child : children) {
+		rs->canvas_item_set_parent(child, parent);
+		rs->canvas_item_add_rect(child, Rect2(0, 0, 8, 8), Color(1, 1, 1));
+	}
+	rs->canvas_item_set_transform(on_screen, Transform2D(0, Vector2(10, 10)));
+	rs->canvas_item_set_transform(off_screen, Transform2D(0, Vector2(500, 500)));
+
+	RendererCanvasCull::Item *parent_item = canvas_cull->canvas_item_owner.get_or_null(parent);
+	RendererCanvasCull::Item *on_screen_item = canvas_cull->canvas_item_owner.get_or_null(on_screen);
+	RendererCanvasCull::Item *off_screen_item = canvas_cull->canvas_item_owner.get_or_null(off_screen);
+	const Rect2 clip_rect = Rect2(0, 0, 100, 100);
+
+	LocalVector<RendererCanvasCull::Item *> visible_items;
+	REQUIRE(canvas_cull->_cull_child_index(parent_item, Transform2D(), clip_rect, visible_items));
+	CHECK(visible_items.size() == 1);
+	CHECK(visible_items.has(on_screen_item));
+	CHECK_FALSE_MESSAGE(visible_items.has(off_screen_item), "Children outside of the viewport should be skipped.");
+
+	SUBCASE("Moved children should be picked up") {
+		rs->canvas_item_set_transform(off_screen, Transform2D(0, Vector2(50, 50)));
+		rs->canvas_item_set_transform(on_screen, Transform2D(0, Vector2(-300, 10)));
+
+		visible_items.clear();
+		REQUIRE(canvas_cull->_cull_child_index(parent_item, Transform2D(), clip_rect, visible_items));
+		CHECK(visible_items.size() == 1);
+		CHECK(visible_items.has(off_screen_item));
+	}
+
+	SUBCASE("Reparented children should be picked up") {
+		RID other_parent = rs->canvas_item_create();
+		rs->canvas_item_set_parent(off_screen, other_parent);
+
+		// Not tracked by the index while it belongs to another parent.
+		rs->canvas_item_set_transform(off_screen, Transform2D(0, Vector2(50, 50)));
+		CHECK(off_screen_item->parent_child_index == nullptr);
+
+		rs->canvas_item_set_parent(off_screen, parent);
+		CHECK(off_screen_item->parent_child_index == parent_item->child_index);
+
+		visible_items.clear();
+		REQUIRE(canvas_cull->_cull_child_index(parent_item, Transform2D(), clip_rect, visible_items));
+		CHECK(visible_items.size() == 2);
+		CHECK(visible_items.has(on_screen_item));
+		CHECK(visible_items.has(off_screen_item));
+
+		rs->free(other_parent);
+	}
+
+	SUBCASE("Moving the parent should not need a rebuild") {
+		visible_items.clear();
+		REQUIRE(canvas_cull->_cull_child_index(parent_item, Transform2D(0, Vector2(-480, -480)), clip_rect, visible_items));
+		CHECK(visible_items.size() == 1);
+		CHECK(visible_items.has(off_screen_item));
+	}
+
+	rs->free(on_screen);
+	rs->free(off_screen);
+	rs->free(parent);
+}
+
+TEST_CASE("[SceneTree][RendererCanvasCull] Threaded culling gives the same draw order as serial culling") {
+	RenderingServer *rs = RenderingServer::get_singleton();
+	RendererCanvasCull *canvas_cull = static_cast<RendererCanvasCull *>(RSG::canvas);
+	const Rect2 clip_rect = Rect2(0, 0, 100, 100);
+
+	RID parent = rs->canvas_item_create();
+	rs->canvas_item_add_rect(parent, Rect2(0, 0, 8, 8), Color(1, 1, 1));
+	LocalVector<RID> items;
+	for (int i = 0; i < 64; i++) {
+		RID child = rs->canvas_item_create();
+		rs->canvas_item_set_parent(child, parent);
+		rs->canvas_item_add_rect(child, Rect2(0, 0, 8, 8), Color(1, 1, 1));
+		// Mix z indices, draw behind parent, nested subtrees and children outside of the viewport.
+		rs->canvas_item_set_z_index(child, (i % 3) - 1);
+		rs->canvas_item_set_draw_behind_parent(child, i % 5 == 0);
+		rs->canvas_item_set_transform(child, Transform2D(0, Vector2(i % 7 == 0 ? 500 : i, i)));
+		items.push_back(child);
+
+		if (i % 4 == 0) {
+			RID grandchild = rs->canvas_item_create();
+			rs->canvas_item_set_parent(grandchild, child);
+			rs->canvas_item_add_rect(grandchild, Rect2(0, 0, 4, 4), Color(1, 1, 1));
+			rs->canvas_item_set_z_index(grandchild, 1);
+			items.push_back(grandchild);
+		}
+	}
+
+	RendererCanvasCull::Item *parent_item = canvas_cull->canvas_item_owner.get_or_null(parent);
+	const int prev_min_children = canvas_cull->threaded_cull_min_children;
+
+	canvas_cull->threaded_cull_min_children = 0;
+	LocalVector<RendererCanvasRender::Item *> serial = TestRendererCanvasCullInternalsAccessor::cull(canvas_cull, parent_item, clip_rect);
+
+	canvas_cull->threaded_cull_min_children = 16;
+	LocalVector<RendererCanvasRender::Item *> threaded = TestRendererCanvasCullInternalsAccessor::cull(canvas_cull, parent_item, clip_rect);
+
+	canvas_cull->threaded_cull_min_children = prev_min_children;
+
+	// Most children are drawn and some are culled, so the comparison below means something.
+	CHECK(serial.size() > 32);
+	CHECK(serial.size() < items.size());
+	REQUIRE(threaded.size() == serial.size());
+	bool same_order = true;
+	for (uint32_t i = 0; i < serial.size(); i++) {
+		same_order = same_order && threaded[i] == serial[i];
+	}
+	CHECK_MESSAGE(same_order, "Z lists should match the serial cull item for item.");
+
+	for (const RID &item : items) {
+		rs->free(item);
+	}
+	rs->free(parent);
+}
+
+// Stable insertion sort by Y key, as a reference for the radix sort and the coherent path.
+static LocalVector<uint32_t> ysort_reference_order(const LocalVector<real_t> &p_ys) {
+	LocalVector<uint32_t> order;
+	for (uint32_t i = 0; i < p_ys.size(); i++) {
+		uint32_t j = order.size();
+		order.push_back(i);
+		while (j > 0 && RendererCanvasCull::_ysort_key(p_ys[order[j - 1]]) > RendererCanvasCull::_ysort_key(p_ys[i])) {
+			order[j] = order[j - 1];
+			j--;
+		}
+		order[j] = i;
+	}
+	return order;
+}
+
+TEST_CASE("[RendererCanvasCull] Y sort keys and radix sort") {
+	CHECK(RendererCanvasCull::_ysort_key(-0.0) == RendererCanvasCull::_ysort_key(0.0));
+	CHECK(RendererCanvasCull::_ysort_key(-1.0) < RendererCanvasCull::_ysort_key(-0.5));
+	CHECK(RendererCanvasCull::_ysort_key(-0.5) < RendererCanvasCull::_ysort_key(0.0));
+	CHECK(RendererCanvasCull::_ysort_key(0.0) < RendererCanvasCull::_ysort_key(1e-4));
+	CHECK(RendererCanvasCull::_ysort_key(1e-4) < RendererCanvasCull::_ysort_key(1.0));
+	CHECK(RendererCanvasCull::_ysort_key(1.0) < RendererCanvasCull::_ysort_key(1e6));
+
+	// Ties, negatives, both zeroes, and values far apart so every radix pass is used.
+	const real_t values[] = { 3, -1, 0, -0.0, 3, -1e-3, 1e6, -1e6, 2.5, 0, 3, -1, 1e-6, -0.0, 1e-20, 512 };
+	LocalVector<real_t> ys;
+	LocalVector<uint64_t> records;
+	for (const real_t y : values) {
+		records.push_back((uint64_t(RendererCanvasCull::_ysort_key(y)) << 32) | ys.size());
+		ys.push_back(y);
+	}
+	LocalVector<uint64_t> scratch;
+	scratch.resize(records.size());
+
+	RendererCanvasCull::_radix_sort_ysort_records(records.ptr(), scratch.ptr(), records.size());
+
+	const LocalVector<uint32_t> expected = ysort_reference_order(ys);
+	bool same_order = true;
+	for (uint32_t i = 0; i < records.size(); i++) {
+		same_order = same_order && uint32_t(records[i]) == expected[i];
+	}
+	CHECK_MESSAGE(same_order, "Radix sort should match a stable sort by Y key.");
+}
+
+TEST_CASE("[RendererCanvasCull] Y sort keys snap positions near zero to zero") {
+	CHECK(RendererCanvasCull::_ysort_key(1e-6) == RendererCanvasCull::_ysort_key(0.0));
+	CHECK(RendererCanvasCull::_ysort_key(-1e-6) == RendererCanvasCull::_ysort_key(0.0));
+	CHECK(RendererCanvasCull::_ysort_key(9e-6) == RendererCanvasCull::_ysort_key(-9e-6));
+	CHECK(RendererCanvasCull::_ysort_key(-2e-5) < RendererCanvasCull::_ysort_key(0.0));
+	CHECK(RendererCanvasCull::_ysort_key(0.0) < RendererCanvasCull::_ysort_key(2e-5));
+
+	// Rounding noise around zero keeps the tree order.
+	const real_t values[] = { 5e-6, -0.0, -5e-6, 0, 1e-20, -1e-7 };
+	LocalVector<uint64_t> records;
+	for (const real_t y : values) {
+		records.push_back((uint64_t(RendererCanvasCull::_ysort_key(y)) << 32) | records.size());
+	}
+	LocalVector<uint64_t> scratch;
+	scratch.resize(records.size());
+
+	RendererCanvasCull::_radix_sort_ysort_records(records.ptr(), scratch.ptr(), records.size());
+
+	bool tree_order = true;
+	for (uint32_t i = 0; i < records.size(); i++) {
+		tree_order = tree_order && uint32_t(records[i]) == i;
+	}
+	CHECK_MESSAGE(tree_order, "Positions within CMP_EPSILON of zero should keep their tree order.");
+}
+
+TEST_CASE("[SceneTree][RendererCanvasCull] Y sorting from the last order matches a stable sort") {
+	RenderingServer *rs = RenderingServer::get_singleton();
+	RendererCanvasCull *canvas_cull = static_cast<RendererCanvasCull *>(RSG::canvas);
+
+	RID owner = rs->canvas_item_create();
+	LocalVector<RID> rids;
+	LocalVector<RendererCanvasCull::Item *> tree_order;
+	LocalVector<real_t> ys;
+	for (int i = 0; i < 64; i++) {
+		RID rid = rs->canvas_item_create();
+		rids.push_back(rid);
+		tree_order.push_back(canvas_cull->canvas_item_owner.get_or_null(rid));
+		// Pairs of ties, half of them negative, and both zeroes.
+		ys.push_back(i == 33 ? -0.0 : real_t(i / 2) - 16);
+	}
+	RendererCanvasCull::Item *owner_item = canvas_cull->canvas_item_owner.get_or_null(owner);
+
+	LocalVector<RendererCanvasCull::Item *> sorted;
+	auto sort_and_check = [&]() {
+		for (uint32_t i = 0; i < tree_order.size(); i++) {
+			tree_order[i]->ysort_pos.y = ys[i];
+		}
+		sorted = tree_order;
+		canvas_cull->_sort_ysort_items(owner_item, sorted.ptr(), sorted.size());
+
+		const LocalVector<uint32_t> expected = ysort_reference_order(ys);
+		bool same_order = true;
+		for (uint32_t i = 0; i < sorted.size(); i++) {
+			same_order = same_order && sorted[i] == tree_order[expected[i]];
+		}
+		return same_order;
+	};
+
+	// No previous order yet, so this radix sorts.
+	CHECK(sort_and_check());
+
+	// A few items moved, so this re-inserts them into the last order.
+	ys[5] += 1.5;
+	ys[20] = ys[23];
+	ys[32] = -0.0;
+	ys[50] -= 2;
+	CHECK_MESSAGE(sort_and_check(), "Re-inserting moved items should match a stable sort.");
+
+	// Everything moved, which exceeds the move budget and falls back to the radix sort.
+	for (uint32_t i = 0; i < ys.size(); i++) {
+		ys[i] = -real_t(i % 4);
+	}
+	CHECK_MESSAGE(sort_and_check(), "Falling back to the radix sort should match a stable sort.");
+
+	for (const RID &rid : rids) {
+		rs->free(rid);
+	}
+	rs->free(owner);
+}
+
+} // namespace TestRendererCanvasCull
+
+#endif // TEST_RENDERER_CANVAS_CULL_H
@@ -0,0 +1,219 @@
+/**************************************************************************/
+/*  test_renderer_scene_cull.h                                            */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_RENDERER_SCENE_CULL_H
+#define TEST_RENDERER_SCENE_CULL_H
+
+#include "servers/rendering/renderer_scene_cull.h"
+#include "servers/rendering/rendering_server_globals.h"
+#include "servers/rendering_server.h"
+
+#include "core/math/random_pcg.h"
+
+#include "tests/test_macros.h"
+
+namespace TestRendererSceneCull {
+
+TEST_CASE("[RendererSceneCull] Block frustum culling matches per-instance culling") {
+	// Use a small page size so blocks straddle page boundaries.
+	PagedArrayPool<RendererSceneCull::InstanceBounds> pool(16);
+	PagedArray<RendererSceneCull::InstanceBounds> instance_aabbs;
+	instance_aabbs.set_page_pool(&pool);
+
+	RandomPCG rng(1234);
+	const uint32_t instance_count = 203; // Not a multiple of the block size.
+	for (uint32_t i = 0; i < instance_count; i++) {
+		Vector3 position(rng.random(-60.0f, 60.0f), rng.random(-60.0f, 60.0f), rng.random(-60.0f, 60.0f));
+		Vector3 size(rng.random(0.0f, 8.0f), rng.random(0.0f, 8.0f), rng.random(0.0f, 8.0f));
+		instance_aabbs.push_back(RendererSceneCull::InstanceBounds(AABB(position, size)));
+	}
+
+	Projection projection;
+	projection.set_perspective(75.0, 16.0 / 9.0, 0.05, 40.0);
+	Transform3D camera_transform = Transform3D().looking_at(Vector3(1, -0.25, -1), Vector3(0, 1, 0));
+	RendererSceneCull::Frustum frustum(projection.get_projection_planes(camera_transform));
+
+	RendererSceneCull::InstanceBoundsBlock block;
+	uint32_t inside_count = 0;
+	uint32_t mismatch_count = 0;
+	for (uint64_t from = 0; from < instance_count; from += RendererSceneCull::InstanceBoundsBlock::SIZE) {
+		uint64_t to = MIN(uint64_t(instance_count), from + RendererSceneCull::InstanceBoundsBlock::SIZE);
+		block.load(instance_aabbs, from, to);
+		uint32_t mask = block.in_frustum(frustum);
+
+		CHECK_MESSAGE((mask >> (to - from)) == 0, "Lanes past the end of the block should never be reported as inside.");
+
+		for (uint64_t i = from; i < to; i++) {
+			bool expected = instance_aabbs[i].in_frustum(frustum);
+			bool inside = mask & (1u << (i - from));
+			if (expected != inside) {
+				mismatch_count++;
+			}
+			if (expected) {
+				inside_count++;
+			}
+		}
+	}
+
+	CHECK_MESSAGE(inside_count > 0, "Some instances should be inside the frustum.");
+	CHECK_MESSAGE(inside_count < instance_count, "Some instances should be outside the frustum.");
+	CHECK_MESSAGE(mismatch_count == 0, "Block culling should agree with InstanceBounds::in_frustum() for every instance.");
+
+	instance_aabbs.reset();
+}
+
+TEST_CASE("[SceneTree][RendererSceneCull] Batched instance transforms are all applied") {
+	RenderingServer *rs = RenderingServer::get_singleton();
+	RID scenario = rs->scenario_create();
+	RID mesh = rs->mesh_create();
+
+	const int instance_count = 64;
+	Vector<RID> instances;
+	Vector<Transform3D> transforms;
+	for (int i = 0; i < instance_count; i++) {
+		RID instance = rs->instance_create();
+		rs->instance_set_base(instance, mesh);
+		rs->instance_set_scenario(instance, scenario);
+		rs->instance_set_custom_aabb(instance, AABB(Vector3(-0.5, -0.5, -0.5), Vector3(1, 1, 1)));
+		rs->instance_attach_object_instance_id(instance, ObjectID(uint64_t(i + 1)));
+		instances.push_back(instance);
+		transforms.push_back(Transform3D(Basis(), Vector3(i * 10, 0, 0)));
+	}
+
+	// Freed instances are reported and skipped, the others are still applied.
+	RID freed_instance = rs->instance_create();
+	rs->free(freed_instance);
+	instances.push_back(freed_instance);
+	transforms.push_back(Transform3D());
+
+	ERR_PRINT_OFF;
+	rs->instance_set_transforms(instances, transforms);
+	ERR_PRINT_ON;
+
+	// Every instance starts at the origin, so it is only found at its own position if its transform was applied.
+	int mismatch_count = 0;
+	for (int i = 0; i < instance_count; i++) {
+		Vector<ObjectID> culled = rs->instances_cull_aabb(AABB(Vector3(i * 10 - 1, -1, -1), Vector3(2, 2, 2)), scenario);
+		if (culled.size() != 1 || culled[0] != ObjectID(uint64_t(i + 1))) {
+			mismatch_count++;
+		}
+	}
+	CHECK_MESSAGE(mismatch_count == 0, "Each instance should be found at its new position, and only there.");
+
+	for (int i = 0; i < instance_count; i++) {
+		rs->free(instances[i]);
+	}
+	rs->free(mesh);
+	rs->free(scenario);
+}
+
+TEST_CASE("[SceneTree][RendererSceneCull] Threaded instance transform updates match the serial path") {
+	RenderingServer *rs = RenderingServer::get_singleton();
+	RendererSceneCull *scene_cull = static_cast<RendererSceneCull *>(RSG::scene);
+	const uint32_t old_thread_cull_threshold = scene_cull->thread_cull_threshold;
+
+	RID mesh = rs->mesh_create();
+	RID scenarios[2] = { rs->scenario_create(), rs->scenario_create() };
+
+	// Both scenarios get the same instances. The first one is updated on threads, the second one serially.
+	RandomPCG rng(4321);
+	const int instance_count = 256;
+	Vector<RID> instances[2];
+	Vector<Transform3D> transforms;
+	for (int i = 0; i < instance_count; i++) {
+		AABB aabb(Vector3(rng.random(-2.0f, 2.0f), rng.random(-2.0f, 2.0f), rng.random(-2.0f, 2.0f)), Vector3(rng.random(0.1f, 3.0f), rng.random(0.1f, 3.0f), rng.random(0.1f, 3.0f)));
+		Vector3 axis = Vector3(rng.random(-1.0f, 1.0f), rng.random(-1.0f, 1.0f), rng.random(-1.0f, 1.0f)) + Vector3(0, 0, 2);
+		Basis basis = Basis(axis.normalized(), rng.random(0.0f, 6.0f)).scaled(Vector3(rng.random(0.5f, 2.0f), rng.random(0.5f, 2.0f), rng.random(0.5f, 2.0f)));
+		transforms.push_back(Transform3D(basis, Vector3(rng.random(-50.0f, 50.0f), rng.random(-50.0f, 50.0f), rng.random(-50.0f, 50.0f))));
+
+		for (int s = 0; s < 2; s++) {
+			RID instance = rs->instance_create();
+			rs->instance_set_base(instance, mesh);
+			rs->instance_set_scenario(instance, scenarios[s]);
+			rs->instance_set_custom_aabb(instance, aabb);
+			rs->instance_attach_object_instance_id(instance, ObjectID(uint64_t(i + 1)));
+			instances[s].push_back(instance);
+		}
+	}
+	// The first update also resolves the dependencies, which always happens serially.
+	scene_cull->update_dirty_instances();
+
+	// Only moving instances afterwards takes the threaded path.
+	scene_cull->thread_cull_threshold = 0;
+	for (int i = 0; i < instance_count; i++) {
+		rs->instance_set_transform(instances[0][i], transforms[i]);
+	}
+	scene_cull->update_dirty_instances();
+	CHECK_MESSAGE(scene_cull->_instance_transform_update_list.size() == uint32_t(instance_count), "All moved instances should have been updated on threads.");
+
+	for (int i = 0; i < instance_count; i++) {
+		rs->instance_set_transform(instances[1][i], transforms[i]);
+	}
+	while (scene_cull->_instance_update_list.first()) {
+		scene_cull->_update_dirty_instance(scene_cull->_instance_update_list.first()->self());
+	}
+
+	int mismatch_count = 0;
+	for (int i = 0; i < instance_count; i++) {
+		const AABB &threaded_aabb = scene_cull->instance_owner.get_or_null(instances[0][i])->transformed_aabb;
+		const AABB &serial_aabb = scene_cull->instance_owner.get_or_null(instances[1][i])->transformed_aabb;
+		if (!threaded_aabb.is_equal_approx(serial_aabb)) {
+			mismatch_count++;
+		}
+	}
+	CHECK_MESSAGE(mismatch_count == 0, "Threaded and serial updates should produce the same transformed AABBs.");
+
+	// The spatial indexers should agree as well.
+	int cull_mismatch_count = 0;
+	for (int i = 0; i < 32; i++) {
+		AABB query(Vector3(rng.random(-60.0f, 40.0f), rng.random(-60.0f, 40.0f), rng.random(-60.0f, 40.0f)), Vector3(20, 20, 20));
+		Vector<ObjectID> threaded_culled = rs->instances_cull_aabb(query, scenarios[0]);
+		Vector<ObjectID> serial_culled = rs->instances_cull_aabb(query, scenarios[1]);
+		threaded_culled.sort();
+		serial_culled.sort();
+		if (threaded_culled != serial_culled) {
+			cull_mismatch_count++;
+		}
+	}
+	CHECK_MESSAGE(cull_mismatch_count == 0, "Culling both scenarios should find the same instances.");
+
+	scene_cull->thread_cull_threshold = old_thread_cull_threshold;
+	for (int s = 0; s < 2; s++) {
+		for (int i = 0; i < instance_count; i++) {
+			rs->free(instances[s][i]);
+		}
+		rs->free(scenarios[s]);
+	}
+	rs->free(mesh);
+}
+
+} // namespace TestRendererSceneCull
+
+#endif // TEST_RENDERER_SCENE_CULL_H
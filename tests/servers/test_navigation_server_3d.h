@@ -31,6 +31,8 @@
 #ifndef TEST_NAVIGATION_SERVER_3D_H
 #define TEST_NAVIGATION_SERVER_3D_H
 
+#include "core/config/project_settings.h"
+#include "core/os/os.h"
 #include "modules/navigation/nav_utils.h"
 #include "scene/3d/mesh_instance_3d.h"
 #include "scene/resources/3d/primitive_meshes.h"
@@ -762,6 +764,23 @@ TEST_SUITE("[Navigation]") {
 			CHECK_NE(query_result->get_path_owner_ids().size(), 0);
 		}
 
+		SUBCASE("Asynchronous query should update the result on a later process") {
+			Ref<NavigationPathQueryParameters3D> query_parameters = memnew(NavigationPathQueryParameters3D);
+			query_parameters->set_map(map);
+			query_parameters->set_start_position(Vector3(10, 0, 10));
+			query_parameters->set_target_position(Vector3(0, 0, 0));
+			Ref<NavigationPathQueryResult3D> query_result = memnew(NavigationPathQueryResult3D);
+			navigation_server->query_path_async(query_parameters, query_result);
+			CHECK_EQ(query_result->get_path().size(), 0);
+			navigation_server->process(0.0); // Starts the queued queries.
+			navigation_server->process(0.0); // Delivers the results.
+			CHECK_NE(query_result->get_path().size(), 0);
+
+			Ref<NavigationPathQueryResult3D> sync_query_result = memnew(NavigationPathQueryResult3D);
+			navigation_server->query_path(query_parameters, sync_query_result);
+			CHECK_EQ(query_result->get_path(), sync_query_result->get_path());
+		}
+
 		SUBCASE("Elaborate query with non-matching navigation layer mask should yield empty result") {
 			Ref<NavigationPathQueryParameters3D> query_parameters = memnew(NavigationPathQueryParameters3D);
 			query_parameters->set_map(map);
@@ -795,6 +814,241 @@ TEST_SUITE("[Navigation]") {
 		navigation_server->process(0.0); // Give server some cycles to commit.
 	}
 
+	TEST_CASE("[NavigationServer3D] Server should connect and reconnect regions on map sync") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+
+		// Two quads made of two triangles each, separated by a gap smaller than the edge connection margin.
+		Ref<NavigationMesh> navigation_mesh_a = memnew(NavigationMesh);
+		navigation_mesh_a->set_vertices(Vector<Vector3>({ Vector3(0.1, 0, 0.1), Vector3(1.1, 0, 0.1), Vector3(1.1, 0, 1.1), Vector3(0.1, 0, 1.1) }));
+		navigation_mesh_a->add_polygon(Vector<int>({ 0, 1, 2 }));
+		navigation_mesh_a->add_polygon(Vector<int>({ 0, 2, 3 }));
+		Ref<NavigationMesh> navigation_mesh_b = memnew(NavigationMesh);
+		navigation_mesh_b->set_vertices(Vector<Vector3>({ Vector3(1.3, 0, 0.1), Vector3(2.3, 0, 0.1), Vector3(2.3, 0, 1.1), Vector3(1.3, 0, 1.1) }));
+		navigation_mesh_b->add_polygon(Vector<int>({ 0, 1, 2 }));
+		navigation_mesh_b->add_polygon(Vector<int>({ 0, 2, 3 }));
+
+		RID map = navigation_server->map_create();
+		RID region_a = navigation_server->region_create();
+		RID region_b = navigation_server->region_create();
+		navigation_server->map_set_active(map, true);
+		navigation_server->region_set_map(region_a, map);
+		navigation_server->region_set_map(region_b, map);
+		navigation_server->region_set_navigation_mesh(region_a, navigation_mesh_a);
+		navigation_server->region_set_navigation_mesh(region_b, navigation_mesh_b);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+
+		CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_EDGE_COUNT), 10);
+		CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_EDGE_MERGE_COUNT), 2);
+		CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_EDGE_FREE_COUNT), 8);
+		CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_EDGE_CONNECTION_COUNT), 2);
+		CHECK_EQ(navigation_server->region_get_connections_count(region_a), 1);
+		CHECK_EQ(navigation_server->region_get_connections_count(region_b), 1);
+		CHECK_NE(navigation_server->map_get_path(map, Vector3(0.5, 0, 0.5), Vector3(2.0, 0, 0.5), true).size(), 0);
+
+		SUBCASE("Changing only links should keep the region connections") {
+			RID link = navigation_server->link_create();
+			navigation_server->link_set_map(link, map);
+			navigation_server->link_set_start_position(link, Vector3(0.5, 0, 0.5));
+			navigation_server->link_set_end_position(link, Vector3(2.0, 0, 0.5));
+			navigation_server->process(0.0); // Give server some cycles to commit.
+
+			CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_EDGE_CONNECTION_COUNT), 2);
+			CHECK_EQ(navigation_server->region_get_connections_count(region_a), 1);
+			CHECK_NE(navigation_server->map_get_path(map, Vector3(0.5, 0, 0.5), Vector3(2.0, 0, 0.5), true).size(), 0);
+
+			navigation_server->link_set_end_position(link, Vector3(2.0, 0, 1.0));
+			navigation_server->process(0.0); // Give server some cycles to commit.
+			CHECK_EQ(navigation_server->region_get_connections_count(region_a), 1);
+
+			navigation_server->free(link);
+		}
+
+		SUBCASE("Moving a region away should remove its connections") {
+			navigation_server->region_set_transform(region_b, Transform3D(Basis(), Vector3(5, 0, 0)));
+			navigation_server->process(0.0); // Give server some cycles to commit.
+
+			CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_EDGE_MERGE_COUNT), 2);
+			CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_EDGE_CONNECTION_COUNT), 0);
+			CHECK_EQ(navigation_server->region_get_connections_count(region_a), 0);
+			CHECK_EQ(navigation_server->region_get_connections_count(region_b), 0);
+
+			navigation_server->region_set_transform(region_b, Transform3D());
+			navigation_server->process(0.0); // Give server some cycles to commit.
+
+			CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_EDGE_CONNECTION_COUNT), 2);
+			CHECK_EQ(navigation_server->region_get_connections_count(region_a), 1);
+			CHECK_EQ(navigation_server->region_get_connections_count(region_b), 1);
+			CHECK_NE(navigation_server->map_get_path(map, Vector3(0.5, 0, 0.5), Vector3(2.0, 0, 0.5), true).size(), 0);
+		}
+
+		SUBCASE("Removing a region should remove the connections of its neighbors") {
+			navigation_server->region_set_map(region_b, RID());
+			navigation_server->process(0.0); // Give server some cycles to commit.
+
+			CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_POLYGON_COUNT), 2);
+			CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_EDGE_CONNECTION_COUNT), 0);
+			CHECK_EQ(navigation_server->region_get_connections_count(region_a), 0);
+			CHECK_EQ(navigation_server->map_get_path(map, Vector3(0.5, 0, 0.5), Vector3(2.0, 0, 0.5), true).size(), 0);
+
+			navigation_server->region_set_map(region_b, map);
+			navigation_server->process(0.0); // Give server some cycles to commit.
+
+			CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_POLYGON_COUNT), 4);
+			CHECK_EQ(navigation_server->region_get_connections_count(region_a), 1);
+			CHECK_NE(navigation_server->map_get_path(map, Vector3(0.5, 0, 0.5), Vector3(2.0, 0, 0.5), true).size(), 0);
+		}
+
+		SUBCASE("Growing and shrinking a region should keep it connected") {
+			// The same quad split around its center, twice as many polygons as the region had before.
+			Ref<NavigationMesh> navigation_mesh_split = memnew(NavigationMesh);
+			navigation_mesh_split->set_vertices(Vector<Vector3>({ Vector3(0.1, 0, 0.1), Vector3(1.1, 0, 0.1), Vector3(1.1, 0, 1.1), Vector3(0.1, 0, 1.1), Vector3(0.6, 0, 0.6) }));
+			navigation_mesh_split->add_polygon(Vector<int>({ 0, 1, 4 }));
+			navigation_mesh_split->add_polygon(Vector<int>({ 1, 2, 4 }));
+			navigation_mesh_split->add_polygon(Vector<int>({ 2, 3, 4 }));
+			navigation_mesh_split->add_polygon(Vector<int>({ 3, 0, 4 }));
+
+			for (int i = 0; i < 3; i++) {
+				navigation_server->region_set_navigation_mesh(region_a, navigation_mesh_split);
+				navigation_server->process(0.0); // Give server some cycles to commit.
+
+				CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_POLYGON_COUNT), 6);
+				CHECK_EQ(navigation_server->region_get_connections_count(region_a), 1);
+				CHECK_EQ(navigation_server->region_get_connections_count(region_b), 1);
+				CHECK_NE(navigation_server->map_get_path(map, Vector3(0.5, 0, 0.5), Vector3(2.0, 0, 0.5), true).size(), 0);
+
+				navigation_server->region_set_navigation_mesh(region_a, navigation_mesh_a);
+				navigation_server->process(0.0); // Give server some cycles to commit.
+
+				CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_POLYGON_COUNT), 4);
+				CHECK_EQ(navigation_server->region_get_connections_count(region_a), 1);
+				CHECK_EQ(navigation_server->region_get_connections_count(region_b), 1);
+				CHECK_NE(navigation_server->map_get_path(map, Vector3(0.5, 0, 0.5), Vector3(2.0, 0, 0.5), true).size(), 0);
+			}
+		}
+
+		navigation_server->free(region_b);
+		navigation_server->free(region_a);
+		navigation_server->free(map);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+	}
+
+	TEST_CASE("[NavigationServer3D] Server should find paths across regions with hierarchical pathfinding") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+
+		// A row of quads, each made of two triangles and separated by a gap smaller than the edge connection margin.
+		LocalVector<Ref<NavigationMesh>> navigation_meshes;
+		for (int i = 0; i < 4; i++) {
+			const real_t x = 0.1 + i * 1.2;
+			Ref<NavigationMesh> navigation_mesh = memnew(NavigationMesh);
+			navigation_mesh->set_vertices(Vector<Vector3>({ Vector3(x, 0, 0.1), Vector3(x + 1.0, 0, 0.1), Vector3(x + 1.0, 0, 1.1), Vector3(x, 0, 1.1) }));
+			navigation_mesh->add_polygon(Vector<int>({ 0, 1, 2 }));
+			navigation_mesh->add_polygon(Vector<int>({ 0, 2, 3 }));
+			navigation_meshes.push_back(navigation_mesh);
+		}
+
+		RID maps[2];
+		LocalVector<RID> regions;
+		for (int m = 0; m < 2; m++) {
+			ProjectSettings::get_singleton()->set_setting("navigation/pathfinding/use_hierarchical_pathfinding", m == 1);
+			maps[m] = navigation_server->map_create();
+			navigation_server->map_set_active(maps[m], true);
+			for (const Ref<NavigationMesh> &navigation_mesh : navigation_meshes) {
+				RID region = navigation_server->region_create();
+				navigation_server->region_set_map(region, maps[m]);
+				navigation_server->region_set_navigation_mesh(region, navigation_mesh);
+				regions.push_back(region);
+			}
+		}
+		ProjectSettings::get_singleton()->set_setting("navigation/pathfinding/use_hierarchical_pathfinding", false);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+
+		const Vector3 origin(0.5, 0, 0.6);
+		const Vector3 destination(4.2, 0, 0.6);
+		const Vector<Vector3> path = navigation_server->map_get_path(maps[0], origin, destination, true);
+		const Vector<Vector3> hierarchical_path = navigation_server->map_get_path(maps[1], origin, destination, true);
+		CHECK_NE(path.size(), 0);
+		CHECK_EQ(hierarchical_path, path);
+		CHECK(hierarchical_path[hierarchical_path.size() - 1].is_equal_approx(destination));
+
+		SUBCASE("Disconnected regions should fall back to the closest reachable point") {
+			navigation_server->region_set_enabled(regions[2], false);
+			navigation_server->region_set_enabled(regions[6], false);
+			navigation_server->process(0.0); // Give server some cycles to commit.
+
+			CHECK_EQ(navigation_server->map_get_path(maps[1], origin, destination, true), navigation_server->map_get_path(maps[0], origin, destination, true));
+		}
+
+		for (const RID &region : regions) {
+			navigation_server->free(region);
+		}
+		navigation_server->free(maps[1]);
+		navigation_server->free(maps[0]);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+	}
+
+	TEST_CASE("[NavigationServer3D] Server should be able to bake navigation mesh tiles") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+		Ref<NavigationMeshSourceGeometryData3D> source_geometry = memnew(NavigationMeshSourceGeometryData3D);
+
+		Array arr;
+		arr.resize(RS::ARRAY_MAX);
+		BoxMesh::create_mesh_array(arr, Vector3(20.0, 0.001, 10.0));
+		source_geometry->add_mesh_array(arr, Transform3D());
+
+		TypedArray<NavigationMesh> tiles;
+		for (int i = 0; i < 3; i++) {
+			Ref<NavigationMesh> tile = memnew(NavigationMesh);
+			tile->set_border_size(1.0);
+			tile->set_filter_baking_aabb(AABB(Vector3(-11.0 + i * 10.0, -1.0, -6.0), Vector3(12.0, 2.0, 12.0)));
+			tiles.push_back(tile);
+		}
+
+		navigation_server->bake_tiles_from_source_geometry_data(tiles, source_geometry);
+
+		Ref<NavigationMesh> first_tile = tiles[0];
+		Ref<NavigationMesh> second_tile = tiles[1];
+		Ref<NavigationMesh> empty_tile = tiles[2];
+		CHECK_NE(first_tile->get_polygon_count(), 0);
+		CHECK_NE(second_tile->get_polygon_count(), 0);
+		CHECK_EQ(empty_tile->get_polygon_count(), 0);
+		for (const Vector3 &vertex : first_tile->get_vertices()) {
+			CHECK_LE(vertex.x, 0.0 + CMP_EPSILON);
+		}
+		for (const Vector3 &vertex : second_tile->get_vertices()) {
+			CHECK_GE(vertex.x, 0.0 - CMP_EPSILON);
+		}
+
+		SUBCASE("Only tiles intersecting the dirty AABB should be rebaked") {
+			first_tile->clear();
+			second_tile->clear();
+			navigation_server->bake_tiles_from_source_geometry_data(tiles, source_geometry, AABB(Vector3(-8.0, -1.0, -1.0), Vector3(2.0, 2.0, 2.0)));
+			CHECK_NE(first_tile->get_polygon_count(), 0);
+			CHECK_EQ(second_tile->get_polygon_count(), 0);
+		}
+
+		SUBCASE("Tiles should bake asynchronously") {
+			first_tile->clear();
+			second_tile->clear();
+			CallableMock callback_mock;
+			navigation_server->bake_tiles_from_source_geometry_data_async(tiles, source_geometry, AABB(), callable_mp(&callback_mock, &CallableMock::function1).bind(0));
+
+			// The bake only completes on the main thread, once sync() finds all the tiles finished.
+			CHECK_EQ(callback_mock.function1_calls, 0);
+			CHECK(navigation_server->is_baking_navigation_mesh(first_tile));
+			CHECK(navigation_server->is_baking_navigation_mesh(second_tile));
+
+			for (int i = 0; i < 10000 && callback_mock.function1_calls == 0; i++) {
+				OS::get_singleton()->delay_usec(1000);
+				navigation_server->sync();
+			}
+			CHECK_EQ(callback_mock.function1_calls, 1);
+			CHECK_FALSE(navigation_server->is_baking_navigation_mesh(first_tile));
+			CHECK_FALSE(navigation_server->is_baking_navigation_mesh(second_tile));
+			CHECK_NE(first_tile->get_polygon_count(), 0);
+			CHECK_NE(second_tile->get_polygon_count(), 0);
+		}
+	}
+
 	// FIXME: The race condition mentioned below is actually a problem and fails on CI (GH-90613).
 	/*
 	TEST_CASE("[NavigationServer3D] Server should be able to bake asynchronously") {
@@ -52,9 +52,57 @@ namespace RVO2D {
 			agentTree_.resize(2 * agents_.size() - 1);
 			buildAgentTreeRecursive(0, agents_.size(), 0);
 		}
+
+		updateAgentPositions();
 	}
 
 	void KdTree2D::buildAgentTreeRecursive(size_t begin, size_t end, size_t node)
+	{
+		const size_t left = buildAgentTreeNode(begin, end, node);
+
+		if (left != end) {
+			buildAgentTreeRecursive(begin, left, agentTree_[node].left);
+			buildAgentTreeRecursive(left, end, agentTree_[node].right);
+		}
+	}
+
+	void KdTree2D::buildAgentTreeTop(std::vector<Agent2D *> agents, size_t maxTaskSize, std::vector<AgentTreeTask> &tasks)
+	{
+		agents_.swap(agents);
+		tasks.clear();
+
+		if (!agents_.empty()) {
+			agentTree_.resize(2 * agents_.size() - 1);
+			buildAgentTreeTopRecursive(0, agents_.size(), 0, maxTaskSize, tasks);
+		}
+	}
+
+	void KdTree2D::buildAgentTreeTopRecursive(size_t begin, size_t end, size_t node, size_t maxTaskSize, std::vector<AgentTreeTask> &tasks)
+	{
+		if (end - begin <= maxTaskSize) {
+			/* Each subtree only touches its own agents and nodes. */
+			AgentTreeTask task;
+			task.begin = begin;
+			task.end = end;
+			task.node = node;
+			tasks.push_back(task);
+			return;
+		}
+
+		const size_t left = buildAgentTreeNode(begin, end, node);
+
+		if (left != end) {
+			buildAgentTreeTopRecursive(begin, left, agentTree_[node].left, maxTaskSize, tasks);
+			buildAgentTreeTopRecursive(left, end, agentTree_[node].right, maxTaskSize, tasks);
+		}
+	}
+
+	void KdTree2D::buildAgentSubtree(const AgentTreeTask &task)
+	{
+		buildAgentTreeRecursive(task.begin, task.end, task.node);
+	}
+
+	size_t KdTree2D::buildAgentTreeNode(size_t begin, size_t end, size_t node)
 	{
 		agentTree_[node].begin = begin;
 		agentTree_[node].end = end;
@@ -68,40 +116,111 @@ namespace RVO2D {
 			agentTree_[node].minY = std::min(agentTree_[node].minY, agents_[i]->position_.y());
 		}
 
-		if (end - begin > MAX_LEAF_SIZE) {
-			/* No leaf node. */
-			const bool isVertical = (agentTree_[node].maxX - agentTree_[node].minX > agentTree_[node].maxY - agentTree_[node].minY);
-			const float splitValue = (isVertical ? 0.5f * (agentTree_[node].maxX + agentTree_[node].minX) : 0.5f * (agentTree_[node].maxY + agentTree_[node].minY));
+		if (end - begin <= MAX_LEAF_SIZE) {
+			return end;
+		}
 
-			size_t left = begin;
-			size_t right = end;
+		/* No leaf node. */
+		const bool isVertical = (agentTree_[node].maxX - agentTree_[node].minX > agentTree_[node].maxY - agentTree_[node].minY);
+		const float splitValue = (isVertical ? 0.5f * (agentTree_[node].maxX + agentTree_[node].minX) : 0.5f * (agentTree_[node].maxY + agentTree_[node].minY));
 
-			while (left < right) {
-				while (left < right && (isVertical ? agents_[left]->position_.x() : agents_[left]->position_.y()) < splitValue) {
-					++left;
-				}
+		size_t left = begin;
+		size_t right = end;
 
-				while (right > left && (isVertical ? agents_[right - 1]->position_.x() : agents_[right - 1]->position_.y()) >= splitValue) {
-					--right;
-				}
+		while (left < right) {
+			while (left < right && (isVertical ? agents_[left]->position_.x() : agents_[left]->position_.y()) < splitValue) {
+				++left;
+			}
 
-				if (left < right) {
-					std::swap(agents_[left], agents_[right - 1]);
-					++left;
-					--right;
-				}
+			while (right > left && (isVertical ? agents_[right - 1]->position_.x() : agents_[right - 1]->position_.y()) >= splitValue) {
+				--right;
 			}
 
-			if (left == begin) {
+			if (left < right) {
+				std::swap(agents_[left], agents_[right - 1]);
 				++left;
-				++right;
+				--right;
+			}
+		}
+
+		if (left == begin) {
+			++left;
+			++right;
+		}
+
+		agentTree_[node].left = node + 1;
+		agentTree_[node].right = node + 2 * (left - begin);
+
+		return left;
+	}
+
+	float KdTree2D::refitAgentTree()
+	{
+		if (agents_.empty()) {
+			return 0.0f;
+		}
+
+		return refitAgentTreeRecursive(0);
+	}
+
+	float KdTree2D::refitAgentTreeRecursive(size_t node)
+	{
+		AgentTreeNode &treeNode = agentTree_[node];
+
+		if (treeNode.end - treeNode.begin <= MAX_LEAF_SIZE) {
+			treeNode.minX = treeNode.maxX = agents_[treeNode.begin]->position_.x();
+			treeNode.minY = treeNode.maxY = agents_[treeNode.begin]->position_.y();
+
+			for (size_t i = treeNode.begin; i < treeNode.end; ++i) {
+				const Vector2 &position = agents_[i]->position_;
+				agentPositions_[i] = position;
+				treeNode.maxX = std::max(treeNode.maxX, position.x());
+				treeNode.minX = std::min(treeNode.minX, position.x());
+				treeNode.maxY = std::max(treeNode.maxY, position.y());
+				treeNode.minY = std::min(treeNode.minY, position.y());
 			}
 
-			agentTree_[node].left = node + 1;
-			agentTree_[node].right = node + 2 * (left - begin);
+			return (treeNode.maxX - treeNode.minX) + (treeNode.maxY - treeNode.minY);
+		}
 
-			buildAgentTreeRecursive(begin, left, agentTree_[node].left);
-			buildAgentTreeRecursive(left, end, agentTree_[node].right);
+		const float extents = refitAgentTreeRecursive(treeNode.left) + refitAgentTreeRecursive(treeNode.right);
+
+		const AgentTreeNode &leftNode = agentTree_[treeNode.left];
+		const AgentTreeNode &rightNode = agentTree_[treeNode.right];
+		treeNode.minX = std::min(leftNode.minX, rightNode.minX);
+		treeNode.maxX = std::max(leftNode.maxX, rightNode.maxX);
+		treeNode.minY = std::min(leftNode.minY, rightNode.minY);
+		treeNode.maxY = std::max(leftNode.maxY, rightNode.maxY);
+
+		return extents;
+	}
+
+	float KdTree2D::getAgentTreeLeafExtents() const
+	{
+		if (agents_.empty()) {
+			return 0.0f;
+		}
+
+		return getAgentTreeLeafExtentsRecursive(0);
+	}
+
+	float KdTree2D::getAgentTreeLeafExtentsRecursive(size_t node) const
+	{
+		const AgentTreeNode &treeNode = agentTree_[node];
+
+		if (treeNode.end - treeNode.begin <= MAX_LEAF_SIZE) {
+			return (treeNode.maxX - treeNode.minX) + (treeNode.maxY - treeNode.minY);
+		}
+
+		return getAgentTreeLeafExtentsRecursive(treeNode.left) + getAgentTreeLeafExtentsRecursive(treeNode.right);
+	}
+
+	void KdTree2D::updateAgentPositions()
+	{
+		agentPositions_.resize(agents_.size());
+
+		for (size_t i = 0; i < agents_.size(); ++i) {
+			agentPositions_[i] = agents_[i]->position_;
 		}
 	}
 
@@ -255,8 +374,24 @@ namespace RVO2D {
 	void KdTree2D::queryAgentTreeRecursive(Agent2D *agent, float &rangeSq, size_t node) const
 	{
 		if (agentTree_[node].end - agentTree_[node].begin <= MAX_LEAF_SIZE) {
-			for (size_t i = agentTree_[node].begin; i < agentTree_[node].end; ++i) {
-				agent->insertAgentNeighbor(agents_[i], rangeSq);
+			/* Test the distances of the whole leaf at once on the packed positions, then only insert the agents in range. */
+			const size_t begin = agentTree_[node].begin;
+			const size_t count = agentTree_[node].end - begin;
+			const Vector2 *positions = agentPositions_.data() + begin;
+			const float x = agent->position_.x();
+			const float y = agent->position_.y();
+			float distSq[MAX_LEAF_SIZE];
+
+			for (size_t i = 0; i < count; ++i) {
+				const float dx = x - positions[i].x();
+				const float dy = y - positions[i].y();
+				distSq[i] = dx * dx + dy * dy;
+			}
+
+			for (size_t i = 0; i < count; ++i) {
+				if (distSq[i] < rangeSq) {
+					agent->insertAgentNeighbor(agents_[begin + i], rangeSq);
+				}
 			}
 		}
 		else {
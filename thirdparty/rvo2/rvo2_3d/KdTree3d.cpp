@@ -51,9 +51,57 @@ namespace RVO3D {
 			agentTree_.resize(2 * agents_.size() - 1);
 			buildAgentTreeRecursive(0, agents_.size(), 0);
 		}
+
+		updateAgentPositions();
 	}
 
 	void KdTree3D::buildAgentTreeRecursive(size_t begin, size_t end, size_t node)
+	{
+		const size_t left = buildAgentTreeNode(begin, end, node);
+
+		if (left != end) {
+			buildAgentTreeRecursive(begin, left, agentTree_[node].left);
+			buildAgentTreeRecursive(left, end, agentTree_[node].right);
+		}
+	}
+
+	void KdTree3D::buildAgentTreeTop(std::vector<Agent3D *> agents, size_t maxTaskSize, std::vector<AgentTreeTask> &tasks)
+	{
+		agents_.swap(agents);
+		tasks.clear();
+
+		if (!agents_.empty()) {
+			agentTree_.resize(2 * agents_.size() - 1);
+			buildAgentTreeTopRecursive(0, agents_.size(), 0, maxTaskSize, tasks);
+		}
+	}
+
+	void KdTree3D::buildAgentTreeTopRecursive(size_t begin, size_t end, size_t node, size_t maxTaskSize, std::vector<AgentTreeTask> &tasks)
+	{
+		if (end - begin <= maxTaskSize) {
+			/* Each subtree only touches its own agents and nodes. */
+			AgentTreeTask task;
+			task.begin = begin;
+			task.end = end;
+			task.node = node;
+			tasks.push_back(task);
+			return;
+		}
+
+		const size_t left = buildAgentTreeNode(begin, end, node);
+
+		if (left != end) {
+			buildAgentTreeTopRecursive(begin, left, agentTree_[node].left, maxTaskSize, tasks);
+			buildAgentTreeTopRecursive(left, end, agentTree_[node].right, maxTaskSize, tasks);
+		}
+	}
+
+	void KdTree3D::buildAgentSubtree(const AgentTreeTask &task)
+	{
+		buildAgentTreeRecursive(task.begin, task.end, task.node);
+	}
+
+	size_t KdTree3D::buildAgentTreeNode(size_t begin, size_t end, size_t node)
 	{
 		agentTree_[node].begin = begin;
 		agentTree_[node].end = end;
@@ -116,8 +164,79 @@ namespace RVO3D {
 			agentTree_[node].left = node + 1;
 			agentTree_[node].right = node + 2 * leftSize;
 
-			buildAgentTreeRecursive(begin, left, agentTree_[node].left);
-			buildAgentTreeRecursive(left, end, agentTree_[node].right);
+			return left;
+		}
+
+		return end;
+	}
+
+	float KdTree3D::refitAgentTree()
+	{
+		if (agents_.empty()) {
+			return 0.0f;
+		}
+
+		return refitAgentTreeRecursive(0);
+	}
+
+	float KdTree3D::refitAgentTreeRecursive(size_t node)
+	{
+		AgentTreeNode3D &treeNode = agentTree_[node];
+
+		if (treeNode.end - treeNode.begin <= RVO3D_MAX_LEAF_SIZE) {
+			treeNode.minCoord = agents_[treeNode.begin]->position_;
+			treeNode.maxCoord = agents_[treeNode.begin]->position_;
+
+			for (size_t i = treeNode.begin; i < treeNode.end; ++i) {
+				const Vector3 &position = agents_[i]->position_;
+				agentPositions_[i] = position;
+				for (size_t coord = 0; coord < 3; ++coord) {
+					treeNode.maxCoord[coord] = std::max(treeNode.maxCoord[coord], position[coord]);
+					treeNode.minCoord[coord] = std::min(treeNode.minCoord[coord], position[coord]);
+				}
+			}
+
+			return (treeNode.maxCoord[0] - treeNode.minCoord[0]) + (treeNode.maxCoord[1] - treeNode.minCoord[1]) + (treeNode.maxCoord[2] - treeNode.minCoord[2]);
+		}
+
+		const float extents = refitAgentTreeRecursive(treeNode.left) + refitAgentTreeRecursive(treeNode.right);
+
+		const AgentTreeNode3D &leftNode = agentTree_[treeNode.left];
+		const AgentTreeNode3D &rightNode = agentTree_[treeNode.right];
+		for (size_t coord = 0; coord < 3; ++coord) {
+			treeNode.minCoord[coord] = std::min(leftNode.minCoord[coord], rightNode.minCoord[coord]);
+			treeNode.maxCoord[coord] = std::max(leftNode.maxCoord[coord], rightNode.maxCoord[coord]);
+		}
+
+		return extents;
+	}
+
+	float KdTree3D::getAgentTreeLeafExtents() const
+	{
+		if (agents_.empty()) {
+			return 0.0f;
+		}
+
+		return getAgentTreeLeafExtentsRecursive(0);
+	}
+
+	float KdTree3D::getAgentTreeLeafExtentsRecursive(size_t node) const
+	{
+		const AgentTreeNode3D &treeNode = agentTree_[node];
+
+		if (treeNode.end - treeNode.begin <= RVO3D_MAX_LEAF_SIZE) {
+			return (treeNode.maxCoord[0] - treeNode.minCoord[0]) + (treeNode.maxCoord[1] - treeNode.minCoord[1]) + (treeNode.maxCoord[2] - treeNode.minCoord[2]);
+		}
+
+		return getAgentTreeLeafExtentsRecursive(treeNode.left) + getAgentTreeLeafExtentsRecursive(treeNode.right);
+	}
+
+	void KdTree3D::updateAgentPositions()
+	{
+		agentPositions_.resize(agents_.size());
+
+		for (size_t i = 0; i < agents_.size(); ++i) {
+			agentPositions_[i] = agents_[i]->position_;
 		}
 	}
 
@@ -129,8 +248,26 @@ namespace RVO3D {
 	void KdTree3D::queryAgentTreeRecursive(Agent3D *agent, float &rangeSq, size_t node) const
 	{
 		if (agentTree_[node].end - agentTree_[node].begin <= RVO3D_MAX_LEAF_SIZE) {
-			for (size_t i = agentTree_[node].begin; i < agentTree_[node].end; ++i) {
-				agent->insertAgentNeighbor(agents_[i], rangeSq);
+			/* Test the distances of the whole leaf at once on the packed positions, then only insert the agents in range. */
+			const size_t begin = agentTree_[node].begin;
+			const size_t count = agentTree_[node].end - begin;
+			const Vector3 *positions = agentPositions_.data() + begin;
+			const float x = agent->position_.x();
+			const float y = agent->position_.y();
+			const float z = agent->position_.z();
+			float distSq[RVO3D_MAX_LEAF_SIZE];
+
+			for (size_t i = 0; i < count; ++i) {
+				const float dx = x - positions[i].x();
+				const float dy = y - positions[i].y();
+				const float dz = z - positions[i].z();
+				distSq[i] = dx * dx + dy * dy + dz * dz;
+			}
+
+			for (size_t i = 0; i < count; ++i) {
+				if (distSq[i] < rangeSq) {
+					agent->insertAgentNeighbor(agents_[begin + i], rangeSq);
+				}
 			}
 		}
 		else {
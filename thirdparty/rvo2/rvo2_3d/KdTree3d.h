@@ -99,6 +99,58 @@ namespace RVO3D {
 
 		void buildAgentTreeRecursive(size_t begin, size_t end, size_t node);
 
+		/**
+		 * \brief   A subtree of the agent <i>k</i>d-tree that is left to build,
+		 *          see buildAgentTreeTop().
+		 */
+		class AgentTreeTask {
+		public:
+			size_t begin;
+			size_t end;
+			size_t node;
+		};
+
+		/**
+		 * \brief   Builds the top of an agent <i>k</i>d-tree, stopping at
+		 *          subtrees of at most maxTaskSize agents. The subtrees are
+		 *          independent and can be built in parallel with
+		 *          buildAgentSubtree(), followed by updateAgentPositions().
+		 */
+		void buildAgentTreeTop(std::vector<Agent3D *> agents, size_t maxTaskSize, std::vector<AgentTreeTask> &tasks);
+
+		void buildAgentTreeTopRecursive(size_t begin, size_t end, size_t node, size_t maxTaskSize, std::vector<AgentTreeTask> &tasks);
+
+		void buildAgentSubtree(const AgentTreeTask &task);
+
+		/**
+		 * \brief   Computes the bounds of a node and splits its agents. Returns
+		 *          the first agent of the right child, or end for leaf nodes.
+		 */
+		size_t buildAgentTreeNode(size_t begin, size_t end, size_t node);
+
+		/**
+		 * \brief   Updates the bounds of the agent <i>k</i>d-tree to the current
+		 *          agent positions, keeping its structure. Returns the summed
+		 *          extents of the leaves, see getAgentTreeLeafExtents().
+		 */
+		float refitAgentTree();
+
+		float refitAgentTreeRecursive(size_t node);
+
+		/**
+		 * \brief   Returns the summed extents of all the leaves, which grows as
+		 *          a refitted tree gets less efficient.
+		 */
+		float getAgentTreeLeafExtents() const;
+
+		float getAgentTreeLeafExtentsRecursive(size_t node) const;
+
+		/**
+		 * \brief   Copies the agent positions next to each other, in tree order,
+		 *          for the neighbor distance tests.
+		 */
+		void updateAgentPositions();
+
 		/**
 		 * \brief   Computes the agent neighbors of the specified agent.
 		 * \param   agent    A pointer to the agent for which agent neighbors are to be computed.
@@ -109,6 +161,7 @@ namespace RVO3D {
 		void queryAgentTreeRecursive(Agent3D *agent, float &rangeSq, size_t node) const;
 
 		std::vector<Agent3D *> agents_;
+		std::vector<Vector3> agentPositions_;
 		std::vector<AgentTreeNode3D> agentTree_;
 		RVOSimulator3D *sim_;
 